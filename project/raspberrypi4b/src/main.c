@@ -34,11 +34,49 @@
  * </table>
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "driver_qmc5883l_basic.h"
 #include "driver_qmc5883l_register_test.h"
 #include "driver_qmc5883l_read_test.h"
+#include "driver_qmc5883l_fault_test.h"
+#include "driver_qmc5883l_calibration_test.h"
+#include "driver_qmc5883l_batch_test.h"
+#include "driver_qmc5883l_heading_test.h"
+#include "driver_qmc5883l_decimate_test.h"
+#include "driver_qmc5883l_hampel_test.h"
+#include "driver_qmc5883l_tempco_test.h"
+#include "driver_qmc5883l_autorange_test.h"
+#include "driver_qmc5883l_change_test.h"
+#include "driver_qmc5883l_mains_test.h"
+#include "driver_qmc5883l_ahrs_test.h"
+#include "driver_qmc5883l_bench_test.h"
+#include "driver_qmc5883l_sweep_test.h"
+#include "driver_qmc5883l_allan_test.h"
+#include "driver_qmc5883l_resample_test.h"
+#include "driver_qmc5883l_binlog_test.h"
+#include "driver_qmc5883l_index_test.h"
+#include "driver_qmc5883l_analyze_test.h"
+#include "driver_qmc5883l_duty_test.h"
+#include "driver_qmc5883l_adaptive_test.h"
+#include "driver_qmc5883l_record_test.h"
 #include <getopt.h>
 #include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief  monotonic clock
+ * @return current time in microseconds
+ * @note   none
+ */
+static uint64_t a_timestamp_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
 
 /**
  * @brief     qmc5883l full function
@@ -181,6 +219,216 @@ uint8_t qmc5883l(uint8_t argc, char **argv)
 
         return 0;
     }
+    else if (strcmp("t_fault", type) == 0)
+    {
+        /* run fault test */
+        if (qmc5883l_fault_test(times, a_timestamp_us) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_calibration", type) == 0)
+    {
+        /* run calibration test */
+        if (qmc5883l_calibration_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_batch", type) == 0)
+    {
+        /* run batch test */
+        if (qmc5883l_batch_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_heading", type) == 0)
+    {
+        /* run heading test */
+        if (qmc5883l_heading_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_decimate", type) == 0)
+    {
+        /* run decimate test */
+        if (qmc5883l_decimate_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_hampel", type) == 0)
+    {
+        /* run hampel test */
+        if (qmc5883l_hampel_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_tempco", type) == 0)
+    {
+        /* run tempco test */
+        if (qmc5883l_tempco_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_autorange", type) == 0)
+    {
+        /* run autorange test */
+        if (qmc5883l_autorange_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_change", type) == 0)
+    {
+        /* run change test */
+        if (qmc5883l_change_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_mains", type) == 0)
+    {
+        /* run mains test */
+        if (qmc5883l_mains_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_ahrs", type) == 0)
+    {
+        /* run ahrs test */
+        if (qmc5883l_ahrs_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_bench", type) == 0)
+    {
+        /* run bench test */
+        if (qmc5883l_bench_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_sweep", type) == 0)
+    {
+        /* run sweep test */
+        if (qmc5883l_sweep_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_allan", type) == 0)
+    {
+        /* run allan test */
+        if (qmc5883l_allan_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_resample", type) == 0)
+    {
+        /* run resample test */
+        if (qmc5883l_resample_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_binlog", type) == 0)
+    {
+        /* run binlog test */
+        if (qmc5883l_binlog_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_index", type) == 0)
+    {
+        /* run index test */
+        if (qmc5883l_index_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_analyze", type) == 0)
+    {
+        /* run analyze test */
+        if (qmc5883l_analyze_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_duty", type) == 0)
+    {
+        /* run duty test */
+        if (qmc5883l_duty_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_adaptive", type) == 0)
+    {
+        /* run adaptive test */
+        if (qmc5883l_adaptive_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_record", type) == 0)
+    {
+        /* run record test */
+        if (qmc5883l_record_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
     else if (strcmp("e_read", type) == 0)
     {
         uint8_t res;
@@ -230,6 +478,27 @@ uint8_t qmc5883l(uint8_t argc, char **argv)
         qmc5883l_interface_debug_print("  qmc5883l (-p | --port)\n");
         qmc5883l_interface_debug_print("  qmc5883l (-t reg | --test=reg)\n");
         qmc5883l_interface_debug_print("  qmc5883l (-t read | --test=read) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t fault | --test=fault) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t calibration | --test=calibration) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t batch | --test=batch) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t heading | --test=heading) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t decimate | --test=decimate) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t hampel | --test=hampel) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t tempco | --test=tempco) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t autorange | --test=autorange) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t change | --test=change) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t mains | --test=mains) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t ahrs | --test=ahrs) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t bench | --test=bench) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t sweep | --test=sweep) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t allan | --test=allan) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t resample | --test=resample) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t binlog | --test=binlog) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t index | --test=index) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t analyze | --test=analyze) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t duty | --test=duty) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t adaptive | --test=adaptive) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t record | --test=record) [--times=<num>]\n");
         qmc5883l_interface_debug_print("  qmc5883l (-e read | --example=read) [--times=<num>]\n");
         qmc5883l_interface_debug_print("\n");
         qmc5883l_interface_debug_print("Options:\n");
@@ -238,7 +507,7 @@ uint8_t qmc5883l(uint8_t argc, char **argv)
         qmc5883l_interface_debug_print("  -h, --help                     Show the help.\n");
         qmc5883l_interface_debug_print("  -i, --information              Show the chip information.\n");
         qmc5883l_interface_debug_print("  -p, --port                     Display the pin connections of the current board.\n");
-        qmc5883l_interface_debug_print("  -t <reg | read>, --test=<reg | read>\n");
+        qmc5883l_interface_debug_print("  -t <reg | read | fault | calibration | batch | heading | decimate | hampel | tempco | autorange | change | mains | ahrs | bench | sweep | allan | resample | binlog | index | analyze | duty | adaptive | record>, --test=<reg | read | fault | calibration | batch | heading | decimate | hampel | tempco | autorange | change | mains | ahrs | bench | sweep | allan | resample | binlog | index | analyze | duty | adaptive | record>\n");
         qmc5883l_interface_debug_print("                                 Run the driver test.\n");
         qmc5883l_interface_debug_print("      --times=<num>              Set the running times.([default: 3])\n");
 
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      console.c
+ * @brief     console source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "console.h"
+
+static uint32_t gs_error_count = 0;        /**< failed check number */
+
+/**
+ * @brief     print a string to the console
+ * @param[in] *str points to a string buffer
+ * @note      a string containing "error" is counted as a failed check
+ */
+void console_print(const char *str)
+{
+    /* the driver tests report a failed check with "error" */
+    if (strstr(str, "error") != NULL)
+    {
+        gs_error_count++;
+    }
+    
+    (void)fputs(str, stdout);
+}
+
+/**
+ * @brief  get the number of failed checks
+ * @return failed check number
+ * @note   none
+ */
+uint32_t console_get_error_count(void)
+{
+    return gs_error_count;
+}
@@ -0,0 +1,902 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_basic.h"
+#include "driver_qmc5883l_register_test.h"
+#include "driver_qmc5883l_read_test.h"
+#include "driver_qmc5883l_fault_test.h"
+#include "driver_qmc5883l_calibration_test.h"
+#include "driver_qmc5883l_batch_test.h"
+#include "driver_qmc5883l_heading_test.h"
+#include "driver_qmc5883l_decimate_test.h"
+#include "driver_qmc5883l_hampel_test.h"
+#include "driver_qmc5883l_tempco_test.h"
+#include "driver_qmc5883l_autorange_test.h"
+#include "driver_qmc5883l_change_test.h"
+#include "driver_qmc5883l_mains_test.h"
+#include "driver_qmc5883l_ahrs_test.h"
+#include "driver_qmc5883l_bench_test.h"
+#include "driver_qmc5883l_sweep_test.h"
+#include "driver_qmc5883l_allan_test.h"
+#include "driver_qmc5883l_resample_test.h"
+#include "driver_qmc5883l_binlog_test.h"
+#include "driver_qmc5883l_index_test.h"
+#include "driver_qmc5883l_analyze_test.h"
+#include "driver_qmc5883l_duty_test.h"
+#include "driver_qmc5883l_adaptive_test.h"
+#include "driver_qmc5883l_device_test.h"
+#include "driver_qmc5883l_coro_test.h"
+#include "driver_qmc5883l_record_test.h"
+#include "driver_qmc5883l_sim.h"
+#include "console.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * @brief simulated field definition
+ */
+#define SIMULATOR_FIELD_X        200.0f        /**< x field in m_gauss */
+#define SIMULATOR_FIELD_Y        -150.0f       /**< y field in m_gauss */
+#define SIMULATOR_FIELD_Z        400.0f        /**< z field in m_gauss */
+
+/**
+ * @brief simulated distortion definition
+ */
+#define SIMULATOR_EARTH_FIELD    500.0f        /**< earth field in m_gauss */
+
+/**
+ * @brief simulated oscillator definition
+ */
+#define SIMULATOR_CLOCK_DRIFT_PPM    20000     /**< chip clock 2% slow */
+
+static qmc5883l_handle_t gs_handle;        /**< qmc5883l handle */
+static const float gs_hard_iron[3] =       /**< hard iron offset in m_gauss */
+{
+    120.0f, -80.0f, 60.0f,
+};
+static const float gs_soft_iron[3][3] =    /**< soft iron matrix */
+{
+    {1.10f, 0.05f, 0.02f},
+    {0.05f, 0.92f, -0.03f},
+    {0.02f, -0.03f, 1.04f},
+};
+static const float gs_drift_linear[3] =    /**< offset drift in m_gauss per degree */
+{
+    0.50f, -0.30f, 0.20f,
+};
+static const float gs_drift_quadratic[3] = /**< offset drift in m_gauss per square degree */
+{
+    0.010f, 0.005f, -0.008f,
+};
+
+/**
+ * @brief      distorted field of a sensor tumbling through all orientations
+ * @param[in]  time_us is the virtual time
+ * @param[out] *m_gauss points to a field buffer
+ * @note       the field direction spirals over the whole sphere every 7.3 s
+ */
+static void a_tumble_field(uint64_t time_us, float m_gauss[3])
+{
+    const double pi = 3.14159265358979323846;
+    double t;
+    double theta;
+    double phi;
+    float f[3];
+    uint8_t i;
+    
+    /* walk the polar angle slowly and the azimuth quickly */
+    t = (double)time_us / 1000000.0;
+    theta = pi * (0.5 - 0.5 * cos(2.0 * pi * t / 7.3));
+    phi = 2.0 * pi * t / 0.9;
+    f[0] = SIMULATOR_EARTH_FIELD * (float)(sin(theta) * cos(phi));
+    f[1] = SIMULATOR_EARTH_FIELD * (float)(sin(theta) * sin(phi));
+    f[2] = SIMULATOR_EARTH_FIELD * (float)cos(theta);
+    
+    /* apply the soft and hard iron */
+    for (i = 0; i < 3; i++)
+    {
+        m_gauss[i] = gs_soft_iron[i][0] * f[0] + gs_soft_iron[i][1] * f[1] + gs_soft_iron[i][2] * f[2] + gs_hard_iron[i];
+    }
+}
+
+/**
+ * @brief      field of a magnet moved close to the sensor and away again
+ * @param[in]  time_us is the virtual time
+ * @param[out] *m_gauss points to a field buffer
+ * @note       the magnet adds up to 4.5 gauss every 4 s
+ */
+static void a_magnet_field(uint64_t time_us, float m_gauss[3])
+{
+    const double pi = 3.14159265358979323846;
+    float a;
+    
+    a = 4500.0f * (float)(0.5 - 0.5 * cos(2.0 * pi * (double)time_us / 4000000.0));
+    m_gauss[0] = SIMULATOR_FIELD_X + 0.6f * a;
+    m_gauss[1] = SIMULATOR_FIELD_Y;
+    m_gauss[2] = SIMULATOR_FIELD_Z + 0.8f * a;
+}
+
+/**
+ * @brief      field of a car parking over the sensor
+ * @param[in]  time_us is the virtual time
+ * @param[out] *m_gauss points to a field buffer
+ * @note       the car arrives at 6 s and leaves at 13 s, the background drifts slowly
+ */
+static void a_car_field(uint64_t time_us, float m_gauss[3])
+{
+    double t;
+    float p;
+    
+    t = (double)time_us / 1000000.0;
+    p = (float)((t < 6.0) ? 0.0 : ((t < 7.0) ? (t - 6.0) : ((t < 13.0) ? 1.0 : ((t < 14.0) ? (14.0 - t) : 0.0))));
+    m_gauss[0] = SIMULATOR_FIELD_X + 0.2f * (float)t + 40.0f * p;
+    m_gauss[1] = SIMULATOR_FIELD_Y - 25.0f * p;
+    m_gauss[2] = SIMULATOR_FIELD_Z + 90.0f * p;
+}
+
+/**
+ * @brief      field at the roadside with passing vehicles
+ * @param[in]  time_us is the virtual time
+ * @param[out] *m_gauss points to a field buffer
+ * @note       a vehicle passes every 10 s from 6 s on, each one a bump of about half a second
+ */
+static void a_traffic_field(uint64_t time_us, float m_gauss[3])
+{
+    double t;
+    double u;
+    float p;
+    
+    t = (double)time_us / 1000000.0;
+    u = (t < 1.0) ? 5.0 : fmod(t - 1.0, 10.0) - 5.0;
+    p = (float)exp(-(u / 0.25) * (u / 0.25));
+    m_gauss[0] = SIMULATOR_FIELD_X + 60.0f * p;
+    m_gauss[1] = SIMULATOR_FIELD_Y - 30.0f * p;
+    m_gauss[2] = SIMULATOR_FIELD_Z + 80.0f * p;
+}
+
+/**
+ * @brief      field next to a cabinet with 60Hz wiring
+ * @param[in]  time_us is the virtual time
+ * @param[out] *m_gauss points to a field buffer
+ * @note       60Hz on x, 120Hz on y and 180Hz on z
+ */
+static void a_mains_field(uint64_t time_us, float m_gauss[3])
+{
+    const double pi = 3.14159265358979323846;
+    double t;
+    
+    t = (double)time_us / 1000000.0;
+    m_gauss[0] = SIMULATOR_FIELD_X + (float)(6.0 * sin(2.0 * pi * 60.0 * t));
+    m_gauss[1] = SIMULATOR_FIELD_Y + (float)(2.0 * sin(2.0 * pi * 120.0 * t + 0.7));
+    m_gauss[2] = SIMULATOR_FIELD_Z + (float)(3.0 * sin(2.0 * pi * 180.0 * t + 1.9));
+}
+
+/**
+ * @brief     die temperature sweeping the deployment range
+ * @param[in] time_us is the virtual time
+ * @return    temperature in degrees
+ * @note      a triangle from -20 to 60 degrees and back every 10 s
+ */
+static float a_sweep_temperature(uint64_t time_us)
+{
+    double t;
+    
+    t = fmod((double)time_us / 1000000.0, 10.0) / 5.0;
+    
+    return -20.0f + 80.0f * (float)((t < 1.0) ? t : (2.0 - t));
+}
+
+/**
+ * @brief  config test over every output rate, full scale and over sample
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+static uint8_t a_config_test(void)
+{
+    const uint32_t rate_hz[4] = {10, 50, 100, 200};
+    const uint32_t sample_num[4] = {512, 256, 128, 64};
+    const float field[3] = {SIMULATOR_FIELD_X, SIMULATOR_FIELD_Y, SIMULATOR_FIELD_Z};
+    uint8_t res;
+    uint8_t rate;
+    uint8_t scale;
+    uint8_t sample;
+    uint8_t i;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    qmc5883l_sim_set_noise(0.0f, 0);
+    
+    /* start config test */
+    qmc5883l_interface_debug_print("qmc5883l: start config test.\n");
+    
+    for (rate = 0; rate < 4; rate++)
+    {
+        for (scale = 0; scale < 2; scale++)
+        {
+            for (sample = 0; sample < 4; sample++)
+            {
+                int16_t raw[3];
+                float m_gauss[3];
+                qmc5883l_output_rate_t rate_check;
+                qmc5883l_full_scale_t scale_check;
+                qmc5883l_over_sample_t sample_check;
+                qmc5883l_sim_stats_t stats;
+                float lsb;
+                uint8_t ok;
+                
+                /* set the config */
+                if ((qmc5883l_set_output_rate(&gs_handle, (qmc5883l_output_rate_t)rate) != 0) ||
+                    (qmc5883l_set_full_scale(&gs_handle, (qmc5883l_full_scale_t)scale) != 0) ||
+                    (qmc5883l_set_over_sample(&gs_handle, (qmc5883l_over_sample_t)sample) != 0) ||
+                    (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+                {
+                    qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+                    (void)qmc5883l_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+                if ((qmc5883l_get_output_rate(&gs_handle, &rate_check) != 0) ||
+                    (qmc5883l_get_full_scale(&gs_handle, &scale_check) != 0) ||
+                    (qmc5883l_get_over_sample(&gs_handle, &sample_check) != 0))
+                {
+                    qmc5883l_interface_debug_print("qmc5883l: get config failed.\n");
+                    (void)qmc5883l_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+                ok = ((rate_check == rate) && (scale_check == scale) && (sample_check == sample)) ? 1 : 0;
+                
+                /* drop the sample of the previous config and read a new one */
+                if ((qmc5883l_read(&gs_handle, raw, m_gauss) != 0) || (qmc5883l_read(&gs_handle, raw, m_gauss) != 0))
+                {
+                    qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+                    (void)qmc5883l_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+                lsb = (scale == QMC5883L_FULL_SCALE_2GAUSS) ? 12.0f : 3.0f;
+                for (i = 0; i < 3; i++)
+                {
+                    float d;
+                    
+                    d = (float)raw[i] - field[i] * lsb;
+                    if ((d > 0.5f) || (d < -0.5f))
+                    {
+                        ok = 0;
+                    }
+                    d = m_gauss[i] - field[i];
+                    if ((d > 0.5f) || (d < -0.5f))
+                    {
+                        ok = 0;
+                    }
+                }
+                
+                /* check the output rate over one second */
+                qmc5883l_sim_clear_stats();
+                qmc5883l_interface_delay_ms(1000);
+                (void)qmc5883l_sim_get_stats(&stats);
+                if ((stats.samples + 1 < rate_hz[rate]) || (stats.samples > rate_hz[rate] + 1))
+                {
+                    ok = 0;
+                }
+                qmc5883l_interface_debug_print("qmc5883l: check %dHz, %dgauss, %d over sample %s.\n",
+                                               rate_hz[rate], (scale == QMC5883L_FULL_SCALE_2GAUSS) ? 2 : 8,
+                                               sample_num[sample], (ok != 0) ? "ok" : "error");
+            }
+        }
+    }
+    
+    /* finish config test */
+    qmc5883l_interface_debug_print("qmc5883l: finish config test.\n");
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief     qmc5883l full function
+ * @param[in] argc is arg numbers
+ * @param[in] **argv is the arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t qmc5883l(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "hie:t:";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"information", no_argument, NULL, 'i'},
+        {"example", required_argument, NULL, 'e'},
+        {"test", required_argument, NULL, 't'},
+        {"times", required_argument, NULL, 1},
+        {NULL, 0, NULL, 0},
+    };
+    char type[33] = "unknown";
+    uint32_t times = 3;
+    
+    /* if no params */
+    if (argc == 1)
+    {
+        /* goto the help */
+        goto help;
+    }
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "h");
+                
+                break;
+            }
+            
+            /* information */
+            case 'i' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "i");
+                
+                break;
+            }
+            
+            /* example */
+            case 'e' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "e_%s", optarg);
+                
+                break;
+            }
+            
+            /* test */
+            case 't' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "t_%s", optarg);
+                
+                break;
+            }
+            
+            /* running times */
+            case 1 :
+            {
+                /* set the times */
+                times = atol(optarg);
+                
+                break;
+            } 
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    /* run the function */
+    if (strcmp("t_reg", type) == 0)
+    {
+        /* run reg test */
+        if (qmc5883l_register_test() != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_read", type) == 0)
+    {
+        /* run read test */
+        if (qmc5883l_read_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_fault", type) == 0)
+    {
+        /* run fault test */
+        if (qmc5883l_fault_test(times, qmc5883l_sim_get_time_us) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_config", type) == 0)
+    {
+        /* run config test */
+        if (a_config_test() != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_calibration", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run calibration test on a tumbling sensor */
+        qmc5883l_sim_set_field_source(a_tumble_field);
+        res = qmc5883l_calibration_test(times);
+        qmc5883l_sim_set_field_source(NULL);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_batch", type) == 0)
+    {
+        /* run batch test */
+        if (qmc5883l_batch_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_heading", type) == 0)
+    {
+        /* run heading test */
+        if (qmc5883l_heading_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_decimate", type) == 0)
+    {
+        /* run decimate test */
+        if (qmc5883l_decimate_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_hampel", type) == 0)
+    {
+        /* run hampel test */
+        if (qmc5883l_hampel_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_tempco", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run tempco test on a drifting sensor */
+        qmc5883l_sim_set_temperature_source(a_sweep_temperature);
+        qmc5883l_sim_set_temperature_drift(gs_drift_linear, gs_drift_quadratic);
+        res = qmc5883l_tempco_test(times);
+        qmc5883l_sim_set_temperature_drift(NULL, NULL);
+        qmc5883l_sim_set_temperature_source(NULL);
+        qmc5883l_sim_set_temperature(25.0f);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_autorange", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run autorange test next to a moving magnet */
+        qmc5883l_sim_set_field_source(a_magnet_field);
+        res = qmc5883l_autorange_test(times);
+        qmc5883l_sim_set_field_source(NULL);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_change", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run change test under a parking car */
+        qmc5883l_sim_set_field_source(a_car_field);
+        res = qmc5883l_change_test(times);
+        qmc5883l_sim_set_field_source(NULL);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_mains", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run mains test next to a cabinet */
+        qmc5883l_sim_set_field_source(a_mains_field);
+        res = qmc5883l_mains_test(times);
+        qmc5883l_sim_set_field_source(NULL);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_ahrs", type) == 0)
+    {
+        /* run ahrs test */
+        if (qmc5883l_ahrs_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_bench", type) == 0)
+    {
+        /* run bench test */
+        if (qmc5883l_bench_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_sweep", type) == 0)
+    {
+        /* run sweep test */
+        if (qmc5883l_sweep_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_allan", type) == 0)
+    {
+        /* run allan test */
+        if (qmc5883l_allan_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_resample", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run resample test with a 2% slow chip clock */
+        qmc5883l_sim_set_clock_drift(SIMULATOR_CLOCK_DRIFT_PPM);
+        res = qmc5883l_resample_test(times);
+        qmc5883l_sim_set_clock_drift(0);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_binlog", type) == 0)
+    {
+        /* run binlog test */
+        if (qmc5883l_binlog_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_index", type) == 0)
+    {
+        /* run index test */
+        if (qmc5883l_index_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_analyze", type) == 0)
+    {
+        /* run analyze test */
+        if (qmc5883l_analyze_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_duty", type) == 0)
+    {
+        /* run duty test */
+        if (qmc5883l_duty_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_adaptive", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run adaptive test beside a road */
+        qmc5883l_sim_set_field_source(a_traffic_field);
+        res = qmc5883l_adaptive_test(times);
+        qmc5883l_sim_set_field_source(NULL);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_device", type) == 0)
+    {
+        /* run device test */
+        if (qmc5883l_device_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_coro", type) == 0)
+    {
+        /* run coro test */
+        if (qmc5883l_coro_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_record", type) == 0)
+    {
+        /* run record test */
+        if (qmc5883l_record_test(times) != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("e_read", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        float m_gauss[3];
+        
+        /* basic init */
+        res = qmc5883l_basic_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            /* delay 1000ms */
+            qmc5883l_interface_delay_ms(1000);
+            
+            /* read data */
+            res = qmc5883l_basic_read((float *)m_gauss);
+            if (res != 0)
+            {
+                (void)qmc5883l_basic_deinit();
+                
+                return 1;
+            }
+            
+            /* output */
+            qmc5883l_interface_debug_print("%d/%d\n", (uint32_t)(i + 1), (uint32_t)times);
+            qmc5883l_interface_debug_print("x is %0.3f m_gauss.\n", m_gauss[0]);
+            qmc5883l_interface_debug_print("y is %0.3f m_gauss.\n", m_gauss[1]);
+            qmc5883l_interface_debug_print("z is %0.3f m_gauss.\n", m_gauss[2]);
+        }
+        
+        /* deinit */
+        (void)qmc5883l_basic_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("h", type) == 0)
+    {
+        help:
+        qmc5883l_interface_debug_print("Usage:\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-i | --information)\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-h | --help)\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t reg | --test=reg)\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t read | --test=read) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t fault | --test=fault) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t config | --test=config)\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t calibration | --test=calibration) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t batch | --test=batch) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t heading | --test=heading) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t decimate | --test=decimate) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t hampel | --test=hampel) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t tempco | --test=tempco) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t autorange | --test=autorange) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t change | --test=change) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t mains | --test=mains) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t ahrs | --test=ahrs) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t bench | --test=bench) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t sweep | --test=sweep) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t allan | --test=allan) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t resample | --test=resample) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t binlog | --test=binlog) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t index | --test=index) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t analyze | --test=analyze) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t duty | --test=duty) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t adaptive | --test=adaptive) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t device | --test=device) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t coro | --test=coro) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-t record | --test=record) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("  qmc5883l (-e read | --example=read) [--times=<num>]\n");
+        qmc5883l_interface_debug_print("\n");
+        qmc5883l_interface_debug_print("Options:\n");
+        qmc5883l_interface_debug_print("  -e <read>, --example=<read>\n");
+        qmc5883l_interface_debug_print("                                 Run the driver example.\n");
+        qmc5883l_interface_debug_print("  -h, --help                     Show the help.\n");
+        qmc5883l_interface_debug_print("  -i, --information              Show the chip information.\n");
+        qmc5883l_interface_debug_print("  -t <reg | read | fault | config | calibration | batch | heading | decimate | hampel | tempco | autorange | change | mains | ahrs | bench | sweep | allan | resample | binlog | index | analyze | duty | adaptive | device | coro | record>, --test=<reg | read | fault | config | calibration | batch | heading | decimate | hampel | tempco | autorange | change | mains | ahrs | bench | sweep | allan | resample | binlog | index | analyze | duty | adaptive | device | coro | record>\n");
+        qmc5883l_interface_debug_print("                                 Run the driver test.\n");
+        qmc5883l_interface_debug_print("      --times=<num>              Set the running times.([default: 3])\n");
+
+        return 0;
+    }
+    else if (strcmp("i", type) == 0)
+    {
+        qmc5883l_info_t info;
+        
+        /* print qmc5883l info */
+        qmc5883l_info(&info);
+        qmc5883l_interface_debug_print("qmc5883l: chip is %s.\n", info.chip_name);
+        qmc5883l_interface_debug_print("qmc5883l: manufacturer is %s.\n", info.manufacturer_name);
+        qmc5883l_interface_debug_print("qmc5883l: interface is %s.\n", info.interface);
+        qmc5883l_interface_debug_print("qmc5883l: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        qmc5883l_interface_debug_print("qmc5883l: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        qmc5883l_interface_debug_print("qmc5883l: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        qmc5883l_interface_debug_print("qmc5883l: max current is %0.2fmA.\n", info.max_current_ma);
+        qmc5883l_interface_debug_print("qmc5883l: max temperature is %0.1fC.\n", info.temperature_max);
+        qmc5883l_interface_debug_print("qmc5883l: min temperature is %0.1fC.\n", info.temperature_min);
+        
+        return 0;
+    }
+    else
+    {
+        return 5;
+    }
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc is arg numbers
+ * @param[in] **argv is the arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed or a check reported an error
+ * @note      none
+ */
+int main(uint8_t argc, char **argv)
+{
+    uint8_t res;
+    const float field[3] = {SIMULATOR_FIELD_X, SIMULATOR_FIELD_Y, SIMULATOR_FIELD_Z};
+
+    /* power on the simulated chip */
+    qmc5883l_sim_set_field(field);
+    qmc5883l_sim_set_noise(1.0f, 1);
+    (void)qmc5883l_sim_init();
+    
+    res = qmc5883l(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: param is invalid.\n");
+    }
+    else
+    {
+        qmc5883l_interface_debug_print("qmc5883l: unknown status code.\n");
+    }
+
+    return ((res == 0) && (console_get_error_count() == 0)) ? 0 : 1;
+}
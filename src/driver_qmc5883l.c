@@ -946,7 +946,7 @@ uint8_t qmc5883l_read(qmc5883l_handle_t *handle, int16_t raw[3], float m_gauss[3
         
         return 1;                                                                                  /* return error */
     }
-    prev = prev >> 4;                                                                              /* set gain */
+    prev = (prev >> 4) & 0x01;                                                                     /* set gain */
     switch (prev)                                                                                  /* choose resolution */
     {
         case 0x00 :
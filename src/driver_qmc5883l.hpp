@@ -0,0 +1,340 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l.hpp
+ * @brief     driver qmc5883l c++17 header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_HPP
+#define DRIVER_QMC5883L_HPP
+
+#if !defined(__cplusplus) || (__cplusplus < 201703L)
+    #error "driver_qmc5883l.hpp needs c++17"
+#endif
+
+#include <cstdint>
+#include "driver_qmc5883l.h"
+
+/**
+ * @defgroup qmc5883l_cpp_driver qmc5883l c++ driver function
+ * @brief    qmc5883l c++ driver modules
+ * @ingroup  qmc5883l_driver
+ * @note     header only, the bus and the configuration are template parameters so the control register,
+ *           the resolution and the data decoding are constants and the whole read path can be inlined,
+ *           the chip is programmed with the same register values as the c driver so both can share a chip
+ * @{
+ */
+
+namespace qmc5883l
+{
+
+/**
+ * @brief qmc5883l register definition
+ * @note  same addresses as the c driver
+ */
+namespace reg
+{
+    inline constexpr uint8_t ADDRESS  = 0x1A;        /**< iic address */
+    inline constexpr uint8_t X_LSB    = 0x00;        /**< data output x lsb register */
+    inline constexpr uint8_t STATUS   = 0x06;        /**< status register */
+    inline constexpr uint8_t TEMP_LSB = 0x07;        /**< temperature data lsb register */
+    inline constexpr uint8_t CONTROL1 = 0x09;        /**< control 1 register */
+    inline constexpr uint8_t CONTROL2 = 0x0A;        /**< control 2 register */
+    inline constexpr uint8_t PERIOD   = 0x0B;        /**< period register */
+    inline constexpr uint8_t ID       = 0x0D;        /**< chip id register */
+}
+
+/**
+ * @brief qmc5883l compile time configuration
+ * @note  the members are the values the c driver setters would leave in the chip
+ */
+template <qmc5883l_full_scale_t Range = QMC5883L_FULL_SCALE_2GAUSS,
+          qmc5883l_output_rate_t Rate = QMC5883L_OUTPUT_RATE_200HZ,
+          qmc5883l_over_sample_t Sample = QMC5883L_OVER_SAMPLE_512,
+          qmc5883l_mode_t Mode = QMC5883L_MODE_CONTINUOUS,
+          uint8_t Period = 0x01>
+struct Config
+{
+    static constexpr qmc5883l_full_scale_t range = Range;                                  /**< full scale */
+    static constexpr qmc5883l_output_rate_t rate = Rate;                                   /**< output rate */
+    static constexpr qmc5883l_over_sample_t sample = Sample;                               /**< over sample */
+    static constexpr qmc5883l_mode_t mode = Mode;                                          /**< mode */
+    static constexpr uint8_t period = Period;                                              /**< set/reset period register */
+    static constexpr uint8_t control1 = static_cast<uint8_t>((Sample << 6) | (Range << 4) |
+                                                             (Rate << 2) | Mode);          /**< control 1 register */
+    static constexpr float resolution = (Range == QMC5883L_FULL_SCALE_2GAUSS) ?
+                                        (1000.0f / 12000.0f) : (1000.0f / 3000.0f);        /**< mgauss per lsb */
+    static constexpr uint32_t rate_hz = (Rate == QMC5883L_OUTPUT_RATE_10HZ) ? 10 :
+                                        (Rate == QMC5883L_OUTPUT_RATE_50HZ) ? 50 :
+                                        (Rate == QMC5883L_OUTPUT_RATE_100HZ) ? 100 : 200;  /**< output rate in Hz */
+    static constexpr uint32_t period_us = 1000000 / rate_hz;                               /**< sample period */
+};
+
+/**
+ * @brief     decode one little endian axis
+ * @param[in] *lsb points to the lsb of the axis
+ * @return    raw value
+ * @note      none
+ */
+constexpr int16_t decode(const uint8_t *lsb) noexcept
+{
+    return static_cast<int16_t>((static_cast<uint16_t>(lsb[1]) << 8) | lsb[0]);        /* little endian */
+}
+
+/**
+ * @brief qmc5883l device
+ * @note  Bus is a static policy with the signatures of the c interface:
+ *        uint8_t init(), uint8_t deinit(), uint8_t read(addr, reg, buf, len),
+ *        uint8_t write(addr, reg, buf, len) and void delay_ms(ms), all return 0 on success
+ */
+template <typename Bus, typename Cfg = Config<>>
+class Device
+{
+    public:
+        using config = Cfg;                                                           /**< configuration */
+        static constexpr uint8_t control1 = Cfg::control1;                            /**< control 1 register */
+        static constexpr float resolution = Cfg::resolution;                          /**< mgauss per lsb */
+        static constexpr uint32_t ready_tries = 10 * Cfg::period_us / 1000 + 100;     /**< 1ms status polls before timeout */
+
+        /**
+         * @brief      decode a data register block
+         * @param[in]  *buf points to the 6 bytes from X_LSB
+         * @param[out] *raw points to a raw data buffer
+         * @param[out] *m_gauss points to a converted data buffer
+         * @note       none
+         */
+        static constexpr void convert(const uint8_t *buf, int16_t *raw, float *m_gauss) noexcept
+        {
+            raw[0] = decode(buf + 0);                                          /* get x raw */
+            raw[1] = decode(buf + 2);                                          /* get y raw */
+            raw[2] = decode(buf + 4);                                          /* get z raw */
+            m_gauss[0] = static_cast<float>(raw[0]) * resolution;              /* calculate x */
+            m_gauss[1] = static_cast<float>(raw[1]) * resolution;              /* calculate y */
+            m_gauss[2] = static_cast<float>(raw[2]) * resolution;              /* calculate z */
+        }
+        
+        /**
+         * @brief  initialize and configure the chip
+         * @return status code
+         *         - 0 success
+         *         - 1 iic initialization failed
+         *         - 4 id is invalid
+         *         - 5 reset failed
+         *         - 6 configure failed
+         * @note   soft resets like qmc5883l_init, then writes the period and control 1 registers
+         */
+        uint8_t init() noexcept
+        {
+            uint8_t id;
+            uint8_t prev;
+            uint8_t period;
+            uint8_t value;
+            
+            if (Bus::init() != 0)                                                                       /* iic init */
+            {
+                return 1;                                                                               /* return error */
+            }
+            if ((Bus::read(reg::ADDRESS, reg::ID, &id, 1) != 0) || (id != 0xFF))                        /* check id */
+            {
+                (void)Bus::deinit();                                                                    /* iic deinit */
+                
+                return 4;                                                                               /* return error */
+            }
+            if (Bus::read(reg::ADDRESS, reg::CONTROL2, &prev, 1) != 0)                                  /* read control2 */
+            {
+                (void)Bus::deinit();                                                                    /* iic deinit */
+                
+                return 5;                                                                               /* return error */
+            }
+            prev |= 1 << 7;                                                                             /* set soft reset */
+            if (Bus::write(reg::ADDRESS, reg::CONTROL2, &prev, 1) != 0)                                 /* write control2 */
+            {
+                (void)Bus::deinit();                                                                    /* iic deinit */
+                
+                return 5;                                                                               /* return error */
+            }
+            Bus::delay_ms(100);                                                                         /* delay 100ms */
+            period = Cfg::period;                                                                       /* set period */
+            value = control1;                                                                           /* set control1 */
+            if ((Bus::write(reg::ADDRESS, reg::PERIOD, &period, 1) != 0) ||
+                (Bus::write(reg::ADDRESS, reg::CONTROL1, &value, 1) != 0))                              /* configure */
+            {
+                (void)Bus::deinit();                                                                    /* iic deinit */
+                
+                return 6;                                                                               /* return error */
+            }
+            m_inited = 1;                                                                               /* flag finish initialization */
+            
+            return 0;                                                                                   /* success return 0 */
+        }
+        
+        /**
+         * @brief  close the chip
+         * @return status code
+         *         - 0 success
+         *         - 1 iic deinit failed
+         *         - 3 device is not initialized
+         *         - 4 soft reset failed
+         * @note   none
+         */
+        uint8_t deinit() noexcept
+        {
+            uint8_t prev;
+            
+            if (m_inited != 1)                                                                          /* check initialization */
+            {
+                return 3;                                                                               /* return error */
+            }
+            if (Bus::read(reg::ADDRESS, reg::CONTROL2, &prev, 1) != 0)                                  /* read control2 */
+            {
+                return 4;                                                                               /* return error */
+            }
+            prev |= 1 << 7;                                                                             /* set soft reset */
+            if (Bus::write(reg::ADDRESS, reg::CONTROL2, &prev, 1) != 0)                                 /* write control2 */
+            {
+                return 4;                                                                               /* return error */
+            }
+            Bus::delay_ms(10);                                                                          /* delay 10ms */
+            if (Bus::deinit() != 0)                                                                     /* iic deinit */
+            {
+                return 1;                                                                               /* return error */
+            }
+            m_inited = 0;                                                                               /* flag close */
+            
+            return 0;                                                                                   /* success return 0 */
+        }
+        
+        /**
+         * @brief      read the latest sample without waiting
+         * @param[out] *raw points to a raw data buffer
+         * @param[out] *m_gauss points to a converted data buffer
+         * @return     status code
+         *             - 0 success
+         *             - 1 read failed
+         *             - 3 device is not initialized
+         * @note       one 6 byte transfer, for callers that already saw data ready on the pin or the status
+         */
+        uint8_t read_data(int16_t raw[3], float m_gauss[3]) noexcept
+        {
+            uint8_t buf[6];
+            
+            if (m_inited != 1)                                                         /* check initialization */
+            {
+                return 3;                                                              /* return error */
+            }
+            if (Bus::read(reg::ADDRESS, reg::X_LSB, buf, 6) != 0)                      /* read raw data */
+            {
+                return 1;                                                              /* return error */
+            }
+            convert(buf, raw, m_gauss);                                                /* convert */
+            
+            return 0;                                                                  /* success return 0 */
+        }
+        
+        /**
+         * @brief      wait for data ready and read the sample
+         * @param[out] *raw points to a raw data buffer
+         * @param[out] *m_gauss points to a converted data buffer
+         * @return     status code
+         *             - 0 success
+         *             - 1 read failed
+         *             - 3 device is not initialized
+         * @note       unlike qmc5883l_read the control 1 register is not read back, the resolution is a constant
+         */
+        uint8_t read(int16_t raw[3], float m_gauss[3]) noexcept
+        {
+            uint8_t status;
+            
+            if (m_inited != 1)                                                         /* check initialization */
+            {
+                return 3;                                                              /* return error */
+            }
+            for (uint32_t i = 0; ; i++)                                                /* poll data ready */
+            {
+                if (Bus::read(reg::ADDRESS, reg::STATUS, &status, 1) != 0)             /* read status */
+                {
+                    return 1;                                                          /* return error */
+                }
+                if ((status & QMC5883L_STATUS_DRDY) != 0)                              /* check data ready */
+                {
+                    break;                                                             /* break loop */
+                }
+                if (i + 1 >= ready_tries)                                              /* check timeout */
+                {
+                    return 1;                                                          /* return error */
+                }
+                Bus::delay_ms(1);                                                      /* delay 1ms */
+            }
+            
+            return read_data(raw, m_gauss);                                            /* read data */
+        }
+        
+        /**
+         * @brief      get status
+         * @param[out] *status points to a status buffer
+         * @return     status code
+         *             - 0 success
+         *             - 1 get status failed
+         *             - 3 device is not initialized
+         * @note       none
+         */
+        uint8_t get_status(uint8_t *status) noexcept
+        {
+            if (m_inited != 1)                                                         /* check initialization */
+            {
+                return 3;                                                              /* return error */
+            }
+            
+            return Bus::read(reg::ADDRESS, reg::STATUS, status, 1);                    /* read status */
+        }
+        
+        /**
+         * @brief  check the initialization
+         * @return true if initialized
+         * @note   none
+         */
+        bool inited() const noexcept
+        {
+            return m_inited == 1;                                                      /* return the flag */
+        }
+    
+    private:
+        uint8_t m_inited = 0;                                                          /**< inited flag */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
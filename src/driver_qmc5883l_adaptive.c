@@ -0,0 +1,345 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_adaptive.c
+ * @brief     driver qmc5883l adaptive source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_adaptive.h"
+#include <math.h>
+
+/**
+ * @brief chip register definition
+ */
+#define ADAPTIVE_REG_X_LSB           0x00          /**< data output x lsb register */
+#define ADAPTIVE_REG_STATUS          0x06          /**< status register */
+#define ADAPTIVE_REG_CONTROL1        0x09          /**< control 1 register */
+
+/**
+ * @brief adaptive definition
+ */
+#define ADAPTIVE_ODR_MASK            (3 << 2)      /**< control1 output rate bits */
+
+/**
+ * @brief output period table definition
+ */
+static const uint32_t gs_period_us[4] = {100000, 20000, 10000, 5000};
+
+/**
+ * @brief     switch the output rate
+ * @param[in] *ad points to an adaptive structure
+ * @param[in] rate is the new rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 write control1 failed
+ * @note      the cached control1 keeps the other settings, so no read is needed
+ */
+static uint8_t a_adaptive_switch(qmc5883l_adaptive_t *ad, uint8_t rate)
+{
+    uint8_t prev;
+    
+    prev = (uint8_t)((ad->control1 & ~ADAPTIVE_ODR_MASK) | (rate << 2));           /* set rate */
+    if (qmc5883l_set_reg(ad->handle, ADAPTIVE_REG_CONTROL1, &prev, 1) != 0)        /* write control1 */
+    {
+        ad->handle->debug_print("qmc5883l: write control1 failed.\n");             /* write control1 failed */
+        
+        return 1;                                                                  /* return error */
+    }
+    ad->control1 = prev;                                                           /* save control1 */
+    ad->quiet_us = 0;                                                              /* restart the hold */
+    ad->switches++;                                                                /* count switch */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     highest declared rate
+ * @param[in] *ad points to an adaptive structure
+ * @return    rate floor
+ * @note      none
+ */
+static uint8_t a_adaptive_floor(qmc5883l_adaptive_t *ad)
+{
+    uint8_t floor_rate = QMC5883L_OUTPUT_RATE_10HZ;
+    uint8_t i;
+    
+    for (i = 0; i < QMC5883L_ADAPTIVE_MAX_CONSUMERS; i++)                                  /* each consumer */
+    {
+        floor_rate = (ad->min_rate[i] > floor_rate) ? ad->min_rate[i] : floor_rate;        /* max */
+    }
+    
+    return floor_rate;                                                                     /* return floor */
+}
+
+/**
+ * @brief     initialize the adaptive rate controller
+ * @param[in] *ad points to an adaptive structure
+ * @param[in] *handle points to an initialized qmc5883l handle
+ * @param[in] low_mgauss is the deviation from the baseline below which the input is quiet
+ * @param[in] high_mgauss is the deviation from the baseline above which the rate goes to 200Hz at once
+ * @param[in] hold_ms is the quiet time before each step down
+ * @return    status code
+ *            - 0 success
+ *            - 1 read control1 failed
+ *            - 2 ad or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 param is invalid
+ * @note      0 < low_mgauss < high_mgauss, the band between them holds the rate,
+ *            configure the chip before, control1 is read once and cached
+ */
+uint8_t qmc5883l_adaptive_init(qmc5883l_adaptive_t *ad, qmc5883l_handle_t *handle, float low_mgauss,
+                               float high_mgauss, uint32_t hold_ms)
+{
+    uint8_t prev;
+    
+    if ((ad == NULL) || (handle == NULL))                                      /* check buffer */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if ((low_mgauss <= 0.0f) || (high_mgauss <= low_mgauss) ||
+        (hold_ms == 0) || (hold_ms > 3600000))                                 /* check param */
+    {
+        return 4;                                                              /* return error */
+    }
+    
+    if (qmc5883l_get_reg(handle, ADAPTIVE_REG_CONTROL1, &prev, 1) != 0)        /* read control1 */
+    {
+        handle->debug_print("qmc5883l: read control1 failed.\n");              /* read control1 failed */
+        
+        return 1;                                                              /* return error */
+    }
+    
+    memset(ad, 0, sizeof(qmc5883l_adaptive_t));                                /* clear all */
+    ad->handle = handle;                                                       /* set handle */
+    ad->low_mgauss = low_mgauss;                                               /* set low threshold */
+    ad->high_mgauss = high_mgauss;                                             /* set high threshold */
+    ad->hold_us = hold_ms * 1000;                                              /* set hold */
+    ad->control1 = prev;                                                       /* cache control1 */
+    ad->inited = 1;                                                            /* flag inited */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      read a sample and adjust the output rate
+ * @param[in]  *ad points to an adaptive structure
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a converted data buffer
+ * @param[out] *time_us points to a sample time buffer
+ * @param[out] *rate points to the rate the sample was taken at buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read or write failed
+ *             - 2 ad or buffer is NULL
+ *             - 3 ad is not initialized
+ * @note       time_us adds up the period in force for every sample since init, so it stays continuous
+ *             across the switches, a data overrun adds one period for the skipped sample,
+ *             a switch costs one control1 write
+ */
+uint8_t qmc5883l_adaptive_read(qmc5883l_adaptive_t *ad, int16_t raw[3], float m_gauss[3], uint64_t *time_us,
+                               qmc5883l_output_rate_t *rate)
+{
+    uint8_t status;
+    uint8_t buf[6];
+    uint8_t level;
+    uint8_t target;
+    uint16_t num;
+    uint32_t period;
+    float resolution;
+    float alpha;
+    float dev;
+    float d[3];
+    uint8_t i;
+    
+    if ((ad == NULL) || (raw == NULL) || (m_gauss == NULL) || (time_us == NULL) || (rate == NULL))        /* check buffer */
+    {
+        return 2;                                                                                         /* return error */
+    }
+    if (ad->inited != 1)                                                                                  /* check ad initialization */
+    {
+        return 3;                                                                                         /* return error */
+    }
+    
+    num = QMC5883L_ADAPTIVE_READY_TRIES;                                                                  /* init tries */
+    while (1)                                                                                             /* wait ready */
+    {
+        if (qmc5883l_get_reg(ad->handle, ADAPTIVE_REG_STATUS, &status, 1) != 0)                           /* read status */
+        {
+            ad->handle->debug_print("qmc5883l: read failed.\n");                                          /* read status failed */
+            
+            return 1;                                                                                     /* return error */
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)                                                         /* check ready */
+        {
+            break;                                                                                        /* break loop */
+        }
+        num--;                                                                                            /* count */
+        if (num == 0)                                                                                     /* check timeout */
+        {
+            ad->handle->debug_print("qmc5883l: ready bit not be set.\n");                                 /* timeout */
+            
+            return 1;                                                                                     /* return error */
+        }
+        ad->handle->delay_ms(1);                                                                          /* check 1 ms */
+    }
+    if (qmc5883l_get_reg(ad->handle, ADAPTIVE_REG_X_LSB, buf, 6) != 0)                                    /* read raw data */
+    {
+        ad->handle->debug_print("qmc5883l: read data failed.\n");                                         /* read data failed */
+        
+        return 1;                                                                                         /* return error */
+    }
+    resolution = (((ad->control1 >> 4) & 0x01) == QMC5883L_FULL_SCALE_2GAUSS) ?
+                 (1000.0f / 12000.0f) : (1000.0f / 3000.0f);                                              /* cached range */
+    raw[0] = (int16_t)(((uint16_t)buf[1] << 8) | buf[0]);                                                 /* get x raw */
+    raw[1] = (int16_t)(((uint16_t)buf[3] << 8) | buf[2]);                                                 /* get y raw */
+    raw[2] = (int16_t)(((uint16_t)buf[5] << 8) | buf[4]);                                                 /* get z raw */
+    m_gauss[0] = (float)(raw[0]) * resolution;                                                            /* calculate x */
+    m_gauss[1] = (float)(raw[1]) * resolution;                                                            /* calculate y */
+    m_gauss[2] = (float)(raw[2]) * resolution;                                                            /* calculate z */
+    
+    /* stamp with the period the sample was taken at */
+    level = (ad->control1 >> 2) & 0x03;                                                                   /* current rate */
+    period = gs_period_us[level];                                                                         /* current period */
+    ad->time_us += ((status & QMC5883L_STATUS_DOR) != 0) ? 2 * (uint64_t)period : period;                 /* next sample time */
+    *time_us = ad->time_us;                                                                               /* save time */
+    *rate = (qmc5883l_output_rate_t)level;                                                                /* save rate */
+    
+    /* deviation from the quiet baseline */
+    if (ad->primed == 0)                                                                                  /* first sample */
+    {
+        ad->baseline[0] = m_gauss[0];                                                                     /* start x */
+        ad->baseline[1] = m_gauss[1];                                                                     /* start y */
+        ad->baseline[2] = m_gauss[2];                                                                     /* start z */
+        ad->primed = 1;                                                                                   /* flag primed */
+    }
+    alpha = (float)period / (QMC5883L_ADAPTIVE_BASELINE_MS * 1000.0f);                                    /* rate independent */
+    alpha = (alpha < 1.0f) ? alpha : 1.0f;                                                                /* clamp */
+    for (i = 0; i < 3; i++)                                                                               /* each axis */
+    {
+        d[i] = m_gauss[i] - ad->baseline[i];                                                              /* deviation */
+        ad->baseline[i] += alpha * d[i];                                                                  /* follow slowly */
+    }
+    dev = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);                                                 /* deviation length */
+    
+    /* up at once, down one step per quiet hold */
+    target = level;                                                                                       /* keep */
+    if (dev > ad->high_mgauss)                                                                            /* active */
+    {
+        target = QMC5883L_OUTPUT_RATE_200HZ;                                                              /* full rate */
+        ad->quiet_us = 0;                                                                                 /* not quiet */
+    }
+    else if (dev < ad->low_mgauss)                                                                        /* quiet */
+    {
+        ad->quiet_us += period;                                                                           /* add quiet time */
+        if ((ad->quiet_us >= ad->hold_us) && (level > QMC5883L_OUTPUT_RATE_10HZ))                         /* held */
+        {
+            target = (uint8_t)(level - 1);                                                                /* step down */
+        }
+    }
+    else
+    {
+        ad->quiet_us = 0;                                                                                 /* hysteresis band */
+    }
+    target = (target > a_adaptive_floor(ad)) ? target : a_adaptive_floor(ad);                             /* consumer floor */
+    if ((target != level) && (a_adaptive_switch(ad, target) != 0))                                        /* switch */
+    {
+        return 1;                                                                                         /* return error */
+    }
+    
+    return 0;                                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     declare the min rate of a consumer
+ * @param[in] *ad points to an adaptive structure
+ * @param[in] consumer is the consumer index
+ * @param[in] rate is the min rate the consumer needs
+ * @return    status code
+ *            - 0 success
+ *            - 2 ad is NULL
+ *            - 3 ad is not initialized
+ *            - 4 param is invalid
+ * @note      the rate never goes below the highest declared rate, declare 10Hz to withdraw,
+ *            a higher floor is applied right after the next sample so the time stays continuous
+ */
+uint8_t qmc5883l_adaptive_set_min_rate(qmc5883l_adaptive_t *ad, uint8_t consumer, qmc5883l_output_rate_t rate)
+{
+    if (ad == NULL)                                 /* check ad */
+    {
+        return 2;                                   /* return error */
+    }
+    if (ad->inited != 1)                            /* check ad initialization */
+    {
+        return 3;                                   /* return error */
+    }
+    if ((consumer >= QMC5883L_ADAPTIVE_MAX_CONSUMERS) ||
+        (rate > QMC5883L_OUTPUT_RATE_200HZ))        /* check param */
+    {
+        return 4;                                   /* return error */
+    }
+    
+    ad->min_rate[consumer] = (uint8_t)rate;         /* save rate */
+    
+    return 0;                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the current rate
+ * @param[in]  *ad points to an adaptive structure
+ * @param[out] *rate points to an output rate buffer
+ * @param[out] *switches points to a switch count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ad or buffer is NULL
+ *             - 3 ad is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_adaptive_get_rate(qmc5883l_adaptive_t *ad, qmc5883l_output_rate_t *rate, uint32_t *switches)
+{
+    if ((ad == NULL) || (rate == NULL) || (switches == NULL))            /* check buffer */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (ad->inited != 1)                                                 /* check ad initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    *rate = (qmc5883l_output_rate_t)((ad->control1 >> 2) & 0x03);        /* get rate */
+    *switches = ad->switches;                                            /* get switches */
+    
+    return 0;                                                            /* success return 0 */
+}
@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_adaptive.h
+ * @brief     driver qmc5883l adaptive header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_ADAPTIVE_H
+#define DRIVER_QMC5883L_ADAPTIVE_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_adaptive_driver qmc5883l adaptive driver function
+ * @brief    qmc5883l adaptive driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l adaptive definition
+ */
+#ifndef QMC5883L_ADAPTIVE_BASELINE_MS
+    #define QMC5883L_ADAPTIVE_BASELINE_MS    4000        /**< time constant of the quiet field baseline */
+#endif
+#define QMC5883L_ADAPTIVE_MAX_CONSUMERS      8           /**< consumers which can declare a min rate */
+#define QMC5883L_ADAPTIVE_READY_TRIES        250         /**< 1ms ready polls before timeout */
+
+/**
+ * @brief qmc5883l adaptive structure definition
+ */
+typedef struct qmc5883l_adaptive_s
+{
+    qmc5883l_handle_t *handle;                                  /**< qmc5883l handle */
+    float baseline[3];                                          /**< quiet field baseline in m_gauss */
+    float low_mgauss;                                           /**< deviation below which the input is quiet */
+    float high_mgauss;                                          /**< deviation above which the rate goes up */
+    uint64_t time_us;                                           /**< time of the last sample */
+    uint32_t hold_us;                                           /**< quiet time before each step down */
+    uint32_t quiet_us;                                          /**< quiet time so far */
+    uint32_t switches;                                          /**< rate switches */
+    uint8_t min_rate[QMC5883L_ADAPTIVE_MAX_CONSUMERS];          /**< declared min rate of every consumer */
+    uint8_t control1;                                           /**< cached control1 register */
+    uint8_t primed;                                             /**< baseline is valid */
+    uint8_t inited;                                             /**< inited flag */
+} qmc5883l_adaptive_t;
+
+/**
+ * @brief     initialize the adaptive rate controller
+ * @param[in] *ad points to an adaptive structure
+ * @param[in] *handle points to an initialized qmc5883l handle
+ * @param[in] low_mgauss is the deviation from the baseline below which the input is quiet
+ * @param[in] high_mgauss is the deviation from the baseline above which the rate goes to 200Hz at once
+ * @param[in] hold_ms is the quiet time before each step down
+ * @return    status code
+ *            - 0 success
+ *            - 1 read control1 failed
+ *            - 2 ad or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 param is invalid
+ * @note      0 < low_mgauss < high_mgauss, the band between them holds the rate,
+ *            configure the chip before, control1 is read once and cached
+ */
+uint8_t qmc5883l_adaptive_init(qmc5883l_adaptive_t *ad, qmc5883l_handle_t *handle, float low_mgauss,
+                               float high_mgauss, uint32_t hold_ms);
+
+/**
+ * @brief      read a sample and adjust the output rate
+ * @param[in]  *ad points to an adaptive structure
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a converted data buffer
+ * @param[out] *time_us points to a sample time buffer
+ * @param[out] *rate points to the rate the sample was taken at buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read or write failed
+ *             - 2 ad or buffer is NULL
+ *             - 3 ad is not initialized
+ * @note       time_us adds up the period in force for every sample since init, so it stays continuous
+ *             across the switches, a data overrun adds one period for the skipped sample,
+ *             a switch costs one control1 write and restarts the chip period at the write, so each
+ *             switch can move time_us back by up to one status poll against the host clock
+ */
+uint8_t qmc5883l_adaptive_read(qmc5883l_adaptive_t *ad, int16_t raw[3], float m_gauss[3], uint64_t *time_us,
+                               qmc5883l_output_rate_t *rate);
+
+/**
+ * @brief     declare the min rate of a consumer
+ * @param[in] *ad points to an adaptive structure
+ * @param[in] consumer is the consumer index
+ * @param[in] rate is the min rate the consumer needs
+ * @return    status code
+ *            - 0 success
+ *            - 2 ad is NULL
+ *            - 3 ad is not initialized
+ *            - 4 param is invalid
+ * @note      the rate never goes below the highest declared rate, declare 10Hz to withdraw,
+ *            a higher floor is applied right after the next sample so the time stays continuous
+ */
+uint8_t qmc5883l_adaptive_set_min_rate(qmc5883l_adaptive_t *ad, uint8_t consumer, qmc5883l_output_rate_t rate);
+
+/**
+ * @brief      get the current rate
+ * @param[in]  *ad points to an adaptive structure
+ * @param[out] *rate points to an output rate buffer
+ * @param[out] *switches points to a switch count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ad or buffer is NULL
+ *             - 3 ad is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_adaptive_get_rate(qmc5883l_adaptive_t *ad, qmc5883l_output_rate_t *rate, uint32_t *switches);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
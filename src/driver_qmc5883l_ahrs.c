@@ -0,0 +1,687 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_ahrs.c
+ * @brief     driver qmc5883l ahrs source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_ahrs.h"
+#include <math.h>
+
+/**
+ * @brief ahrs definition
+ */
+#define AHRS_RAD_TO_DEG          57.2957795130823f          /**< radians to degrees */
+#define AHRS_FIXED_HALF          (1 << 29)                  /**< 0.5 in q30 */
+#define AHRS_FIXED_MAX_INPUT     (1 << 24)                  /**< max fixed vector component */
+#define AHRS_FIXED_MAX_INT       ((int32_t)(1 << 30))       /**< integral feedback limit, 1 rad/s */
+
+/**
+ * @brief         normalize a vector
+ * @param[in,out] *v points to a vector buffer
+ * @return        1 if the vector is zero
+ * @note          none
+ */
+static uint8_t a_ahrs_normalize(float v[3])
+{
+    float n;
+    
+    n = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];        /* squared norm */
+    if (n <= 0.0f)                                      /* check zero */
+    {
+        return 1;                                       /* zero vector */
+    }
+    n = 1.0f / sqrtf(n);                                /* inverse norm */
+    v[0] *= n;                                          /* scale x */
+    v[1] *= n;                                          /* scale y */
+    v[2] *= n;                                          /* scale z */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the magnetometer error
+ * @param[in]  *q points to a quaternion buffer
+ * @param[in]  *m points to a unit magnetometer buffer
+ * @param[out] *e points to an error buffer
+ * @note       the measured field is rotated to the earth frame, its horizontal part is put on north
+ *             and the result is rotated back, the error is the cross product with the measurement
+ */
+static void a_ahrs_mag_error(const float q[4], const float m[3], float e[3])
+{
+    float q0q1 = q[0] * q[1];
+    float q0q2 = q[0] * q[2];
+    float q0q3 = q[0] * q[3];
+    float q1q1 = q[1] * q[1];
+    float q1q2 = q[1] * q[2];
+    float q1q3 = q[1] * q[3];
+    float q2q2 = q[2] * q[2];
+    float q2q3 = q[2] * q[3];
+    float q3q3 = q[3] * q[3];
+    float hx;
+    float hy;
+    float bx;
+    float bz;
+    float w[3];
+    
+    hx = 2.0f * (m[0] * (0.5f - q2q2 - q3q3) + m[1] * (q1q2 - q0q3) + m[2] * (q1q3 + q0q2));        /* earth x */
+    hy = 2.0f * (m[0] * (q1q2 + q0q3) + m[1] * (0.5f - q1q1 - q3q3) + m[2] * (q2q3 - q0q1));        /* earth y */
+    bz = 2.0f * (m[0] * (q1q3 - q0q2) + m[1] * (q2q3 + q0q1) + m[2] * (0.5f - q1q1 - q2q2));        /* earth z */
+    bx = sqrtf(hx * hx + hy * hy);                                                                  /* horizontal */
+    w[0] = 2.0f * (bx * (0.5f - q2q2 - q3q3) + bz * (q1q3 - q0q2));                                 /* body x */
+    w[1] = 2.0f * (bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3));                                        /* body y */
+    w[2] = 2.0f * (bx * (q0q2 + q1q3) + bz * (0.5f - q1q1 - q2q2));                                 /* body z */
+    e[0] = m[1] * w[2] - m[2] * w[1];                                                               /* cross x */
+    e[1] = m[2] * w[0] - m[0] * w[2];                                                               /* cross y */
+    e[2] = m[0] * w[1] - m[1] * w[0];                                                               /* cross z */
+}
+
+/**
+ * @brief     integer square root
+ * @param[in] n is the radicand
+ * @return    floor of the square root
+ * @note      bit by bit, no multiply and no divide
+ */
+static uint32_t a_ahrs_isqrt(uint64_t n)
+{
+    uint64_t r;
+    uint64_t b;
+    
+    r = 0;                           /* init 0 */
+    b = 1ULL << 62;                  /* highest even bit */
+    while (b > n)                    /* find the start */
+    {
+        b >>= 2;                     /* next */
+    }
+    while (b != 0)                   /* each bit */
+    {
+        if (n >= r + b)              /* check bit */
+        {
+            n -= r + b;              /* subtract */
+            r = (r >> 1) + b;        /* set bit */
+        }
+        else
+        {
+            r >>= 1;                 /* clear bit */
+        }
+        b >>= 2;                     /* next */
+    }
+    
+    return (uint32_t)r;              /* return root */
+}
+
+/**
+ * @brief     multiply two q30 values
+ * @param[in] a is the first value
+ * @param[in] b is the second value
+ * @return    q30 product
+ * @note      none
+ */
+static inline int32_t a_ahrs_mul(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * b) >> 30);        /* q60 to q30 */
+}
+
+/**
+ * @brief      normalize a fixed vector
+ * @param[in]  *v points to a vector buffer within +-2^24
+ * @param[out] *u points to a q30 unit vector buffer
+ * @return     1 if the vector is zero
+ * @note       one division for the three components
+ */
+static uint8_t a_ahrs_fixed_normalize(const int32_t v[3], int32_t u[3])
+{
+    uint64_t n;
+    uint64_t inv;
+    uint32_t r;
+    uint8_t i;
+    
+    n = (uint64_t)((int64_t)v[0] * v[0]) + (uint64_t)((int64_t)v[1] * v[1]) + 
+        (uint64_t)((int64_t)v[2] * v[2]);                              /* squared norm */
+    r = a_ahrs_isqrt(n);                                               /* norm */
+    if (r == 0)                                                        /* check zero */
+    {
+        return 1;                                                      /* zero vector */
+    }
+    inv = (1ULL << 62) / r;                                            /* q62 inverse norm */
+    for (i = 0; i < 3; i++)                                            /* each axis */
+    {
+        u[i] = (int32_t)(((int64_t)v[i] * (int64_t)inv) >> 32);        /* q30 */
+    }
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the fixed magnetometer error
+ * @param[in]  *q points to a q30 quaternion buffer
+ * @param[in]  *m points to a q30 unit magnetometer buffer
+ * @param[out] *e points to a q30 error buffer
+ * @note       same steps as the float version
+ */
+static void a_ahrs_fixed_mag_error(const int32_t q[4], const int32_t m[3], int32_t e[3])
+{
+    int32_t q0q1 = a_ahrs_mul(q[0], q[1]);
+    int32_t q0q2 = a_ahrs_mul(q[0], q[2]);
+    int32_t q0q3 = a_ahrs_mul(q[0], q[3]);
+    int32_t q1q1 = a_ahrs_mul(q[1], q[1]);
+    int32_t q1q2 = a_ahrs_mul(q[1], q[2]);
+    int32_t q1q3 = a_ahrs_mul(q[1], q[3]);
+    int32_t q2q2 = a_ahrs_mul(q[2], q[2]);
+    int32_t q2q3 = a_ahrs_mul(q[2], q[3]);
+    int32_t q3q3 = a_ahrs_mul(q[3], q[3]);
+    int64_t hx;
+    int64_t hy;
+    int32_t bx;
+    int32_t bz;
+    int32_t w[3];
+    
+    hx = ((int64_t)m[0] * (AHRS_FIXED_HALF - q2q2 - q3q3) + (int64_t)m[1] * (q1q2 - q0q3) +
+          (int64_t)m[2] * (q1q3 + q0q2)) >> 29;                                                                   /* earth x */
+    hy = ((int64_t)m[0] * (q1q2 + q0q3) + (int64_t)m[1] * (AHRS_FIXED_HALF - q1q1 - q3q3) +
+          (int64_t)m[2] * (q2q3 - q0q1)) >> 29;                                                                   /* earth y */
+    bz = (int32_t)(((int64_t)m[0] * (q1q3 - q0q2) + (int64_t)m[1] * (q2q3 + q0q1) +
+                    (int64_t)m[2] * (AHRS_FIXED_HALF - q1q1 - q2q2)) >> 29);                                      /* earth z */
+    bx = (int32_t)a_ahrs_isqrt((uint64_t)(hx * hx) + (uint64_t)(hy * hy));                                        /* horizontal */
+    w[0] = (int32_t)(((int64_t)bx * (AHRS_FIXED_HALF - q2q2 - q3q3) + (int64_t)bz * (q1q3 - q0q2)) >> 29);        /* body x */
+    w[1] = (int32_t)(((int64_t)bx * (q1q2 - q0q3) + (int64_t)bz * (q0q1 + q2q3)) >> 29);                          /* body y */
+    w[2] = (int32_t)(((int64_t)bx * (q0q2 + q1q3) + (int64_t)bz * (AHRS_FIXED_HALF - q1q1 - q2q2)) >> 29);        /* body z */
+    e[0] = a_ahrs_mul(m[1], w[2]) - a_ahrs_mul(m[2], w[1]);                                                       /* cross x */
+    e[1] = a_ahrs_mul(m[2], w[0]) - a_ahrs_mul(m[0], w[2]);                                                       /* cross y */
+    e[2] = a_ahrs_mul(m[0], w[1]) - a_ahrs_mul(m[1], w[0]);                                                       /* cross z */
+}
+
+/**
+ * @brief      initialize the mahony filter
+ * @param[out] *ahrs points to an ahrs structure
+ * @param[in]  kp is the proportional gain
+ * @param[in]  ki is the integral gain that learns the gyro bias, 0 disables it
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 4 gain is invalid
+ * @note       gyro, accelerometer and magnetometer must share one right handed body frame,
+ *             the accelerometer reads +1g along z when level and the earth frame is x north, z up
+ */
+uint8_t qmc5883l_ahrs_init(qmc5883l_ahrs_t *ahrs, float kp, float ki)
+{
+    if (ahrs == NULL)                                /* check ahrs */
+    {
+        return 2;                                    /* return error */
+    }
+    if ((kp < 0.0f) || (ki < 0.0f))                  /* check gain */
+    {
+        return 4;                                    /* return error */
+    }
+    
+    memset(ahrs, 0, sizeof(qmc5883l_ahrs_t));        /* clear all */
+    ahrs->q[0] = 1.0f;                               /* identity */
+    ahrs->kp = kp;                                   /* set kp */
+    ahrs->ki = ki;                                   /* set ki */
+    ahrs->inited = 1;                                /* flag inited */
+    
+    return 0;                                        /* success return 0 */
+}
+
+/**
+ * @brief     queue a magnetometer sample
+ * @param[in] *ahrs points to an ahrs structure
+ * @param[in] time_us is the sample time
+ * @param[in] *m_gauss points to a calibrated data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 ahrs or m_gauss is NULL
+ *            - 3 ahrs is not initialized
+ * @note      applied by the first gyro update at or after time_us, weighted by the time since the last one
+ */
+uint8_t qmc5883l_ahrs_set_mag(qmc5883l_ahrs_t *ahrs, uint64_t time_us, const float m_gauss[3])
+{
+    if ((ahrs == NULL) || (m_gauss == NULL))        /* check ahrs and m_gauss */
+    {
+        return 2;                                   /* return error */
+    }
+    if (ahrs->inited != 1)                          /* check ahrs initialization */
+    {
+        return 3;                                   /* return error */
+    }
+    
+    ahrs->mag[0] = m_gauss[0];                      /* save x */
+    ahrs->mag[1] = m_gauss[1];                      /* save y */
+    ahrs->mag[2] = m_gauss[2];                      /* save z */
+    ahrs->mag_time_us = time_us;                    /* save time */
+    ahrs->mag_pending = 1;                          /* flag pending */
+    
+    return 0;                                       /* success return 0 */
+}
+
+/**
+ * @brief     run one filter step at the gyro rate
+ * @param[in] *ahrs points to an ahrs structure
+ * @param[in] time_us is the gyro sample time
+ * @param[in] *gyro points to an angular rate buffer in rad/s
+ * @param[in] *accel points to an acceleration buffer in any unit
+ * @return    status code
+ *            - 0 success
+ *            - 2 ahrs, gyro or accel is NULL
+ *            - 3 ahrs is not initialized
+ * @note      the first call only sets the time, a zero accel skips the tilt correction
+ */
+uint8_t qmc5883l_ahrs_update(qmc5883l_ahrs_t *ahrs, uint64_t time_us, const float gyro[3], const float accel[3])
+{
+    float a[3];
+    float e[3];
+    float g[3];
+    float dt;
+    float qa;
+    float qb;
+    float qc;
+    float n;
+    uint8_t i;
+    
+    if ((ahrs == NULL) || (gyro == NULL) || (accel == NULL))                            /* check ahrs and buffers */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (ahrs->inited != 1)                                                              /* check ahrs initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    if ((ahrs->started == 0) || (time_us <= ahrs->time_us) ||
+        ((time_us - ahrs->time_us) > QMC5883L_AHRS_MAX_DT_US))                          /* check interval */
+    {
+        ahrs->time_us = time_us;                                                        /* set time */
+        ahrs->started = 1;                                                              /* flag started */
+        
+        return 0;                                                                       /* success return 0 */
+    }
+    dt = (float)(time_us - ahrs->time_us) * 1e-6f;                                      /* interval */
+    ahrs->time_us = time_us;                                                            /* save time */
+    e[0] = 0.0f;                                                                        /* init 0 */
+    e[1] = 0.0f;                                                                        /* init 0 */
+    e[2] = 0.0f;                                                                        /* init 0 */
+    a[0] = accel[0];                                                                    /* copy x */
+    a[1] = accel[1];                                                                    /* copy y */
+    a[2] = accel[2];                                                                    /* copy z */
+    if (a_ahrs_normalize(a) == 0)                                                       /* check accel */
+    {
+        float v[3];
+        
+        v[0] = 2.0f * (ahrs->q[1] * ahrs->q[3] - ahrs->q[0] * ahrs->q[2]);              /* up in body x */
+        v[1] = 2.0f * (ahrs->q[0] * ahrs->q[1] + ahrs->q[2] * ahrs->q[3]);              /* up in body y */
+        v[2] = ahrs->q[0] * ahrs->q[0] - ahrs->q[1] * ahrs->q[1] -
+               ahrs->q[2] * ahrs->q[2] + ahrs->q[3] * ahrs->q[3];                       /* up in body z */
+        e[0] = a[1] * v[2] - a[2] * v[1];                                               /* cross x */
+        e[1] = a[2] * v[0] - a[0] * v[2];                                               /* cross y */
+        e[2] = a[0] * v[1] - a[1] * v[0];                                               /* cross z */
+    }
+    if ((ahrs->mag_pending != 0) && (ahrs->mag_time_us <= time_us))                     /* check magnetometer */
+    {
+        float m[3];
+        float em[3];
+        float w;
+        
+        m[0] = ahrs->mag[0];                                                            /* copy x */
+        m[1] = ahrs->mag[1];                                                            /* copy y */
+        m[2] = ahrs->mag[2];                                                            /* copy z */
+        w = 1.0f;                                                                       /* first one stands for a step */
+        if ((ahrs->mag_applied != 0) && (ahrs->mag_time_us > ahrs->mag_last_us))        /* check interval */
+        {
+            w = (float)(ahrs->mag_time_us - ahrs->mag_last_us) * 1e-6f / dt;            /* gyro steps covered */
+            w = (w > (float)QMC5883L_AHRS_MAX_MAG_WEIGHT) ? (float)QMC5883L_AHRS_MAX_MAG_WEIGHT : w;
+        }
+        if (a_ahrs_normalize(m) == 0)                                                   /* check magnetometer */
+        {
+            a_ahrs_mag_error(ahrs->q, m, em);                                           /* heading error */
+            e[0] += w * em[0];                                                          /* add x */
+            e[1] += w * em[1];                                                          /* add y */
+            e[2] += w * em[2];                                                          /* add z */
+        }
+        ahrs->mag_last_us = ahrs->mag_time_us;                                          /* save time */
+        ahrs->mag_applied = 1;                                                          /* flag applied */
+        ahrs->mag_pending = 0;                                                          /* clear pending */
+    }
+    for (i = 0; i < 3; i++)                                                             /* each axis */
+    {
+        if (ahrs->ki > 0.0f)                                                            /* check integral */
+        {
+            ahrs->e_int[i] += ahrs->ki * e[i] * dt;                                     /* integrate */
+        }
+        g[i] = (gyro[i] + ahrs->e_int[i] + ahrs->kp * e[i]) * (0.5f * dt);              /* half angle */
+    }
+    qa = ahrs->q[0];                                                                    /* save w */
+    qb = ahrs->q[1];                                                                    /* save x */
+    qc = ahrs->q[2];                                                                    /* save y */
+    ahrs->q[0] += -qb * g[0] - qc * g[1] - ahrs->q[3] * g[2];                           /* integrate w */
+    ahrs->q[1] += qa * g[0] + qc * g[2] - ahrs->q[3] * g[1];                            /* integrate x */
+    ahrs->q[2] += qa * g[1] - qb * g[2] + ahrs->q[3] * g[0];                            /* integrate y */
+    ahrs->q[3] += qa * g[2] + qb * g[1] - qc * g[0];                                    /* integrate z */
+    n = 1.0f / sqrtf(ahrs->q[0] * ahrs->q[0] + ahrs->q[1] * ahrs->q[1] +
+                     ahrs->q[2] * ahrs->q[2] + ahrs->q[3] * ahrs->q[3]);                /* inverse norm */
+    for (i = 0; i < 4; i++)                                                             /* each element */
+    {
+        ahrs->q[i] *= n;                                                                /* normalize */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the orientation
+ * @param[in]  *ahrs points to an ahrs structure
+ * @param[out] *q points to a quaternion buffer w x y z
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 3 ahrs is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_ahrs_get_quaternion(qmc5883l_ahrs_t *ahrs, float q[4])
+{
+    if (ahrs == NULL)                           /* check ahrs */
+    {
+        return 2;                               /* return error */
+    }
+    if (ahrs->inited != 1)                      /* check ahrs initialization */
+    {
+        return 3;                               /* return error */
+    }
+    
+    memcpy(q, ahrs->q, sizeof(ahrs->q));        /* get quaternion */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the orientation as angles
+ * @param[in]  *ahrs points to an ahrs structure
+ * @param[out] *roll points to a roll buffer in degrees
+ * @param[out] *pitch points to a pitch buffer in degrees
+ * @param[out] *yaw points to a yaw buffer in degrees
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 3 ahrs is not initialized
+ * @note       z y x order, yaw is counterclockwise from north seen from above
+ */
+uint8_t qmc5883l_ahrs_get_euler(qmc5883l_ahrs_t *ahrs, float *roll, float *pitch, float *yaw)
+{
+    const float *q;
+    float s;
+    
+    if (ahrs == NULL)                                                                   /* check ahrs */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (ahrs->inited != 1)                                                              /* check ahrs initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    q = ahrs->q;                                                                        /* quaternion */
+    s = 2.0f * (q[0] * q[2] - q[3] * q[1]);                                             /* pitch sine */
+    s = (s > 1.0f) ? 1.0f : ((s < -1.0f) ? -1.0f : s);                                  /* clamp */
+    *roll = atan2f(2.0f * (q[0] * q[1] + q[2] * q[3]),
+                   1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2])) * AHRS_RAD_TO_DEG;        /* roll */
+    *pitch = asinf(s) * AHRS_RAD_TO_DEG;                                                /* pitch */
+    *yaw = atan2f(2.0f * (q[0] * q[3] + q[1] * q[2]),
+                  1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3])) * AHRS_RAD_TO_DEG;         /* yaw */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      initialize the fixed point mahony filter
+ * @param[out] *ahrs points to an ahrs fixed structure
+ * @param[in]  kp is the proportional gain in q16
+ * @param[in]  ki is the integral gain in q16, 0 disables it
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 4 gain is invalid
+ * @note       same frames as qmc5883l_ahrs_init, no float operation is used by the fixed functions
+ */
+uint8_t qmc5883l_ahrs_fixed_init(qmc5883l_ahrs_fixed_t *ahrs, int32_t kp, int32_t ki)
+{
+    if (ahrs == NULL)                                      /* check ahrs */
+    {
+        return 2;                                          /* return error */
+    }
+    if ((kp < 0) || (ki < 0))                              /* check gain */
+    {
+        return 4;                                          /* return error */
+    }
+    
+    memset(ahrs, 0, sizeof(qmc5883l_ahrs_fixed_t));        /* clear all */
+    ahrs->q[0] = QMC5883L_AHRS_FIXED_ONE;                  /* identity */
+    ahrs->kp = kp;                                         /* set kp */
+    ahrs->ki = ki;                                         /* set ki */
+    ahrs->inited = 1;                                      /* flag inited */
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief     queue a fixed magnetometer sample
+ * @param[in] *ahrs points to an ahrs fixed structure
+ * @param[in] time_us is the sample time
+ * @param[in] *mag points to a calibrated data buffer in any unit
+ * @return    status code
+ *            - 0 success
+ *            - 2 ahrs or mag is NULL
+ *            - 3 ahrs is not initialized
+ *            - 4 mag is out of range
+ * @note      the components must stay within +-2^24, raw data or qmc5883l_batch_calibrate_fixed output fits
+ */
+uint8_t qmc5883l_ahrs_fixed_set_mag(qmc5883l_ahrs_fixed_t *ahrs, uint64_t time_us, const int32_t mag[3])
+{
+    uint8_t i;
+    
+    if ((ahrs == NULL) || (mag == NULL))                                                /* check ahrs and mag */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (ahrs->inited != 1)                                                              /* check ahrs initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    for (i = 0; i < 3; i++)                                                             /* each axis */
+    {
+        if ((mag[i] > AHRS_FIXED_MAX_INPUT) || (mag[i] < -AHRS_FIXED_MAX_INPUT))        /* check range */
+        {
+            return 4;                                                                   /* return error */
+        }
+    }
+    
+    ahrs->mag[0] = mag[0];                                                              /* save x */
+    ahrs->mag[1] = mag[1];                                                              /* save y */
+    ahrs->mag[2] = mag[2];                                                              /* save z */
+    ahrs->mag_time_us = time_us;                                                        /* save time */
+    ahrs->mag_pending = 1;                                                              /* flag pending */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     run one fixed filter step at the gyro rate
+ * @param[in] *ahrs points to an ahrs fixed structure
+ * @param[in] time_us is the gyro sample time
+ * @param[in] *gyro points to an angular rate buffer in q16 rad/s
+ * @param[in] *accel points to an acceleration buffer in any unit within +-2^24
+ * @return    status code
+ *            - 0 success
+ *            - 2 ahrs, gyro or accel is NULL
+ *            - 3 ahrs is not initialized
+ *            - 4 accel is out of range
+ * @note      the first call only sets the time, a zero accel skips the tilt correction
+ */
+uint8_t qmc5883l_ahrs_fixed_update(qmc5883l_ahrs_fixed_t *ahrs, uint64_t time_us, const int32_t gyro[3], const int32_t accel[3])
+{
+    int32_t a[3];
+    int64_t e[3];
+    int32_t h[3];
+    int32_t hdt;
+    int32_t dt;
+    uint64_t dt_us;
+    int32_t qa;
+    int32_t qb;
+    int32_t qc;
+    int32_t nrm;
+    int64_t n;
+    uint8_t i;
+    
+    if ((ahrs == NULL) || (gyro == NULL) || (accel == NULL))                                          /* check ahrs and buffers */
+    {
+        return 2;                                                                                     /* return error */
+    }
+    if (ahrs->inited != 1)                                                                            /* check ahrs initialization */
+    {
+        return 3;                                                                                     /* return error */
+    }
+    for (i = 0; i < 3; i++)                                                                           /* each axis */
+    {
+        if ((accel[i] > AHRS_FIXED_MAX_INPUT) || (accel[i] < -AHRS_FIXED_MAX_INPUT))                  /* check range */
+        {
+            return 4;                                                                                 /* return error */
+        }
+    }
+    
+    if ((ahrs->started == 0) || (time_us <= ahrs->time_us) ||
+        ((time_us - ahrs->time_us) > QMC5883L_AHRS_MAX_DT_US))                                        /* check interval */
+    {
+        ahrs->time_us = time_us;                                                                      /* set time */
+        ahrs->started = 1;                                                                            /* flag started */
+        
+        return 0;                                                                                     /* success return 0 */
+    }
+    dt_us = time_us - ahrs->time_us;                                                                  /* interval */
+    hdt = (int32_t)((dt_us << 29) / 1000000U);                                                        /* q30 half interval */
+    dt = hdt * 2;                                                                                     /* q30 interval */
+    ahrs->time_us = time_us;                                                                          /* save time */
+    e[0] = 0;                                                                                         /* init 0 */
+    e[1] = 0;                                                                                         /* init 0 */
+    e[2] = 0;                                                                                         /* init 0 */
+    if (a_ahrs_fixed_normalize(accel, a) == 0)                                                        /* check accel */
+    {
+        int32_t v[3];
+        
+        v[0] = 2 * (a_ahrs_mul(ahrs->q[1], ahrs->q[3]) - a_ahrs_mul(ahrs->q[0], ahrs->q[2]));         /* up in body x */
+        v[1] = 2 * (a_ahrs_mul(ahrs->q[0], ahrs->q[1]) + a_ahrs_mul(ahrs->q[2], ahrs->q[3]));         /* up in body y */
+        v[2] = a_ahrs_mul(ahrs->q[0], ahrs->q[0]) - a_ahrs_mul(ahrs->q[1], ahrs->q[1]) -
+               a_ahrs_mul(ahrs->q[2], ahrs->q[2]) + a_ahrs_mul(ahrs->q[3], ahrs->q[3]);               /* up in body z */
+        e[0] = a_ahrs_mul(a[1], v[2]) - a_ahrs_mul(a[2], v[1]);                                       /* cross x */
+        e[1] = a_ahrs_mul(a[2], v[0]) - a_ahrs_mul(a[0], v[2]);                                       /* cross y */
+        e[2] = a_ahrs_mul(a[0], v[1]) - a_ahrs_mul(a[1], v[0]);                                       /* cross z */
+    }
+    if ((ahrs->mag_pending != 0) && (ahrs->mag_time_us <= time_us))                                   /* check magnetometer */
+    {
+        int32_t m[3];
+        int32_t em[3];
+        int64_t w;
+        
+        w = QMC5883L_AHRS_FIXED_GAIN_ONE;                                                             /* first one stands for a step */
+        if ((ahrs->mag_applied != 0) && (ahrs->mag_time_us > ahrs->mag_last_us))                      /* check interval */
+        {
+            w = (int64_t)(((ahrs->mag_time_us - ahrs->mag_last_us) << 16) / dt_us);                   /* gyro steps covered */
+            w = (w > ((int64_t)QMC5883L_AHRS_MAX_MAG_WEIGHT << 16)) ?
+                ((int64_t)QMC5883L_AHRS_MAX_MAG_WEIGHT << 16) : w;                                    /* limit */
+        }
+        if (a_ahrs_fixed_normalize(ahrs->mag, m) == 0)                                                /* check magnetometer */
+        {
+            a_ahrs_fixed_mag_error(ahrs->q, m, em);                                                   /* heading error */
+            e[0] += (em[0] * w) >> 16;                                                                /* add x */
+            e[1] += (em[1] * w) >> 16;                                                                /* add y */
+            e[2] += (em[2] * w) >> 16;                                                                /* add z */
+        }
+        ahrs->mag_last_us = ahrs->mag_time_us;                                                        /* save time */
+        ahrs->mag_applied = 1;                                                                        /* flag applied */
+        ahrs->mag_pending = 0;                                                                        /* clear pending */
+    }
+    for (i = 0; i < 3; i++)                                                                           /* each axis */
+    {
+        int64_t g;
+        
+        if (ahrs->ki > 0)                                                                             /* check integral */
+        {
+            int64_t s;
+            
+            s = (int64_t)ahrs->e_int[i] + (((e[i] * ahrs->ki) >> 16) * dt >> 30);                     /* integrate */
+            s = (s > AHRS_FIXED_MAX_INT) ? AHRS_FIXED_MAX_INT : s;                                    /* limit high */
+            s = (s < -AHRS_FIXED_MAX_INT) ? -AHRS_FIXED_MAX_INT : s;                                  /* limit low */
+            ahrs->e_int[i] = (int32_t)s;                                                              /* save */
+        }
+        g = (int64_t)gyro[i] + (ahrs->e_int[i] >> 14) + ((e[i] * ahrs->kp) >> 30);                    /* q16 rate */
+        h[i] = (int32_t)((g * hdt) >> 16);                                                            /* q30 half angle */
+    }
+    qa = ahrs->q[0];                                                                                  /* save w */
+    qb = ahrs->q[1];                                                                                  /* save x */
+    qc = ahrs->q[2];                                                                                  /* save y */
+    ahrs->q[0] += -a_ahrs_mul(qb, h[0]) - a_ahrs_mul(qc, h[1]) - a_ahrs_mul(ahrs->q[3], h[2]);        /* integrate w */
+    ahrs->q[1] += a_ahrs_mul(qa, h[0]) + a_ahrs_mul(qc, h[2]) - a_ahrs_mul(ahrs->q[3], h[1]);         /* integrate x */
+    ahrs->q[2] += a_ahrs_mul(qa, h[1]) - a_ahrs_mul(qb, h[2]) + a_ahrs_mul(ahrs->q[3], h[0]);         /* integrate y */
+    ahrs->q[3] += a_ahrs_mul(qa, h[2]) + a_ahrs_mul(qb, h[1]) - a_ahrs_mul(qc, h[0]);                 /* integrate z */
+    n = ((int64_t)ahrs->q[0] * ahrs->q[0] + (int64_t)ahrs->q[1] * ahrs->q[1] +
+         (int64_t)ahrs->q[2] * ahrs->q[2] + (int64_t)ahrs->q[3] * ahrs->q[3]) >> 30;                  /* q30 squared norm */
+    nrm = (int32_t)((3LL * QMC5883L_AHRS_FIXED_ONE - n) / 2);                                         /* newton step of 1 / sqrt */
+    for (i = 0; i < 4; i++)                                                                           /* each element */
+    {
+        ahrs->q[i] = a_ahrs_mul(ahrs->q[i], nrm);                                                     /* normalize */
+    }
+    
+    return 0;                                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the fixed orientation
+ * @param[in]  *ahrs points to an ahrs fixed structure
+ * @param[out] *q points to a q30 quaternion buffer w x y z
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 3 ahrs is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_ahrs_fixed_get_quaternion(qmc5883l_ahrs_fixed_t *ahrs, int32_t q[4])
+{
+    if (ahrs == NULL)                           /* check ahrs */
+    {
+        return 2;                               /* return error */
+    }
+    if (ahrs->inited != 1)                      /* check ahrs initialization */
+    {
+        return 3;                               /* return error */
+    }
+    
+    memcpy(q, ahrs->q, sizeof(ahrs->q));        /* get quaternion */
+    
+    return 0;                                   /* success return 0 */
+}
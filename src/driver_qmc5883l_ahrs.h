@@ -0,0 +1,228 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_ahrs.h
+ * @brief     driver qmc5883l ahrs header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_AHRS_H
+#define DRIVER_QMC5883L_AHRS_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_ahrs_driver qmc5883l ahrs driver function
+ * @brief    qmc5883l ahrs driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l ahrs definition
+ */
+#define QMC5883L_AHRS_MAX_DT_US           1000000        /**< longer gyro gaps restart the integration */
+#define QMC5883L_AHRS_MAX_MAG_WEIGHT      32             /**< max gyro steps one magnetometer sample stands for */
+#define QMC5883L_AHRS_FIXED_ONE           (1 << 30)      /**< 1.0 of a q30 quaternion */
+#define QMC5883L_AHRS_FIXED_GAIN_ONE      (1 << 16)      /**< 1.0 of a q16 gain or rate */
+
+/**
+ * @brief qmc5883l ahrs structure definition
+ */
+typedef struct qmc5883l_ahrs_s
+{
+    float q[4];                      /**< body to earth quaternion w x y z */
+    float e_int[3];                  /**< integral feedback in rad/s */
+    float kp;                        /**< proportional gain */
+    float ki;                        /**< integral gain */
+    float mag[3];                    /**< pending magnetometer sample */
+    uint64_t mag_time_us;            /**< pending magnetometer time */
+    uint64_t mag_last_us;            /**< last applied magnetometer time */
+    uint64_t time_us;                /**< last gyro time */
+    uint8_t mag_pending;             /**< pending magnetometer flag */
+    uint8_t mag_applied;             /**< magnetometer applied once flag */
+    uint8_t started;                 /**< gyro time valid flag */
+    uint8_t inited;                  /**< inited flag */
+} qmc5883l_ahrs_t;
+
+/**
+ * @brief qmc5883l ahrs fixed structure definition
+ */
+typedef struct qmc5883l_ahrs_fixed_s
+{
+    int32_t q[4];                    /**< body to earth quaternion w x y z in q30 */
+    int32_t e_int[3];                /**< integral feedback in q30 rad/s */
+    int32_t kp;                      /**< proportional gain in q16 */
+    int32_t ki;                      /**< integral gain in q16 */
+    int32_t mag[3];                  /**< pending magnetometer sample */
+    uint64_t mag_time_us;            /**< pending magnetometer time */
+    uint64_t mag_last_us;            /**< last applied magnetometer time */
+    uint64_t time_us;                /**< last gyro time */
+    uint8_t mag_pending;             /**< pending magnetometer flag */
+    uint8_t mag_applied;             /**< magnetometer applied once flag */
+    uint8_t started;                 /**< gyro time valid flag */
+    uint8_t inited;                  /**< inited flag */
+} qmc5883l_ahrs_fixed_t;
+
+/**
+ * @brief      initialize the mahony filter
+ * @param[out] *ahrs points to an ahrs structure
+ * @param[in]  kp is the proportional gain
+ * @param[in]  ki is the integral gain that learns the gyro bias, 0 disables it
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 4 gain is invalid
+ * @note       gyro, accelerometer and magnetometer must share one right handed body frame,
+ *             the accelerometer reads +1g along z when level and the earth frame is x north, z up
+ */
+uint8_t qmc5883l_ahrs_init(qmc5883l_ahrs_t *ahrs, float kp, float ki);
+
+/**
+ * @brief     queue a magnetometer sample
+ * @param[in] *ahrs points to an ahrs structure
+ * @param[in] time_us is the sample time
+ * @param[in] *m_gauss points to a calibrated data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 ahrs or m_gauss is NULL
+ *            - 3 ahrs is not initialized
+ * @note      applied by the first gyro update at or after time_us, weighted by the time since the last one
+ */
+uint8_t qmc5883l_ahrs_set_mag(qmc5883l_ahrs_t *ahrs, uint64_t time_us, const float m_gauss[3]);
+
+/**
+ * @brief     run one filter step at the gyro rate
+ * @param[in] *ahrs points to an ahrs structure
+ * @param[in] time_us is the gyro sample time
+ * @param[in] *gyro points to an angular rate buffer in rad/s
+ * @param[in] *accel points to an acceleration buffer in any unit
+ * @return    status code
+ *            - 0 success
+ *            - 2 ahrs, gyro or accel is NULL
+ *            - 3 ahrs is not initialized
+ * @note      the first call only sets the time, a zero accel skips the tilt correction
+ */
+uint8_t qmc5883l_ahrs_update(qmc5883l_ahrs_t *ahrs, uint64_t time_us, const float gyro[3], const float accel[3]);
+
+/**
+ * @brief      get the orientation
+ * @param[in]  *ahrs points to an ahrs structure
+ * @param[out] *q points to a quaternion buffer w x y z
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 3 ahrs is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_ahrs_get_quaternion(qmc5883l_ahrs_t *ahrs, float q[4]);
+
+/**
+ * @brief      get the orientation as angles
+ * @param[in]  *ahrs points to an ahrs structure
+ * @param[out] *roll points to a roll buffer in degrees
+ * @param[out] *pitch points to a pitch buffer in degrees
+ * @param[out] *yaw points to a yaw buffer in degrees
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 3 ahrs is not initialized
+ * @note       z y x order, yaw is counterclockwise from north seen from above
+ */
+uint8_t qmc5883l_ahrs_get_euler(qmc5883l_ahrs_t *ahrs, float *roll, float *pitch, float *yaw);
+
+/**
+ * @brief      initialize the fixed point mahony filter
+ * @param[out] *ahrs points to an ahrs fixed structure
+ * @param[in]  kp is the proportional gain in q16
+ * @param[in]  ki is the integral gain in q16, 0 disables it
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 4 gain is invalid
+ * @note       same frames as qmc5883l_ahrs_init, no float operation is used by the fixed functions
+ */
+uint8_t qmc5883l_ahrs_fixed_init(qmc5883l_ahrs_fixed_t *ahrs, int32_t kp, int32_t ki);
+
+/**
+ * @brief     queue a fixed magnetometer sample
+ * @param[in] *ahrs points to an ahrs fixed structure
+ * @param[in] time_us is the sample time
+ * @param[in] *mag points to a calibrated data buffer in any unit
+ * @return    status code
+ *            - 0 success
+ *            - 2 ahrs or mag is NULL
+ *            - 3 ahrs is not initialized
+ *            - 4 mag is out of range
+ * @note      the components must stay within +-2^24, raw data or qmc5883l_batch_calibrate_fixed output fits
+ */
+uint8_t qmc5883l_ahrs_fixed_set_mag(qmc5883l_ahrs_fixed_t *ahrs, uint64_t time_us, const int32_t mag[3]);
+
+/**
+ * @brief     run one fixed filter step at the gyro rate
+ * @param[in] *ahrs points to an ahrs fixed structure
+ * @param[in] time_us is the gyro sample time
+ * @param[in] *gyro points to an angular rate buffer in q16 rad/s
+ * @param[in] *accel points to an acceleration buffer in any unit within +-2^24
+ * @return    status code
+ *            - 0 success
+ *            - 2 ahrs, gyro or accel is NULL
+ *            - 3 ahrs is not initialized
+ *            - 4 accel is out of range
+ * @note      the first call only sets the time, a zero accel skips the tilt correction
+ */
+uint8_t qmc5883l_ahrs_fixed_update(qmc5883l_ahrs_fixed_t *ahrs, uint64_t time_us, const int32_t gyro[3], const int32_t accel[3]);
+
+/**
+ * @brief      get the fixed orientation
+ * @param[in]  *ahrs points to an ahrs fixed structure
+ * @param[out] *q points to a q30 quaternion buffer w x y z
+ * @return     status code
+ *             - 0 success
+ *             - 2 ahrs is NULL
+ *             - 3 ahrs is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_ahrs_fixed_get_quaternion(qmc5883l_ahrs_fixed_t *ahrs, int32_t q[4]);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
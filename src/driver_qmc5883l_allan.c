@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_allan.c
+ * @brief     driver qmc5883l allan source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_allan.h"
+#include <math.h>
+
+/**
+ * @brief     add one window difference
+ * @param[in] *allan points to an allan structure
+ * @param[in] j is the sub block size index
+ * @param[in] k is the octave
+ * @param[in] m is the window length in sub blocks
+ * @note      the newest m sub blocks are compared with the m before them
+ */
+static void a_allan_level(qmc5883l_allan_t *allan, uint8_t j, uint8_t k, uint8_t m)
+{
+    uint8_t i;
+    uint8_t a;
+    uint8_t slot;
+    
+    if (allan->filled[j] < 2 * m)                                                            /* check history */
+    {
+        return;                                                                              /* not enough */
+    }
+    for (a = 0; a < 3; a++)                                                                  /* each axis */
+    {
+        double d;
+        
+        d = 0.0;                                                                             /* init 0 */
+        slot = allan->head[j];                                                               /* newest after the loop */
+        for (i = 0; i < 2 * m; i++)                                                          /* two windows */
+        {
+            slot = (uint8_t)((slot + QMC5883L_ALLAN_RING - 1) % QMC5883L_ALLAN_RING);        /* step back */
+            d += (i < m) ? allan->ring[j][slot][a] : -allan->ring[j][slot][a];               /* newer minus older */
+        }
+        allan->d2[k][a] += d * d;                                                            /* accumulate */
+    }
+    allan->diffs[k]++;                                                                       /* count */
+}
+
+/**
+ * @brief     push one finished sub block
+ * @param[in] *allan points to an allan structure
+ * @param[in] j is the sub block size index, the size is 2^j samples
+ * @param[in] *sum points to the sub block sum buffer
+ * @note      size 1 serves the octaves up to the overlap, larger sizes serve one octave each
+ */
+static void a_allan_block(qmc5883l_allan_t *allan, uint8_t j, const double sum[3])
+{
+    uint8_t k;
+    
+    allan->ring[j][allan->head[j]][0] = sum[0];                                             /* save x */
+    allan->ring[j][allan->head[j]][1] = sum[1];                                             /* save y */
+    allan->ring[j][allan->head[j]][2] = sum[2];                                             /* save z */
+    allan->head[j] = (uint8_t)((allan->head[j] + 1) % QMC5883L_ALLAN_RING);                 /* next slot */
+    if (allan->filled[j] < QMC5883L_ALLAN_RING)                                             /* check filled */
+    {
+        allan->filled[j]++;                                                                 /* one more */
+    }
+    if (j == 0)                                                                             /* single samples */
+    {
+        for (k = 0; (k <= QMC5883L_ALLAN_OVERLAP_SHIFT) && (k < allan->levels); k++)        /* short octaves */
+        {
+            a_allan_level(allan, 0, k, (uint8_t)(1 << k));                                  /* full overlap */
+        }
+    }
+    else
+    {
+        a_allan_level(allan, j, (uint8_t)(j + QMC5883L_ALLAN_OVERLAP_SHIFT),
+                      QMC5883L_ALLAN_OVERLAP);                                              /* tau / overlap stride */
+    }
+}
+
+/**
+ * @brief      initialize the allan variance calculator
+ * @param[out] *allan points to an allan structure
+ * @param[in]  rate_hz is the sample rate
+ * @param[in]  levels is the number of octaves, tau runs from 1 to 2^(levels - 1) samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 allan is NULL
+ *             - 4 rate_hz or levels is invalid
+ * @note       levels must be in [1, QMC5883L_ALLAN_MAX_LEVELS], memory does not grow with the capture length
+ */
+uint8_t qmc5883l_allan_init(qmc5883l_allan_t *allan, float rate_hz, uint8_t levels)
+{
+    if (allan == NULL)                                                                     /* check allan */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if ((rate_hz <= 0.0f) || (levels == 0) || (levels > QMC5883L_ALLAN_MAX_LEVELS))        /* check param */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    memset(allan, 0, sizeof(qmc5883l_allan_t));                                            /* clear all */
+    allan->rate_hz = rate_hz;                                                              /* set rate */
+    allan->levels = levels;                                                                /* set levels */
+    allan->blocks = (uint8_t)((levels > QMC5883L_ALLAN_OVERLAP_SHIFT) ?
+                              (levels - QMC5883L_ALLAN_OVERLAP_SHIFT) : 1);                /* sub block sizes */
+    allan->inited = 1;                                                                     /* flag inited */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     push one sample
+ * @param[in] *allan points to an allan structure
+ * @param[in] *m_gauss points to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 allan or m_gauss is NULL
+ *            - 3 allan is not initialized
+ * @note      constant time per sample on average
+ */
+uint8_t qmc5883l_allan_push(qmc5883l_allan_t *allan, const float m_gauss[3])
+{
+    double sum[3];
+    uint8_t j;
+    
+    if ((allan == NULL) || (m_gauss == NULL))        /* check allan and m_gauss */
+    {
+        return 2;                                    /* return error */
+    }
+    if (allan->inited != 1)                          /* check allan initialization */
+    {
+        return 3;                                    /* return error */
+    }
+    
+    sum[0] = m_gauss[0];                             /* copy x */
+    sum[1] = m_gauss[1];                             /* copy y */
+    sum[2] = m_gauss[2];                             /* copy z */
+    allan->samples++;                                /* one more */
+    for (j = 0; j < allan->blocks; j++)              /* pairwise cascade */
+    {
+        a_allan_block(allan, j, sum);                /* finished sub block */
+        if ((j + 1) >= allan->blocks)                /* check last size */
+        {
+            break;                                   /* break */
+        }
+        if (allan->phase[j + 1] == 0)                /* first half */
+        {
+            allan->half[j + 1][0] = sum[0];          /* save x */
+            allan->half[j + 1][1] = sum[1];          /* save y */
+            allan->half[j + 1][2] = sum[2];          /* save z */
+            allan->phase[j + 1] = 1;                 /* wait for the second */
+            
+            break;                                   /* break */
+        }
+        sum[0] += allan->half[j + 1][0];             /* join x */
+        sum[1] += allan->half[j + 1][1];             /* join y */
+        sum[2] += allan->half[j + 1][2];             /* join z */
+        allan->phase[j + 1] = 0;                     /* next pair */
+    }
+    
+    return 0;                                        /* success return 0 */
+}
+
+/**
+ * @brief      get the allan deviation of one octave
+ * @param[in]  *allan points to an allan structure
+ * @param[in]  level is the octave, tau is 2^level samples
+ * @param[out] *tau_s points to a tau buffer in seconds
+ * @param[out] *sigma points to an allan deviation buffer in the unit of the samples
+ * @param[out] *diffs points to a window difference count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 allan is NULL
+ *             - 3 allan is not initialized or the octave has no difference yet
+ *             - 4 level is invalid
+ * @note       overlapping estimator, tau above the overlap uses windows every tau / QMC5883L_ALLAN_OVERLAP samples
+ */
+uint8_t qmc5883l_allan_get(qmc5883l_allan_t *allan, uint8_t level, float *tau_s, float sigma[3], uint32_t *diffs)
+{
+    double tau;
+    uint8_t a;
+    
+    if (allan == NULL)                                                                                /* check allan */
+    {
+        return 2;                                                                                     /* return error */
+    }
+    if (allan->inited != 1)                                                                           /* check allan initialization */
+    {
+        return 3;                                                                                     /* return error */
+    }
+    if (level >= allan->levels)                                                                       /* check level */
+    {
+        return 4;                                                                                     /* return error */
+    }
+    if (allan->diffs[level] == 0)                                                                     /* check differences */
+    {
+        return 3;                                                                                     /* return error */
+    }
+    
+    tau = (double)(1UL << level);                                                                     /* tau in samples */
+    for (a = 0; a < 3; a++)                                                                           /* each axis */
+    {
+        sigma[a] = (float)sqrt(allan->d2[level][a] / (2.0 * tau * tau * allan->diffs[level]));        /* window sums to means */
+    }
+    *tau_s = (float)(tau / allan->rate_hz);                                                           /* tau in seconds */
+    *diffs = allan->diffs[level];                                                                     /* difference count */
+    
+    return 0;                                                                                         /* success return 0 */
+}
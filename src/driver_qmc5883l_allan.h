@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_allan.h
+ * @brief     driver qmc5883l allan header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_ALLAN_H
+#define DRIVER_QMC5883L_ALLAN_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_allan_driver qmc5883l allan driver function
+ * @brief    qmc5883l allan driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l allan definition
+ */
+#define QMC5883L_ALLAN_MAX_LEVELS       24        /**< tau up to 2^23 samples, 11.6 hours at 200Hz */
+#define QMC5883L_ALLAN_OVERLAP_SHIFT    2         /**< windows start every tau / 4 samples */
+#define QMC5883L_ALLAN_OVERLAP          (1 << QMC5883L_ALLAN_OVERLAP_SHIFT)                        /**< windows per tau */
+#define QMC5883L_ALLAN_RING             (2 * QMC5883L_ALLAN_OVERLAP)                               /**< sub blocks of two windows */
+#define QMC5883L_ALLAN_MAX_BLOCKS       (QMC5883L_ALLAN_MAX_LEVELS - QMC5883L_ALLAN_OVERLAP_SHIFT) /**< octave sub block sizes */
+
+/**
+ * @brief qmc5883l allan structure definition
+ */
+typedef struct qmc5883l_allan_s
+{
+    double ring[QMC5883L_ALLAN_MAX_BLOCKS][QMC5883L_ALLAN_RING][3];    /**< last sub block sums of each size */
+    double half[QMC5883L_ALLAN_MAX_BLOCKS][3];                         /**< first half of the next sub block */
+    double d2[QMC5883L_ALLAN_MAX_LEVELS][3];                           /**< sum of squared window differences */
+    uint32_t diffs[QMC5883L_ALLAN_MAX_LEVELS];                         /**< window differences */
+    uint8_t head[QMC5883L_ALLAN_MAX_BLOCKS];                           /**< next ring slot */
+    uint8_t filled[QMC5883L_ALLAN_MAX_BLOCKS];                         /**< used ring slots */
+    uint8_t phase[QMC5883L_ALLAN_MAX_BLOCKS];                          /**< half flag of the next sub block */
+    uint64_t samples;                                                  /**< pushed samples */
+    float rate_hz;                                                     /**< sample rate */
+    uint8_t levels;                                                    /**< computed octaves */
+    uint8_t blocks;                                                    /**< used sub block sizes */
+    uint8_t inited;                                                    /**< inited flag */
+} qmc5883l_allan_t;
+
+/**
+ * @brief      initialize the allan variance calculator
+ * @param[out] *allan points to an allan structure
+ * @param[in]  rate_hz is the sample rate
+ * @param[in]  levels is the number of octaves, tau runs from 1 to 2^(levels - 1) samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 allan is NULL
+ *             - 4 rate_hz or levels is invalid
+ * @note       levels must be in [1, QMC5883L_ALLAN_MAX_LEVELS], memory does not grow with the capture length
+ */
+uint8_t qmc5883l_allan_init(qmc5883l_allan_t *allan, float rate_hz, uint8_t levels);
+
+/**
+ * @brief     push one sample
+ * @param[in] *allan points to an allan structure
+ * @param[in] *m_gauss points to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 allan or m_gauss is NULL
+ *            - 3 allan is not initialized
+ * @note      constant time per sample on average
+ */
+uint8_t qmc5883l_allan_push(qmc5883l_allan_t *allan, const float m_gauss[3]);
+
+/**
+ * @brief      get the allan deviation of one octave
+ * @param[in]  *allan points to an allan structure
+ * @param[in]  level is the octave, tau is 2^level samples
+ * @param[out] *tau_s points to a tau buffer in seconds
+ * @param[out] *sigma points to an allan deviation buffer in the unit of the samples
+ * @param[out] *diffs points to a window difference count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 allan is NULL
+ *             - 3 allan is not initialized or the octave has no difference yet
+ *             - 4 level is invalid
+ * @note       overlapping estimator, tau above the overlap uses windows every tau / QMC5883L_ALLAN_OVERLAP samples
+ */
+uint8_t qmc5883l_allan_get(qmc5883l_allan_t *allan, uint8_t level, float *tau_s, float sigma[3], uint32_t *diffs);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
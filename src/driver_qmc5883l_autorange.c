@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_autorange.c
+ * @brief     driver qmc5883l autorange source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_autorange.h"
+
+/**
+ * @brief chip register definition
+ */
+#define AUTORANGE_REG_X_LSB           0x00          /**< data output x lsb register */
+#define AUTORANGE_REG_STATUS          0x06          /**< status register */
+#define AUTORANGE_REG_CONTROL1        0x09          /**< control 1 register */
+
+/**
+ * @brief autorange definition
+ */
+#define AUTORANGE_RNG_MASK            (3 << 4)      /**< control1 range bits */
+#define AUTORANGE_2GAUSS_PEAK_8G      8192.0f       /**< 2gauss full scale in 8gauss lsb */
+#define AUTORANGE_READY_TRIES         5000          /**< ready polls before timeout */
+
+/**
+ * @brief     switch the range
+ * @param[in] *ar points to an autorange structure
+ * @param[in] scale is the new range
+ * @return    status code
+ *            - 0 success
+ *            - 1 write control1 failed
+ * @note      the cached control1 keeps the other settings, so no read is needed
+ */
+static uint8_t a_autorange_switch(qmc5883l_autorange_t *ar, qmc5883l_full_scale_t scale)
+{
+    uint8_t prev;
+    
+    prev = (uint8_t)((ar->control1 & ~AUTORANGE_RNG_MASK) | ((uint8_t)scale << 4));        /* set scale */
+    if (qmc5883l_set_reg(ar->handle, AUTORANGE_REG_CONTROL1, &prev, 1) != 0)               /* write control1 */
+    {
+        return 1;                                                                          /* return error */
+    }
+    ar->control1 = prev;                                                                   /* save control1 */
+    ar->pending = 1;                                                                       /* flag the next sample */
+    ar->below = 0;                                                                         /* restart the hold */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     initialize the auto range
+ * @param[in] *ar points to an autorange structure
+ * @param[in] *handle points to a configured qmc5883l handle structure
+ * @param[in] down_ratio is the fraction of the 2gauss span below which the range goes down
+ * @param[in] hold is the number of samples the field must stay below before going down
+ * @return    status code
+ *            - 0 success
+ *            - 1 read control1 failed
+ *            - 2 ar or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 down_ratio or hold is invalid
+ * @note      control1 is read once and cached, call it again after changing the chip config
+ */
+uint8_t qmc5883l_autorange_init(qmc5883l_autorange_t *ar, qmc5883l_handle_t *handle, float down_ratio, uint32_t hold)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if ((ar == NULL) || (handle == NULL))                                    /* check ar and handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    if ((down_ratio <= 0.0f) || (down_ratio >= 1.0f) || (hold == 0))         /* check ratio and hold */
+    {
+        return 4;                                                            /* return error */
+    }
+    
+    res = qmc5883l_get_reg(handle, AUTORANGE_REG_CONTROL1, &prev, 1);        /* read control1 */
+    if (res != 0)                                                            /* check result */
+    {
+        handle->debug_print("qmc5883l: read control1 failed.\n");            /* read control1 failed */
+        
+        return 1;                                                            /* return error */
+    }
+    memset(ar, 0, sizeof(qmc5883l_autorange_t));                             /* clear all */
+    ar->handle = handle;                                                     /* set handle */
+    ar->down_raw = (uint16_t)(down_ratio * AUTORANGE_2GAUSS_PEAK_8G);        /* set threshold */
+    ar->hold = hold;                                                         /* set hold */
+    ar->control1 = prev;                                                     /* cache control1 */
+    ar->inited = 1;                                                          /* flag inited */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      read a sample and adjust the range
+ * @param[in]  *ar points to an autorange structure
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a converted data buffer
+ * @param[out] *flags points to a qmc5883l_autorange_flag_t mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 ar is NULL
+ *             - 3 ar is not initialized
+ * @note       m_gauss is continuous across the switches while raw follows the chip range,
+ *             a switch costs one control1 write and no sample costs more than a status and a data read
+ */
+uint8_t qmc5883l_autorange_read(qmc5883l_autorange_t *ar, int16_t raw[3], float m_gauss[3], uint8_t *flags)
+{
+    uint8_t status;
+    uint8_t buf[6];
+    uint8_t scale;
+    uint8_t mask;
+    uint16_t num;
+    float resolution;
+    
+    if (ar == NULL)                                                                     /* check ar */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (ar->inited != 1)                                                                /* check ar initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    num = AUTORANGE_READY_TRIES;                                                        /* init tries */
+    while (1)                                                                           /* wait ready */
+    {
+        if (qmc5883l_get_reg(ar->handle, AUTORANGE_REG_STATUS, &status, 1) != 0)        /* read status */
+        {
+            ar->handle->debug_print("qmc5883l: read failed.\n");                        /* read status failed */
+            
+            return 1;                                                                   /* return error */
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)                                       /* check ready */
+        {
+            break;                                                                      /* break loop */
+        }
+        num--;                                                                          /* count */
+        if (num == 0)                                                                   /* check timeout */
+        {
+            ar->handle->debug_print("qmc5883l: ready bit not be set.\n");               /* timeout */
+            
+            return 1;                                                                   /* return error */
+        }
+        ar->handle->delay_ms(10);                                                       /* check 10 ms */
+    }
+    if (qmc5883l_get_reg(ar->handle, AUTORANGE_REG_X_LSB, buf, 6) != 0)                 /* read raw data */
+    {
+        ar->handle->debug_print("qmc5883l: read data failed.\n");                       /* read data failed */
+        
+        return 1;                                                                       /* return error */
+    }
+    scale = (ar->control1 >> 4) & 0x01;                                                 /* cached range */
+    resolution = (scale == QMC5883L_FULL_SCALE_2GAUSS) ? (1000.0f / 12000.0f) :
+                                                         (1000.0f / 3000.0f);           /* set resolution */
+    raw[0] = (int16_t)(((uint16_t)buf[1] << 8) | buf[0]);                               /* get x raw */
+    raw[1] = (int16_t)(((uint16_t)buf[3] << 8) | buf[2]);                               /* get y raw */
+    raw[2] = (int16_t)(((uint16_t)buf[5] << 8) | buf[4]);                               /* get z raw */
+    m_gauss[0] = (float)(raw[0]) * resolution;                                          /* calculate x */
+    m_gauss[1] = (float)(raw[1]) * resolution;                                          /* calculate y */
+    m_gauss[2] = (float)(raw[2]) * resolution;                                          /* calculate z */
+    
+    mask = (ar->pending != 0) ? QMC5883L_AUTORANGE_FLAG_SWITCH : 0;                     /* flag the switch over */
+    ar->pending = 0;                                                                    /* clear pending */
+    if ((status & QMC5883L_STATUS_OVL) != 0)                                            /* check overflow */
+    {
+        mask |= QMC5883L_AUTORANGE_FLAG_OVERFLOW;                                       /* flag clipped */
+        ar->below = 0;                                                                  /* restart the hold */
+        if ((scale == QMC5883L_FULL_SCALE_2GAUSS) &&
+            (a_autorange_switch(ar, QMC5883L_FULL_SCALE_8GAUSS) != 0))                  /* go up */
+        {
+            ar->handle->debug_print("qmc5883l: write control1 failed.\n");              /* write control1 failed */
+            
+            return 1;                                                                   /* return error */
+        }
+    }
+    else if (scale == QMC5883L_FULL_SCALE_8GAUSS)                                       /* check down */
+    {
+        uint16_t peak;
+        uint8_t i;
+        
+        peak = 0;                                                                       /* init 0 */
+        for (i = 0; i < 3; i++)                                                         /* each axis */
+        {
+            uint16_t a;
+            
+            a = (uint16_t)((raw[i] < 0) ? -(int32_t)raw[i] : raw[i]);                   /* absolute */
+            peak = (a > peak) ? a : peak;                                               /* max */
+        }
+        ar->below = (peak < ar->down_raw) ? (ar->below + 1) : 0;                        /* hold count */
+        if ((ar->below >= ar->hold) &&
+            (a_autorange_switch(ar, QMC5883L_FULL_SCALE_2GAUSS) != 0))                  /* go down */
+        {
+            ar->handle->debug_print("qmc5883l: write control1 failed.\n");              /* write control1 failed */
+            
+            return 1;                                                                   /* return error */
+        }
+    }
+    else
+    {
+        ar->below = 0;                                                                  /* in range */
+    }
+    if (flags != NULL)                                                                  /* check flags */
+    {
+        *flags = mask;                                                                  /* set flags */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the current range
+ * @param[in]  *ar points to an autorange structure
+ * @param[out] *scale points to a full scale buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ar is NULL
+ *             - 3 ar is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_autorange_get_full_scale(qmc5883l_autorange_t *ar, qmc5883l_full_scale_t *scale)
+{
+    if (ar == NULL)                                                      /* check ar */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (ar->inited != 1)                                                 /* check ar initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    *scale = (qmc5883l_full_scale_t)((ar->control1 >> 4) & 0x01);        /* get range */
+    
+    return 0;                                                            /* success return 0 */
+}
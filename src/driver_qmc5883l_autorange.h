@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_autorange.h
+ * @brief     driver qmc5883l autorange header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_AUTORANGE_H
+#define DRIVER_QMC5883L_AUTORANGE_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_autorange_driver qmc5883l autorange driver function
+ * @brief    qmc5883l autorange driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l autorange flag enumeration definition
+ */
+typedef enum
+{
+    QMC5883L_AUTORANGE_FLAG_OVERFLOW = (1 << 0),        /**< the sample is clipped */
+    QMC5883L_AUTORANGE_FLAG_SWITCH   = (1 << 1),        /**< first sample after a range switch */
+} qmc5883l_autorange_flag_t;
+
+/**
+ * @brief qmc5883l autorange structure definition
+ */
+typedef struct qmc5883l_autorange_s
+{
+    qmc5883l_handle_t *handle;        /**< qmc5883l handle */
+    uint16_t down_raw;                /**< 8gauss raw peak below which the range goes down */
+    uint32_t hold;                    /**< samples below the threshold before going down */
+    uint32_t below;                   /**< samples below the threshold so far */
+    uint8_t control1;                 /**< cached control1 register */
+    uint8_t pending;                  /**< range switched after the last sample */
+    uint8_t inited;                   /**< inited flag */
+} qmc5883l_autorange_t;
+
+/**
+ * @brief     initialize the auto range
+ * @param[in] *ar points to an autorange structure
+ * @param[in] *handle points to a configured qmc5883l handle structure
+ * @param[in] down_ratio is the fraction of the 2gauss span below which the range goes down
+ * @param[in] hold is the number of samples the field must stay below before going down
+ * @return    status code
+ *            - 0 success
+ *            - 1 read control1 failed
+ *            - 2 ar or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 down_ratio or hold is invalid
+ * @note      control1 is read once and cached, call it again after changing the chip config
+ */
+uint8_t qmc5883l_autorange_init(qmc5883l_autorange_t *ar, qmc5883l_handle_t *handle, float down_ratio, uint32_t hold);
+
+/**
+ * @brief      read a sample and adjust the range
+ * @param[in]  *ar points to an autorange structure
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a converted data buffer
+ * @param[out] *flags points to a qmc5883l_autorange_flag_t mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 ar is NULL
+ *             - 3 ar is not initialized
+ * @note       m_gauss is continuous across the switches while raw follows the chip range,
+ *             a switch costs one control1 write and no sample costs more than a status and a data read
+ */
+uint8_t qmc5883l_autorange_read(qmc5883l_autorange_t *ar, int16_t raw[3], float m_gauss[3], uint8_t *flags);
+
+/**
+ * @brief      get the current range
+ * @param[in]  *ar points to an autorange structure
+ * @param[out] *scale points to a full scale buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ar is NULL
+ *             - 3 ar is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_autorange_get_full_scale(qmc5883l_autorange_t *ar, qmc5883l_full_scale_t *scale);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
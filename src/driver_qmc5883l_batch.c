@@ -0,0 +1,674 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_batch.c
+ * @brief     driver qmc5883l batch source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_batch.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BATCH_USE_AVX2
+#define BATCH_USE_SSE2
+#define BATCH_NATIVE_KERNEL        QMC5883L_BATCH_KERNEL_AVX2         /**< avx2 build */
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define BATCH_USE_SSE2
+#define BATCH_NATIVE_KERNEL        QMC5883L_BATCH_KERNEL_SSE2         /**< sse2 build */
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BATCH_USE_NEON
+#define BATCH_NATIVE_KERNEL        QMC5883L_BATCH_KERNEL_NEON         /**< neon build */
+#else
+#define BATCH_NATIVE_KERNEL        QMC5883L_BATCH_KERNEL_SCALAR       /**< portable build */
+#endif
+
+/**
+ * @brief batch definition
+ */
+#define BATCH_FIXED_ONE            ((float)(1 << QMC5883L_BATCH_FRAC_BITS))        /**< fixed point one */
+
+static qmc5883l_batch_kernel_t gs_kernel = BATCH_NATIVE_KERNEL;        /**< used kernel */
+
+/**
+ * @brief     round to fixed point
+ * @param[in] v is the value in m_gauss
+ * @return    fixed point value
+ * @note      rounds half away from zero like the simd kernels
+ */
+static int32_t a_batch_round(float v)
+{
+    v = v * BATCH_FIXED_ONE;                                       /* scale */
+    
+    return (int32_t)((v < 0.0f) ? (v - 0.5f) : (v + 0.5f));        /* round and truncate */
+}
+
+/**
+ * @brief      scalar kernel
+ * @param[in]  *a points to a row major 3x3 matrix
+ * @param[in]  *b points to an offset buffer
+ * @param[in]  *raw points to an interleaved raw data buffer
+ * @param[out] *out points to an interleaved float buffer, NULL to output fixed point
+ * @param[out] *fixed points to an interleaved fixed point buffer
+ * @param[in]  len is the number of samples
+ * @note       out = a * raw + b
+ */
+static void a_batch_scalar(const float a[9], const float b[3], const int16_t *raw, float *out, int32_t *fixed, uint32_t len)
+{
+    uint32_t i;
+    
+    for (i = 0; i < len; i++)                                /* each sample */
+    {
+        float x;
+        float y;
+        float z;
+        float o[3];
+        
+        x = (float)raw[0];                                   /* get x */
+        y = (float)raw[1];                                   /* get y */
+        z = (float)raw[2];                                   /* get z */
+        o[0] = a[0] * x + a[1] * y + a[2] * z + b[0];        /* calculate x */
+        o[1] = a[3] * x + a[4] * y + a[5] * z + b[1];        /* calculate y */
+        o[2] = a[6] * x + a[7] * y + a[8] * z + b[2];        /* calculate z */
+        if (out != NULL)                                     /* check output */
+        {
+            out[0] = o[0];                                   /* set x */
+            out[1] = o[1];                                   /* set y */
+            out[2] = o[2];                                   /* set z */
+            out += 3;                                        /* next */
+        }
+        else
+        {
+            fixed[0] = a_batch_round(o[0]);                  /* set x */
+            fixed[1] = a_batch_round(o[1]);                  /* set y */
+            fixed[2] = a_batch_round(o[2]);                  /* set z */
+            fixed += 3;                                      /* next */
+        }
+        raw += 3;                                            /* next */
+    }
+}
+
+#ifdef BATCH_USE_SSE2
+
+/**
+ * @brief     sse2 kernel
+ * @param[in] *a points to a row major 3x3 matrix
+ * @param[in] *b points to an offset buffer
+ * @param[in] *raw points to an interleaved raw data buffer
+ * @param[in] *out points to an interleaved float buffer, NULL to output fixed point
+ * @param[in] *fixed points to an interleaved fixed point buffer
+ * @param[in] len is the number of samples
+ * @note      four samples are transposed to x, y and z vectors with shuffles
+ */
+static void a_batch_sse2(const float a[9], const float b[3], const int16_t *raw, float *out, int32_t *fixed, uint32_t len)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);                                          /* sign mask */
+    const __m128 half = _mm_set1_ps(0.5f);                                           /* rounding */
+    const __m128 one = _mm_set1_ps(BATCH_FIXED_ONE);                                 /* fixed one */
+    uint32_t i;
+    
+    for (i = 0; (i + 4) <= len; i += 4)                                              /* four samples */
+    {
+        __m128i r0;
+        __m128i r1;
+        __m128 v0;
+        __m128 v1;
+        __m128 v2;
+        __m128 t0;
+        __m128 t1;
+        __m128 t2;
+        __m128 x;
+        __m128 y;
+        __m128 z;
+        __m128 o[3];
+        uint8_t k;
+        
+        r0 = _mm_loadu_si128((const __m128i *)raw);                                  /* x0 y0 z0 x1 y1 z1 x2 y2 */
+        r1 = _mm_loadl_epi64((const __m128i *)(raw + 8));                            /* z2 x3 y3 z3 */
+        v0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(r0, r0), 16));        /* x0 y0 z0 x1 */
+        v1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(r0, r0), 16));        /* y1 z1 x2 y2 */
+        v2 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(r1, r1), 16));        /* z2 x3 y3 z3 */
+        t0 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 3, 0));                        /* x0 x1 y1 z1 */
+        t1 = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2));                        /* x2 y2 x3 y3 */
+        x = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 1, 0));                         /* x0 x1 x2 x3 */
+        t2 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1));                        /* y0 y0 y1 y1 */
+        y = _mm_shuffle_ps(t2, t1, _MM_SHUFFLE(3, 1, 2, 0));                         /* y0 y1 y2 y3 */
+        t0 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2));                        /* z0 z0 z1 z1 */
+        t1 = _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0));                        /* z2 z2 z3 z3 */
+        z = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));                         /* z0 z1 z2 z3 */
+        for (k = 0; k < 3; k++)                                                      /* each axis */
+        {
+            o[k] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[k * 3 + 0]), x),
+                                                    _mm_mul_ps(_mm_set1_ps(a[k * 3 + 1]), y)),
+                                         _mm_mul_ps(_mm_set1_ps(a[k * 3 + 2]), z)),
+                              _mm_set1_ps(b[k]));                                    /* a * raw + b */
+        }
+        t0 = _mm_unpacklo_ps(o[0], o[1]);                                            /* x0 y0 x1 y1 */
+        t1 = _mm_unpackhi_ps(o[0], o[1]);                                            /* x2 y2 x3 y3 */
+        t2 = _mm_shuffle_ps(o[2], o[0], _MM_SHUFFLE(1, 1, 0, 0));                    /* z0 z0 x1 x1 */
+        v0 = _mm_shuffle_ps(t0, t2, _MM_SHUFFLE(2, 0, 1, 0));                        /* x0 y0 z0 x1 */
+        t2 = _mm_shuffle_ps(o[1], o[2], _MM_SHUFFLE(1, 1, 1, 1));                    /* y1 y1 z1 z1 */
+        v1 = _mm_shuffle_ps(t2, t1, _MM_SHUFFLE(1, 0, 2, 0));                        /* y1 z1 x2 y2 */
+        t0 = _mm_shuffle_ps(o[2], t1, _MM_SHUFFLE(2, 2, 2, 2));                      /* z2 z2 x3 x3 */
+        t2 = _mm_shuffle_ps(t1, o[2], _MM_SHUFFLE(3, 3, 3, 3));                      /* y3 y3 z3 z3 */
+        v2 = _mm_shuffle_ps(t0, t2, _MM_SHUFFLE(2, 0, 2, 0));                        /* z2 x3 y3 z3 */
+        if (out != NULL)                                                             /* check output */
+        {
+            _mm_storeu_ps(out + 0, v0);                                              /* store */
+            _mm_storeu_ps(out + 4, v1);                                              /* store */
+            _mm_storeu_ps(out + 8, v2);                                              /* store */
+            out += 12;                                                               /* next */
+        }
+        else
+        {
+            v0 = _mm_mul_ps(v0, one);                                                /* scale */
+            v1 = _mm_mul_ps(v1, one);                                                /* scale */
+            v2 = _mm_mul_ps(v2, one);                                                /* scale */
+            v0 = _mm_add_ps(v0, _mm_or_ps(_mm_and_ps(v0, sign), half));              /* round */
+            v1 = _mm_add_ps(v1, _mm_or_ps(_mm_and_ps(v1, sign), half));              /* round */
+            v2 = _mm_add_ps(v2, _mm_or_ps(_mm_and_ps(v2, sign), half));              /* round */
+            _mm_storeu_si128((__m128i *)(fixed + 0), _mm_cvttps_epi32(v0));          /* store */
+            _mm_storeu_si128((__m128i *)(fixed + 4), _mm_cvttps_epi32(v1));          /* store */
+            _mm_storeu_si128((__m128i *)(fixed + 8), _mm_cvttps_epi32(v2));          /* store */
+            fixed += 12;                                                             /* next */
+        }
+        raw += 12;                                                                   /* next */
+    }
+    a_batch_scalar(a, b, raw, out, fixed, len - i);                                  /* tail */
+}
+
+#endif
+
+#ifdef BATCH_USE_AVX2
+
+/**
+ * @brief     load four samples as float
+ * @param[in] *raw points to an interleaved raw data buffer
+ * @param[in] offset is the int16 offset of the four values
+ * @return    four int32 values
+ * @note      none
+ */
+static __m128i a_batch_avx2_load4(const int16_t *raw, uint32_t offset)
+{
+    return _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)(raw + offset)));        /* sign extend */
+}
+
+/**
+ * @brief     avx2 kernel
+ * @param[in] *a points to a row major 3x3 matrix
+ * @param[in] *b points to an offset buffer
+ * @param[in] *raw points to an interleaved raw data buffer
+ * @param[in] *out points to an interleaved float buffer, NULL to output fixed point
+ * @param[in] *fixed points to an interleaved fixed point buffer
+ * @param[in] len is the number of samples
+ * @note      each 128 bit lane runs the sse2 transpose on four samples
+ */
+static void a_batch_avx2(const float a[9], const float b[3], const int16_t *raw, float *out, int32_t *fixed, uint32_t len)
+{
+    const __m256 sign = _mm256_set1_ps(-0.0f);                                                               /* sign mask */
+    const __m256 half = _mm256_set1_ps(0.5f);                                                                /* rounding */
+    const __m256 one = _mm256_set1_ps(BATCH_FIXED_ONE);                                                      /* fixed one */
+    __m256 c[9];
+    __m256 d[3];
+    uint32_t i;
+    uint8_t k;
+    
+    for (k = 0; k < 9; k++)                                                                                  /* broadcast matrix */
+    {
+        c[k] = _mm256_set1_ps(a[k]);                                                                         /* set */
+    }
+    for (k = 0; k < 3; k++)                                                                                  /* broadcast offset */
+    {
+        d[k] = _mm256_set1_ps(b[k]);                                                                         /* set */
+    }
+    for (i = 0; (i + 8) <= len; i += 8)                                                                      /* eight samples */
+    {
+        __m256 v0;
+        __m256 v1;
+        __m256 v2;
+        __m256 t0;
+        __m256 t1;
+        __m256 t2;
+        __m256 x;
+        __m256 y;
+        __m256 z;
+        __m256 o[3];
+        
+        v0 = _mm256_cvtepi32_ps(_mm256_inserti128_si256(_mm256_castsi128_si256(a_batch_avx2_load4(raw, 0)),
+                                                        a_batch_avx2_load4(raw, 12), 1));                    /* x0 y0 z0 x1 */
+        v1 = _mm256_cvtepi32_ps(_mm256_inserti128_si256(_mm256_castsi128_si256(a_batch_avx2_load4(raw, 4)),
+                                                        a_batch_avx2_load4(raw, 16), 1));                    /* y1 z1 x2 y2 */
+        v2 = _mm256_cvtepi32_ps(_mm256_inserti128_si256(_mm256_castsi128_si256(a_batch_avx2_load4(raw, 8)),
+                                                        a_batch_avx2_load4(raw, 20), 1));                    /* z2 x3 y3 z3 */
+        t0 = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 3, 0));                                             /* x0 x1 y1 z1 */
+        t1 = _mm256_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2));                                             /* x2 y2 x3 y3 */
+        x = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 1, 0));                                              /* x0 x1 x2 x3 */
+        t2 = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1));                                             /* y0 y0 y1 y1 */
+        y = _mm256_shuffle_ps(t2, t1, _MM_SHUFFLE(3, 1, 2, 0));                                              /* y0 y1 y2 y3 */
+        t0 = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2));                                             /* z0 z0 z1 z1 */
+        t1 = _mm256_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0));                                             /* z2 z2 z3 z3 */
+        z = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));                                              /* z0 z1 z2 z3 */
+        for (k = 0; k < 3; k++)                                                                              /* each axis */
+        {
+            o[k] = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c[k * 3 + 0], x),
+                                                             _mm256_mul_ps(c[k * 3 + 1], y)),
+                                               _mm256_mul_ps(c[k * 3 + 2], z)),
+                                 d[k]);                                                                      /* a * raw + b */
+        }
+        t0 = _mm256_unpacklo_ps(o[0], o[1]);                                                                 /* x0 y0 x1 y1 */
+        t1 = _mm256_unpackhi_ps(o[0], o[1]);                                                                 /* x2 y2 x3 y3 */
+        t2 = _mm256_shuffle_ps(o[2], o[0], _MM_SHUFFLE(1, 1, 0, 0));                                         /* z0 z0 x1 x1 */
+        v0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(2, 0, 1, 0));                                             /* x0 y0 z0 x1 */
+        t2 = _mm256_shuffle_ps(o[1], o[2], _MM_SHUFFLE(1, 1, 1, 1));                                         /* y1 y1 z1 z1 */
+        v1 = _mm256_shuffle_ps(t2, t1, _MM_SHUFFLE(1, 0, 2, 0));                                             /* y1 z1 x2 y2 */
+        t0 = _mm256_shuffle_ps(o[2], t1, _MM_SHUFFLE(2, 2, 2, 2));                                           /* z2 z2 x3 x3 */
+        t2 = _mm256_shuffle_ps(t1, o[2], _MM_SHUFFLE(3, 3, 3, 3));                                           /* y3 y3 z3 z3 */
+        v2 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(2, 0, 2, 0));                                             /* z2 x3 y3 z3 */
+        if (out != NULL)                                                                                     /* check output */
+        {
+            _mm_storeu_ps(out + 0, _mm256_castps256_ps128(v0));                                              /* store */
+            _mm_storeu_ps(out + 4, _mm256_castps256_ps128(v1));                                              /* store */
+            _mm_storeu_ps(out + 8, _mm256_castps256_ps128(v2));                                              /* store */
+            _mm_storeu_ps(out + 12, _mm256_extractf128_ps(v0, 1));                                           /* store */
+            _mm_storeu_ps(out + 16, _mm256_extractf128_ps(v1, 1));                                           /* store */
+            _mm_storeu_ps(out + 20, _mm256_extractf128_ps(v2, 1));                                           /* store */
+            out += 24;                                                                                       /* next */
+        }
+        else
+        {
+            __m256i f0;
+            __m256i f1;
+            __m256i f2;
+            
+            v0 = _mm256_mul_ps(v0, one);                                                                     /* scale */
+            v1 = _mm256_mul_ps(v1, one);                                                                     /* scale */
+            v2 = _mm256_mul_ps(v2, one);                                                                     /* scale */
+            f0 = _mm256_cvttps_epi32(_mm256_add_ps(v0, _mm256_or_ps(_mm256_and_ps(v0, sign), half)));        /* round */
+            f1 = _mm256_cvttps_epi32(_mm256_add_ps(v1, _mm256_or_ps(_mm256_and_ps(v1, sign), half)));        /* round */
+            f2 = _mm256_cvttps_epi32(_mm256_add_ps(v2, _mm256_or_ps(_mm256_and_ps(v2, sign), half)));        /* round */
+            _mm_storeu_si128((__m128i *)(fixed + 0), _mm256_castsi256_si128(f0));                            /* store */
+            _mm_storeu_si128((__m128i *)(fixed + 4), _mm256_castsi256_si128(f1));                            /* store */
+            _mm_storeu_si128((__m128i *)(fixed + 8), _mm256_castsi256_si128(f2));                            /* store */
+            _mm_storeu_si128((__m128i *)(fixed + 12), _mm256_extracti128_si256(f0, 1));                      /* store */
+            _mm_storeu_si128((__m128i *)(fixed + 16), _mm256_extracti128_si256(f1, 1));                      /* store */
+            _mm_storeu_si128((__m128i *)(fixed + 20), _mm256_extracti128_si256(f2, 1));                      /* store */
+            fixed += 24;                                                                                     /* next */
+        }
+        raw += 24;                                                                                           /* next */
+    }
+    a_batch_sse2(a, b, raw, out, fixed, len - i);                                                            /* tail */
+}
+
+#endif
+
+#ifdef BATCH_USE_NEON
+
+/**
+ * @brief     neon kernel
+ * @param[in] *a points to a row major 3x3 matrix
+ * @param[in] *b points to an offset buffer
+ * @param[in] *raw points to an interleaved raw data buffer
+ * @param[in] *out points to an interleaved float buffer, NULL to output fixed point
+ * @param[in] *fixed points to an interleaved fixed point buffer
+ * @param[in] len is the number of samples
+ * @note      the structure loads and stores do the transpose
+ */
+static void a_batch_neon(const float a[9], const float b[3], const int16_t *raw, float *out, int32_t *fixed, uint32_t len)
+{
+    const float32x4_t half = vdupq_n_f32(0.5f);                                      /* rounding */
+    const float32x4_t nhalf = vdupq_n_f32(-0.5f);                                    /* rounding */
+    const float32x4_t zero = vdupq_n_f32(0.0f);                                      /* zero */
+    uint32_t i;
+    
+    for (i = 0; (i + 4) <= len; i += 4)                                              /* four samples */
+    {
+        int16x4x3_t r;
+        float32x4_t x;
+        float32x4_t y;
+        float32x4_t z;
+        float32x4x3_t o;
+        uint8_t k;
+        
+        r = vld3_s16(raw);                                                           /* load and transpose */
+        x = vcvtq_f32_s32(vmovl_s16(r.val[0]));                                      /* x0 x1 x2 x3 */
+        y = vcvtq_f32_s32(vmovl_s16(r.val[1]));                                      /* y0 y1 y2 y3 */
+        z = vcvtq_f32_s32(vmovl_s16(r.val[2]));                                      /* z0 z1 z2 z3 */
+        for (k = 0; k < 3; k++)                                                      /* each axis */
+        {
+            o.val[k] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, a[k * 3 + 0]),
+                                                     vmulq_n_f32(y, a[k * 3 + 1])),
+                                           vmulq_n_f32(z, a[k * 3 + 2])),
+                                 vdupq_n_f32(b[k]));                                 /* a * raw + b */
+        }
+        if (out != NULL)                                                             /* check output */
+        {
+            vst3q_f32(out, o);                                                       /* transpose and store */
+            out += 12;                                                               /* next */
+        }
+        else
+        {
+            int32x4x3_t f;
+            
+            for (k = 0; k < 3; k++)                                                  /* each axis */
+            {
+                float32x4_t v;
+                
+                v = vmulq_n_f32(o.val[k], BATCH_FIXED_ONE);                          /* scale */
+                v = vaddq_f32(v, vbslq_f32(vcltq_f32(v, zero), nhalf, half));        /* round */
+                f.val[k] = vcvtq_s32_f32(v);                                         /* truncate */
+            }
+            vst3q_s32(fixed, f);                                                     /* transpose and store */
+            fixed += 12;                                                             /* next */
+        }
+        raw += 12;                                                                   /* next */
+    }
+    a_batch_scalar(a, b, raw, out, fixed, len - i);                                  /* tail */
+}
+
+#endif
+
+/**
+ * @brief      build the fused coefficients
+ * @param[in]  *cal points to a calibration structure, NULL for no calibration
+ * @param[in]  scale is the full scale of the samples
+ * @param[out] *a points to a row major 3x3 matrix
+ * @param[out] *b points to an offset buffer
+ * @return     status code
+ *             - 0 success
+ *             - 4 scale is invalid
+ * @note       a = matrix * resolution, b = -matrix * offset
+ */
+static uint8_t a_batch_coefficient(qmc5883l_calibration_t *cal, qmc5883l_full_scale_t scale, float a[9], float b[3])
+{
+    float resolution;
+    uint8_t i;
+    uint8_t j;
+    
+    if (scale == QMC5883L_FULL_SCALE_2GAUSS)                          /* 2gauss */
+    {
+        resolution = 1000.0f / 12000.0f;                              /* set resolution 2gauss */
+    }
+    else if (scale == QMC5883L_FULL_SCALE_8GAUSS)                     /* 8gauss */
+    {
+        resolution = 1000.0f / 3000.0f;                               /* set resolution 8gauss */
+    }
+    else
+    {
+        return 4;                                                     /* return error */
+    }
+    for (i = 0; i < 3; i++)                                           /* each row */
+    {
+        b[i] = 0.0f;                                                  /* init 0 */
+        for (j = 0; j < 3; j++)                                       /* each column */
+        {
+            if (cal != NULL)                                          /* check cal */
+            {
+                a[i * 3 + j] = cal->matrix[i][j] * resolution;        /* fold resolution */
+                b[i] -= cal->matrix[i][j] * cal->offset[j];           /* fold offset */
+            }
+            else
+            {
+                a[i * 3 + j] = (i == j) ? resolution : 0.0f;          /* diagonal */
+            }
+        }
+    }
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief      run the used kernel
+ * @param[in]  *a points to a row major 3x3 matrix
+ * @param[in]  *b points to an offset buffer
+ * @param[in]  *raw points to an interleaved raw data buffer
+ * @param[out] *out points to an interleaved float buffer, NULL to output fixed point
+ * @param[out] *fixed points to an interleaved fixed point buffer
+ * @param[in]  len is the number of samples
+ * @note       none
+ */
+static void a_batch_run(const float a[9], const float b[3], const int16_t *raw, float *out, int32_t *fixed, uint32_t len)
+{
+    switch (gs_kernel)                                         /* choose kernel */
+    {
+#ifdef BATCH_USE_AVX2
+        case QMC5883L_BATCH_KERNEL_AVX2 :
+        {
+            a_batch_avx2(a, b, raw, out, fixed, len);          /* avx2 */
+            
+            break;                                             /* break */
+        }
+#endif
+#ifdef BATCH_USE_SSE2
+        case QMC5883L_BATCH_KERNEL_SSE2 :
+        {
+            a_batch_sse2(a, b, raw, out, fixed, len);          /* sse2 */
+            
+            break;                                             /* break */
+        }
+#endif
+#ifdef BATCH_USE_NEON
+        case QMC5883L_BATCH_KERNEL_NEON :
+        {
+            a_batch_neon(a, b, raw, out, fixed, len);          /* neon */
+            
+            break;                                             /* break */
+        }
+#endif
+        default :
+        {
+            a_batch_scalar(a, b, raw, out, fixed, len);        /* scalar */
+            
+            break;                                             /* break */
+        }
+    }
+}
+
+/**
+ * @brief      get the fastest kernel of the build
+ * @param[out] *kernel points to a kernel buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 kernel is NULL
+ * @note       the kernel is chosen at compile time, build with -mavx2 to enable avx2
+ */
+uint8_t qmc5883l_batch_get_native_kernel(qmc5883l_batch_kernel_t *kernel)
+{
+    if (kernel == NULL)                   /* check kernel */
+    {
+        return 2;                         /* return error */
+    }
+    
+    *kernel = BATCH_NATIVE_KERNEL;        /* get native kernel */
+    
+    return 0;                             /* success return 0 */
+}
+
+/**
+ * @brief     set the batch kernel
+ * @param[in] kernel is the used kernel
+ * @return    status code
+ *            - 0 success
+ *            - 4 kernel is not built
+ * @note      the native kernel is used by default
+ */
+uint8_t qmc5883l_batch_set_kernel(qmc5883l_batch_kernel_t kernel)
+{
+    uint8_t built;
+    
+    switch (kernel)                                                               /* check kernel */
+    {
+        case QMC5883L_BATCH_KERNEL_SCALAR :
+        {
+            built = 1;                                                            /* always built */
+            
+            break;                                                                /* break */
+        }
+        case QMC5883L_BATCH_KERNEL_SSE2 :
+        {
+            built = ((BATCH_NATIVE_KERNEL == QMC5883L_BATCH_KERNEL_SSE2) ||
+                     (BATCH_NATIVE_KERNEL == QMC5883L_BATCH_KERNEL_AVX2));        /* avx2 builds include sse2 */
+            
+            break;                                                                /* break */
+        }
+        default :
+        {
+            built = (kernel == BATCH_NATIVE_KERNEL);                              /* native only */
+            
+            break;                                                                /* break */
+        }
+    }
+    if (built == 0)                                                               /* check built */
+    {
+        return 4;                                                                 /* return error */
+    }
+    gs_kernel = kernel;                                                           /* set kernel */
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the batch kernel
+ * @param[out] *kernel points to a kernel buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 kernel is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_batch_get_kernel(qmc5883l_batch_kernel_t *kernel)
+{
+    if (kernel == NULL)         /* check kernel */
+    {
+        return 2;               /* return error */
+    }
+    
+    *kernel = gs_kernel;        /* get kernel */
+    
+    return 0;                   /* success return 0 */
+}
+
+/**
+ * @brief      convert raw samples to m_gauss
+ * @param[in]  scale is the full scale of the samples
+ * @param[in]  **raw points to a raw data array in the qmc5883l_read format
+ * @param[out] **m_gauss points to a converted data array
+ * @param[in]  len is the number of samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 scale is invalid
+ * @note       none
+ */
+uint8_t qmc5883l_batch_convert(qmc5883l_full_scale_t scale, const int16_t (*raw)[3], float (*m_gauss)[3], uint32_t len)
+{
+    float a[9];
+    float b[3];
+    
+    if ((raw == NULL) || (m_gauss == NULL))                          /* check buffer */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (a_batch_coefficient(NULL, scale, a, b) != 0)                 /* get coefficient */
+    {
+        return 4;                                                    /* return error */
+    }
+    
+    a_batch_run(a, b, &raw[0][0], &m_gauss[0][0], NULL, len);        /* run */
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief      convert and calibrate raw samples
+ * @param[in]  *cal points to a calibration structure
+ * @param[in]  scale is the full scale of the samples
+ * @param[in]  **raw points to a raw data array in the qmc5883l_read format
+ * @param[out] **out points to a calibrated data array in m_gauss
+ * @param[in]  len is the number of samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal or buffer is NULL
+ *             - 4 scale is invalid
+ * @note       same result as qmc5883l_calibration_apply on the qmc5883l_read output
+ */
+uint8_t qmc5883l_batch_calibrate(qmc5883l_calibration_t *cal, qmc5883l_full_scale_t scale,
+                                 const int16_t (*raw)[3], float (*out)[3], uint32_t len)
+{
+    float a[9];
+    float b[3];
+    
+    if ((cal == NULL) || (raw == NULL) || (out == NULL))         /* check buffer */
+    {
+        return 2;                                                /* return error */
+    }
+    if (a_batch_coefficient(cal, scale, a, b) != 0)              /* get coefficient */
+    {
+        return 4;                                                /* return error */
+    }
+    
+    a_batch_run(a, b, &raw[0][0], &out[0][0], NULL, len);        /* run */
+    
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief      convert and calibrate raw samples to fixed point
+ * @param[in]  *cal points to a calibration structure
+ * @param[in]  scale is the full scale of the samples
+ * @param[in]  **raw points to a raw data array in the qmc5883l_read format
+ * @param[out] **out points to a calibrated data array in m_gauss with QMC5883L_BATCH_FRAC_BITS fractional bits
+ * @param[in]  len is the number of samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal or buffer is NULL
+ *             - 4 scale is invalid
+ * @note       values are rounded half away from zero
+ */
+uint8_t qmc5883l_batch_calibrate_fixed(qmc5883l_calibration_t *cal, qmc5883l_full_scale_t scale,
+                                       const int16_t (*raw)[3], int32_t (*out)[3], uint32_t len)
+{
+    float a[9];
+    float b[3];
+    
+    if ((cal == NULL) || (raw == NULL) || (out == NULL))         /* check buffer */
+    {
+        return 2;                                                /* return error */
+    }
+    if (a_batch_coefficient(cal, scale, a, b) != 0)              /* get coefficient */
+    {
+        return 4;                                                /* return error */
+    }
+    
+    a_batch_run(a, b, &raw[0][0], NULL, &out[0][0], len);        /* run */
+    
+    return 0;                                                    /* success return 0 */
+}
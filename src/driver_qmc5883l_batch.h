@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_batch.h
+ * @brief     driver qmc5883l batch header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_BATCH_H
+#define DRIVER_QMC5883L_BATCH_H
+
+#include "driver_qmc5883l_calibration.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_batch_driver qmc5883l batch driver function
+ * @brief    qmc5883l batch driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l batch definition
+ */
+#define QMC5883L_BATCH_FRAC_BITS        8        /**< fractional bits of the fixed point output */
+
+/**
+ * @brief qmc5883l batch kernel enumeration definition
+ */
+typedef enum
+{
+    QMC5883L_BATCH_KERNEL_SCALAR = 0x00,        /**< portable c kernel */
+    QMC5883L_BATCH_KERNEL_SSE2   = 0x01,        /**< x86 sse2 kernel */
+    QMC5883L_BATCH_KERNEL_AVX2   = 0x02,        /**< x86 avx2 kernel */
+    QMC5883L_BATCH_KERNEL_NEON   = 0x03,        /**< arm neon kernel */
+} qmc5883l_batch_kernel_t;
+
+/**
+ * @brief      get the fastest kernel of the build
+ * @param[out] *kernel points to a kernel buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 kernel is NULL
+ * @note       the kernel is chosen at compile time, build with -mavx2 to enable avx2
+ */
+uint8_t qmc5883l_batch_get_native_kernel(qmc5883l_batch_kernel_t *kernel);
+
+/**
+ * @brief     set the batch kernel
+ * @param[in] kernel is the used kernel
+ * @return    status code
+ *            - 0 success
+ *            - 4 kernel is not built
+ * @note      the native kernel is used by default
+ */
+uint8_t qmc5883l_batch_set_kernel(qmc5883l_batch_kernel_t kernel);
+
+/**
+ * @brief      get the batch kernel
+ * @param[out] *kernel points to a kernel buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 kernel is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_batch_get_kernel(qmc5883l_batch_kernel_t *kernel);
+
+/**
+ * @brief      convert raw samples to m_gauss
+ * @param[in]  scale is the full scale of the samples
+ * @param[in]  **raw points to a raw data array in the qmc5883l_read format
+ * @param[out] **m_gauss points to a converted data array
+ * @param[in]  len is the number of samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ *             - 4 scale is invalid
+ * @note       none
+ */
+uint8_t qmc5883l_batch_convert(qmc5883l_full_scale_t scale, const int16_t (*raw)[3], float (*m_gauss)[3], uint32_t len);
+
+/**
+ * @brief      convert and calibrate raw samples
+ * @param[in]  *cal points to a calibration structure
+ * @param[in]  scale is the full scale of the samples
+ * @param[in]  **raw points to a raw data array in the qmc5883l_read format
+ * @param[out] **out points to a calibrated data array in m_gauss
+ * @param[in]  len is the number of samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal or buffer is NULL
+ *             - 4 scale is invalid
+ * @note       same result as qmc5883l_calibration_apply on the qmc5883l_read output
+ */
+uint8_t qmc5883l_batch_calibrate(qmc5883l_calibration_t *cal, qmc5883l_full_scale_t scale,
+                                 const int16_t (*raw)[3], float (*out)[3], uint32_t len);
+
+/**
+ * @brief      convert and calibrate raw samples to fixed point
+ * @param[in]  *cal points to a calibration structure
+ * @param[in]  scale is the full scale of the samples
+ * @param[in]  **raw points to a raw data array in the qmc5883l_read format
+ * @param[out] **out points to a calibrated data array in m_gauss with QMC5883L_BATCH_FRAC_BITS fractional bits
+ * @param[in]  len is the number of samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal or buffer is NULL
+ *             - 4 scale is invalid
+ * @note       values are rounded half away from zero
+ */
+uint8_t qmc5883l_batch_calibrate_fixed(qmc5883l_calibration_t *cal, qmc5883l_full_scale_t scale,
+                                       const int16_t (*raw)[3], int32_t (*out)[3], uint32_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,386 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_binlog.c
+ * @brief     driver qmc5883l binlog source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_binlog.h"
+
+/**
+ * @brief crc-16/ccitt nibble table
+ */
+static const uint16_t gs_crc_table[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/**
+ * @brief     update a crc-16/ccitt
+ * @param[in] crc is the running crc
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    updated crc
+ * @note      none
+ */
+static uint16_t a_binlog_crc(uint16_t crc, const uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    for (i = 0; i < len; i++)                                                              /* each byte */
+    {
+        crc = (uint16_t)((crc << 4) ^ gs_crc_table[(crc >> 12) ^ (buf[i] >> 4)]);          /* high nibble */
+        crc = (uint16_t)((crc << 4) ^ gs_crc_table[(crc >> 12) ^ (buf[i] & 0x0F)]);        /* low nibble */
+    }
+    
+    return crc;                                                                            /* return crc */
+}
+
+/**
+ * @brief     crc of a block
+ * @param[in] *block points to a block buffer
+ * @param[in] size is the block length
+ * @return    block crc
+ * @note      covers the whole block except the crc field
+ */
+static uint16_t a_binlog_block_crc(const uint8_t *block, uint16_t size)
+{
+    uint16_t crc;
+    
+    crc = a_binlog_crc(0xFFFF, block, QMC5883L_BINLOG_HEADER - 2);                                              /* header */
+    
+    return a_binlog_crc(crc, block + QMC5883L_BINLOG_HEADER, (uint16_t)(size - QMC5883L_BINLOG_HEADER));        /* payload */
+}
+
+/**
+ * @brief     put a little endian value
+ * @param[in] *buf points to a data buffer
+ * @param[in] v is the value
+ * @param[in] len is the value length
+ * @note      none
+ */
+static void a_binlog_put(uint8_t *buf, uint64_t v, uint8_t len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < len; i++)                    /* each byte */
+    {
+        buf[i] = (uint8_t)(v >> (8 * i));        /* low byte first */
+    }
+}
+
+/**
+ * @brief     get a little endian value
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the value length
+ * @return    value
+ * @note      none
+ */
+static uint64_t a_binlog_get(const uint8_t *buf, uint8_t len)
+{
+    uint64_t v = 0;
+    uint8_t i;
+    
+    for (i = 0; i < len; i++)                    /* each byte */
+    {
+        v |= (uint64_t)buf[i] << (8 * i);        /* low byte first */
+    }
+    
+    return v;                                    /* return value */
+}
+
+/**
+ * @brief     close the open block and hand it to the sink
+ * @param[in] *binlog points to a binlog structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 block write failed
+ * @note      the block is reset even when the write fails
+ */
+static uint8_t a_binlog_close(qmc5883l_binlog_t *binlog)
+{
+    uint8_t *b = binlog->block;
+    uint8_t res;
+    
+    memset(b + binlog->used, 0, binlog->size - binlog->used);                       /* clear the tail */
+    b[0] = 'Q';                                                                     /* magic */
+    b[1] = 'L';                                                                     /* magic */
+    b[2] = QMC5883L_BINLOG_VERSION;                                                 /* version */
+    b[3] = 0;                                                                       /* reserved */
+    a_binlog_put(b + 4, binlog->seq, 4);                                            /* sequence */
+    a_binlog_put(b + 8, binlog->first_us, 8);                                       /* first time */
+    a_binlog_put(b + 16, (uint32_t)(binlog->last_us - binlog->first_us), 4);        /* time span */
+    a_binlog_put(b + 20, binlog->count, 2);                                         /* sample count */
+    a_binlog_put(b + 22, binlog->used, 2);                                          /* used length */
+    a_binlog_put(b + 30, a_binlog_block_crc(b, binlog->size), 2);                   /* crc */
+    res = binlog->write(b, binlog->size);                                           /* write block */
+    binlog->seq++;                                                                  /* next sequence */
+    binlog->count = 0;                                                              /* empty block */
+    binlog->used = QMC5883L_BINLOG_HEADER;                                          /* payload start */
+    
+    return (res != 0) ? 1 : 0;                                                      /* return result */
+}
+
+/**
+ * @brief      initialize the log writer
+ * @param[out] *binlog points to a binlog structure
+ * @param[in]  *block points to a block buffer
+ * @param[in]  size is the block length
+ * @param[in]  *write points to a block sink that gets every finished block
+ * @return     status code
+ *             - 0 success
+ *             - 2 binlog, block or write is NULL
+ *             - 4 size is invalid
+ * @note       size must be in [QMC5883L_BINLOG_MIN_BLOCK, QMC5883L_BINLOG_MAX_BLOCK], a page of the flash fits well
+ */
+uint8_t qmc5883l_binlog_init(qmc5883l_binlog_t *binlog, uint8_t *block, uint16_t size,
+                             uint8_t (*write)(const uint8_t *block, uint16_t len))
+{
+    if ((binlog == NULL) || (block == NULL) || (write == NULL))                          /* check buffer */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if ((size < QMC5883L_BINLOG_MIN_BLOCK) || (size > QMC5883L_BINLOG_MAX_BLOCK))        /* check size */
+    {
+        return 4;                                                                        /* return error */
+    }
+    
+    memset(binlog, 0, sizeof(qmc5883l_binlog_t));                                        /* clear all */
+    binlog->block = block;                                                               /* set block */
+    binlog->write = write;                                                               /* set sink */
+    binlog->size = size;                                                                 /* set size */
+    binlog->used = QMC5883L_BINLOG_HEADER;                                               /* payload start */
+    binlog->inited = 1;                                                                  /* flag inited */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     log one sample
+ * @param[in] *binlog points to a binlog structure
+ * @param[in] time_us is the sample time
+ * @param[in] *raw points to a raw data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 block write failed
+ *            - 2 binlog or raw is NULL
+ *            - 3 binlog is not initialized
+ * @note      the first sample of a block is stored whole, the others as zigzag varint deltas per axis,
+ *            a sample that does not fit closes the block and starts the next one
+ */
+uint8_t qmc5883l_binlog_push(qmc5883l_binlog_t *binlog, uint64_t time_us, const int16_t raw[3])
+{
+    uint8_t buf[QMC5883L_BINLOG_MAX_SAMPLE];
+    uint8_t len = 0;
+    uint8_t res = 0;
+    uint8_t a;
+    
+    if ((binlog == NULL) || (raw == NULL))                                        /* check buffer */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (binlog->inited != 1)                                                      /* check inited */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    if (binlog->count != 0)                                                       /* delta sample */
+    {
+        for (a = 0; a < 3; a++)                                                   /* each axis */
+        {
+            int32_t d = (int32_t)raw[a] - (int32_t)binlog->prev[a];
+            uint32_t z = ((uint32_t)d << 1) ^ (uint32_t)(-(int32_t)((uint32_t)d >> 31));
+            
+            while (z >= 0x80)                                                     /* more groups */
+            {
+                buf[len++] = (uint8_t)(z | 0x80);                                 /* low 7 bits and more */
+                z >>= 7;                                                          /* next group */
+            }
+            buf[len++] = (uint8_t)z;                                              /* last group */
+        }
+        if ((binlog->used + len > binlog->size) || (binlog->count == 0xFFFF) ||
+            (time_us - binlog->first_us > 0xFFFFFFFFULL))                         /* block is full */
+        {
+            res = a_binlog_close(binlog);                                         /* close block */
+        }
+        else
+        {
+            memcpy(binlog->block + binlog->used, buf, len);                       /* append deltas */
+            binlog->used = (uint16_t)(binlog->used + len);                        /* advance */
+            binlog->count++;                                                      /* one more */
+        }
+    }
+    if (binlog->count == 0)                                                       /* block anchor */
+    {
+        for (a = 0; a < 3; a++)                                                   /* each axis */
+        {
+            a_binlog_put(binlog->block + 24 + 2 * a, (uint16_t)raw[a], 2);        /* whole sample */
+        }
+        binlog->first_us = time_us;                                               /* first time */
+        binlog->count = 1;                                                        /* one sample */
+    }
+    binlog->prev[0] = raw[0];                                                     /* save x */
+    binlog->prev[1] = raw[1];                                                     /* save y */
+    binlog->prev[2] = raw[2];                                                     /* save z */
+    binlog->last_us = time_us;                                                    /* last time */
+    binlog->samples++;                                                            /* count sample */
+    
+    return res;                                                                   /* return result */
+}
+
+/**
+ * @brief     write the open block
+ * @param[in] *binlog points to a binlog structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 block write failed
+ *            - 2 binlog is NULL
+ *            - 3 binlog is not initialized
+ * @note      nothing is written when the block is empty
+ */
+uint8_t qmc5883l_binlog_flush(qmc5883l_binlog_t *binlog)
+{
+    if (binlog == NULL)                   /* check binlog */
+    {
+        return 2;                         /* return error */
+    }
+    if (binlog->inited != 1)              /* check inited */
+    {
+        return 3;                         /* return error */
+    }
+    if (binlog->count == 0)               /* empty block */
+    {
+        return 0;                         /* nothing to write */
+    }
+    
+    return a_binlog_close(binlog);        /* close block */
+}
+
+/**
+ * @brief      decode one block
+ * @param[in]  *block points to a block buffer
+ * @param[in]  size is the block length
+ * @param[out] *seq points to a block sequence buffer
+ * @param[out] **raw points to a raw data buffer
+ * @param[out] *time_us points to a sample time buffer, NULL skips the times
+ * @param[in]  max is the length of the raw and time buffers
+ * @param[out] *count points to a decoded sample count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 crc or format check failed
+ *             - 2 buffer is NULL
+ *             - 4 max is too small
+ * @note       sample times are spread evenly between the first and the last time of the block
+ */
+uint8_t qmc5883l_binlog_decode(const uint8_t *block, uint16_t size, uint32_t *seq, int16_t (*raw)[3],
+                               uint64_t *time_us, uint16_t max, uint16_t *count)
+{
+    uint64_t first;
+    uint32_t span;
+    uint16_t n;
+    uint16_t used;
+    uint16_t pos;
+    uint16_t i;
+    int32_t v[3];
+    uint8_t a;
+    
+    if ((block == NULL) || (seq == NULL) || (raw == NULL) || (count == NULL))                         /* check buffer */
+    {
+        return 2;                                                                                     /* return error */
+    }
+    if ((size < QMC5883L_BINLOG_MIN_BLOCK) || (size > QMC5883L_BINLOG_MAX_BLOCK) ||
+        (block[0] != 'Q') || (block[1] != 'L') || (block[2] != QMC5883L_BINLOG_VERSION))              /* check format */
+    {
+        return 1;                                                                                     /* return error */
+    }
+    if ((uint16_t)a_binlog_get(block + 30, 2) != a_binlog_block_crc(block, size))                     /* check crc */
+    {
+        return 1;                                                                                     /* return error */
+    }
+    n = (uint16_t)a_binlog_get(block + 20, 2);                                                        /* sample count */
+    used = (uint16_t)a_binlog_get(block + 22, 2);                                                     /* used length */
+    if ((n == 0) || (used < QMC5883L_BINLOG_HEADER) || (used > size))                                 /* check fields */
+    {
+        return 1;                                                                                     /* return error */
+    }
+    if (n > max)                                                                                      /* check max */
+    {
+        return 4;                                                                                     /* return error */
+    }
+    
+    *seq = (uint32_t)a_binlog_get(block + 4, 4);                                                      /* sequence */
+    first = a_binlog_get(block + 8, 8);                                                               /* first time */
+    span = (uint32_t)a_binlog_get(block + 16, 4);                                                     /* time span */
+    for (a = 0; a < 3; a++)                                                                           /* each axis */
+    {
+        v[a] = (int16_t)a_binlog_get(block + 24 + 2 * a, 2);                                          /* whole sample */
+        raw[0][a] = (int16_t)v[a];                                                                    /* first sample */
+    }
+    pos = QMC5883L_BINLOG_HEADER;                                                                     /* payload start */
+    for (i = 1; i < n; i++)                                                                           /* each delta sample */
+    {
+        for (a = 0; a < 3; a++)                                                                       /* each axis */
+        {
+            uint32_t z = 0;
+            uint8_t shift = 0;
+            uint8_t c;
+            
+            do
+            {
+                if ((pos >= used) || (shift > 14))                                                    /* check length */
+                {
+                    return 1;                                                                         /* return error */
+                }
+                c = block[pos++];                                                                     /* next group */
+                z |= (uint32_t)(c & 0x7F) << shift;                                                   /* add bits */
+                shift = (uint8_t)(shift + 7);                                                         /* next shift */
+            } while ((c & 0x80) != 0);
+            v[a] += (int32_t)(z >> 1) ^ -(int32_t)(z & 1);                                            /* undo zigzag */
+            raw[i][a] = (int16_t)v[a];                                                                /* save axis */
+        }
+    }
+    if (pos != used)                                                                                  /* check length */
+    {
+        return 1;                                                                                     /* return error */
+    }
+    if (time_us != NULL)                                                                              /* times wanted */
+    {
+        for (i = 0; i < n; i++)                                                                       /* each sample */
+        {
+            time_us[i] = first + ((n > 1) ? ((uint64_t)span * i + (n - 1) / 2) / (n - 1) : 0);        /* even spread */
+        }
+    }
+    *count = n;                                                                                       /* save count */
+    
+    return 0;                                                                                         /* success return 0 */
+}
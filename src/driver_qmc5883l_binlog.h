@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_binlog.h
+ * @brief     driver qmc5883l binlog header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_BINLOG_H
+#define DRIVER_QMC5883L_BINLOG_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_binlog_driver qmc5883l binlog driver function
+ * @brief    qmc5883l binlog driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l binlog definition
+ * @note  little endian block header: "QL", version, reserved, sequence u32, first time u64 in us,
+ *        time span u32 in us, sample count u16, used length u16, first sample 3 x s16, crc-16/ccitt u16,
+ *        then one zigzag leb128 varint per axis delta for every further sample, zero padded
+ */
+#define QMC5883L_BINLOG_VERSION         1          /**< block format version */
+#define QMC5883L_BINLOG_HEADER          32         /**< block header length */
+#define QMC5883L_BINLOG_MIN_BLOCK       64         /**< min block length */
+#define QMC5883L_BINLOG_MAX_BLOCK       4096       /**< max block length */
+#define QMC5883L_BINLOG_MAX_SAMPLE      9          /**< max encoded bytes of one sample */
+
+/**
+ * @brief qmc5883l binlog structure definition
+ */
+typedef struct qmc5883l_binlog_s
+{
+    uint8_t *block;                                            /**< block buffer */
+    uint8_t (*write)(const uint8_t *block, uint16_t len);      /**< full block sink */
+    uint64_t first_us;                                         /**< time of the first block sample */
+    uint64_t last_us;                                          /**< time of the last block sample */
+    uint64_t samples;                                          /**< logged samples */
+    uint32_t seq;                                              /**< next block sequence */
+    uint16_t size;                                             /**< block length */
+    uint16_t used;                                             /**< next payload byte */
+    uint16_t count;                                            /**< block samples */
+    int16_t prev[3];                                           /**< last sample */
+    uint8_t inited;                                            /**< inited flag */
+} qmc5883l_binlog_t;
+
+/**
+ * @brief      initialize the log writer
+ * @param[out] *binlog points to a binlog structure
+ * @param[in]  *block points to a block buffer
+ * @param[in]  size is the block length
+ * @param[in]  *write points to a block sink that gets every finished block
+ * @return     status code
+ *             - 0 success
+ *             - 2 binlog, block or write is NULL
+ *             - 4 size is invalid
+ * @note       size must be in [QMC5883L_BINLOG_MIN_BLOCK, QMC5883L_BINLOG_MAX_BLOCK], a page of the flash fits well
+ */
+uint8_t qmc5883l_binlog_init(qmc5883l_binlog_t *binlog, uint8_t *block, uint16_t size,
+                             uint8_t (*write)(const uint8_t *block, uint16_t len));
+
+/**
+ * @brief     log one sample
+ * @param[in] *binlog points to a binlog structure
+ * @param[in] time_us is the sample time
+ * @param[in] *raw points to a raw data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 block write failed
+ *            - 2 binlog or raw is NULL
+ *            - 3 binlog is not initialized
+ * @note      the first sample of a block is stored whole, the others as zigzag varint deltas per axis,
+ *            a sample that does not fit closes the block and starts the next one
+ */
+uint8_t qmc5883l_binlog_push(qmc5883l_binlog_t *binlog, uint64_t time_us, const int16_t raw[3]);
+
+/**
+ * @brief     write the open block
+ * @param[in] *binlog points to a binlog structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 block write failed
+ *            - 2 binlog is NULL
+ *            - 3 binlog is not initialized
+ * @note      nothing is written when the block is empty
+ */
+uint8_t qmc5883l_binlog_flush(qmc5883l_binlog_t *binlog);
+
+/**
+ * @brief      decode one block
+ * @param[in]  *block points to a block buffer
+ * @param[in]  size is the block length
+ * @param[out] *seq points to a block sequence buffer
+ * @param[out] **raw points to a raw data buffer
+ * @param[out] *time_us points to a sample time buffer, NULL skips the times
+ * @param[in]  max is the length of the raw and time buffers
+ * @param[out] *count points to a decoded sample count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 crc or format check failed
+ *             - 2 buffer is NULL
+ *             - 4 max is too small
+ * @note       sample times are spread evenly between the first and the last time of the block
+ */
+uint8_t qmc5883l_binlog_decode(const uint8_t *block, uint16_t size, uint32_t *seq, int16_t (*raw)[3],
+                               uint64_t *time_us, uint16_t max, uint16_t *count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
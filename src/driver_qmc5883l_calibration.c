@@ -0,0 +1,508 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_calibration.c
+ * @brief     driver qmc5883l calibration source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_calibration.h"
+#include <math.h>
+
+/**
+ * @brief calibration definition
+ */
+#define CALIBRATION_SCALE              0.001        /**< m_gauss to gauss, keeps the sums well conditioned */
+#define CALIBRATION_EPSILON            1e-12        /**< singular pivot threshold */
+#define CALIBRATION_JACOBI_SWEEPS      32           /**< max jacobi sweeps */
+
+/**
+ * @brief      solve the 9x9 normal equations
+ * @param[in]  *cal points to a calibration structure
+ * @param[out] *p points to a parameter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 matrix is singular
+ * @note       gaussian elimination with partial pivoting
+ */
+static uint8_t a_calibration_solve_normal(qmc5883l_calibration_t *cal, double p[9])
+{
+    double m[9][10];
+    double max;
+    uint8_t i;
+    uint8_t j;
+    uint8_t k;
+    uint8_t n;
+    
+    n = 0;                                                           /* init 0 */
+    for (i = 0; i < 9; i++)                                          /* build the matrix */
+    {
+        for (j = i; j < 9; j++)                                      /* upper triangle */
+        {
+            m[i][j] = cal->sum_dd[n];                                /* set upper */
+            m[j][i] = cal->sum_dd[n];                                /* set lower */
+            n++;                                                     /* next */
+        }
+        m[i][9] = cal->sum_d[i];                                     /* set right side */
+    }
+    max = 0.0;                                                       /* init 0 */
+    for (i = 0; i < 9; i++)                                          /* find the max diagonal */
+    {
+        if (m[i][i] > max)                                           /* check diagonal */
+        {
+            max = m[i][i];                                           /* save max */
+        }
+    }
+    for (k = 0; k < 9; k++)                                          /* eliminate */
+    {
+        uint8_t pivot;
+        
+        pivot = k;                                                   /* init pivot */
+        for (i = k + 1; i < 9; i++)                                  /* find the pivot */
+        {
+            if (fabs(m[i][k]) > fabs(m[pivot][k]))                   /* check row */
+            {
+                pivot = i;                                           /* save pivot */
+            }
+        }
+        if (fabs(m[pivot][k]) <= (max * CALIBRATION_EPSILON))        /* check singular */
+        {
+            return 1;                                                /* return error */
+        }
+        if (pivot != k)                                              /* check swap */
+        {
+            for (j = k; j < 10; j++)                                 /* swap rows */
+            {
+                double t;
+                
+                t = m[k][j];                                         /* save */
+                m[k][j] = m[pivot][j];                               /* swap */
+                m[pivot][j] = t;                                     /* restore */
+            }
+        }
+        for (i = k + 1; i < 9; i++)                                  /* clear the column */
+        {
+            double f;
+            
+            f = m[i][k] / m[k][k];                                   /* get factor */
+            for (j = k; j < 10; j++)                                 /* row */
+            {
+                m[i][j] -= f * m[k][j];                              /* subtract */
+            }
+        }
+    }
+    for (k = 9; k > 0; k--)                                          /* back substitution */
+    {
+        double s;
+        
+        s = m[k - 1][9];                                             /* right side */
+        for (j = k; j < 9; j++)                                      /* known params */
+        {
+            s -= m[k - 1][j] * p[j];                                 /* subtract */
+        }
+        p[k - 1] = s / m[k - 1][k - 1];                              /* set param */
+    }
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief         jacobi eigen decomposition of a symmetric 3x3 matrix
+ * @param[in,out] *a points to a matrix buffer, the diagonal holds the eigenvalues
+ * @param[out]    *v points to an eigenvector buffer, one vector per column
+ * @note          none
+ */
+static void a_calibration_jacobi(double a[3][3], double v[3][3])
+{
+    uint8_t sweep;
+    uint8_t i;
+    uint8_t j;
+    
+    for (i = 0; i < 3; i++)                                                                        /* identity */
+    {
+        for (j = 0; j < 3; j++)                                                                    /* column */
+        {
+            v[i][j] = (i == j) ? 1.0 : 0.0;                                                        /* set */
+        }
+    }
+    for (sweep = 0; sweep < CALIBRATION_JACOBI_SWEEPS; sweep++)                                    /* sweeps */
+    {
+        uint8_t p;
+        double off;
+        
+        off = fabs(a[0][1]) + fabs(a[0][2]) + fabs(a[1][2]);                                       /* off diagonal */
+        if (off <= (CALIBRATION_EPSILON * (fabs(a[0][0]) + fabs(a[1][1]) + fabs(a[2][2]))))        /* check converged */
+        {
+            break;                                                                                 /* break */
+        }
+        for (p = 0; p < 3; p++)                                                                    /* rotate each pair */
+        {
+            uint8_t q;
+            uint8_t k;
+            double theta;
+            double t;
+            double c;
+            double s;
+            
+            q = (p == 2) ? 0 : (p + 1);                                                            /* pair */
+            i = (p < q) ? p : q;                                                                   /* row */
+            j = (p < q) ? q : p;                                                                   /* column */
+            if (a[i][j] == 0.0)                                                                    /* check zero */
+            {
+                continue;                                                                          /* skip */
+            }
+            theta = (a[j][j] - a[i][i]) / (2.0 * a[i][j]);                                         /* rotation angle */
+            t = ((theta >= 0.0) ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta * theta + 1.0));         /* tangent */
+            c = 1.0 / sqrt(t * t + 1.0);                                                           /* cosine */
+            s = t * c;                                                                             /* sine */
+            for (k = 0; k < 3; k++)                                                                /* rotate columns */
+            {
+                double ki;
+                double kj;
+                
+                ki = a[k][i];                                                                      /* save */
+                kj = a[k][j];                                                                      /* save */
+                a[k][i] = c * ki - s * kj;                                                         /* set */
+                a[k][j] = s * ki + c * kj;                                                         /* set */
+            }
+            for (k = 0; k < 3; k++)                                                                /* rotate rows */
+            {
+                double ik;
+                double jk;
+                
+                ik = a[i][k];                                                                      /* save */
+                jk = a[j][k];                                                                      /* save */
+                a[i][k] = c * ik - s * jk;                                                         /* set */
+                a[j][k] = s * ik + c * jk;                                                         /* set */
+            }
+            for (k = 0; k < 3; k++)                                                                /* rotate vectors */
+            {
+                double ki;
+                double kj;
+                
+                ki = v[k][i];                                                                      /* save */
+                kj = v[k][j];                                                                      /* save */
+                v[k][i] = c * ki - s * kj;                                                         /* set */
+                v[k][j] = s * ki + c * kj;                                                         /* set */
+            }
+        }
+    }
+}
+
+/**
+ * @brief      initialize the calibration
+ * @param[out] *cal points to a calibration structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal is NULL
+ * @note       the offset is cleared and the matrix is set to the identity
+ */
+uint8_t qmc5883l_calibration_init(qmc5883l_calibration_t *cal)
+{
+    if (cal == NULL)                                       /* check cal */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    memset(cal, 0, sizeof(qmc5883l_calibration_t));        /* clear all */
+    cal->matrix[0][0] = 1.0f;                              /* set identity */
+    cal->matrix[1][1] = 1.0f;                              /* set identity */
+    cal->matrix[2][2] = 1.0f;                              /* set identity */
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief     clear the accumulated samples
+ * @param[in] *cal points to a calibration structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 cal is NULL
+ * @note      the current offset and matrix are kept
+ */
+uint8_t qmc5883l_calibration_reset(qmc5883l_calibration_t *cal)
+{
+    if (cal == NULL)                                    /* check cal */
+    {
+        return 2;                                       /* return error */
+    }
+    
+    memset(cal->sum_dd, 0, sizeof(cal->sum_dd));        /* clear normal matrix */
+    memset(cal->sum_d, 0, sizeof(cal->sum_d));          /* clear right side */
+    cal->count = 0;                                     /* clear count */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     add a sample to the fit
+ * @param[in] *cal points to a calibration structure
+ * @param[in] *m_gauss points to an uncalibrated data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 cal is NULL
+ * @note      the sample is not stored, only the normal equation sums are updated
+ */
+uint8_t qmc5883l_calibration_update(qmc5883l_calibration_t *cal, const float m_gauss[3])
+{
+    double x;
+    double y;
+    double z;
+    double d[9];
+    uint8_t i;
+    uint8_t j;
+    uint8_t n;
+    
+    if (cal == NULL)                                   /* check cal */
+    {
+        return 2;                                      /* return error */
+    }
+    
+    x = (double)m_gauss[0] * CALIBRATION_SCALE;        /* scale x */
+    y = (double)m_gauss[1] * CALIBRATION_SCALE;        /* scale y */
+    z = (double)m_gauss[2] * CALIBRATION_SCALE;        /* scale z */
+    d[0] = x * x;                                      /* x^2 */
+    d[1] = y * y;                                      /* y^2 */
+    d[2] = z * z;                                      /* z^2 */
+    d[3] = 2.0 * x * y;                                /* 2xy */
+    d[4] = 2.0 * x * z;                                /* 2xz */
+    d[5] = 2.0 * y * z;                                /* 2yz */
+    d[6] = 2.0 * x;                                    /* 2x */
+    d[7] = 2.0 * y;                                    /* 2y */
+    d[8] = 2.0 * z;                                    /* 2z */
+    n = 0;                                             /* init 0 */
+    for (i = 0; i < 9; i++)                            /* accumulate */
+    {
+        for (j = i; j < 9; j++)                        /* upper triangle */
+        {
+            cal->sum_dd[n] += d[i] * d[j];             /* add product */
+            n++;                                       /* next */
+        }
+        cal->sum_d[i] += d[i];                         /* add right side */
+    }
+    cal->count++;                                      /* count */
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief     solve the ellipsoid fit
+ * @param[in] *cal points to a calibration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 fit failed
+ *            - 2 cal is NULL
+ *            - 4 not enough samples
+ * @note      the fit fails when the samples do not span an ellipsoid, the previous result is kept
+ */
+uint8_t qmc5883l_calibration_solve(qmc5883l_calibration_t *cal)
+{
+    double p[9];
+    double a[3][3];
+    double inv[3][3];
+    double v[3][3];
+    double c[3];
+    double det;
+    double k;
+    double r;
+    uint8_t i;
+    uint8_t j;
+    
+    if (cal == NULL)                                                                   /* check cal */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (cal->count < QMC5883L_CALIBRATION_MIN_SAMPLES)                                 /* check count */
+    {
+        return 4;                                                                      /* return error */
+    }
+    
+    if (a_calibration_solve_normal(cal, p) != 0)                                       /* solve the normal equations */
+    {
+        return 1;                                                                      /* return error */
+    }
+    a[0][0] = p[0];                                                                    /* set xx */
+    a[1][1] = p[1];                                                                    /* set yy */
+    a[2][2] = p[2];                                                                    /* set zz */
+    a[0][1] = p[3];                                                                    /* set xy */
+    a[1][0] = p[3];                                                                    /* set yx */
+    a[0][2] = p[4];                                                                    /* set xz */
+    a[2][0] = p[4];                                                                    /* set zx */
+    a[1][2] = p[5];                                                                    /* set yz */
+    a[2][1] = p[5];                                                                    /* set zy */
+    inv[0][0] = a[1][1] * a[2][2] - a[1][2] * a[2][1];                                 /* cofactor 00 */
+    inv[0][1] = a[0][2] * a[2][1] - a[0][1] * a[2][2];                                 /* cofactor 01 */
+    inv[0][2] = a[0][1] * a[1][2] - a[0][2] * a[1][1];                                 /* cofactor 02 */
+    inv[1][0] = a[1][2] * a[2][0] - a[1][0] * a[2][2];                                 /* cofactor 10 */
+    inv[1][1] = a[0][0] * a[2][2] - a[0][2] * a[2][0];                                 /* cofactor 11 */
+    inv[1][2] = a[0][2] * a[1][0] - a[0][0] * a[1][2];                                 /* cofactor 12 */
+    inv[2][0] = a[1][0] * a[2][1] - a[1][1] * a[2][0];                                 /* cofactor 20 */
+    inv[2][1] = a[0][1] * a[2][0] - a[0][0] * a[2][1];                                 /* cofactor 21 */
+    inv[2][2] = a[0][0] * a[1][1] - a[0][1] * a[1][0];                                 /* cofactor 22 */
+    det = a[0][0] * inv[0][0] + a[0][1] * inv[1][0] + a[0][2] * inv[2][0];             /* determinant */
+    if (det <= 0.0)                                                                    /* check ellipsoid */
+    {
+        return 1;                                                                      /* return error */
+    }
+    for (i = 0; i < 3; i++)                                                            /* center */
+    {
+        c[i] = -(inv[i][0] * p[6] + inv[i][1] * p[7] + inv[i][2] * p[8]) / det;        /* c = -a^-1 * v */
+    }
+    k = 1.0;                                                                           /* init 1 */
+    for (i = 0; i < 3; i++)                                                            /* k = 1 + c' * a * c */
+    {
+        for (j = 0; j < 3; j++)                                                        /* column */
+        {
+            k += c[i] * a[i][j] * c[j];                                                /* add */
+        }
+    }
+    if (k <= 0.0)                                                                      /* check ellipsoid */
+    {
+        return 1;                                                                      /* return error */
+    }
+    for (i = 0; i < 3; i++)                                                            /* normalize */
+    {
+        for (j = 0; j < 3; j++)                                                        /* column */
+        {
+            a[i][j] /= k;                                                              /* divide */
+        }
+    }
+    a_calibration_jacobi(a, v);                                                        /* eigen decomposition */
+    if ((a[0][0] <= 0.0) || (a[1][1] <= 0.0) || (a[2][2] <= 0.0))                      /* check axes */
+    {
+        return 1;                                                                      /* return error */
+    }
+    r = pow(a[0][0] * a[1][1] * a[2][2], -1.0 / 6.0);                                  /* geometric mean radius */
+    for (i = 0; i < 3; i++)                                                            /* w = r * v * sqrt(l) * v' */
+    {
+        for (j = 0; j < 3; j++)                                                        /* column */
+        {
+            double s;
+            
+            s = v[i][0] * sqrt(a[0][0]) * v[j][0]
+              + v[i][1] * sqrt(a[1][1]) * v[j][1]
+              + v[i][2] * sqrt(a[2][2]) * v[j][2];                                     /* sum */
+            cal->matrix[i][j] = (float)(r * s);                                        /* set matrix */
+        }
+        cal->offset[i] = (float)(c[i] / CALIBRATION_SCALE);                            /* set offset */
+    }
+    cal->radius = (float)(r / CALIBRATION_SCALE);                                      /* set radius */
+    cal->solved = 1;                                                                   /* set solved */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      apply the calibration
+ * @param[in]  *cal points to a calibration structure
+ * @param[in]  *m_gauss points to an uncalibrated data buffer
+ * @param[out] *out points to a calibrated data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal is NULL
+ * @note       m_gauss and out may be the same buffer
+ */
+uint8_t qmc5883l_calibration_apply(qmc5883l_calibration_t *cal, const float m_gauss[3], float out[3])
+{
+    float x;
+    float y;
+    float z;
+    
+    if (cal == NULL)                                                                       /* check cal */
+    {
+        return 2;                                                                          /* return error */
+    }
+    
+    x = m_gauss[0] - cal->offset[0];                                                       /* remove x offset */
+    y = m_gauss[1] - cal->offset[1];                                                       /* remove y offset */
+    z = m_gauss[2] - cal->offset[2];                                                       /* remove z offset */
+    out[0] = cal->matrix[0][0] * x + cal->matrix[0][1] * y + cal->matrix[0][2] * z;        /* correct x */
+    out[1] = cal->matrix[1][0] * x + cal->matrix[1][1] * y + cal->matrix[1][2] * z;        /* correct y */
+    out[2] = cal->matrix[2][0] * x + cal->matrix[2][1] * y + cal->matrix[2][2] * z;        /* correct z */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the calibration
+ * @param[in]  *cal points to a calibration structure
+ * @param[out] *offset points to an offset buffer
+ * @param[out] *matrix points to a matrix buffer
+ * @param[out] *radius points to a radius buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal is NULL
+ *             - 3 cal is not solved
+ * @note       none
+ */
+uint8_t qmc5883l_calibration_get(qmc5883l_calibration_t *cal, float offset[3], float matrix[3][3], float *radius)
+{
+    if (cal == NULL)                                       /* check cal */
+    {
+        return 2;                                          /* return error */
+    }
+    if (cal->solved != 1)                                  /* check solved */
+    {
+        return 3;                                          /* return error */
+    }
+    
+    memcpy(offset, cal->offset, sizeof(float) * 3);        /* copy offset */
+    memcpy(matrix, cal->matrix, sizeof(float) * 9);        /* copy matrix */
+    *radius = cal->radius;                                 /* copy radius */
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the calibration
+ * @param[in] *cal points to a calibration structure
+ * @param[in] *offset points to an offset buffer
+ * @param[in] *matrix points to a matrix buffer
+ * @param[in] radius is the field radius in m_gauss
+ * @return    status code
+ *            - 0 success
+ *            - 2 cal is NULL
+ * @note      used to restore a stored calibration
+ */
+uint8_t qmc5883l_calibration_set(qmc5883l_calibration_t *cal, const float offset[3], const float matrix[3][3], float radius)
+{
+    if (cal == NULL)                                       /* check cal */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    memcpy(cal->offset, offset, sizeof(float) * 3);        /* copy offset */
+    memcpy(cal->matrix, matrix, sizeof(float) * 9);        /* copy matrix */
+    cal->radius = radius;                                  /* copy radius */
+    cal->solved = 1;                                       /* set solved */
+    
+    return 0;                                              /* success return 0 */
+}
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_calibration.h
+ * @brief     driver qmc5883l calibration header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_CALIBRATION_H
+#define DRIVER_QMC5883L_CALIBRATION_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_calibration_driver qmc5883l calibration driver function
+ * @brief    qmc5883l calibration driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l calibration definition
+ */
+#define QMC5883L_CALIBRATION_MIN_SAMPLES        32        /**< min samples to solve the fit */
+
+/**
+ * @brief qmc5883l calibration structure definition
+ */
+typedef struct qmc5883l_calibration_s
+{
+    double sum_dd[45];        /**< upper triangle of the normal matrix */
+    double sum_d[9];          /**< right side of the normal equations */
+    uint32_t count;           /**< accumulated samples */
+    float offset[3];          /**< hard iron offset in m_gauss */
+    float matrix[3][3];       /**< soft iron matrix */
+    float radius;             /**< fitted field radius in m_gauss */
+    uint8_t solved;           /**< solved flag */
+} qmc5883l_calibration_t;
+
+/**
+ * @brief      initialize the calibration
+ * @param[out] *cal points to a calibration structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal is NULL
+ * @note       the offset is cleared and the matrix is set to the identity
+ */
+uint8_t qmc5883l_calibration_init(qmc5883l_calibration_t *cal);
+
+/**
+ * @brief     clear the accumulated samples
+ * @param[in] *cal points to a calibration structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 cal is NULL
+ * @note      the current offset and matrix are kept
+ */
+uint8_t qmc5883l_calibration_reset(qmc5883l_calibration_t *cal);
+
+/**
+ * @brief     add a sample to the fit
+ * @param[in] *cal points to a calibration structure
+ * @param[in] *m_gauss points to an uncalibrated data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 cal is NULL
+ * @note      the sample is not stored, only the normal equation sums are updated
+ */
+uint8_t qmc5883l_calibration_update(qmc5883l_calibration_t *cal, const float m_gauss[3]);
+
+/**
+ * @brief     solve the ellipsoid fit
+ * @param[in] *cal points to a calibration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 fit failed
+ *            - 2 cal is NULL
+ *            - 4 not enough samples
+ * @note      the fit fails when the samples do not span an ellipsoid, the previous result is kept
+ */
+uint8_t qmc5883l_calibration_solve(qmc5883l_calibration_t *cal);
+
+/**
+ * @brief      apply the calibration
+ * @param[in]  *cal points to a calibration structure
+ * @param[in]  *m_gauss points to an uncalibrated data buffer
+ * @param[out] *out points to a calibrated data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal is NULL
+ * @note       m_gauss and out may be the same buffer
+ */
+uint8_t qmc5883l_calibration_apply(qmc5883l_calibration_t *cal, const float m_gauss[3], float out[3]);
+
+/**
+ * @brief      get the calibration
+ * @param[in]  *cal points to a calibration structure
+ * @param[out] *offset points to an offset buffer
+ * @param[out] *matrix points to a matrix buffer
+ * @param[out] *radius points to a radius buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 cal is NULL
+ *             - 3 cal is not solved
+ * @note       none
+ */
+uint8_t qmc5883l_calibration_get(qmc5883l_calibration_t *cal, float offset[3], float matrix[3][3], float *radius);
+
+/**
+ * @brief     set the calibration
+ * @param[in] *cal points to a calibration structure
+ * @param[in] *offset points to an offset buffer
+ * @param[in] *matrix points to a matrix buffer
+ * @param[in] radius is the field radius in m_gauss
+ * @return    status code
+ *            - 0 success
+ *            - 2 cal is NULL
+ * @note      used to restore a stored calibration
+ */
+uint8_t qmc5883l_calibration_set(qmc5883l_calibration_t *cal, const float offset[3], const float matrix[3][3], float radius);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,287 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_change.c
+ * @brief     driver qmc5883l change source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_change.h"
+#include <math.h>
+
+/**
+ * @brief      initialize the change detector
+ * @param[out] *ch points to a change structure
+ * @param[in]  on is the deviation magnitude in m_gauss that starts a change
+ * @param[in]  off is the deviation magnitude in m_gauss that ends a change
+ * @param[in]  debounce_on is the number of samples above on before a rise
+ * @param[in]  debounce_off is the number of samples below off before a fall
+ * @param[in]  time_constant is the baseline time constant in samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 ch is NULL
+ *             - 4 threshold, debounce or time constant is invalid
+ * @note       off must be below on, the baseline is frozen during a change
+ */
+uint8_t qmc5883l_change_init(qmc5883l_change_t *ch, float on, float off, uint32_t debounce_on,
+                             uint32_t debounce_off, float time_constant)
+{
+    if (ch == NULL)                                                                 /* check ch */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if ((off <= 0.0f) || (on <= off))                                               /* check thresholds */
+    {
+        return 4;                                                                   /* return error */
+    }
+    if ((debounce_on == 0) || (debounce_off == 0) || (time_constant < 1.0f))        /* check debounce and time constant */
+    {
+        return 4;                                                                   /* return error */
+    }
+    
+    memset(ch, 0, sizeof(qmc5883l_change_t));                                       /* clear all */
+    ch->on2 = on * on;                                                              /* set on */
+    ch->off2 = off * off;                                                           /* set off */
+    ch->debounce_on = debounce_on;                                                  /* set debounce on */
+    ch->debounce_off = debounce_off;                                                /* set debounce off */
+    ch->alpha = 1.0f / time_constant;                                               /* set rate */
+    ch->inited = 1;                                                                 /* flag inited */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     forget the baseline and the counters
+ * @param[in] *ch points to a change structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 ch is NULL
+ *            - 3 ch is not initialized
+ * @note      the next sample becomes the baseline
+ */
+uint8_t qmc5883l_change_reset(qmc5883l_change_t *ch)
+{
+    if (ch == NULL)               /* check ch */
+    {
+        return 2;                 /* return error */
+    }
+    if (ch->inited != 1)          /* check ch initialization */
+    {
+        return 3;                 /* return error */
+    }
+    
+    ch->deviation2 = 0.0f;        /* clear deviation */
+    ch->run = 0;                  /* clear run */
+    ch->samples = 0;              /* clear samples */
+    ch->published = 0;            /* clear published */
+    ch->suppressed = 0;           /* clear suppressed */
+    ch->active = 0;               /* clear state */
+    ch->primed = 0;               /* forget baseline */
+    
+    return 0;                     /* success return 0 */
+}
+
+/**
+ * @brief      push a sample
+ * @param[in]  *ch points to a change structure
+ * @param[in]  *m_gauss points to a converted data buffer
+ * @param[out] *event points to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ch, m_gauss or event is NULL
+ *             - 3 ch is not initialized
+ * @note       only samples with an event need to be published
+ */
+uint8_t qmc5883l_change_push(qmc5883l_change_t *ch, const float m_gauss[3], qmc5883l_change_event_t *event)
+{
+    float d[3];
+    float d2;
+    uint8_t i;
+    
+    if ((ch == NULL) || (m_gauss == NULL) || (event == NULL))        /* check ch and buffers */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (ch->inited != 1)                                             /* check ch initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    
+    if (ch->primed == 0)                                             /* check baseline */
+    {
+        ch->baseline[0] = m_gauss[0];                                /* set x */
+        ch->baseline[1] = m_gauss[1];                                /* set y */
+        ch->baseline[2] = m_gauss[2];                                /* set z */
+        ch->primed = 1;                                              /* flag primed */
+    }
+    for (i = 0; i < 3; i++)                                          /* each axis */
+    {
+        d[i] = m_gauss[i] - ch->baseline[i];                         /* deviation */
+    }
+    d2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];                    /* squared magnitude */
+    ch->deviation2 = d2;                                             /* save deviation */
+    *event = QMC5883L_CHANGE_EVENT_NONE;                             /* init none */
+    if (ch->active == 0)                                             /* check idle */
+    {
+        ch->run = (d2 > ch->on2) ? (ch->run + 1) : 0;                /* count above on */
+        if (ch->run >= ch->debounce_on)                              /* check debounce */
+        {
+            ch->active = 1;                                          /* set active */
+            ch->run = 0;                                             /* clear run */
+            *event = QMC5883L_CHANGE_EVENT_RISE;                     /* rise */
+        }
+        else if (ch->run == 0)                                       /* check quiet */
+        {
+            for (i = 0; i < 3; i++)                                  /* each axis */
+            {
+                ch->baseline[i] += ch->alpha * d[i];                 /* follow slowly */
+            }
+        }
+    }
+    else
+    {
+        ch->run = (d2 < ch->off2) ? (ch->run + 1) : 0;               /* count below off */
+        if (ch->run >= ch->debounce_off)                             /* check debounce */
+        {
+            ch->active = 0;                                          /* set idle */
+            ch->run = 0;                                             /* clear run */
+            *event = QMC5883L_CHANGE_EVENT_FALL;                     /* fall */
+        }
+    }
+    ch->samples++;                                                   /* count sample */
+    if (*event != QMC5883L_CHANGE_EVENT_NONE)                        /* check event */
+    {
+        ch->published++;                                             /* count published */
+    }
+    else
+    {
+        ch->suppressed++;                                            /* count suppressed */
+    }
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief      read a sample and detect changes
+ * @param[in]  *handle points to a qmc5883l handle structure
+ * @param[in]  *ch points to a change structure
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a converted data buffer
+ * @param[out] *event points to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle, ch or event is NULL
+ *             - 3 handle or ch is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_change_read(qmc5883l_handle_t *handle, qmc5883l_change_t *ch, int16_t raw[3], float m_gauss[3],
+                             qmc5883l_change_event_t *event)
+{
+    uint8_t res;
+    
+    if ((ch == NULL) || (event == NULL))                    /* check ch and event */
+    {
+        return 2;                                           /* return error */
+    }
+    if (ch->inited != 1)                                    /* check ch initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    res = qmc5883l_read(handle, raw, m_gauss);              /* read data */
+    if (res != 0)                                           /* check result */
+    {
+        return res;                                         /* return error */
+    }
+    
+    return qmc5883l_change_push(ch, m_gauss, event);        /* detect */
+}
+
+/**
+ * @brief      get the baseline and the last deviation
+ * @param[in]  *ch points to a change structure
+ * @param[out] *baseline points to a baseline buffer
+ * @param[out] *deviation points to a deviation magnitude buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ch is NULL
+ *             - 3 ch has no sample yet
+ * @note       none
+ */
+uint8_t qmc5883l_change_get_baseline(qmc5883l_change_t *ch, float baseline[3], float *deviation)
+{
+    if (ch == NULL)                                    /* check ch */
+    {
+        return 2;                                      /* return error */
+    }
+    if ((ch->inited != 1) || (ch->primed != 1))        /* check ch baseline */
+    {
+        return 3;                                      /* return error */
+    }
+    
+    baseline[0] = ch->baseline[0];                     /* get x */
+    baseline[1] = ch->baseline[1];                     /* get y */
+    baseline[2] = ch->baseline[2];                     /* get z */
+    *deviation = sqrtf(ch->deviation2);                /* get deviation */
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the counters
+ * @param[in]  *ch points to a change structure
+ * @param[out] *samples points to a pushed samples buffer
+ * @param[out] *published points to a published events buffer
+ * @param[out] *suppressed points to a suppressed samples buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ch is NULL
+ *             - 3 ch is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_change_get_stats(qmc5883l_change_t *ch, uint32_t *samples, uint32_t *published, uint32_t *suppressed)
+{
+    if (ch == NULL)                      /* check ch */
+    {
+        return 2;                        /* return error */
+    }
+    if (ch->inited != 1)                 /* check ch initialization */
+    {
+        return 3;                        /* return error */
+    }
+    
+    *samples = ch->samples;              /* get samples */
+    *published = ch->published;          /* get published */
+    *suppressed = ch->suppressed;        /* get suppressed */
+    
+    return 0;                            /* success return 0 */
+}
@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_change.h
+ * @brief     driver qmc5883l change header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_CHANGE_H
+#define DRIVER_QMC5883L_CHANGE_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_change_driver qmc5883l change driver function
+ * @brief    qmc5883l change driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l change event enumeration definition
+ */
+typedef enum
+{
+    QMC5883L_CHANGE_EVENT_NONE = 0x00,        /**< suppressed sample */
+    QMC5883L_CHANGE_EVENT_RISE = 0x01,        /**< deviation rose above the on threshold */
+    QMC5883L_CHANGE_EVENT_FALL = 0x02,        /**< deviation fell below the off threshold */
+} qmc5883l_change_event_t;
+
+/**
+ * @brief qmc5883l change structure definition
+ */
+typedef struct qmc5883l_change_s
+{
+    float baseline[3];              /**< slow baseline in m_gauss */
+    float deviation2;               /**< last squared deviation magnitude */
+    float on2;                      /**< squared on threshold */
+    float off2;                     /**< squared off threshold */
+    float alpha;                    /**< baseline adaption rate */
+    uint32_t debounce_on;           /**< samples above on before a rise */
+    uint32_t debounce_off;          /**< samples below off before a fall */
+    uint32_t run;                   /**< samples towards the next event */
+    uint32_t samples;               /**< pushed samples */
+    uint32_t published;             /**< published events */
+    uint32_t suppressed;            /**< suppressed samples */
+    uint8_t active;                 /**< deviation state */
+    uint8_t primed;                 /**< baseline valid flag */
+    uint8_t inited;                 /**< inited flag */
+} qmc5883l_change_t;
+
+/**
+ * @brief      initialize the change detector
+ * @param[out] *ch points to a change structure
+ * @param[in]  on is the deviation magnitude in m_gauss that starts a change
+ * @param[in]  off is the deviation magnitude in m_gauss that ends a change
+ * @param[in]  debounce_on is the number of samples above on before a rise
+ * @param[in]  debounce_off is the number of samples below off before a fall
+ * @param[in]  time_constant is the baseline time constant in samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 ch is NULL
+ *             - 4 threshold, debounce or time constant is invalid
+ * @note       off must be below on, the baseline is frozen during a change
+ */
+uint8_t qmc5883l_change_init(qmc5883l_change_t *ch, float on, float off, uint32_t debounce_on,
+                             uint32_t debounce_off, float time_constant);
+
+/**
+ * @brief     forget the baseline and the counters
+ * @param[in] *ch points to a change structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 ch is NULL
+ *            - 3 ch is not initialized
+ * @note      the next sample becomes the baseline
+ */
+uint8_t qmc5883l_change_reset(qmc5883l_change_t *ch);
+
+/**
+ * @brief      push a sample
+ * @param[in]  *ch points to a change structure
+ * @param[in]  *m_gauss points to a converted data buffer
+ * @param[out] *event points to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ch, m_gauss or event is NULL
+ *             - 3 ch is not initialized
+ * @note       only samples with an event need to be published
+ */
+uint8_t qmc5883l_change_push(qmc5883l_change_t *ch, const float m_gauss[3], qmc5883l_change_event_t *event);
+
+/**
+ * @brief      read a sample and detect changes
+ * @param[in]  *handle points to a qmc5883l handle structure
+ * @param[in]  *ch points to a change structure
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a converted data buffer
+ * @param[out] *event points to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle, ch or event is NULL
+ *             - 3 handle or ch is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_change_read(qmc5883l_handle_t *handle, qmc5883l_change_t *ch, int16_t raw[3], float m_gauss[3],
+                             qmc5883l_change_event_t *event);
+
+/**
+ * @brief      get the baseline and the last deviation
+ * @param[in]  *ch points to a change structure
+ * @param[out] *baseline points to a baseline buffer
+ * @param[out] *deviation points to a deviation magnitude buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ch is NULL
+ *             - 3 ch has no sample yet
+ * @note       none
+ */
+uint8_t qmc5883l_change_get_baseline(qmc5883l_change_t *ch, float baseline[3], float *deviation);
+
+/**
+ * @brief      get the counters
+ * @param[in]  *ch points to a change structure
+ * @param[out] *samples points to a pushed samples buffer
+ * @param[out] *published points to a published events buffer
+ * @param[out] *suppressed points to a suppressed samples buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ch is NULL
+ *             - 3 ch is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_change_get_stats(qmc5883l_change_t *ch, uint32_t *samples, uint32_t *published, uint32_t *suppressed);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
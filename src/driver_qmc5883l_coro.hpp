@@ -0,0 +1,674 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_coro.hpp
+ * @brief     driver qmc5883l c++20 coroutine header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_CORO_HPP
+#define DRIVER_QMC5883L_CORO_HPP
+
+#if !defined(__cplusplus) || (__cplusplus < 202002L)
+    #error "driver_qmc5883l_coro.hpp needs c++20"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "driver_qmc5883l.hpp"
+
+/**
+ * @defgroup qmc5883l_coro_driver qmc5883l coroutine driver function
+ * @brief    qmc5883l coroutine driver modules
+ * @ingroup  qmc5883l_driver
+ * @note     one loop thread waits for data ready of any number of devices, by status polls on a timer
+ *           or by the interrupt pin, reads the sample and hands the waiting coroutine to an executor
+ * @{
+ */
+
+namespace qmc5883l
+{
+
+/**
+ * @brief qmc5883l sample structure definition
+ */
+struct Sample
+{
+    int16_t raw[3];         /**< raw data */
+    float m_gauss[3];       /**< converted data */
+    uint64_t time_us;       /**< loop time of the read */
+    uint8_t status;         /**< status register, only drdy when woken by the pin */
+    uint8_t res;            /**< 0 ok, 1 read failed, 3 device not initialized, 4 another wait is pending */
+};
+
+/**
+ * @brief executor concept
+ * @note  anything that can later resume a coroutine handle, on any thread
+ */
+template <typename E>
+concept Executor = requires(E &e, std::coroutine_handle<> h)
+{
+    e.post(h);
+};
+
+/**
+ * @brief steady clock policy
+ * @note  a clock has now_us() and sleep_until_us(time), sleep_until_us may return early,
+ *        e.g. when it waits on the event fd of a gpio line, the loop then rechecks everything
+ */
+struct SteadyClock
+{
+    /**
+     * @brief  get the time
+     * @return time in microseconds
+     * @note   none
+     */
+    static uint64_t now_us() noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch()).count());        /* steady time */
+    }
+    
+    /**
+     * @brief     sleep until a time
+     * @param[in] time_us is the wake time
+     * @note      none
+     */
+    static void sleep_until_us(uint64_t time_us) noexcept
+    {
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::microseconds(time_us)));        /* sleep */
+    }
+};
+
+/**
+ * @brief qmc5883l event loop
+ * @note  single threaded, the scheduling calls may come from any thread and are picked up within one poll period,
+ *        pin watches are level checks made on every wake
+ */
+template <typename Clock = SteadyClock>
+class Loop
+{
+    public:
+        using callback_t = void (*)(void *ctx);        /**< work callback */
+        using ready_t = bool (*)(void *ctx);           /**< watch predicate */
+        
+        /**
+         * @brief     make a loop
+         * @param[in] poll_us is the pin check and cross thread pickup period
+         * @note      none
+         */
+        explicit Loop(uint32_t poll_us = 1000) noexcept : m_poll_us(std::max<uint32_t>(poll_us, 1))
+        {
+        }
+        
+        /**
+         * @brief     resume a coroutine on the loop
+         * @param[in] h is the coroutine handle
+         * @note      makes the loop an executor
+         */
+        void post(std::coroutine_handle<> h)
+        {
+            call(&a_resume, h.address());                                              /* queue the resume */
+        }
+        
+        /**
+         * @brief     run a callback on the next iteration
+         * @param[in] fn is the callback
+         * @param[in] *ctx points to the callback context
+         * @note      none
+         */
+        void call(callback_t fn, void *ctx)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);                                 /* lock */
+            
+            m_ready.push_back({fn, ctx, 0, nullptr});                                  /* queue */
+        }
+        
+        /**
+         * @brief     run a callback at a time
+         * @param[in] time_us is the loop time
+         * @param[in] fn is the callback
+         * @param[in] *ctx points to the callback context
+         * @note      none
+         */
+        void at(uint64_t time_us, callback_t fn, void *ctx)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);                                 /* lock */
+            
+            m_timers.push_back({fn, ctx, time_us, nullptr});                           /* add the timer */
+            std::push_heap(m_timers.begin(), m_timers.end(), a_later);                 /* keep the earliest first */
+        }
+        
+        /**
+         * @brief     run a callback once a predicate holds
+         * @param[in] ready is the predicate, e.g. the interrupt pin level
+         * @param[in] fn is the callback
+         * @param[in] *ctx points to the predicate and callback context
+         * @note      the watch is removed when it fires
+         */
+        void when(ready_t ready, callback_t fn, void *ctx)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);                                 /* lock */
+            
+            m_watches.push_back({fn, ctx, 0, ready});                                  /* add the watch */
+        }
+        
+        /**
+         * @brief  get the loop time
+         * @return time in microseconds
+         * @note   none
+         */
+        uint64_t now_us() const noexcept
+        {
+            return Clock::now_us();                                                    /* clock time */
+        }
+        
+        /**
+         * @brief  get the poll period
+         * @return period in microseconds
+         * @note   none
+         */
+        uint32_t poll_us() const noexcept
+        {
+            return m_poll_us;                                                          /* poll period */
+        }
+        
+        /**
+         * @brief  run one iteration
+         * @return false when there is nothing left to wait for
+         * @note   sleeps until the next timer or poll when nothing is due
+         */
+        bool run_once()
+        {
+            std::vector<work_t> due;
+            uint64_t now;
+            uint64_t wake;
+            
+            now = Clock::now_us();                                                     /* get the time */
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);                             /* lock */
+                
+                due.swap(m_ready);                                                     /* take the queued work */
+                while ((!m_timers.empty()) && (m_timers.front().time_us <= now))       /* take the due timers */
+                {
+                    std::pop_heap(m_timers.begin(), m_timers.end(), a_later);          /* earliest to the back */
+                    due.push_back(m_timers.back());                                    /* take it */
+                    m_timers.pop_back();                                               /* remove it */
+                }
+                for (size_t i = 0; i < m_watches.size(); )                             /* check the watches */
+                {
+                    if (m_watches[i].ready(m_watches[i].ctx))                          /* check the predicate */
+                    {
+                        due.push_back(m_watches[i]);                                   /* take it */
+                        m_watches[i] = m_watches.back();                               /* remove it */
+                        m_watches.pop_back();                                          /* shrink */
+                    }
+                    else
+                    {
+                        i++;                                                           /* next watch */
+                    }
+                }
+                if (due.empty())                                                       /* nothing to run */
+                {
+                    if (m_timers.empty() && m_watches.empty())                         /* check idle */
+                    {
+                        return false;                                                  /* nothing left */
+                    }
+                    wake = now + m_poll_us;                                            /* next poll */
+                    if ((!m_timers.empty()) && (m_timers.front().time_us < wake))      /* check the next timer */
+                    {
+                        wake = m_timers.front().time_us;                               /* wake for the timer */
+                    }
+                }
+            }
+            if (due.empty())                                                           /* nothing to run */
+            {
+                Clock::sleep_until_us(wake);                                           /* sleep */
+                
+                return true;                                                           /* keep running */
+            }
+            for (work_t &w : due)                                                      /* run the work */
+            {
+                w.fn(w.ctx);                                                           /* run */
+            }
+            
+            return true;                                                               /* keep running */
+        }
+        
+        /**
+         * @brief run until there is nothing left to wait for
+         * @note  none
+         */
+        void run()
+        {
+            while (run_once())                                                         /* run */
+            {
+            }
+        }
+    
+    private:
+        struct work_t
+        {
+            callback_t fn;            /**< callback */
+            void *ctx;                /**< context */
+            uint64_t time_us;         /**< timer time */
+            ready_t ready;            /**< watch predicate */
+        };
+        
+        static void a_resume(void *ctx)
+        {
+            std::coroutine_handle<>::from_address(ctx).resume();                       /* resume */
+        }
+        
+        static bool a_later(const work_t &a, const work_t &b) noexcept
+        {
+            return a.time_us > b.time_us;                                              /* min heap */
+        }
+        
+        std::mutex m_mutex;                   /**< scheduling lock */
+        std::vector<work_t> m_ready;          /**< queued work */
+        std::vector<work_t> m_timers;         /**< timer heap */
+        std::vector<work_t> m_watches;        /**< pin watches */
+        uint32_t m_poll_us;                   /**< poll period */
+};
+
+/**
+ * @brief timer trigger
+ * @note  checks the status one poll before the next sample is due, then every poll until data ready,
+ *        the wait times out Device::ready_tries ms after it is armed whatever the poll period
+ */
+struct TimerTrigger
+{
+};
+
+/**
+ * @brief pin trigger
+ * @note  Pin has static bool level() that returns the interrupt pin, the chip interrupt must be enabled,
+ *        which is the default after the soft reset of Device::init, the wake costs only the data read
+ */
+template <typename Pin>
+struct PinTrigger
+{
+    /**
+     * @brief  get the pin level
+     * @return true when data is ready
+     * @note   none
+     */
+    static bool level() noexcept
+    {
+        return Pin::level();                                                           /* pin level */
+    }
+};
+
+/**
+ * @brief async generator
+ * @note  the consumer calls co_await next() which returns a pointer to the value or nullptr at the end,
+ *        the generator body may co_await, the value lives until the next call
+ */
+template <typename T>
+class AsyncGenerator
+{
+    public:
+        struct promise_type;
+        using handle_t = std::coroutine_handle<promise_type>;        /**< generator handle */
+        
+        /**
+         * @brief transfer back to the consumer
+         */
+        struct transfer_t
+        {
+            bool await_ready() noexcept
+            {
+                return false;                                                          /* always suspend */
+            }
+            
+            std::coroutine_handle<> await_suspend(handle_t h) noexcept
+            {
+                return h.promise().consumer;                                           /* resume the consumer */
+            }
+            
+            void await_resume() noexcept
+            {
+            }
+        };
+        
+        /**
+         * @brief generator promise
+         */
+        struct promise_type
+        {
+            T value;                                       /**< yielded value */
+            std::coroutine_handle<> consumer;              /**< waiting consumer */
+            
+            AsyncGenerator get_return_object() noexcept
+            {
+                return AsyncGenerator(handle_t::from_promise(*this));                  /* generator */
+            }
+            
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};                                                             /* start on the first next */
+            }
+            
+            transfer_t final_suspend() noexcept
+            {
+                return {};                                                             /* back to the consumer */
+            }
+            
+            transfer_t yield_value(const T &v) noexcept
+            {
+                value = v;                                                             /* keep the value */
+                
+                return {};                                                             /* back to the consumer */
+            }
+            
+            void return_void() noexcept
+            {
+            }
+            
+            void unhandled_exception() noexcept
+            {
+                std::terminate();                                                      /* no exceptions */
+            }
+        };
+        
+        /**
+         * @brief next awaiter
+         */
+        struct next_t
+        {
+            handle_t h;        /**< generator handle */
+            
+            bool await_ready() noexcept
+            {
+                return (!h) || h.done();                                               /* finished */
+            }
+            
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept
+            {
+                h.promise().consumer = consumer;                                       /* save the consumer */
+                
+                return h;                                                              /* run the generator */
+            }
+            
+            T *await_resume() noexcept
+            {
+                return ((!h) || h.done()) ? nullptr : &h.promise().value;              /* value or end */
+            }
+        };
+        
+        AsyncGenerator(AsyncGenerator &&other) noexcept : m_h(std::exchange(other.m_h, {}))
+        {
+        }
+        
+        AsyncGenerator(const AsyncGenerator &) = delete;
+        AsyncGenerator &operator=(const AsyncGenerator &) = delete;
+        
+        ~AsyncGenerator()
+        {
+            if (m_h)                                                                   /* check the handle */
+            {
+                m_h.destroy();                                                         /* destroy */
+            }
+        }
+        
+        /**
+         * @brief  wait for the next value
+         * @return awaiter of a value pointer, nullptr at the end
+         * @note   none
+         */
+        next_t next() noexcept
+        {
+            return next_t{m_h};                                                        /* awaiter */
+        }
+    
+    private:
+        explicit AsyncGenerator(handle_t h) noexcept : m_h(h)
+        {
+        }
+        
+        handle_t m_h;        /**< generator handle */
+};
+
+/**
+ * @brief qmc5883l coroutine sample source
+ * @note  Dev is a qmc5883l::Device, one wait per source at a time, the source, the loop and the executor
+ *        must outlive the waits
+ */
+template <typename Dev, typename Clock = SteadyClock, typename Trigger = TimerTrigger>
+class Source
+{
+    public:
+        /**
+         * @brief sample awaiter
+         */
+        template <typename E>
+        struct next_t
+        {
+            Source *source;        /**< source */
+            E *ex;                 /**< executor */
+            Sample sample;         /**< sample */
+            
+            bool await_ready() noexcept
+            {
+                sample = Sample{};                                                     /* clear */
+                if (!source->m_dev.inited())                                           /* check the device */
+                {
+                    sample.res = 3;                                                    /* not initialized */
+                    
+                    return true;                                                       /* no wait */
+                }
+                if (source->m_h)                                                       /* check the pending wait */
+                {
+                    sample.res = 4;                                                    /* busy */
+                    
+                    return true;                                                       /* no wait */
+                }
+                
+                return false;                                                          /* wait */
+            }
+            
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                source->a_arm(&sample, h, ex, &a_post);                                /* arm the trigger */
+            }
+            
+            Sample await_resume() noexcept
+            {
+                return sample;                                                         /* sample */
+            }
+            
+            static void a_post(void *e, std::coroutine_handle<> h)
+            {
+                static_cast<E *>(e)->post(h);                                          /* hand over */
+            }
+        };
+        
+        /**
+         * @brief     make a source
+         * @param[in] &dev is an initialized device
+         * @param[in] &loop is the loop that waits for data ready
+         * @note      none
+         */
+        Source(Dev &dev, Loop<Clock> &loop) noexcept : m_dev(dev), m_loop(loop)
+        {
+        }
+        
+        Source(const Source &) = delete;
+        Source &operator=(const Source &) = delete;
+        
+        /**
+         * @brief     wait for the next sample
+         * @param[in] &ex is the executor that resumes the caller
+         * @return    awaiter of a sample
+         * @note      check sample.res
+         */
+        template <Executor E>
+        next_t<E> next_sample(E &ex) noexcept
+        {
+            return next_t<E>{this, &ex, Sample{}};                                     /* awaiter */
+        }
+        
+        /**
+         * @brief  wait for the next sample and resume on the loop
+         * @return awaiter of a sample
+         * @note   check sample.res
+         */
+        next_t<Loop<Clock>> next_sample() noexcept
+        {
+            return next_sample(m_loop);                                                /* awaiter */
+        }
+        
+        /**
+         * @brief     generate samples
+         * @param[in] &ex is the executor that resumes the consumer
+         * @param[in] count is the number of samples, 0 means no end
+         * @return    async generator of samples
+         * @note      a failed sample is generated and then the generator ends
+         */
+        template <Executor E>
+        AsyncGenerator<Sample> samples(E &ex, uint32_t count = 0)
+        {
+            for (uint32_t i = 0; (count == 0) || (i < count); i++)                     /* each sample */
+            {
+                Sample s = co_await next_sample(ex);                                   /* wait */
+                
+                co_yield s;                                                            /* hand out */
+                if (s.res != 0)                                                        /* check the result */
+                {
+                    co_return;                                                         /* stop */
+                }
+            }
+        }
+    
+    private:
+        using post_t = void (*)(void *ex, std::coroutine_handle<> h);        /**< type erased executor */
+        
+        void a_arm(Sample *out, std::coroutine_handle<> h, void *ex, post_t post)
+        {
+            uint64_t now = m_loop.now_us();
+            
+            m_out = out;                                                               /* save the output */
+            m_h = h;                                                                   /* save the caller */
+            m_ex = ex;                                                                 /* save the executor */
+            m_post = post;                                                             /* save the hand over */
+            m_arm_us = now;                                                            /* save the arm time */
+            if constexpr (std::is_same_v<Trigger, TimerTrigger>)                       /* timer */
+            {
+                m_loop.at(std::max(m_next_us, now), &a_fire, this);                    /* check when due */
+            }
+            else
+            {
+                m_loop.when(&a_level, &a_fire, this);                                  /* wait for the pin */
+            }
+        }
+        
+        static bool a_level(void *ctx) noexcept
+        {
+            (void)ctx;                                                                 /* not used */
+            
+            return Trigger::level();                                                   /* pin level */
+        }
+        
+        static void a_fire(void *ctx)
+        {
+            Source *s = static_cast<Source *>(ctx);
+            Sample *out = s->m_out;
+            uint64_t now = s->m_loop.now_us();
+            
+            if constexpr (std::is_same_v<Trigger, TimerTrigger>)                       /* timer */
+            {
+                if (s->m_dev.get_status(&out->status) != 0)                            /* read status */
+                {
+                    out->res = 1;                                                      /* read failed */
+                    s->a_complete();                                                   /* complete */
+                    
+                    return;                                                            /* return */
+                }
+                if ((out->status & QMC5883L_STATUS_DRDY) == 0)                         /* not ready */
+                {
+                    if (now - s->m_arm_us > Dev::ready_tries * 1000ULL)                /* check timeout */
+                    {
+                        out->res = 1;                                                  /* timeout */
+                        s->a_complete();                                               /* complete */
+                        
+                        return;                                                        /* return */
+                    }
+                    s->m_loop.at(now + s->m_loop.poll_us(), &a_fire, s);               /* poll again */
+                    
+                    return;                                                            /* return */
+                }
+            }
+            else
+            {
+                out->status = QMC5883L_STATUS_DRDY;                                    /* pin means ready */
+            }
+            out->res = s->m_dev.read_data(out->raw, out->m_gauss);                     /* read data */
+            out->time_us = now;                                                        /* stamp */
+            if (Dev::config::period_us > s->m_loop.poll_us())                          /* check the period */
+            {
+                s->m_next_us = now + Dev::config::period_us - s->m_loop.poll_us();     /* check one poll early */
+            }
+            s->a_complete();                                                           /* complete */
+        }
+        
+        void a_complete()
+        {
+            std::coroutine_handle<> h = std::exchange(m_h, {});
+            
+            m_post(m_ex, h);                                                           /* resume on the executor */
+        }
+        
+        Dev &m_dev;                                /**< device */
+        Loop<Clock> &m_loop;                       /**< loop */
+        Sample *m_out = nullptr;                   /**< pending output */
+        std::coroutine_handle<> m_h;               /**< pending caller */
+        void *m_ex = nullptr;                      /**< pending executor */
+        post_t m_post = nullptr;                   /**< pending hand over */
+        uint64_t m_next_us = 0;                    /**< next status check */
+        uint64_t m_arm_us = 0;                     /**< arm time of this wait */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
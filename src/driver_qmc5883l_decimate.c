@@ -0,0 +1,253 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_decimate.c
+ * @brief     driver qmc5883l decimate source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_decimate.h"
+
+/**
+ * @brief decimate definition
+ */
+#define DECIMATE_GAIN_SHIFT        30        /**< gain normalization shift */
+#define DECIMATE_OUT_SHIFT         8         /**< fractional bits between the cic and the fir */
+#define DECIMATE_TAP_SHIFT         14        /**< fir coefficient fractional bits */
+
+/**
+ * @brief     convert a modulo 2^32 value to signed
+ * @param[in] v is the modulo value
+ * @return    signed value
+ * @note      avoids the implementation defined unsigned to signed conversion
+ */
+static int32_t a_decimate_signed(uint32_t v)
+{
+    if ((v & 0x80000000U) != 0)           /* check sign */
+    {
+        return -(int32_t)(~v) - 1;        /* negative */
+    }
+    
+    return (int32_t)v;                    /* positive */
+}
+
+/**
+ * @brief     round and saturate a q8 value to int16
+ * @param[in] v is the q8 value
+ * @return    int16 value
+ * @note      none
+ */
+static int16_t a_decimate_round(int64_t v)
+{
+    v = (v >= 0) ? ((v + (1 << (DECIMATE_OUT_SHIFT - 1))) / (1 << DECIMATE_OUT_SHIFT))
+                 : -((-v + (1 << (DECIMATE_OUT_SHIFT - 1))) / (1 << DECIMATE_OUT_SHIFT));        /* round half away from zero */
+    if (v > 32767)                                                                               /* check max */
+    {
+        return 32767;                                                                            /* saturate */
+    }
+    if (v < -32768)                                                                              /* check min */
+    {
+        return -32768;                                                                           /* saturate */
+    }
+    
+    return (int16_t)v;                                                                           /* return value */
+}
+
+/**
+ * @brief      initialize the decimation stage
+ * @param[out] *dec points to a decimate structure
+ * @param[in]  ratio is the decimation ratio
+ * @param[in]  order is the cic order
+ * @param[in]  compensate enables the droop compensation fir
+ * @return     status code
+ *             - 0 success
+ *             - 2 dec is NULL
+ *             - 4 ratio or order is invalid
+ * @note       ratio^order must not exceed QMC5883L_DECIMATE_MAX_GAIN
+ */
+uint8_t qmc5883l_decimate_init(qmc5883l_decimate_t *dec, uint8_t ratio, uint8_t order, qmc5883l_bool_t compensate)
+{
+    uint32_t gain;
+    uint8_t i;
+    
+    if (dec == NULL)                                                                 /* check dec */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if ((ratio < 2) || (ratio > QMC5883L_DECIMATE_MAX_RATIO) ||
+        (order < 1) || (order > QMC5883L_DECIMATE_MAX_ORDER))                        /* check range */
+    {
+        return 4;                                                                    /* return error */
+    }
+    gain = 1;                                                                        /* init 1 */
+    for (i = 0; i < order; i++)                                                      /* ratio^order */
+    {
+        gain *= ratio;                                                               /* multiply */
+        if (gain > QMC5883L_DECIMATE_MAX_GAIN)                                       /* check growth */
+        {
+            return 4;                                                                /* return error */
+        }
+    }
+    
+    memset(dec, 0, sizeof(qmc5883l_decimate_t));                                     /* clear all */
+    dec->ratio = ratio;                                                              /* set ratio */
+    dec->order = order;                                                              /* set order */
+    dec->gain_mul = ((1UL << DECIMATE_GAIN_SHIFT) + gain / 2) / gain;                /* 2^30 / gain */
+    if (compensate == QMC5883L_BOOL_TRUE)                                            /* check compensate */
+    {
+        dec->tap = (int32_t)((order * (1L << DECIMATE_TAP_SHIFT) + 12) / 24);        /* cancel the order / 24 * w^2 droop */
+    }
+    dec->inited = 1;                                                                 /* flag inited */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     clear the filter states
+ * @param[in] *dec points to a decimate structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ *            - 3 dec is not initialized
+ * @note      none
+ */
+uint8_t qmc5883l_decimate_reset(qmc5883l_decimate_t *dec)
+{
+    if (dec == NULL)                                            /* check dec */
+    {
+        return 2;                                               /* return error */
+    }
+    if (dec->inited != 1)                                       /* check dec initialization */
+    {
+        return 3;                                               /* return error */
+    }
+    
+    memset(dec->integrator, 0, sizeof(dec->integrator));        /* clear integrators */
+    memset(dec->comb, 0, sizeof(dec->comb));                    /* clear combs */
+    memset(dec->fir, 0, sizeof(dec->fir));                      /* clear fir */
+    dec->phase = 0;                                             /* clear phase */
+    dec->fill = 0;                                              /* clear fill */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      push a raw sample
+ * @param[in]  *dec points to a decimate structure
+ * @param[in]  *raw points to a raw data buffer
+ * @param[out] *out points to a decimated raw data buffer
+ * @param[out] *ready points to a ready buffer, 1 when out holds a new sample
+ * @return     status code
+ *             - 0 success
+ *             - 2 dec or buffer is NULL
+ *             - 3 dec is not initialized
+ * @note       integer only, one output is produced every ratio inputs once the filter is filled
+ */
+uint8_t qmc5883l_decimate_push(qmc5883l_decimate_t *dec, const int16_t raw[3], int16_t out[3], uint8_t *ready)
+{
+    uint8_t warmup;
+    uint8_t i;
+    uint8_t k;
+    
+    if (dec == NULL)                                                                /* check dec */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if ((raw == NULL) || (out == NULL) || (ready == NULL))                          /* check buffer */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (dec->inited != 1)                                                           /* check dec initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    
+    *ready = 0;                                                                     /* init 0 */
+    for (k = 0; k < 3; k++)                                                         /* each axis */
+    {
+        uint32_t v;
+        
+        v = (uint32_t)(int32_t)raw[k];                                              /* modulo input */
+        for (i = 0; i < dec->order; i++)                                            /* integrators */
+        {
+            dec->integrator[i][k] += v;                                             /* integrate */
+            v = dec->integrator[i][k];                                              /* next stage */
+        }
+    }
+    dec->phase++;                                                                   /* count input */
+    if (dec->phase < dec->ratio)                                                    /* check decimation */
+    {
+        return 0;                                                                   /* success return 0 */
+    }
+    dec->phase = 0;                                                                 /* reset phase */
+    for (k = 0; k < 3; k++)                                                         /* each axis */
+    {
+        uint32_t v;
+        int32_t y;
+        
+        v = dec->integrator[dec->order - 1][k];                                     /* last integrator */
+        for (i = 0; i < dec->order; i++)                                            /* combs */
+        {
+            uint32_t d;
+            
+            d = v - dec->comb[i][k];                                                /* difference */
+            dec->comb[i][k] = v;                                                    /* save delay */
+            v = d;                                                                  /* next stage */
+        }
+        y = (int32_t)(((int64_t)a_decimate_signed(v) * dec->gain_mul)
+                      / (1L << (DECIMATE_GAIN_SHIFT - DECIMATE_OUT_SHIFT)));        /* normalize to q8 */
+        if (dec->tap != 0)                                                          /* check compensation */
+        {
+            int64_t f;
+            
+            f = ((int64_t)dec->fir[0][k] * ((1L << DECIMATE_TAP_SHIFT) + 2 * dec->tap))
+                - ((int64_t)dec->fir[1][k] + y) * dec->tap;                         /* -a, 1 + 2a, -a */
+            dec->fir[1][k] = dec->fir[0][k];                                        /* shift */
+            dec->fir[0][k] = y;                                                     /* shift */
+            out[k] = a_decimate_round(f / (1L << DECIMATE_TAP_SHIFT));              /* output */
+        }
+        else
+        {
+            out[k] = a_decimate_round(y);                                           /* output */
+        }
+    }
+    warmup = dec->order + ((dec->tap != 0) ? 2 : 0);                                /* settled outputs */
+    if (dec->fill < warmup)                                                         /* check fill */
+    {
+        dec->fill++;                                                                /* count */
+    }
+    if (dec->fill >= warmup)                                                        /* check settled */
+    {
+        *ready = 1;                                                                 /* set ready */
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
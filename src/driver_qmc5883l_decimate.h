@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_decimate.h
+ * @brief     driver qmc5883l decimate header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_DECIMATE_H
+#define DRIVER_QMC5883L_DECIMATE_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_decimate_driver qmc5883l decimate driver function
+ * @brief    qmc5883l decimate driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l decimate definition
+ */
+#define QMC5883L_DECIMATE_MAX_ORDER        4             /**< max cic order */
+#define QMC5883L_DECIMATE_MAX_RATIO        32            /**< max decimation ratio */
+#define QMC5883L_DECIMATE_MAX_GAIN         65536UL       /**< max cic gain ratio^order */
+
+/**
+ * @brief qmc5883l decimate structure definition
+ */
+typedef struct qmc5883l_decimate_s
+{
+    uint32_t integrator[QMC5883L_DECIMATE_MAX_ORDER][3];        /**< integrator states, modulo 2^32 */
+    uint32_t comb[QMC5883L_DECIMATE_MAX_ORDER][3];              /**< comb delay states, modulo 2^32 */
+    int32_t fir[2][3];                                          /**< previous cic outputs in q8 */
+    uint32_t gain_mul;                                          /**< 2^30 / ratio^order */
+    int32_t tap;                                                /**< compensation side tap in q14 */
+    uint8_t order;                                              /**< cic order */
+    uint8_t ratio;                                              /**< decimation ratio */
+    uint8_t phase;                                              /**< input samples of the current output */
+    uint8_t fill;                                               /**< cic outputs in the fir */
+    uint8_t inited;                                             /**< inited flag */
+} qmc5883l_decimate_t;
+
+/**
+ * @brief      initialize the decimation stage
+ * @param[out] *dec points to a decimate structure
+ * @param[in]  ratio is the decimation ratio
+ * @param[in]  order is the cic order
+ * @param[in]  compensate enables the droop compensation fir
+ * @return     status code
+ *             - 0 success
+ *             - 2 dec is NULL
+ *             - 4 ratio or order is invalid
+ * @note       ratio^order must not exceed QMC5883L_DECIMATE_MAX_GAIN
+ */
+uint8_t qmc5883l_decimate_init(qmc5883l_decimate_t *dec, uint8_t ratio, uint8_t order, qmc5883l_bool_t compensate);
+
+/**
+ * @brief     clear the filter states
+ * @param[in] *dec points to a decimate structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ *            - 3 dec is not initialized
+ * @note      none
+ */
+uint8_t qmc5883l_decimate_reset(qmc5883l_decimate_t *dec);
+
+/**
+ * @brief      push a raw sample
+ * @param[in]  *dec points to a decimate structure
+ * @param[in]  *raw points to a raw data buffer
+ * @param[out] *out points to a decimated raw data buffer
+ * @param[out] *ready points to a ready buffer, 1 when out holds a new sample
+ * @return     status code
+ *             - 0 success
+ *             - 2 dec or buffer is NULL
+ *             - 3 dec is not initialized
+ * @note       integer only, one output is produced every ratio inputs once the filter is filled
+ */
+uint8_t qmc5883l_decimate_push(qmc5883l_decimate_t *dec, const int16_t raw[3], int16_t out[3], uint8_t *ready);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
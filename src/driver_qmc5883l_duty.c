@@ -0,0 +1,319 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_duty.c
+ * @brief     driver qmc5883l duty source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_duty.h"
+
+/**
+ * @brief chip register definition
+ */
+#define DUTY_REG_X_LSB           0x00          /**< data output x lsb register */
+#define DUTY_REG_CONTROL1        0x09          /**< control 1 register */
+
+/**
+ * @brief duty definition
+ */
+#define DUTY_MODE_MASK           (3 << 0)      /**< control1 mode bits */
+#define DUTY_STATUS_DRDY         (1 << 0)      /**< status data ready bit */
+
+/**
+ * @brief output rate table definition
+ */
+static const uint16_t gs_rate_hz[4] = {10, 50, 100, 200};
+
+/**
+ * @brief     average current in continuous mode
+ * @param[in] control1 is the cached control1 register
+ * @return    current in uA
+ * @note      conversions at the peak current on top of the standby current
+ */
+static float a_duty_continuous_ua(uint8_t control1)
+{
+    float conversion_s;
+    float ua;
+    
+    conversion_s = (float)(QMC5883L_DUTY_CONVERSION_US >> ((control1 >> 6) & 0x03)) * 1e-6f;        /* conversion time */
+    ua = QMC5883L_DUTY_STANDBY_UA +
+         QMC5883L_DUTY_PEAK_UA * conversion_s * (float)gs_rate_hz[(control1 >> 2) & 0x03];          /* conversions per second */
+    
+    return (ua < QMC5883L_DUTY_PEAK_UA) ? ua : QMC5883L_DUTY_PEAK_UA;                               /* cap at the peak */
+}
+
+/**
+ * @brief     set continuous mode
+ * @param[in] *duty points to a duty structure
+ * @param[in] now_us is the current time
+ * @return    status code
+ *            - 0 success
+ *            - 1 write control1 failed
+ * @note      none
+ */
+static uint8_t a_duty_wake(qmc5883l_duty_t *duty, uint64_t now_us)
+{
+    uint8_t prev;
+    
+    prev = (uint8_t)(duty->control1 | QMC5883L_MODE_CONTINUOUS);                 /* continuous mode */
+    if (qmc5883l_set_reg(duty->handle, DUTY_REG_CONTROL1, &prev, 1) != 0)        /* write control1 */
+    {
+        duty->handle->debug_print("qmc5883l: write control1 failed.\n");         /* write control1 failed */
+        
+        return 1;                                                                /* return error */
+    }
+    duty->awake = 1;                                                             /* flag awake */
+    duty->wake_us = now_us;                                                      /* save wake time */
+    duty->due_us = now_us + duty->latency_us;                                    /* first sample due */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     initialize the scheduler and put the chip into standby
+ * @param[in] *duty points to a duty structure
+ * @param[in] *handle points to an initialized qmc5883l handle
+ * @param[in] interval_us is the sample interval
+ * @param[in] now_us is the current time
+ * @return    status code
+ *            - 0 success
+ *            - 1 read or write control1 failed
+ *            - 2 duty or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 interval_us is not above the first sample latency
+ * @note      set the rate, range and over sample before, control1 is read once and cached,
+ *            the first sample is due one interval after now_us
+ */
+uint8_t qmc5883l_duty_init(qmc5883l_duty_t *duty, qmc5883l_handle_t *handle, uint64_t interval_us, uint64_t now_us)
+{
+    uint32_t period;
+    uint32_t conversion;
+    uint32_t latency;
+    uint8_t prev;
+    
+    if ((duty == NULL) || (handle == NULL))                                  /* check buffer */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    if (qmc5883l_get_reg(handle, DUTY_REG_CONTROL1, &prev, 1) != 0)          /* read control1 */
+    {
+        handle->debug_print("qmc5883l: read control1 failed.\n");            /* read control1 failed */
+        
+        return 1;                                                            /* return error */
+    }
+    prev &= (uint8_t)~DUTY_MODE_MASK;                                        /* standby mode */
+    period = 1000000U / gs_rate_hz[(prev >> 2) & 0x03];                      /* output period */
+    conversion = QMC5883L_DUTY_CONVERSION_US >> ((prev >> 6) & 0x03);        /* conversion time */
+    latency = (period > conversion) ? period : conversion;                   /* first data ready */
+    latency = latency * (100 + QMC5883L_DUTY_MARGIN_PERCENT) / 100;          /* add the margin */
+    if (interval_us <= latency)                                              /* check interval */
+    {
+        return 4;                                                            /* return error */
+    }
+    if (qmc5883l_set_reg(handle, DUTY_REG_CONTROL1, &prev, 1) != 0)          /* write control1 */
+    {
+        handle->debug_print("qmc5883l: write control1 failed.\n");           /* write control1 failed */
+        
+        return 1;                                                            /* return error */
+    }
+    
+    memset(duty, 0, sizeof(qmc5883l_duty_t));                                /* clear all */
+    duty->handle = handle;                                                   /* set handle */
+    duty->interval_us = interval_us;                                         /* set interval */
+    duty->next_us = now_us + interval_us;                                    /* first sample */
+    duty->due_us = duty->next_us - latency;                                  /* first wake */
+    duty->start_us = now_us;                                                 /* schedule start */
+    duty->latency_us = latency;                                              /* set latency */
+    duty->control1 = prev;                                                   /* cache control1 */
+    duty->inited = 1;                                                        /* flag inited */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      run the scheduler
+ * @param[in]  *duty points to a duty structure
+ * @param[in]  now_us is the current time
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a converted data buffer
+ * @param[out] *ready points to a ready flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 iic transfer failed
+ *             - 2 duty or buffer is NULL
+ *             - 3 duty is not initialized
+ * @note       switches to continuous one latency before the sample is due, reads data and status in one
+ *             transfer once the latency has passed and goes back to standby, a late call skips missed slots
+ */
+uint8_t qmc5883l_duty_poll(qmc5883l_duty_t *duty, uint64_t now_us, int16_t raw[3], float m_gauss[3], uint8_t *ready)
+{
+    uint8_t buf[7];
+    uint8_t prev;
+    float resolution;
+    
+    if ((duty == NULL) || (raw == NULL) || (m_gauss == NULL) || (ready == NULL))                         /* check buffer */
+    {
+        return 2;                                                                                        /* return error */
+    }
+    if (duty->inited != 1)                                                                               /* check inited */
+    {
+        return 3;                                                                                        /* return error */
+    }
+    
+    *ready = 0;                                                                                          /* no sample yet */
+    if (now_us < duty->due_us)                                                                           /* nothing due */
+    {
+        return 0;                                                                                        /* success return 0 */
+    }
+    if (duty->awake == 0)                                                                                /* in standby */
+    {
+        return a_duty_wake(duty, now_us);                                                                /* wake just in time */
+    }
+    
+    if (qmc5883l_get_reg(duty->handle, DUTY_REG_X_LSB, buf, 7) != 0)                                     /* read data and status */
+    {
+        duty->handle->debug_print("qmc5883l: read data failed.\n");                                      /* read data failed */
+        
+        return 1;                                                                                        /* return error */
+    }
+    if ((buf[6] & DUTY_STATUS_DRDY) == 0)                                                                /* not ready */
+    {
+        duty->retries++;                                                                                 /* count retry */
+        if (now_us - duty->wake_us > (uint64_t)duty->latency_us * QMC5883L_DUTY_REWAKE_LATENCIES)        /* lost the wake */
+        {
+            duty->active_us += now_us - duty->wake_us;                                                   /* keep the active time */
+            
+            return a_duty_wake(duty, now_us);                                                            /* set continuous again */
+        }
+        duty->due_us = now_us + QMC5883L_DUTY_RETRY_US;                                                  /* try again */
+        
+        return 0;                                                                                        /* success return 0 */
+    }
+    prev = duty->control1;                                                                               /* standby mode */
+    if (qmc5883l_set_reg(duty->handle, DUTY_REG_CONTROL1, &prev, 1) != 0)                                /* write control1 */
+    {
+        duty->handle->debug_print("qmc5883l: write control1 failed.\n");                                 /* write control1 failed */
+        
+        return 1;                                                                                        /* return error */
+    }
+    duty->awake = 0;                                                                                     /* flag standby */
+    duty->active_us += now_us - duty->wake_us;                                                           /* add active time */
+    duty->samples++;                                                                                     /* count sample */
+    duty->next_us += duty->interval_us;                                                                  /* next slot */
+    if (duty->next_us <= now_us + duty->latency_us)                                                      /* slot missed */
+    {
+        duty->next_us += ((now_us + duty->latency_us - duty->next_us) / duty->interval_us + 1) *
+                         duty->interval_us;                                                              /* skip to a future slot */
+    }
+    duty->due_us = duty->next_us - duty->latency_us;                                                     /* next wake */
+    
+    raw[0] = (int16_t)(((uint16_t)buf[1] << 8) | buf[0]);                                                /* set raw x */
+    raw[1] = (int16_t)(((uint16_t)buf[3] << 8) | buf[2]);                                                /* set raw y */
+    raw[2] = (int16_t)(((uint16_t)buf[5] << 8) | buf[4]);                                                /* set raw z */
+    resolution = (((duty->control1 >> 4) & 0x01) == QMC5883L_FULL_SCALE_2GAUSS) ?
+                 (1000.0f / 12000.0f) : (1000.0f / 3000.0f);                                             /* cached range */
+    m_gauss[0] = (float)raw[0] * resolution;                                                             /* calculate x */
+    m_gauss[1] = (float)raw[1] * resolution;                                                             /* calculate y */
+    m_gauss[2] = (float)raw[2] * resolution;                                                             /* calculate z */
+    *ready = 1;                                                                                          /* sample ready */
+    
+    return 0;                                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the time until the scheduler has work
+ * @param[in]  *duty points to a duty structure
+ * @param[in]  now_us is the current time
+ * @param[out] *wait_us points to a wait time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 duty or wait_us is NULL
+ *             - 3 duty is not initialized
+ * @note       the host can sleep this long before the next poll
+ */
+uint8_t qmc5883l_duty_get_wait(qmc5883l_duty_t *duty, uint64_t now_us, uint64_t *wait_us)
+{
+    if ((duty == NULL) || (wait_us == NULL))                                 /* check buffer */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (duty->inited != 1)                                                   /* check inited */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    *wait_us = (duty->due_us > now_us) ? (duty->due_us - now_us) : 0;        /* time to the next work */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the duty cycle and current estimate
+ * @param[in]  *duty points to a duty structure
+ * @param[in]  now_us is the current time
+ * @param[out] *duty_cycle points to a continuous mode time fraction buffer
+ * @param[out] *current_ua points to an average current buffer
+ * @param[out] *continuous_ua points to the current without duty cycling buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 duty or buffer is NULL
+ *             - 3 duty is not initialized
+ * @note       the current follows the QMC5883L_DUTY_* model for the cached rate and over sample
+ */
+uint8_t qmc5883l_duty_get_report(qmc5883l_duty_t *duty, uint64_t now_us, float *duty_cycle,
+                                 float *current_ua, float *continuous_ua)
+{
+    uint64_t active;
+    float d;
+    
+    if ((duty == NULL) || (duty_cycle == NULL) || (current_ua == NULL) || (continuous_ua == NULL))             /* check buffer */
+    {
+        return 2;                                                                                              /* return error */
+    }
+    if (duty->inited != 1)                                                                                     /* check inited */
+    {
+        return 3;                                                                                              /* return error */
+    }
+    
+    active = duty->active_us + ((duty->awake != 0) ? (now_us - duty->wake_us) : 0);                            /* time awake */
+    d = (now_us > duty->start_us) ? (float)((double)active / (double)(now_us - duty->start_us)) : 0.0f;        /* awake fraction */
+    *continuous_ua = a_duty_continuous_ua(duty->control1);                                                     /* without duty cycling */
+    *current_ua = d * (*continuous_ua) + (1.0f - d) * QMC5883L_DUTY_STANDBY_UA;                                /* weighted current */
+    *duty_cycle = d;                                                                                           /* save duty cycle */
+    
+    return 0;                                                                                                  /* success return 0 */
+}
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_duty.h
+ * @brief     driver qmc5883l duty header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_DUTY_H
+#define DRIVER_QMC5883L_DUTY_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_duty_driver qmc5883l duty driver function
+ * @brief    qmc5883l duty driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l duty current model definition
+ * @note  standby and peak follow the datasheet, the conversion time at 512 over sample is an estimate
+ *        which gives the 75uA low power figure at 10Hz, override all three with board measurements
+ */
+#ifndef QMC5883L_DUTY_STANDBY_UA
+    #define QMC5883L_DUTY_STANDBY_UA         3.0f          /**< standby current */
+#endif
+#ifndef QMC5883L_DUTY_PEAK_UA
+    #define QMC5883L_DUTY_PEAK_UA            2600.0f       /**< current during a conversion */
+#endif
+#ifndef QMC5883L_DUTY_CONVERSION_US
+    #define QMC5883L_DUTY_CONVERSION_US      2770          /**< conversion time at 512 over sample */
+#endif
+
+/**
+ * @brief qmc5883l duty definition
+ */
+#define QMC5883L_DUTY_MARGIN_PERCENT         5             /**< latency margin for the chip clock tolerance */
+#define QMC5883L_DUTY_RETRY_US               1000          /**< data ready retry period */
+#define QMC5883L_DUTY_REWAKE_LATENCIES       4             /**< latencies without data before continuous is set again */
+
+/**
+ * @brief qmc5883l duty structure definition
+ */
+typedef struct qmc5883l_duty_s
+{
+    qmc5883l_handle_t *handle;        /**< qmc5883l handle */
+    uint64_t interval_us;             /**< sample interval */
+    uint64_t next_us;                 /**< next sample time */
+    uint64_t wake_us;                 /**< time continuous mode was set */
+    uint64_t due_us;                  /**< time the next poll has work */
+    uint64_t start_us;                /**< schedule start */
+    uint64_t active_us;               /**< time spent in continuous mode */
+    uint32_t latency_us;              /**< first sample latency */
+    uint32_t samples;                 /**< taken samples */
+    uint32_t retries;                 /**< reads before data was ready */
+    uint8_t control1;                 /**< cached control1 register in standby */
+    uint8_t awake;                    /**< continuous mode is set */
+    uint8_t inited;                   /**< inited flag */
+} qmc5883l_duty_t;
+
+/**
+ * @brief     initialize the scheduler and put the chip into standby
+ * @param[in] *duty points to a duty structure
+ * @param[in] *handle points to an initialized qmc5883l handle
+ * @param[in] interval_us is the sample interval
+ * @param[in] now_us is the current time
+ * @return    status code
+ *            - 0 success
+ *            - 1 read or write control1 failed
+ *            - 2 duty or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 interval_us is not above the first sample latency
+ * @note      set the rate, range and over sample before, control1 is read once and cached,
+ *            the first sample is due one interval after now_us
+ */
+uint8_t qmc5883l_duty_init(qmc5883l_duty_t *duty, qmc5883l_handle_t *handle, uint64_t interval_us, uint64_t now_us);
+
+/**
+ * @brief      run the scheduler
+ * @param[in]  *duty points to a duty structure
+ * @param[in]  now_us is the current time
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a converted data buffer
+ * @param[out] *ready points to a ready flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 iic transfer failed
+ *             - 2 duty or buffer is NULL
+ *             - 3 duty is not initialized
+ * @note       switches to continuous one latency before the sample is due, reads data and status in one
+ *             transfer once the latency has passed and goes back to standby, a late call skips missed slots
+ */
+uint8_t qmc5883l_duty_poll(qmc5883l_duty_t *duty, uint64_t now_us, int16_t raw[3], float m_gauss[3], uint8_t *ready);
+
+/**
+ * @brief      get the time until the scheduler has work
+ * @param[in]  *duty points to a duty structure
+ * @param[in]  now_us is the current time
+ * @param[out] *wait_us points to a wait time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 duty or wait_us is NULL
+ *             - 3 duty is not initialized
+ * @note       the host can sleep this long before the next poll
+ */
+uint8_t qmc5883l_duty_get_wait(qmc5883l_duty_t *duty, uint64_t now_us, uint64_t *wait_us);
+
+/**
+ * @brief      get the duty cycle and current estimate
+ * @param[in]  *duty points to a duty structure
+ * @param[in]  now_us is the current time
+ * @param[out] *duty_cycle points to a continuous mode time fraction buffer
+ * @param[out] *current_ua points to an average current buffer
+ * @param[out] *continuous_ua points to the current without duty cycling buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 duty or buffer is NULL
+ *             - 3 duty is not initialized
+ * @note       the current follows the QMC5883L_DUTY_* model for the cached rate and over sample
+ */
+uint8_t qmc5883l_duty_get_report(qmc5883l_duty_t *duty, uint64_t now_us, float *duty_cycle,
+                                 float *current_ua, float *continuous_ua);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,359 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_hampel.c
+ * @brief     driver qmc5883l hampel source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_hampel.h"
+
+/**
+ * @brief hampel definition
+ */
+#define HAMPEL_MAD_SCALE        1.4826f        /**< mad to standard deviation of gaussian noise */
+
+/**
+ * @brief     find the first element not less than a value
+ * @param[in] *a points to an ascending array
+ * @param[in] n is the array length
+ * @param[in] v is the value
+ * @return    index in [0, n]
+ * @note      binary search
+ */
+static uint8_t a_hampel_lower_bound(const int16_t *a, uint8_t n, int32_t v)
+{
+    uint8_t lo;
+    uint8_t hi;
+    
+    lo = 0;                                    /* init 0 */
+    hi = n;                                    /* init n */
+    while (lo < hi)                            /* search */
+    {
+        uint8_t mid;
+        
+        mid = (uint8_t)((lo + hi) / 2);        /* middle */
+        if (a[mid] < v)                        /* check middle */
+        {
+            lo = mid + 1;                      /* upper half */
+        }
+        else
+        {
+            hi = mid;                          /* lower half */
+        }
+    }
+    
+    return lo;                                 /* return index */
+}
+
+/**
+ * @brief     find the first element greater than a value
+ * @param[in] *a points to an ascending array
+ * @param[in] n is the array length
+ * @param[in] v is the value
+ * @return    index in [0, n]
+ * @note      binary search
+ */
+static uint8_t a_hampel_upper_bound(const int16_t *a, uint8_t n, int32_t v)
+{
+    uint8_t lo;
+    uint8_t hi;
+    
+    lo = 0;                                    /* init 0 */
+    hi = n;                                    /* init n */
+    while (lo < hi)                            /* search */
+    {
+        uint8_t mid;
+        
+        mid = (uint8_t)((lo + hi) / 2);        /* middle */
+        if (a[mid] <= v)                       /* check middle */
+        {
+            lo = mid + 1;                      /* upper half */
+        }
+        else
+        {
+            hi = mid;                          /* lower half */
+        }
+    }
+    
+    return lo;                                 /* return index */
+}
+
+/**
+ * @brief         replace the oldest value of a sorted window
+ * @param[in,out] *a points to an ascending array
+ * @param[in]     n is the array length
+ * @param[in]     old is the leaving value
+ * @param[in]     v is the entering value
+ * @note          two binary searches and one shift of the elements between both positions
+ */
+static void a_hampel_replace(int16_t *a, uint8_t n, int16_t old, int16_t v)
+{
+    uint8_t pos_out;
+    uint8_t pos_in;
+    
+    pos_out = a_hampel_lower_bound(a, n, old);                                                          /* leaving position */
+    pos_in = a_hampel_lower_bound(a, n, v);                                                             /* entering position */
+    if (pos_in > pos_out)                                                                               /* check direction */
+    {
+        memmove(&a[pos_out], &a[pos_out + 1], sizeof(int16_t) * (size_t)(pos_in - 1 - pos_out));        /* shift down */
+        a[pos_in - 1] = v;                                                                              /* insert */
+    }
+    else
+    {
+        memmove(&a[pos_in + 1], &a[pos_in], sizeof(int16_t) * (size_t)(pos_out - pos_in));              /* shift up */
+        a[pos_in] = v;                                                                                  /* insert */
+    }
+}
+
+/**
+ * @brief         insert a value into a sorted window
+ * @param[in,out] *a points to an ascending array
+ * @param[in]     n is the array length before the insertion
+ * @param[in]     v is the entering value
+ * @note          none
+ */
+static void a_hampel_insert(int16_t *a, uint8_t n, int16_t v)
+{
+    uint8_t pos;
+    
+    pos = a_hampel_lower_bound(a, n, v);                                       /* entering position */
+    memmove(&a[pos + 1], &a[pos], sizeof(int16_t) * (size_t)(n - pos));        /* shift up */
+    a[pos] = v;                                                                /* insert */
+}
+
+/**
+ * @brief     check whether a value is an outlier
+ * @param[in] *hampel points to a hampel structure
+ * @param[in] *a points to the ascending window of the axis
+ * @param[in] v is the checked value
+ * @return    1 if the value is an outlier
+ * @note      |v - median| > k * max(mad, 1) holds exactly when the mad is at most d, the largest d
+ *            with k * max(d, 1) < |v - median|, which one window count of [median - d, median + d]
+ *            decides without computing the mad
+ */
+static uint8_t a_hampel_outlier(qmc5883l_hampel_t *hampel, const int16_t *a, int16_t v)
+{
+    int32_t med;
+    int32_t dev;
+    int32_t d;
+    uint8_t m;
+    uint8_t count;
+    
+    m = hampel->window / 2;                                                     /* median index */
+    med = a[m];                                                                 /* median */
+    dev = (int32_t)v - med;                                                     /* deviation */
+    dev = (dev < 0) ? -dev : dev;                                               /* absolute */
+    if ((uint32_t)dev * 256U <= hampel->k_q8)                                   /* below k * 1 */
+    {
+        return 0;                                                               /* keep */
+    }
+    d = (int32_t)(((uint32_t)dev * 256U - 1U) / hampel->k_q8);                  /* largest d */
+    count = (uint8_t)(a_hampel_upper_bound(a, hampel->window, med + d) -
+                      a_hampel_lower_bound(a, hampel->window, med - d));        /* values within d */
+    
+    return (count >= (m + 1)) ? 1 : 0;                                          /* mad <= d */
+}
+
+/**
+ * @brief      initialize the outlier filter
+ * @param[out] *hampel points to a hampel structure
+ * @param[in]  window is the odd window length
+ * @param[in]  threshold is the number of scaled median absolute deviations
+ * @return     status code
+ *             - 0 success
+ *             - 2 hampel is NULL
+ *             - 4 window or threshold is invalid
+ * @note       3 is a common threshold
+ */
+uint8_t qmc5883l_hampel_init(qmc5883l_hampel_t *hampel, uint8_t window, float threshold)
+{
+    if (hampel == NULL)                                                                      /* check hampel */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if ((window < 3) || (window > QMC5883L_HAMPEL_MAX_WINDOW) || ((window % 2) == 0))        /* check window */
+    {
+        return 4;                                                                            /* return error */
+    }
+    if ((threshold <= 0.0f) || (threshold > 1000.0f))                                        /* check threshold */
+    {
+        return 4;                                                                            /* return error */
+    }
+    
+    memset(hampel, 0, sizeof(qmc5883l_hampel_t));                                            /* clear all */
+    hampel->window = window;                                                                 /* set window */
+    hampel->k_q8 = (uint32_t)(threshold * HAMPEL_MAD_SCALE * 256.0f + 0.5f);                 /* set threshold */
+    if (hampel->k_q8 == 0)                                                                   /* check zero */
+    {
+        hampel->k_q8 = 1;                                                                    /* set min */
+    }
+    hampel->inited = 1;                                                                      /* flag inited */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     clear the window and the counters
+ * @param[in] *hampel points to a hampel structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 hampel is NULL
+ *            - 3 hampel is not initialized
+ * @note      none
+ */
+uint8_t qmc5883l_hampel_reset(qmc5883l_hampel_t *hampel)
+{
+    if (hampel == NULL)                  /* check hampel */
+    {
+        return 2;                        /* return error */
+    }
+    if (hampel->inited != 1)             /* check hampel initialization */
+    {
+        return 3;                        /* return error */
+    }
+    
+    hampel->head = 0;                    /* clear head */
+    hampel->fill = 0;                    /* clear fill */
+    hampel->samples = 0;                 /* clear samples */
+    hampel->replaced_samples = 0;        /* clear replaced samples */
+    hampel->replaced_values = 0;         /* clear replaced values */
+    
+    return 0;                            /* success return 0 */
+}
+
+/**
+ * @brief      filter a raw sample
+ * @param[in]  *hampel points to a hampel structure
+ * @param[in]  *raw points to a raw data buffer
+ * @param[out] *out points to a filtered raw data buffer
+ * @param[out] *replaced points to a replaced axis mask buffer, bit n set when axis n was replaced
+ * @return     status code
+ *             - 0 success
+ *             - 2 hampel or buffer is NULL
+ *             - 3 hampel is not initialized
+ * @note       causal, an axis is replaced by the window median when it deviates by more than
+ *             threshold * 1.4826 * mad, raw and out may be the same buffer
+ */
+uint8_t qmc5883l_hampel_push(qmc5883l_hampel_t *hampel, const int16_t raw[3], int16_t out[3], uint8_t *replaced)
+{
+    int16_t v[3];
+    uint8_t mask;
+    uint8_t k;
+    
+    if ((hampel == NULL) || (raw == NULL) || (out == NULL) || (replaced == NULL))        /* check hampel and buffer */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (hampel->inited != 1)                                                             /* check hampel initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    v[0] = raw[0];                                                                       /* copy x */
+    v[1] = raw[1];                                                                       /* copy y */
+    v[2] = raw[2];                                                                       /* copy z */
+    if (hampel->fill == hampel->window)                                                  /* check full */
+    {
+        for (k = 0; k < 3; k++)                                                          /* each axis */
+        {
+            a_hampel_replace(hampel->sorted[k], hampel->window,
+                             hampel->ring[hampel->head][k], v[k]);                       /* slide */
+            hampel->ring[hampel->head][k] = v[k];                                        /* save */
+        }
+        hampel->head = (uint8_t)((hampel->head + 1) % hampel->window);                   /* next oldest */
+    }
+    else
+    {
+        for (k = 0; k < 3; k++)                                                          /* each axis */
+        {
+            a_hampel_insert(hampel->sorted[k], hampel->fill, v[k]);                      /* grow */
+            hampel->ring[hampel->fill][k] = v[k];                                        /* save */
+        }
+        hampel->fill++;                                                                  /* count */
+    }
+    mask = 0;                                                                            /* init 0 */
+    for (k = 0; k < 3; k++)                                                              /* each axis */
+    {
+        if ((hampel->fill == hampel->window) &&
+            (a_hampel_outlier(hampel, hampel->sorted[k], v[k]) != 0))                    /* check outlier */
+        {
+            out[k] = hampel->sorted[k][hampel->window / 2];                              /* use the median */
+            mask |= (uint8_t)(1 << k);                                                   /* set mask */
+            hampel->replaced_values++;                                                   /* count value */
+        }
+        else
+        {
+            out[k] = v[k];                                                               /* pass */
+        }
+    }
+    hampel->samples++;                                                                   /* count sample */
+    if (mask != 0)                                                                       /* check mask */
+    {
+        hampel->replaced_samples++;                                                      /* count sample */
+    }
+    if (replaced != NULL)                                                                /* check replaced */
+    {
+        *replaced = mask;                                                                /* set mask */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the filter counters
+ * @param[in]  *hampel points to a hampel structure
+ * @param[out] *samples points to a pushed samples buffer
+ * @param[out] *replaced_samples points to a replaced samples buffer
+ * @param[out] *replaced_values points to a replaced axis values buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 hampel is NULL
+ *             - 3 hampel is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_hampel_get_stats(qmc5883l_hampel_t *hampel, uint32_t *samples, uint32_t *replaced_samples, uint32_t *replaced_values)
+{
+    if (hampel == NULL)                                  /* check hampel */
+    {
+        return 2;                                        /* return error */
+    }
+    if (hampel->inited != 1)                             /* check hampel initialization */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    *samples = hampel->samples;                          /* get samples */
+    *replaced_samples = hampel->replaced_samples;        /* get replaced samples */
+    *replaced_values = hampel->replaced_values;          /* get replaced values */
+    
+    return 0;                                            /* success return 0 */
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_hampel.h
+ * @brief     driver qmc5883l hampel header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_HAMPEL_H
+#define DRIVER_QMC5883L_HAMPEL_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_hampel_driver qmc5883l hampel driver function
+ * @brief    qmc5883l hampel driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l hampel definition
+ */
+#define QMC5883L_HAMPEL_MAX_WINDOW        63        /**< max window length */
+
+/**
+ * @brief qmc5883l hampel structure definition
+ */
+typedef struct qmc5883l_hampel_s
+{
+    int16_t ring[QMC5883L_HAMPEL_MAX_WINDOW][3];          /**< samples in arrival order */
+    int16_t sorted[3][QMC5883L_HAMPEL_MAX_WINDOW];        /**< samples of each axis in ascending order */
+    uint32_t samples;                                     /**< pushed samples */
+    uint32_t replaced_samples;                            /**< samples with at least one replaced axis */
+    uint32_t replaced_values;                             /**< replaced axis values */
+    uint32_t k_q8;                                        /**< threshold * 1.4826 in q8 */
+    uint8_t window;                                       /**< window length */
+    uint8_t head;                                         /**< oldest sample of the ring */
+    uint8_t fill;                                         /**< samples in the window */
+    uint8_t inited;                                       /**< inited flag */
+} qmc5883l_hampel_t;
+
+/**
+ * @brief      initialize the outlier filter
+ * @param[out] *hampel points to a hampel structure
+ * @param[in]  window is the odd window length
+ * @param[in]  threshold is the number of scaled median absolute deviations
+ * @return     status code
+ *             - 0 success
+ *             - 2 hampel is NULL
+ *             - 4 window or threshold is invalid
+ * @note       3 is a common threshold
+ */
+uint8_t qmc5883l_hampel_init(qmc5883l_hampel_t *hampel, uint8_t window, float threshold);
+
+/**
+ * @brief     clear the window and the counters
+ * @param[in] *hampel points to a hampel structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 hampel is NULL
+ *            - 3 hampel is not initialized
+ * @note      none
+ */
+uint8_t qmc5883l_hampel_reset(qmc5883l_hampel_t *hampel);
+
+/**
+ * @brief      filter a raw sample
+ * @param[in]  *hampel points to a hampel structure
+ * @param[in]  *raw points to a raw data buffer
+ * @param[out] *out points to a filtered raw data buffer
+ * @param[out] *replaced points to a replaced axis mask buffer, bit n set when axis n was replaced
+ * @return     status code
+ *             - 0 success
+ *             - 2 hampel or buffer is NULL
+ *             - 3 hampel is not initialized
+ * @note       causal, an axis is replaced by the window median when it deviates by more than
+ *             threshold * 1.4826 * mad, raw and out may be the same buffer
+ */
+uint8_t qmc5883l_hampel_push(qmc5883l_hampel_t *hampel, const int16_t raw[3], int16_t out[3], uint8_t *replaced);
+
+/**
+ * @brief      get the filter counters
+ * @param[in]  *hampel points to a hampel structure
+ * @param[out] *samples points to a pushed samples buffer
+ * @param[out] *replaced_samples points to a replaced samples buffer
+ * @param[out] *replaced_values points to a replaced axis values buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 hampel is NULL
+ *             - 3 hampel is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_hampel_get_stats(qmc5883l_hampel_t *hampel, uint32_t *samples, uint32_t *replaced_samples, uint32_t *replaced_values);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,409 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_heading.c
+ * @brief     driver qmc5883l heading source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_heading.h"
+#include <math.h>
+
+/**
+ * @brief heading definition
+ */
+#define HEADING_PI                 3.14159265f         /**< pi */
+#define HEADING_RAD_TO_DEG         57.2957795f         /**< radian to degree */
+#define HEADING_DEG_TO_RAD         0.0174532925f       /**< degree to radian */
+#define HEADING_CORDIC_GAIN        652032874           /**< 1 / cordic gain in q30 */
+#define HEADING_CORDIC_NORM        (1L << 28)          /**< cordic input normalization */
+
+/**
+ * @brief cordic arc tangent table, atan(2^-i) as 32 bit binary angles
+ */
+static const int32_t gs_cordic_atan[16] =
+{
+    536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838, 5340245,
+    2670163, 1335087, 667544, 333772, 166886, 83443, 41722, 20861,
+};
+
+/**
+ * @brief      fast sine and cosine
+ * @param[in]  deg is the angle in degrees
+ * @param[out] *s points to a sine buffer
+ * @param[out] *c points to a cosine buffer
+ * @note       quadrant reduction and 7th order polynomials on [-45, 45] degrees, error below 1e-6
+ */
+static void a_heading_sincos(float deg, float *s, float *c)
+{
+    int32_t k;
+    float r;
+    float r2;
+    float sr;
+    float cr;
+    
+    k = (int32_t)(deg * (1.0f / 90.0f) + 1024.5f) - 1024;                                                 /* nearest quadrant, |deg| below 92000 */
+    r = (deg - (float)k * 90.0f) * HEADING_DEG_TO_RAD;                                                    /* reduce */
+    r2 = r * r;                                                                                           /* square */
+    sr = r * (1.0f - r2 * (1.0f / 6.0f - r2 * (1.0f / 120.0f - r2 * (1.0f / 5040.0f))));                  /* sine */
+    cr = 1.0f - r2 * (0.5f - r2 * (1.0f / 24.0f - r2 * (1.0f / 720.0f - r2 * (1.0f / 40320.0f))));        /* cosine */
+    switch (k & 3)                                                                                        /* choose quadrant */
+    {
+        case 0 :
+        {
+            *s = sr;                                                                                      /* set sine */
+            *c = cr;                                                                                      /* set cosine */
+            
+            break;                                                                                        /* break */
+        }
+        case 1 :
+        {
+            *s = cr;                                                                                      /* set sine */
+            *c = -sr;                                                                                     /* set cosine */
+            
+            break;                                                                                        /* break */
+        }
+        case 2 :
+        {
+            *s = -sr;                                                                                     /* set sine */
+            *c = -cr;                                                                                     /* set cosine */
+            
+            break;                                                                                        /* break */
+        }
+        default :
+        {
+            *s = -cr;                                                                                     /* set sine */
+            *c = sr;                                                                                      /* set cosine */
+            
+            break;                                                                                        /* break */
+        }
+    }
+}
+
+/**
+ * @brief      fixed point sine and cosine
+ * @param[in]  angle is the binary angle
+ * @param[out] *s points to a q15 sine buffer
+ * @param[out] *c points to a q15 cosine buffer
+ * @note       16 cordic rotations
+ */
+static void a_heading_sincos_fixed(int16_t angle, int32_t *s, int32_t *c)
+{
+    int32_t a;
+    int32_t x;
+    int32_t y;
+    int32_t z;
+    uint8_t negate;
+    uint8_t i;
+    
+    a = angle;                                   /* get angle */
+    negate = 0;                                  /* init 0 */
+    if (a > 16384)                               /* above 90 degrees */
+    {
+        a -= 32768;                              /* rotate back 180 degrees */
+        negate = 1;                              /* set negate */
+    }
+    else if (a < -16384)                         /* below -90 degrees */
+    {
+        a += 32768;                              /* rotate 180 degrees */
+        negate = 1;                              /* set negate */
+    }
+    x = HEADING_CORDIC_GAIN;                     /* start with the inverse gain */
+    y = 0;                                       /* init 0 */
+    z = a * 65536;                               /* 32 bit binary angle */
+    for (i = 0; i < 16; i++)                     /* rotate */
+    {
+        int32_t m;
+        int32_t xn;
+        
+        m = (z < 0) ? -1 : 0;                    /* branchless direction, -1 to rotate back */
+        xn = x - (((y >> i) ^ m) - m);           /* rotate x */
+        y = y + (((x >> i) ^ m) - m);            /* rotate y */
+        z -= (gs_cordic_atan[i] ^ m) - m;        /* update angle */
+        x = xn;                                  /* set x */
+    }
+    x = (x + (1 << 14)) >> 15;                   /* q30 to q15 */
+    y = (y + (1 << 14)) >> 15;                   /* q30 to q15 */
+    *c = (negate != 0) ? -x : x;                 /* set cosine */
+    *s = (negate != 0) ? -y : y;                 /* set sine */
+}
+
+/**
+ * @brief     heading from the horizontal field
+ * @param[in] xh is the north component
+ * @param[in] yh is the east component
+ * @return    heading in [0, 360)
+ * @note      none
+ */
+static float a_heading_wrap(float xh, float yh)
+{
+    float h;
+    
+    h = qmc5883l_heading_atan2(-yh, xh);        /* clockwise from north */
+    if (h < 0.0f)                               /* check negative */
+    {
+        h += 360.0f;                            /* wrap */
+    }
+    if (h >= 360.0f)                            /* check rounding */
+    {
+        h -= 360.0f;                            /* wrap */
+    }
+    
+    return h;                                   /* return heading */
+}
+
+/**
+ * @brief     fast atan2
+ * @param[in] y is the y value
+ * @param[in] x is the x value
+ * @return    angle in degrees in (-180, 180]
+ * @note      9th order polynomial, the error is below QMC5883L_HEADING_ATAN2_MAX_ERROR, atan2(0, 0) is 0
+ */
+float qmc5883l_heading_atan2(float y, float x)
+{
+    float ax;
+    float ay;
+    float z;
+    float z2;
+    float a;
+    
+    ax = fabsf(x);                                                                                               /* abs x */
+    ay = fabsf(y);                                                                                               /* abs y */
+    if ((ax == 0.0f) && (ay == 0.0f))                                                                            /* check zero */
+    {
+        return 0.0f;                                                                                             /* return 0 */
+    }
+    z = (ay <= ax) ? (ay / ax) : (ax / ay);                                                                      /* ratio in [0, 1] */
+    z2 = z * z;                                                                                                  /* square */
+    a = z * (0.9998660f + z2 * (-0.3302995f + z2 * (0.1801410f + z2 * (-0.0851330f + z2 * 0.0208351f))));        /* atan on [0, 1] */
+    if (ay > ax)                                                                                                 /* check octant */
+    {
+        a = 0.5f * HEADING_PI - a;                                                                               /* mirror */
+    }
+    if (x < 0.0f)                                                                                                /* check left half */
+    {
+        a = HEADING_PI - a;                                                                                      /* mirror */
+    }
+    if (y < 0.0f)                                                                                                /* check lower half */
+    {
+        a = -a;                                                                                                  /* negate */
+    }
+    
+    return a * HEADING_RAD_TO_DEG;                                                                               /* return degrees */
+}
+
+/**
+ * @brief     fixed point atan2
+ * @param[in] y is the y value
+ * @param[in] x is the x value
+ * @return    binary angle, QMC5883L_HEADING_TURN is a full turn
+ * @note      16 cordic iterations, |x| and |y| must be below 2^29
+ */
+uint16_t qmc5883l_heading_atan2_fixed(int32_t y, int32_t x)
+{
+    uint32_t angle;
+    int32_t m;
+    uint8_t i;
+    
+    if ((x == 0) && (y == 0))                                        /* check zero */
+    {
+        return 0;                                                    /* return 0 */
+    }
+    angle = 0;                                                       /* init 0 */
+    if (x < 0)                                                       /* check left half */
+    {
+        x = -x;                                                      /* rotate x 180 degrees */
+        y = -y;                                                      /* rotate y 180 degrees */
+        angle = 0x80000000U;                                         /* start at 180 degrees */
+    }
+    m = (x > ((y < 0) ? -y : y)) ? x : ((y < 0) ? -y : y);           /* max component */
+    while (m < (HEADING_CORDIC_NORM >> 8))                           /* coarse normalize */
+    {
+        x *= 256;                                                    /* scale x */
+        y *= 256;                                                    /* scale y */
+        m *= 256;                                                    /* scale max */
+    }
+    while (m < HEADING_CORDIC_NORM)                                  /* fine normalize */
+    {
+        x *= 2;                                                      /* scale x */
+        y *= 2;                                                      /* scale y */
+        m *= 2;                                                      /* scale max */
+    }
+    for (i = 0; i < 16; i++)                                         /* vectoring */
+    {
+        int32_t dir;
+        int32_t xn;
+        
+        dir = (y > 0) ? 0 : -1;                                      /* branchless direction, -1 to rotate up */
+        xn = x + (((y >> i) ^ dir) - dir);                           /* rotate x */
+        y = y - (((x >> i) ^ dir) - dir);                            /* rotate y */
+        angle += (uint32_t)((gs_cordic_atan[i] ^ dir) - dir);        /* update angle */
+        x = xn;                                                      /* set x */
+    }
+    
+    return (uint16_t)((angle + 0x8000U) >> 16);                      /* round to 16 bits */
+}
+
+/**
+ * @brief      heading of a level sensor
+ * @param[in]  *m_gauss points to a calibrated data buffer
+ * @param[out] *deg points to a heading buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       x forward, y right, z down, heading is clockwise from magnetic north in [0, 360)
+ */
+uint8_t qmc5883l_heading_flat(const float m_gauss[3], float *deg)
+{
+    if ((m_gauss == NULL) || (deg == NULL))               /* check buffer */
+    {
+        return 2;                                         /* return error */
+    }
+    
+    *deg = a_heading_wrap(m_gauss[0], m_gauss[1]);        /* get heading */
+    
+    return 0;                                             /* success return 0 */
+}
+
+/**
+ * @brief      tilt compensated heading
+ * @param[in]  *m_gauss points to a calibrated data buffer
+ * @param[in]  pitch is the nose up pitch in degrees
+ * @param[in]  roll is the right side down roll in degrees
+ * @param[out] *deg points to a heading buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       x forward, y right, z down, heading is clockwise from magnetic north in [0, 360)
+ */
+uint8_t qmc5883l_heading_tilt(const float m_gauss[3], float pitch, float roll, float *deg)
+{
+    float sp;
+    float cp;
+    float sr;
+    float cr;
+    float xh;
+    float yh;
+    
+    if ((m_gauss == NULL) || (deg == NULL))                                    /* check buffer */
+    {
+        return 2;                                                              /* return error */
+    }
+    
+    a_heading_sincos(pitch, &sp, &cp);                                         /* pitch terms */
+    a_heading_sincos(roll, &sr, &cr);                                          /* roll terms */
+    xh = m_gauss[0] * cp + m_gauss[1] * sr * sp + m_gauss[2] * cr * sp;        /* north component */
+    yh = m_gauss[1] * cr - m_gauss[2] * sr;                                    /* east component */
+    *deg = a_heading_wrap(xh, yh);                                             /* get heading */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      fixed point tilt compensated heading
+ * @param[in]  *raw points to a calibrated raw data buffer
+ * @param[in]  pitch is the nose up pitch as a binary angle
+ * @param[in]  roll is the right side down roll as a binary angle
+ * @param[out] *angle points to a heading buffer as a binary angle
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       no floating point is used, pass 0 for a level sensor
+ */
+uint8_t qmc5883l_heading_fixed(const int16_t raw[3], int16_t pitch, int16_t roll, uint16_t *angle)
+{
+    int32_t sp;
+    int32_t cp;
+    int32_t sr;
+    int32_t cr;
+    int32_t xh;
+    int32_t yh;
+    
+    if ((raw == NULL) || (angle == NULL))                    /* check buffer */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    a_heading_sincos_fixed(pitch, &sp, &cp);                 /* pitch terms */
+    a_heading_sincos_fixed(roll, &sr, &cr);                  /* roll terms */
+    xh = ((raw[0] * cp) / 32) + ((raw[1] * ((sr * sp) / 32768)) / 32)
+         + ((raw[2] * ((cr * sp) / 32768)) / 32);            /* north component in q10 */
+    yh = ((raw[1] * cr) / 32) - ((raw[2] * sr) / 32);        /* east component in q10 */
+    *angle = qmc5883l_heading_atan2_fixed(-yh, xh);          /* clockwise from north */
+    
+    return 0;                                                /* success return 0 */
+}
+
+/**
+ * @brief      tilt compensated heading of many samples
+ * @param[in]  **m_gauss points to a calibrated data array
+ * @param[in]  **pitch_roll points to a pitch and roll array in degrees, NULL for level samples
+ * @param[out] *deg points to a heading array
+ * @param[in]  len is the number of samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_heading_batch(const float (*m_gauss)[3], const float (*pitch_roll)[2], float *deg, uint32_t len)
+{
+    uint32_t i;
+    
+    if ((m_gauss == NULL) || (deg == NULL))                                          /* check buffer */
+    {
+        return 2;                                                                    /* return error */
+    }
+    
+    if (pitch_roll == NULL)                                                          /* check level */
+    {
+        for (i = 0; i < len; i++)                                                    /* each sample */
+        {
+            deg[i] = a_heading_wrap(m_gauss[i][0], m_gauss[i][1]);                   /* get heading */
+        }
+    }
+    else
+    {
+        for (i = 0; i < len; i++)                                                    /* each sample */
+        {
+            float sp;
+            float cp;
+            float sr;
+            float cr;
+            
+            a_heading_sincos(pitch_roll[i][0], &sp, &cp);                            /* pitch terms */
+            a_heading_sincos(pitch_roll[i][1], &sr, &cr);                            /* roll terms */
+            deg[i] = a_heading_wrap(m_gauss[i][0] * cp + m_gauss[i][1] * sr * sp + m_gauss[i][2] * cr * sp,
+                                    m_gauss[i][1] * cr - m_gauss[i][2] * sr);        /* get heading */
+        }
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_heading.h
+ * @brief     driver qmc5883l heading header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_HEADING_H
+#define DRIVER_QMC5883L_HEADING_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_heading_driver qmc5883l heading driver function
+ * @brief    qmc5883l heading driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l heading definition
+ */
+#define QMC5883L_HEADING_ATAN2_MAX_ERROR        0.001f         /**< max float atan2 error in degrees */
+#define QMC5883L_HEADING_TURN                   65536U         /**< binary angle of a full turn */
+
+/**
+ * @brief     fast atan2
+ * @param[in] y is the y value
+ * @param[in] x is the x value
+ * @return    angle in degrees in (-180, 180]
+ * @note      9th order polynomial, the error is below QMC5883L_HEADING_ATAN2_MAX_ERROR, atan2(0, 0) is 0
+ */
+float qmc5883l_heading_atan2(float y, float x);
+
+/**
+ * @brief     fixed point atan2
+ * @param[in] y is the y value
+ * @param[in] x is the x value
+ * @return    binary angle, QMC5883L_HEADING_TURN is a full turn
+ * @note      16 cordic iterations, |x| and |y| must be below 2^29
+ */
+uint16_t qmc5883l_heading_atan2_fixed(int32_t y, int32_t x);
+
+/**
+ * @brief      heading of a level sensor
+ * @param[in]  *m_gauss points to a calibrated data buffer
+ * @param[out] *deg points to a heading buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       x forward, y right, z down, heading is clockwise from magnetic north in [0, 360)
+ */
+uint8_t qmc5883l_heading_flat(const float m_gauss[3], float *deg);
+
+/**
+ * @brief      tilt compensated heading
+ * @param[in]  *m_gauss points to a calibrated data buffer
+ * @param[in]  pitch is the nose up pitch in degrees
+ * @param[in]  roll is the right side down roll in degrees
+ * @param[out] *deg points to a heading buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       x forward, y right, z down, heading is clockwise from magnetic north in [0, 360)
+ */
+uint8_t qmc5883l_heading_tilt(const float m_gauss[3], float pitch, float roll, float *deg);
+
+/**
+ * @brief      fixed point tilt compensated heading
+ * @param[in]  *raw points to a calibrated raw data buffer
+ * @param[in]  pitch is the nose up pitch as a binary angle
+ * @param[in]  roll is the right side down roll as a binary angle
+ * @param[out] *angle points to a heading buffer as a binary angle
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       no floating point is used, pass 0 for a level sensor
+ */
+uint8_t qmc5883l_heading_fixed(const int16_t raw[3], int16_t pitch, int16_t roll, uint16_t *angle);
+
+/**
+ * @brief      tilt compensated heading of many samples
+ * @param[in]  **m_gauss points to a calibrated data array
+ * @param[in]  **pitch_roll points to a pitch and roll array in degrees, NULL for level samples
+ * @param[out] *deg points to a heading array
+ * @param[in]  len is the number of samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_heading_batch(const float (*m_gauss)[3], const float (*pitch_roll)[2], float *deg, uint32_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,310 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_mains.c
+ * @brief     driver qmc5883l mains source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_mains.h"
+#include <math.h>
+
+/**
+ * @brief mains definition
+ */
+#define MAINS_PI        3.14159265358979323846        /**< pi */
+
+/**
+ * @brief      initialize the mains interference detector
+ * @param[out] *mains points to a mains structure
+ * @param[in]  rate_hz is the output data rate
+ * @param[in]  mains_hz is the mains frequency
+ * @param[in]  harmonics is the number of watched mains harmonics
+ * @param[in]  block is the goertzel block length in samples
+ * @param[in]  notch_width_hz is the notch -3dB width, 0 disables the notch
+ * @return     status code
+ *             - 0 success
+ *             - 2 mains is NULL
+ *             - 4 param is invalid or every harmonic aliases to dc
+ * @note       the harmonics are folded into 0 to rate_hz / 2, repeated bins and bins at dc are dropped,
+ *             a block of rate_hz samples gives 1Hz bins
+ */
+uint8_t qmc5883l_mains_init(qmc5883l_mains_t *mains, float rate_hz, float mains_hz, uint8_t harmonics,
+                            uint32_t block, float notch_width_hz)
+{
+    uint32_t bins[QMC5883L_MAINS_MAX_TONES];
+    uint8_t h;
+    
+    if (mains == NULL)                                                                          /* check mains */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if ((rate_hz <= 0.0f) || (mains_hz <= 0.0f) || (harmonics < 1) ||
+        (harmonics > QMC5883L_MAINS_MAX_HARMONIC) || (block < QMC5883L_MAINS_MIN_BLOCK))        /* check param */
+    {
+        return 4;                                                                               /* return error */
+    }
+    if ((notch_width_hz < 0.0f) || (notch_width_hz >= (rate_hz / 4.0f)))                        /* check width */
+    {
+        return 4;                                                                               /* return error */
+    }
+    
+    memset(mains, 0, sizeof(qmc5883l_mains_t));                                                 /* clear all */
+    for (h = 1; (h <= harmonics) && (mains->tones < QMC5883L_MAINS_MAX_TONES); h++)             /* each harmonic */
+    {
+        double f;
+        uint32_t bin;
+        uint8_t i;
+        
+        f = fmod((double)mains_hz * h, (double)rate_hz);                                        /* fold */
+        f = (f > (double)rate_hz / 2.0) ? ((double)rate_hz - f) : f;                            /* mirror */
+        bin = (uint32_t)(f * block / (double)rate_hz + 0.5);                                    /* nearest bin */
+        if (bin == 0)                                                                           /* check dc */
+        {
+            continue;                                                                           /* skip */
+        }
+        for (i = 0; i < mains->tones; i++)                                                      /* check repeated */
+        {
+            if (bins[i] == bin)                                                                 /* same bin */
+            {
+                break;                                                                          /* break */
+            }
+        }
+        if (i != mains->tones)                                                                  /* check found */
+        {
+            continue;                                                                           /* skip */
+        }
+        bins[mains->tones] = bin;                                                               /* save bin */
+        mains->freq[mains->tones] = (float)f;                                                   /* save frequency */
+        mains->coeff[mains->tones] = (float)(2.0 * cos(2.0 * MAINS_PI * bin / block));          /* goertzel coefficient */
+        mains->scale[mains->tones] = ((2 * bin) == block) ? (1.0f / (float)block) :
+                                                            (2.0f / (float)block);              /* nyquist bin is not split */
+        if (notch_width_hz > 0.0f)                                                              /* check notch */
+        {
+            double c;
+            double r;
+            double g;
+            
+            c = cos(2.0 * MAINS_PI * f / (double)rate_hz);                                      /* zero angle */
+            r = 1.0 - MAINS_PI * (double)notch_width_hz / (double)rate_hz;                      /* pole radius */
+            g = (1.0 - 2.0 * r * c + r * r) / (2.0 - 2.0 * c);                                  /* unity dc gain */
+            mains->b0[mains->tones] = (float)g;                                                 /* set b0 */
+            mains->b1[mains->tones] = (float)(-2.0 * c * g);                                    /* set b1 */
+            mains->a1[mains->tones] = (float)(-2.0 * r * c);                                    /* set a1 */
+            mains->a2[mains->tones] = (float)(r * r);                                           /* set a2 */
+        }
+        mains->tones++;                                                                         /* next tone */
+    }
+    if (mains->tones == 0)                                                                      /* check tones */
+    {
+        return 4;                                                                               /* return error */
+    }
+    mains->block = block;                                                                       /* set block */
+    mains->notch = (notch_width_hz > 0.0f) ? 1 : 0;                                             /* set notch */
+    mains->inited = 1;                                                                          /* flag inited */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     clear the filter states and the estimates
+ * @param[in] *mains points to a mains structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 mains is NULL
+ *            - 3 mains is not initialized
+ * @note      none
+ */
+uint8_t qmc5883l_mains_reset(qmc5883l_mains_t *mains)
+{
+    if (mains == NULL)                                            /* check mains */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (mains->inited != 1)                                       /* check mains initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    
+    memset(mains->s1, 0, sizeof(mains->s1));                      /* clear goertzel */
+    memset(mains->s2, 0, sizeof(mains->s2));                      /* clear goertzel */
+    memset(mains->amplitude, 0, sizeof(mains->amplitude));        /* clear estimates */
+    memset(mains->z1, 0, sizeof(mains->z1));                      /* clear notch */
+    memset(mains->z2, 0, sizeof(mains->z2));                      /* clear notch */
+    mains->n = 0;                                                 /* clear block */
+    mains->blocks = 0;                                            /* clear blocks */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief      push a sample
+ * @param[in]  *mains points to a mains structure
+ * @param[in]  *m_gauss points to a converted data buffer
+ * @param[out] *out points to a filtered data buffer
+ * @param[out] *ready points to a block finished flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 mains or buffer is NULL
+ *             - 3 mains is not initialized
+ * @note       the detector watches the unfiltered input, out equals the input when the notch is disabled,
+ *             m_gauss and out may be the same buffer
+ */
+uint8_t qmc5883l_mains_push(qmc5883l_mains_t *mains, const float m_gauss[3], float out[3], uint8_t *ready)
+{
+    float x[3];
+    uint8_t t;
+    uint8_t k;
+    
+    if ((mains == NULL) || (m_gauss == NULL) || (out == NULL) || (ready == NULL))        /* check mains and buffer */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (mains->inited != 1)                                                              /* check mains initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    x[0] = m_gauss[0];                                                                   /* copy x */
+    x[1] = m_gauss[1];                                                                   /* copy y */
+    x[2] = m_gauss[2];                                                                   /* copy z */
+    for (t = 0; t < mains->tones; t++)                                                   /* each tone */
+    {
+        for (k = 0; k < 3; k++)                                                          /* each axis */
+        {
+            float s;
+            
+            s = x[k] + mains->coeff[t] * mains->s1[t][k] - mains->s2[t][k];              /* goertzel step */
+            mains->s2[t][k] = mains->s1[t][k];                                           /* shift */
+            mains->s1[t][k] = s;                                                         /* shift */
+        }
+    }
+    mains->n++;                                                                          /* count */
+    *ready = 0;                                                                          /* init 0 */
+    if (mains->n == mains->block)                                                        /* check block */
+    {
+        for (t = 0; t < mains->tones; t++)                                               /* each tone */
+        {
+            for (k = 0; k < 3; k++)                                                      /* each axis */
+            {
+                float s1;
+                float s2;
+                float p;
+                
+                s1 = mains->s1[t][k];                                                    /* get state */
+                s2 = mains->s2[t][k];                                                    /* get state */
+                p = s1 * s1 + s2 * s2 - mains->coeff[t] * s1 * s2;                       /* bin power */
+                p = (p > 0.0f) ? p : 0.0f;                                               /* clamp rounding */
+                mains->amplitude[t][k] = mains->scale[t] * sqrtf(p);                     /* amplitude */
+                mains->s1[t][k] = 0.0f;                                                  /* restart */
+                mains->s2[t][k] = 0.0f;                                                  /* restart */
+            }
+        }
+        mains->n = 0;                                                                    /* next block */
+        mains->blocks++;                                                                 /* count block */
+        *ready = 1;                                                                      /* set ready */
+    }
+    if (mains->notch != 0)                                                               /* check notch */
+    {
+        for (t = 0; t < mains->tones; t++)                                               /* cascade */
+        {
+            for (k = 0; k < 3; k++)                                                      /* each axis */
+            {
+                float y;
+                
+                y = mains->b0[t] * x[k] + mains->z1[t][k];                               /* output */
+                mains->z1[t][k] = mains->b1[t] * x[k] - mains->a1[t] * y +
+                                  mains->z2[t][k];                                       /* state 1 */
+                mains->z2[t][k] = mains->b0[t] * x[k] - mains->a2[t] * y;                /* state 2 */
+                x[k] = y;                                                                /* next section */
+            }
+        }
+    }
+    out[0] = x[0];                                                                       /* set x */
+    out[1] = x[1];                                                                       /* set y */
+    out[2] = x[2];                                                                       /* set z */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the watched tones
+ * @param[in]  *mains points to a mains structure
+ * @param[out] *freq points to a frequency buffer of QMC5883L_MAINS_MAX_TONES
+ * @param[out] *tones points to a tone number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 mains is NULL
+ *             - 3 mains is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_mains_get_tones(qmc5883l_mains_t *mains, float freq[QMC5883L_MAINS_MAX_TONES], uint8_t *tones)
+{
+    if (mains == NULL)                                     /* check mains */
+    {
+        return 2;                                          /* return error */
+    }
+    if (mains->inited != 1)                                /* check mains initialization */
+    {
+        return 3;                                          /* return error */
+    }
+    
+    memcpy(freq, mains->freq, sizeof(mains->freq));        /* get frequencies */
+    *tones = mains->tones;                                 /* get tones */
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the interference amplitude of the last block
+ * @param[in]  *mains points to a mains structure
+ * @param[out] *amplitude points to an amplitude buffer in m_gauss, one row per tone
+ * @return     status code
+ *             - 0 success
+ *             - 2 mains is NULL
+ *             - 3 no block is finished
+ * @note       none
+ */
+uint8_t qmc5883l_mains_get_amplitude(qmc5883l_mains_t *mains, float amplitude[QMC5883L_MAINS_MAX_TONES][3])
+{
+    if (mains == NULL)                                                    /* check mains */
+    {
+        return 2;                                                         /* return error */
+    }
+    if ((mains->inited != 1) || (mains->blocks == 0))                     /* check block */
+    {
+        return 3;                                                         /* return error */
+    }
+    
+    memcpy(amplitude, mains->amplitude, sizeof(mains->amplitude));        /* get amplitude */
+    
+    return 0;                                                             /* success return 0 */
+}
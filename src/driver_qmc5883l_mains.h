@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_mains.h
+ * @brief     driver qmc5883l mains header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_MAINS_H
+#define DRIVER_QMC5883L_MAINS_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_mains_driver qmc5883l mains driver function
+ * @brief    qmc5883l mains driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l mains definition
+ */
+#define QMC5883L_MAINS_MAX_TONES        4         /**< max watched aliased frequencies */
+#define QMC5883L_MAINS_MAX_HARMONIC     8         /**< max mains harmonic */
+#define QMC5883L_MAINS_MIN_BLOCK        16        /**< min goertzel block length */
+
+/**
+ * @brief qmc5883l mains structure definition
+ */
+typedef struct qmc5883l_mains_s
+{
+    float freq[QMC5883L_MAINS_MAX_TONES];                    /**< aliased tone frequency in Hz */
+    float coeff[QMC5883L_MAINS_MAX_TONES];                   /**< goertzel 2cos(w) of the tone bin */
+    float scale[QMC5883L_MAINS_MAX_TONES];                   /**< power to amplitude scale */
+    float s1[QMC5883L_MAINS_MAX_TONES][3];                   /**< goertzel state n - 1 */
+    float s2[QMC5883L_MAINS_MAX_TONES][3];                   /**< goertzel state n - 2 */
+    float amplitude[QMC5883L_MAINS_MAX_TONES][3];            /**< last block amplitude in m_gauss */
+    float b0[QMC5883L_MAINS_MAX_TONES];                      /**< notch b0 and b2 */
+    float b1[QMC5883L_MAINS_MAX_TONES];                      /**< notch b1 */
+    float a1[QMC5883L_MAINS_MAX_TONES];                      /**< notch a1 */
+    float a2[QMC5883L_MAINS_MAX_TONES];                      /**< notch a2 */
+    float z1[QMC5883L_MAINS_MAX_TONES][3];                   /**< notch state 1 */
+    float z2[QMC5883L_MAINS_MAX_TONES][3];                   /**< notch state 2 */
+    uint32_t block;                                          /**< goertzel block length */
+    uint32_t n;                                              /**< samples in the current block */
+    uint32_t blocks;                                         /**< finished blocks */
+    uint8_t tones;                                           /**< watched tones */
+    uint8_t notch;                                           /**< notch enable */
+    uint8_t inited;                                          /**< inited flag */
+} qmc5883l_mains_t;
+
+/**
+ * @brief      initialize the mains interference detector
+ * @param[out] *mains points to a mains structure
+ * @param[in]  rate_hz is the output data rate
+ * @param[in]  mains_hz is the mains frequency
+ * @param[in]  harmonics is the number of watched mains harmonics
+ * @param[in]  block is the goertzel block length in samples
+ * @param[in]  notch_width_hz is the notch -3dB width, 0 disables the notch
+ * @return     status code
+ *             - 0 success
+ *             - 2 mains is NULL
+ *             - 4 param is invalid or every harmonic aliases to dc
+ * @note       the harmonics are folded into 0 to rate_hz / 2, repeated bins and bins at dc are dropped,
+ *             a block of rate_hz samples gives 1Hz bins
+ */
+uint8_t qmc5883l_mains_init(qmc5883l_mains_t *mains, float rate_hz, float mains_hz, uint8_t harmonics,
+                            uint32_t block, float notch_width_hz);
+
+/**
+ * @brief     clear the filter states and the estimates
+ * @param[in] *mains points to a mains structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 mains is NULL
+ *            - 3 mains is not initialized
+ * @note      none
+ */
+uint8_t qmc5883l_mains_reset(qmc5883l_mains_t *mains);
+
+/**
+ * @brief      push a sample
+ * @param[in]  *mains points to a mains structure
+ * @param[in]  *m_gauss points to a converted data buffer
+ * @param[out] *out points to a filtered data buffer
+ * @param[out] *ready points to a block finished flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 mains or buffer is NULL
+ *             - 3 mains is not initialized
+ * @note       the detector watches the unfiltered input, out equals the input when the notch is disabled,
+ *             m_gauss and out may be the same buffer
+ */
+uint8_t qmc5883l_mains_push(qmc5883l_mains_t *mains, const float m_gauss[3], float out[3], uint8_t *ready);
+
+/**
+ * @brief      get the watched tones
+ * @param[in]  *mains points to a mains structure
+ * @param[out] *freq points to a frequency buffer of QMC5883L_MAINS_MAX_TONES
+ * @param[out] *tones points to a tone number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 mains is NULL
+ *             - 3 mains is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_mains_get_tones(qmc5883l_mains_t *mains, float freq[QMC5883L_MAINS_MAX_TONES], uint8_t *tones);
+
+/**
+ * @brief      get the interference amplitude of the last block
+ * @param[in]  *mains points to a mains structure
+ * @param[out] *amplitude points to an amplitude buffer in m_gauss, one row per tone
+ * @return     status code
+ *             - 0 success
+ *             - 2 mains is NULL
+ *             - 3 no block is finished
+ * @note       none
+ */
+uint8_t qmc5883l_mains_get_amplitude(qmc5883l_mains_t *mains, float amplitude[QMC5883L_MAINS_MAX_TONES][3]);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
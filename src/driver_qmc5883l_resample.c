@@ -0,0 +1,284 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_resample.c
+ * @brief     driver qmc5883l resample source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_resample.h"
+#include <math.h>
+
+/**
+ * @brief     start or restart the estimate
+ * @param[in] *rs points to a resample structure
+ * @param[in] t is the data ready time
+ * @param[in] *m_gauss points to a data buffer
+ * @note      the grid continues at the first point after t
+ */
+static void a_resample_start(qmc5883l_resample_t *rs, double t, const float m_gauss[3])
+{
+    rs->period_us = rs->nominal_us;                                    /* nominal period */
+    rs->time_us = t;                                                   /* first time */
+    rs->n = 1;                                                         /* one sample */
+    rs->t[3] = t;                                                      /* history time */
+    rs->m[3][0] = m_gauss[0];                                          /* history x */
+    rs->m[3][1] = m_gauss[1];                                          /* history y */
+    rs->m[3][2] = m_gauss[2];                                          /* history z */
+    rs->filled = 1;                                                    /* one valid */
+    rs->next = (uint64_t)ceil(t * rs->out_rate_hz / 1000000.0);        /* first grid point */
+}
+
+/**
+ * @brief      interpolate one grid point
+ * @param[in]  *rs points to a resample structure
+ * @param[in]  u is the position in the interval in [0, 1)
+ * @param[out] *out points to an output buffer
+ * @note       linear uses the last two samples, cubic the last four
+ */
+static void a_resample_point(qmc5883l_resample_t *rs, float u, float out[3])
+{
+    uint8_t a;
+    
+    for (a = 0; a < 3; a++)                                                                     /* each axis */
+    {
+        if (rs->method == QMC5883L_RESAMPLE_LINEAR)                                             /* linear */
+        {
+            out[a] = rs->m[2][a] + u * (rs->m[3][a] - rs->m[2][a]);                             /* between the last two */
+        }
+        else
+        {
+            float p0 = rs->m[0][a];
+            float p1 = rs->m[1][a];
+            float p2 = rs->m[2][a];
+            float p3 = rs->m[3][a];
+            
+            out[a] = p1 + 0.5f * u * (p2 - p0 + u * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3 +
+                                                     u * (3.0f * (p1 - p2) + p3 - p0)));        /* catmull rom */
+        }
+    }
+}
+
+/**
+ * @brief      initialize the resampler
+ * @param[out] *rs points to a resample structure
+ * @param[in]  rate_hz is the nominal output data rate of the chip
+ * @param[in]  out_rate_hz is the rate of the host grid
+ * @param[in]  method is the interpolation method
+ * @param[in]  time_constant is the steady tracking time constant in samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 rs is NULL
+ *             - 4 param is invalid
+ * @note       out_rate_hz must not exceed QMC5883L_RESAMPLE_MAX_RATIO * rate_hz, time_constant must be at least 2
+ */
+uint8_t qmc5883l_resample_init(qmc5883l_resample_t *rs, float rate_hz, float out_rate_hz,
+                               qmc5883l_resample_method_t method, uint32_t time_constant)
+{
+    if (rs == NULL)                                                       /* check rs */
+    {
+        return 2;                                                         /* return error */
+    }
+    if ((rate_hz <= 0.0f) || (out_rate_hz <= 0.0f) ||
+        (out_rate_hz > QMC5883L_RESAMPLE_MAX_RATIO * rate_hz) ||
+        (method > QMC5883L_RESAMPLE_CUBIC) || (time_constant < 2))        /* check param */
+    {
+        return 4;                                                         /* return error */
+    }
+    
+    memset(rs, 0, sizeof(qmc5883l_resample_t));                           /* clear all */
+    rs->nominal_us = 1000000.0 / rate_hz;                                 /* nominal period */
+    rs->period_us = rs->nominal_us;                                       /* start nominal */
+    rs->out_rate_hz = out_rate_hz;                                        /* set grid rate */
+    rs->alpha = 2.0f / (float)(time_constant + 1);                        /* phase gain */
+    rs->beta = rs->alpha * rs->alpha / (2.0f - rs->alpha);                /* benedict bordner period gain */
+    rs->method = (uint8_t)method;                                         /* set method */
+    rs->inited = 1;                                                       /* flag inited */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      push one sample and get the grid points it completes
+ * @param[in]  *rs points to a resample structure
+ * @param[in]  time_us is the host time the data ready was seen
+ * @param[in]  *m_gauss points to a data buffer
+ * @param[out] *out points to an output buffer
+ * @param[out] *out_time_us points to an output grid time buffer
+ * @param[out] *count points to an output count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rs or buffer is NULL
+ *             - 3 rs is not initialized
+ * @note       the data ready times are fitted by least squares while the estimate starts and by a second
+ *             order tracking loop after time_constant samples, lost samples are detected from the gap,
+ *             a gap over QMC5883L_RESAMPLE_MAX_GAP periods or a time step back restarts the estimate
+ */
+uint8_t qmc5883l_resample_push(qmc5883l_resample_t *rs, uint64_t time_us, const float m_gauss[3],
+                               float out[QMC5883L_RESAMPLE_MAX_OUT][3], uint64_t out_time_us[QMC5883L_RESAMPLE_MAX_OUT],
+                               uint8_t *count)
+{
+    double t;
+    double r;
+    double a;
+    double b;
+    double lo;
+    double hi;
+    double steps;
+    uint32_t k;
+    uint8_t i;
+    
+    if ((rs == NULL) || (m_gauss == NULL) || (out == NULL) ||
+        (out_time_us == NULL) || (count == NULL))                                           /* check rs and buffers */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (rs->inited != 1)                                                                    /* check rs initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    *count = 0;                                                                             /* no point yet */
+    t = (double)time_us;                                                                    /* measured time */
+    steps = (t - rs->time_us) / rs->period_us;                                              /* periods since the last sample */
+    if ((rs->n == 0) || (steps <= 0.0) || (steps > QMC5883L_RESAMPLE_MAX_GAP + 0.5))        /* check gap */
+    {
+        a_resample_start(rs, t, m_gauss);                                                   /* restart */
+        
+        return 0;                                                                           /* success return 0 */
+    }
+    k = (uint32_t)(steps + 0.5);                                                            /* nearest whole period */
+    k = (k == 0) ? 1 : k;                                                                   /* early edge is one period */
+    rs->missed += k - 1;                                                                    /* lost samples */
+    rs->n += k;                                                                             /* fitted periods */
+    
+    /* least squares line while it is tighter than the steady loop */
+    a = 2.0 * (2.0 * rs->n - 1.0) / ((double)rs->n * (rs->n + 1.0));                        /* least squares phase gain */
+    b = 6.0 / ((double)rs->n * (rs->n + 1.0));                                              /* least squares period gain */
+    a = (a < rs->alpha) ? rs->alpha : a;                                                    /* steady floor */
+    b = (b < rs->beta) ? rs->beta : b;                                                      /* steady floor */
+    r = t - (rs->time_us + k * rs->period_us);                                              /* phase error */
+    rs->time_us += k * rs->period_us + a * r;                                               /* smoothed time */
+    rs->period_us += b * r / k;                                                             /* period */
+    if (rs->period_us > rs->nominal_us * (1.0 + QMC5883L_RESAMPLE_MAX_ERROR))               /* check slow */
+    {
+        rs->period_us = rs->nominal_us * (1.0 + QMC5883L_RESAMPLE_MAX_ERROR);               /* limit */
+    }
+    if (rs->period_us < rs->nominal_us * (1.0 - QMC5883L_RESAMPLE_MAX_ERROR))               /* check fast */
+    {
+        rs->period_us = rs->nominal_us * (1.0 - QMC5883L_RESAMPLE_MAX_ERROR);               /* limit */
+    }
+    
+    /* history */
+    for (i = 0; i < 3; i++)                                                                 /* shift */
+    {
+        rs->t[i] = rs->t[i + 1];                                                            /* time */
+        rs->m[i][0] = rs->m[i + 1][0];                                                      /* x */
+        rs->m[i][1] = rs->m[i + 1][1];                                                      /* y */
+        rs->m[i][2] = rs->m[i + 1][2];                                                      /* z */
+    }
+    rs->t[3] = rs->time_us;                                                                 /* newest time */
+    rs->m[3][0] = m_gauss[0];                                                               /* newest x */
+    rs->m[3][1] = m_gauss[1];                                                               /* newest y */
+    rs->m[3][2] = m_gauss[2];                                                               /* newest z */
+    rs->filled = (rs->filled < 4) ? (uint8_t)(rs->filled + 1) : 4;                          /* valid history */
+    if (rs->method == QMC5883L_RESAMPLE_LINEAR)                                             /* linear */
+    {
+        lo = rs->t[2];                                                                      /* previous sample */
+        hi = rs->t[3];                                                                      /* newest sample */
+    }
+    else if (rs->filled < 4)                                                                /* cubic still filling */
+    {
+        return 0;                                                                           /* success return 0 */
+    }
+    else
+    {
+        lo = rs->t[1];                                                                      /* one sample late */
+        hi = rs->t[2];                                                                      /* one sample late */
+    }
+    
+    /* grid points in [lo, hi) */
+    while (1)                                                                               /* each grid point */
+    {
+        double g = (double)rs->next * 1000000.0 / rs->out_rate_hz;                          /* grid time */
+        
+        if (g >= hi)                                                                        /* check end */
+        {
+            break;                                                                          /* break */
+        }
+        if (g >= lo)                                                                        /* check start */
+        {
+            if (*count < QMC5883L_RESAMPLE_MAX_OUT)                                         /* check space */
+            {
+                a_resample_point(rs, (float)((g - lo) / (hi - lo)), out[*count]);           /* interpolate */
+                out_time_us[*count] = (uint64_t)(g + 0.5);                                  /* grid time */
+                (*count)++;                                                                 /* one more */
+            }
+            else
+            {
+                rs->dropped++;                                                              /* no space */
+            }
+        }
+        rs->next++;                                                                         /* next grid point */
+    }
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the estimated clock
+ * @param[in]  *rs points to a resample structure
+ * @param[out] *rate_hz points to an estimated output data rate buffer
+ * @param[out] *missed points to a lost sample count buffer
+ * @param[out] *dropped points to a dropped grid point count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rs is NULL
+ *             - 3 rs is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_resample_get_rate(qmc5883l_resample_t *rs, float *rate_hz, uint32_t *missed, uint32_t *dropped)
+{
+    if (rs == NULL)                                       /* check rs */
+    {
+        return 2;                                         /* return error */
+    }
+    if (rs->inited != 1)                                  /* check rs initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    *rate_hz = (float)(1000000.0 / rs->period_us);        /* estimated rate */
+    *missed = rs->missed;                                 /* lost samples */
+    *dropped = rs->dropped;                               /* dropped points */
+    
+    return 0;                                             /* success return 0 */
+}
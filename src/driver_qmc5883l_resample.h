@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_resample.h
+ * @brief     driver qmc5883l resample header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_RESAMPLE_H
+#define DRIVER_QMC5883L_RESAMPLE_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_resample_driver qmc5883l resample driver function
+ * @brief    qmc5883l resample driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l resample definition
+ */
+#define QMC5883L_RESAMPLE_MAX_OUT         8          /**< max grid points per input sample */
+#define QMC5883L_RESAMPLE_MAX_RATIO       4          /**< max output rate over input rate */
+#define QMC5883L_RESAMPLE_MAX_GAP         16         /**< longer gaps restart the estimate */
+#define QMC5883L_RESAMPLE_MAX_ERROR       0.25f      /**< max oscillator error accepted at start */
+
+/**
+ * @brief qmc5883l resample method enumeration definition
+ */
+typedef enum
+{
+    QMC5883L_RESAMPLE_LINEAR = 0x00,        /**< linear, no added delay */
+    QMC5883L_RESAMPLE_CUBIC  = 0x01,        /**< catmull rom, one sample of added delay */
+} qmc5883l_resample_method_t;
+
+/**
+ * @brief qmc5883l resample structure definition
+ */
+typedef struct qmc5883l_resample_s
+{
+    double period_us;                      /**< estimated sample period */
+    double nominal_us;                     /**< nominal sample period */
+    double time_us;                        /**< smoothed time of the newest sample */
+    double out_rate_hz;                    /**< output grid rate */
+    double t[4];                           /**< smoothed times of the last samples */
+    float m[4][3];                         /**< last samples */
+    float alpha;                           /**< steady phase gain */
+    float beta;                            /**< steady period gain */
+    uint64_t next;                         /**< next grid index */
+    uint32_t n;                            /**< samples since the estimate started */
+    uint32_t missed;                       /**< samples lost between reads */
+    uint32_t dropped;                      /**< grid points over QMC5883L_RESAMPLE_MAX_OUT */
+    uint8_t filled;                        /**< valid history samples */
+    uint8_t method;                        /**< interpolation method */
+    uint8_t inited;                        /**< inited flag */
+} qmc5883l_resample_t;
+
+/**
+ * @brief      initialize the resampler
+ * @param[out] *rs points to a resample structure
+ * @param[in]  rate_hz is the nominal output data rate of the chip
+ * @param[in]  out_rate_hz is the rate of the host grid
+ * @param[in]  method is the interpolation method
+ * @param[in]  time_constant is the steady tracking time constant in samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 rs is NULL
+ *             - 4 param is invalid
+ * @note       out_rate_hz must not exceed QMC5883L_RESAMPLE_MAX_RATIO * rate_hz, time_constant must be at least 2
+ */
+uint8_t qmc5883l_resample_init(qmc5883l_resample_t *rs, float rate_hz, float out_rate_hz,
+                               qmc5883l_resample_method_t method, uint32_t time_constant);
+
+/**
+ * @brief      push one sample and get the grid points it completes
+ * @param[in]  *rs points to a resample structure
+ * @param[in]  time_us is the host time the data ready was seen
+ * @param[in]  *m_gauss points to a data buffer
+ * @param[out] *out points to an output buffer
+ * @param[out] *out_time_us points to an output grid time buffer
+ * @param[out] *count points to an output count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rs or buffer is NULL
+ *             - 3 rs is not initialized
+ * @note       the data ready times are fitted by least squares while the estimate starts and by a second
+ *             order tracking loop after time_constant samples, lost samples are detected from the gap,
+ *             a gap over QMC5883L_RESAMPLE_MAX_GAP periods or a time step back restarts the estimate
+ */
+uint8_t qmc5883l_resample_push(qmc5883l_resample_t *rs, uint64_t time_us, const float m_gauss[3],
+                               float out[QMC5883L_RESAMPLE_MAX_OUT][3], uint64_t out_time_us[QMC5883L_RESAMPLE_MAX_OUT],
+                               uint8_t *count);
+
+/**
+ * @brief      get the estimated clock
+ * @param[in]  *rs points to a resample structure
+ * @param[out] *rate_hz points to an estimated output data rate buffer
+ * @param[out] *missed points to a lost sample count buffer
+ * @param[out] *dropped points to a dropped grid point count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rs is NULL
+ *             - 3 rs is not initialized
+ * @note       none
+ */
+uint8_t qmc5883l_resample_get_rate(qmc5883l_resample_t *rs, float *rate_hz, uint32_t *missed, uint32_t *dropped);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,536 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_tempco.c
+ * @brief     driver qmc5883l tempco source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_tempco.h"
+#include <math.h>
+
+/**
+ * @brief tempco definition
+ */
+#define TEMPCO_EPSILON        1e-12        /**< singular pivot threshold */
+
+/**
+ * @brief     normalize a temperature
+ * @param[in] deg is the temperature in degrees
+ * @return    normalized temperature
+ * @note      -20 to 60 degrees map to -1 to 1, which keeps the power sums well conditioned
+ */
+static double a_tempco_normalize(float deg)
+{
+    return ((double)deg - QMC5883L_TEMPCO_CENTER) / QMC5883L_TEMPCO_HALF_SPAN;        /* normalize */
+}
+
+/**
+ * @brief     evaluate the offset polynomial of an axis
+ * @param[in] *tc points to a tempco structure
+ * @param[in] axis is the axis index
+ * @param[in] deg is the temperature in degrees
+ * @return    offset in m_gauss
+ * @note      horner scheme, the temperature is clamped to the learned range
+ */
+static float a_tempco_eval(qmc5883l_tempco_t *tc, uint8_t axis, float deg)
+{
+    float t;
+    float s;
+    int8_t i;
+    
+    deg = (deg < tc->t_min) ? tc->t_min : deg;        /* clamp low */
+    deg = (deg > tc->t_max) ? tc->t_max : deg;        /* clamp high */
+    t = (float)a_tempco_normalize(deg);               /* normalize */
+    s = 0.0f;                                         /* init 0 */
+    for (i = (int8_t)tc->order; i >= 0; i--)          /* horner */
+    {
+        s = s * t + tc->coeff[axis][i];               /* next coefficient */
+    }
+    
+    return s;                                         /* return offset */
+}
+
+/**
+ * @brief      solve the normal equations of the three axes
+ * @param[in]  *tc points to a tempco structure
+ * @param[out] *p points to a parameter buffer, one row per axis
+ * @return     status code
+ *             - 0 success
+ *             - 1 matrix is singular
+ * @note       gaussian elimination with partial pivoting, the axes share the matrix
+ */
+static uint8_t a_tempco_solve_normal(qmc5883l_tempco_t *tc, double p[3][QMC5883L_TEMPCO_MAX_ORDER + 1])
+{
+    double m[QMC5883L_TEMPCO_MAX_ORDER + 1][QMC5883L_TEMPCO_MAX_ORDER + 4];
+    double max;
+    uint8_t n;
+    uint8_t i;
+    uint8_t j;
+    uint8_t k;
+    
+    n = tc->order + 1;                                          /* unknowns */
+    for (i = 0; i < n; i++)                                     /* build the matrix */
+    {
+        for (j = 0; j < n; j++)                                 /* hankel matrix */
+        {
+            m[i][j] = tc->sum_tt[i + j];                        /* set power sum */
+        }
+        for (k = 0; k < 3; k++)                                 /* three right sides */
+        {
+            m[i][n + k] = tc->sum_ty[k][i];                     /* set right side */
+        }
+    }
+    max = 0.0;                                                  /* init 0 */
+    for (i = 0; i < n; i++)                                     /* find the max diagonal */
+    {
+        if (m[i][i] > max)                                      /* check diagonal */
+        {
+            max = m[i][i];                                      /* save max */
+        }
+    }
+    for (k = 0; k < n; k++)                                     /* eliminate */
+    {
+        uint8_t pivot;
+        
+        pivot = k;                                              /* init pivot */
+        for (i = k + 1; i < n; i++)                             /* find the pivot */
+        {
+            if (fabs(m[i][k]) > fabs(m[pivot][k]))              /* check row */
+            {
+                pivot = i;                                      /* save pivot */
+            }
+        }
+        if (fabs(m[pivot][k]) <= (max * TEMPCO_EPSILON))        /* check singular */
+        {
+            return 1;                                           /* return error */
+        }
+        if (pivot != k)                                         /* check swap */
+        {
+            for (j = k; j < n + 3; j++)                         /* swap rows */
+            {
+                double t;
+                
+                t = m[k][j];                                    /* save */
+                m[k][j] = m[pivot][j];                          /* swap */
+                m[pivot][j] = t;                                /* restore */
+            }
+        }
+        for (i = k + 1; i < n; i++)                             /* clear the column */
+        {
+            double f;
+            
+            f = m[i][k] / m[k][k];                              /* get factor */
+            for (j = k; j < n + 3; j++)                         /* row */
+            {
+                m[i][j] -= f * m[k][j];                         /* subtract */
+            }
+        }
+    }
+    for (i = 0; i < 3; i++)                                     /* each axis */
+    {
+        for (k = n; k > 0; k--)                                 /* back substitution */
+        {
+            double s;
+            
+            s = m[k - 1][n + i];                                /* right side */
+            for (j = k; j < n; j++)                             /* known params */
+            {
+                s -= m[k - 1][j] * p[i][j];                     /* subtract */
+            }
+            p[i][k - 1] = s / m[k - 1][k - 1];                  /* set param */
+        }
+    }
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      initialize the temperature compensation
+ * @param[out] *tc points to a tempco structure
+ * @param[in]  order is the polynomial order
+ * @param[in]  period is the temperature refresh period in samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 tc is NULL
+ *             - 4 order or period is invalid
+ * @note       the correction is zero until the model is solved or set
+ */
+uint8_t qmc5883l_tempco_init(qmc5883l_tempco_t *tc, uint8_t order, uint32_t period)
+{
+    if (tc == NULL)                                                                 /* check tc */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if ((order < 1) || (order > QMC5883L_TEMPCO_MAX_ORDER) || (period == 0))        /* check order and period */
+    {
+        return 4;                                                                   /* return error */
+    }
+    
+    memset(tc, 0, sizeof(qmc5883l_tempco_t));                                       /* clear all */
+    tc->order = order;                                                              /* set order */
+    tc->period = period;                                                            /* set period */
+    tc->inited = 1;                                                                 /* flag inited */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     clear the learned sums
+ * @param[in] *tc points to a tempco structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 tc is NULL
+ *            - 3 tc is not initialized
+ * @note      the solved model is kept
+ */
+uint8_t qmc5883l_tempco_reset(qmc5883l_tempco_t *tc)
+{
+    if (tc == NULL)                                   /* check tc */
+    {
+        return 2;                                     /* return error */
+    }
+    if (tc->inited != 1)                              /* check tc initialization */
+    {
+        return 3;                                     /* return error */
+    }
+    
+    memset(tc->sum_tt, 0, sizeof(tc->sum_tt));        /* clear power sums */
+    memset(tc->sum_ty, 0, sizeof(tc->sum_ty));        /* clear field sums */
+    tc->count = 0;                                    /* clear count */
+    
+    return 0;                                         /* success return 0 */
+}
+
+/**
+ * @brief     add a learning sample
+ * @param[in] *tc points to a tempco structure
+ * @param[in] deg is the chip temperature
+ * @param[in] *m_gauss points to a converted data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 tc or m_gauss is NULL
+ *            - 3 tc is not initialized
+ * @note      the sensor must be kept still in a constant field while the temperature changes
+ */
+uint8_t qmc5883l_tempco_update(qmc5883l_tempco_t *tc, float deg, const float m_gauss[3])
+{
+    double t;
+    double tp;
+    uint8_t i;
+    uint8_t k;
+    
+    if ((tc == NULL) || (m_gauss == NULL))                          /* check tc and m_gauss */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (tc->inited != 1)                                            /* check tc initialization */
+    {
+        return 3;                                                   /* return error */
+    }
+    
+    t = a_tempco_normalize(deg);                                    /* normalize */
+    tp = 1.0;                                                       /* t^0 */
+    for (i = 0; i <= 2 * tc->order; i++)                            /* each power */
+    {
+        tc->sum_tt[i] += tp;                                        /* add t^i */
+        if (i <= tc->order)                                         /* check order */
+        {
+            for (k = 0; k < 3; k++)                                 /* each axis */
+            {
+                tc->sum_ty[k][i] += tp * (double)m_gauss[k];        /* add t^i * m */
+            }
+        }
+        tp *= t;                                                    /* next power */
+    }
+    if ((tc->count == 0) || (deg < tc->t_min))                      /* check min */
+    {
+        tc->t_min = deg;                                            /* save min */
+    }
+    if ((tc->count == 0) || (deg > tc->t_max))                      /* check max */
+    {
+        tc->t_max = deg;                                            /* save max */
+    }
+    tc->count++;                                                    /* count */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief     fit the offset against the temperature
+ * @param[in] *tc points to a tempco structure
+ * @param[in] reference is the temperature where the correction is zero
+ * @return    status code
+ *            - 0 success
+ *            - 1 fit failed
+ *            - 2 tc is NULL
+ *            - 3 tc is not initialized
+ *            - 4 too few samples or too small temperature span
+ * @note      use the temperature of the hard iron calibration as the reference
+ */
+uint8_t qmc5883l_tempco_solve(qmc5883l_tempco_t *tc, float reference)
+{
+    double p[3][QMC5883L_TEMPCO_MAX_ORDER + 1];
+    uint8_t i;
+    uint8_t k;
+    
+    if (tc == NULL)                                                  /* check tc */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (tc->inited != 1)                                             /* check tc initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    if ((tc->count < QMC5883L_TEMPCO_MIN_SAMPLES) ||
+        ((tc->t_max - tc->t_min) < QMC5883L_TEMPCO_MIN_SPAN))        /* check samples and span */
+    {
+        return 4;                                                    /* return error */
+    }
+    
+    if (a_tempco_solve_normal(tc, p) != 0)                           /* solve */
+    {
+        return 1;                                                    /* return error */
+    }
+    memset(tc->coeff, 0, sizeof(tc->coeff));                         /* clear high orders */
+    for (k = 0; k < 3; k++)                                          /* each axis */
+    {
+        for (i = 0; i <= tc->order; i++)                             /* each power */
+        {
+            tc->coeff[k][i] = (float)p[k][i];                        /* save coefficient */
+        }
+    }
+    tc->reference = reference;                                       /* set reference */
+    tc->solved = 1;                                                  /* flag solved */
+    
+    return qmc5883l_tempco_set_temperature(tc, reference);           /* zero correction */
+}
+
+/**
+ * @brief     refresh the correction for a new temperature
+ * @param[in] *tc points to a tempco structure
+ * @param[in] deg is the chip temperature
+ * @return    status code
+ *            - 0 success
+ *            - 2 tc is NULL
+ *            - 3 tc is not initialized
+ * @note      the temperature is clamped to the learned range
+ */
+uint8_t qmc5883l_tempco_set_temperature(qmc5883l_tempco_t *tc, float deg)
+{
+    uint8_t k;
+    
+    if (tc == NULL)                                                                                 /* check tc */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    if (tc->inited != 1)                                                                            /* check tc initialization */
+    {
+        return 3;                                                                                   /* return error */
+    }
+    
+    tc->temperature = deg;                                                                          /* save temperature */
+    for (k = 0; k < 3; k++)                                                                         /* each axis */
+    {
+        if (tc->solved != 0)                                                                        /* check solved */
+        {
+            tc->offset[k] = a_tempco_eval(tc, k, deg) - a_tempco_eval(tc, k, tc->reference);        /* relative offset */
+        }
+        else
+        {
+            tc->offset[k] = 0.0f;                                                                   /* no correction */
+        }
+    }
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      remove the temperature offset from a sample
+ * @param[in]  *tc points to a tempco structure
+ * @param[in]  *m_gauss points to a converted data buffer
+ * @param[out] *out points to a compensated data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 tc, m_gauss or out is NULL
+ *             - 3 tc is not initialized
+ * @note       three subtractions, m_gauss and out may be the same buffer
+ */
+uint8_t qmc5883l_tempco_apply(qmc5883l_tempco_t *tc, const float m_gauss[3], float out[3])
+{
+    if ((tc == NULL) || (m_gauss == NULL) || (out == NULL))        /* check tc and buffers */
+    {
+        return 2;                                                  /* return error */
+    }
+    if (tc->inited != 1)                                           /* check tc initialization */
+    {
+        return 3;                                                  /* return error */
+    }
+    
+    out[0] = m_gauss[0] - tc->offset[0];                           /* compensate x */
+    out[1] = m_gauss[1] - tc->offset[1];                           /* compensate y */
+    out[2] = m_gauss[2] - tc->offset[2];                           /* compensate z */
+    
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief      read a compensated sample
+ * @param[in]  *handle points to a qmc5883l handle structure
+ * @param[in]  *tc points to a tempco structure
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a compensated data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle or tc is NULL
+ *             - 3 handle or tc is not initialized
+ * @note       the temperature is read and the correction refreshed once every period samples,
+ *             raw is not compensated
+ */
+uint8_t qmc5883l_tempco_read(qmc5883l_handle_t *handle, qmc5883l_tempco_t *tc, int16_t raw[3], float m_gauss[3])
+{
+    uint8_t res;
+    
+    if (tc == NULL)                                                   /* check tc */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (tc->inited != 1)                                              /* check tc initialization */
+    {
+        return 3;                                                     /* return error */
+    }
+    
+    if (tc->countdown == 0)                                           /* check refresh */
+    {
+        int16_t t_raw;
+        float deg;
+        
+        res = qmc5883l_read_temperature(handle, &t_raw, &deg);        /* read temperature */
+        if (res != 0)                                                 /* check result */
+        {
+            return res;                                               /* return error */
+        }
+        (void)qmc5883l_tempco_set_temperature(tc, deg);               /* refresh */
+        tc->countdown = tc->period;                                   /* restart */
+    }
+    tc->countdown--;                                                  /* count down */
+    res = qmc5883l_read(handle, raw, m_gauss);                        /* read data */
+    if (res != 0)                                                     /* check result */
+    {
+        return res;                                                   /* return error */
+    }
+    
+    return qmc5883l_tempco_apply(tc, m_gauss, m_gauss);               /* compensate */
+}
+
+/**
+ * @brief      get the solved model
+ * @param[in]  *tc points to a tempco structure
+ * @param[out] *coeff points to a coefficient buffer in m_gauss over the normalized temperature
+ * @param[out] *reference points to a reference temperature buffer
+ * @param[out] *t_min points to a lowest temperature buffer
+ * @param[out] *t_max points to a highest temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 tc is NULL
+ *             - 3 tc is not solved
+ * @note       the normalized temperature is (deg - QMC5883L_TEMPCO_CENTER) / QMC5883L_TEMPCO_HALF_SPAN,
+ *             unused high order coefficients are zero
+ */
+uint8_t qmc5883l_tempco_get(qmc5883l_tempco_t *tc, float coeff[3][QMC5883L_TEMPCO_MAX_ORDER + 1],
+                            float *reference, float *t_min, float *t_max)
+{
+    if (tc == NULL)                                     /* check tc */
+    {
+        return 2;                                       /* return error */
+    }
+    if ((tc->inited != 1) || (tc->solved != 1))         /* check tc solved */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    memcpy(coeff, tc->coeff, sizeof(tc->coeff));        /* get coefficients */
+    *reference = tc->reference;                         /* get reference */
+    *t_min = tc->t_min;                                 /* get min */
+    *t_max = tc->t_max;                                 /* get max */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     set a stored model
+ * @param[in] *tc points to a tempco structure
+ * @param[in] *coeff points to a coefficient buffer in m_gauss over the normalized temperature
+ * @param[in] reference is the reference temperature
+ * @param[in] t_min is the lowest temperature
+ * @param[in] t_max is the highest temperature
+ * @return    status code
+ *            - 0 success
+ *            - 2 tc is NULL
+ *            - 3 tc is not initialized
+ *            - 4 temperature range is invalid
+ * @note      coefficients above the initialized order are ignored
+ */
+uint8_t qmc5883l_tempco_set(qmc5883l_tempco_t *tc, const float coeff[3][QMC5883L_TEMPCO_MAX_ORDER + 1],
+                            float reference, float t_min, float t_max)
+{
+    uint8_t i;
+    uint8_t k;
+    
+    if (tc == NULL)                                                     /* check tc */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (tc->inited != 1)                                                /* check tc initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if (!(t_max >= t_min))                                              /* check range */
+    {
+        return 4;                                                       /* return error */
+    }
+    
+    memset(tc->coeff, 0, sizeof(tc->coeff));                            /* clear high orders */
+    for (k = 0; k < 3; k++)                                             /* each axis */
+    {
+        for (i = 0; i <= tc->order; i++)                                /* each power */
+        {
+            tc->coeff[k][i] = coeff[k][i];                              /* set coefficient */
+        }
+    }
+    tc->reference = reference;                                          /* set reference */
+    tc->t_min = t_min;                                                  /* set min */
+    tc->t_max = t_max;                                                  /* set max */
+    tc->solved = 1;                                                     /* flag solved */
+    
+    return qmc5883l_tempco_set_temperature(tc, tc->temperature);        /* refresh */
+}
@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_tempco.h
+ * @brief     driver qmc5883l tempco header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_TEMPCO_H
+#define DRIVER_QMC5883L_TEMPCO_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_tempco_driver qmc5883l tempco driver function
+ * @brief    qmc5883l tempco driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l tempco definition
+ */
+#define QMC5883L_TEMPCO_MAX_ORDER          3            /**< max polynomial order */
+#define QMC5883L_TEMPCO_MIN_SAMPLES        32           /**< min samples to solve the fit */
+#define QMC5883L_TEMPCO_MIN_SPAN           5.0f         /**< min learned temperature span in degrees */
+#define QMC5883L_TEMPCO_CENTER             20.0f        /**< polynomial center in degrees */
+#define QMC5883L_TEMPCO_HALF_SPAN          40.0f        /**< polynomial half span in degrees */
+
+/**
+ * @brief qmc5883l tempco structure definition
+ */
+typedef struct qmc5883l_tempco_s
+{
+    double sum_tt[2 * QMC5883L_TEMPCO_MAX_ORDER + 1];           /**< temperature power sums */
+    double sum_ty[3][QMC5883L_TEMPCO_MAX_ORDER + 1];            /**< temperature power by field sums */
+    uint32_t count;                                             /**< accumulated samples */
+    float coeff[3][QMC5883L_TEMPCO_MAX_ORDER + 1];              /**< offset polynomial in m_gauss */
+    float t_min;                                                /**< lowest learned temperature */
+    float t_max;                                                /**< highest learned temperature */
+    float reference;                                            /**< temperature of zero correction */
+    float temperature;                                          /**< last refreshed temperature */
+    float offset[3];                                            /**< correction at the last temperature */
+    uint32_t period;                                            /**< temperature refresh period in samples */
+    uint32_t countdown;                                         /**< samples to the next refresh */
+    uint8_t order;                                              /**< polynomial order */
+    uint8_t solved;                                             /**< solved flag */
+    uint8_t inited;                                             /**< inited flag */
+} qmc5883l_tempco_t;
+
+/**
+ * @brief      initialize the temperature compensation
+ * @param[out] *tc points to a tempco structure
+ * @param[in]  order is the polynomial order
+ * @param[in]  period is the temperature refresh period in samples
+ * @return     status code
+ *             - 0 success
+ *             - 2 tc is NULL
+ *             - 4 order or period is invalid
+ * @note       the correction is zero until the model is solved or set
+ */
+uint8_t qmc5883l_tempco_init(qmc5883l_tempco_t *tc, uint8_t order, uint32_t period);
+
+/**
+ * @brief     clear the learned sums
+ * @param[in] *tc points to a tempco structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 tc is NULL
+ *            - 3 tc is not initialized
+ * @note      the solved model is kept
+ */
+uint8_t qmc5883l_tempco_reset(qmc5883l_tempco_t *tc);
+
+/**
+ * @brief     add a learning sample
+ * @param[in] *tc points to a tempco structure
+ * @param[in] deg is the chip temperature
+ * @param[in] *m_gauss points to a converted data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 tc or m_gauss is NULL
+ *            - 3 tc is not initialized
+ * @note      the sensor must be kept still in a constant field while the temperature changes
+ */
+uint8_t qmc5883l_tempco_update(qmc5883l_tempco_t *tc, float deg, const float m_gauss[3]);
+
+/**
+ * @brief     fit the offset against the temperature
+ * @param[in] *tc points to a tempco structure
+ * @param[in] reference is the temperature where the correction is zero
+ * @return    status code
+ *            - 0 success
+ *            - 1 fit failed
+ *            - 2 tc is NULL
+ *            - 3 tc is not initialized
+ *            - 4 too few samples or too small temperature span
+ * @note      use the temperature of the hard iron calibration as the reference
+ */
+uint8_t qmc5883l_tempco_solve(qmc5883l_tempco_t *tc, float reference);
+
+/**
+ * @brief     refresh the correction for a new temperature
+ * @param[in] *tc points to a tempco structure
+ * @param[in] deg is the chip temperature
+ * @return    status code
+ *            - 0 success
+ *            - 2 tc is NULL
+ *            - 3 tc is not initialized
+ * @note      the temperature is clamped to the learned range
+ */
+uint8_t qmc5883l_tempco_set_temperature(qmc5883l_tempco_t *tc, float deg);
+
+/**
+ * @brief      remove the temperature offset from a sample
+ * @param[in]  *tc points to a tempco structure
+ * @param[in]  *m_gauss points to a converted data buffer
+ * @param[out] *out points to a compensated data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 tc, m_gauss or out is NULL
+ *             - 3 tc is not initialized
+ * @note       three subtractions, m_gauss and out may be the same buffer
+ */
+uint8_t qmc5883l_tempco_apply(qmc5883l_tempco_t *tc, const float m_gauss[3], float out[3]);
+
+/**
+ * @brief      read a compensated sample
+ * @param[in]  *handle points to a qmc5883l handle structure
+ * @param[in]  *tc points to a tempco structure
+ * @param[out] *raw points to a raw data buffer
+ * @param[out] *m_gauss points to a compensated data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle or tc is NULL
+ *             - 3 handle or tc is not initialized
+ * @note       the temperature is read and the correction refreshed once every period samples,
+ *             raw is not compensated
+ */
+uint8_t qmc5883l_tempco_read(qmc5883l_handle_t *handle, qmc5883l_tempco_t *tc, int16_t raw[3], float m_gauss[3]);
+
+/**
+ * @brief      get the solved model
+ * @param[in]  *tc points to a tempco structure
+ * @param[out] *coeff points to a coefficient buffer in m_gauss over the normalized temperature
+ * @param[out] *reference points to a reference temperature buffer
+ * @param[out] *t_min points to a lowest temperature buffer
+ * @param[out] *t_max points to a highest temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 tc is NULL
+ *             - 3 tc is not solved
+ * @note       the normalized temperature is (deg - QMC5883L_TEMPCO_CENTER) / QMC5883L_TEMPCO_HALF_SPAN,
+ *             unused high order coefficients are zero
+ */
+uint8_t qmc5883l_tempco_get(qmc5883l_tempco_t *tc, float coeff[3][QMC5883L_TEMPCO_MAX_ORDER + 1],
+                            float *reference, float *t_min, float *t_max);
+
+/**
+ * @brief     set a stored model
+ * @param[in] *tc points to a tempco structure
+ * @param[in] *coeff points to a coefficient buffer in m_gauss over the normalized temperature
+ * @param[in] reference is the reference temperature
+ * @param[in] t_min is the lowest temperature
+ * @param[in] t_max is the highest temperature
+ * @return    status code
+ *            - 0 success
+ *            - 2 tc is NULL
+ *            - 3 tc is not initialized
+ *            - 4 temperature range is invalid
+ * @note      coefficients above the initialized order are ignored
+ */
+uint8_t qmc5883l_tempco_set(qmc5883l_tempco_t *tc, const float coeff[3][QMC5883L_TEMPCO_MAX_ORDER + 1],
+                            float reference, float t_min, float t_max);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,295 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_adaptive_test.c
+ * @brief     driver qmc5883l adaptive test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_adaptive_test.h"
+#include <math.h>
+
+/**
+ * @brief adaptive test definition
+ */
+#define ADAPTIVE_TEST_LOW_MGAUSS        6.0f          /**< quiet deviation */
+#define ADAPTIVE_TEST_HIGH_MGAUSS       20.0f         /**< active deviation */
+#define ADAPTIVE_TEST_HOLD_MS           1000          /**< quiet time before each step down */
+#define ADAPTIVE_TEST_FLOOR_SAMPLES     100           /**< samples with a declared 100Hz floor */
+#define ADAPTIVE_TEST_MAX_SLIP_US       2000          /**< max change of the host to sample time offset */
+#define ADAPTIVE_TEST_SWITCH_SLIP_US    1100          /**< extra offset change allowed per switch */
+#define ADAPTIVE_TEST_POLL_MS           1             /**< data ready poll period */
+#define ADAPTIVE_TEST_POLL_TRIES        100           /**< data ready polls before timeout */
+#define ADAPTIVE_TEST_BUS_HZ            400000        /**< assumed iic clock for the host time */
+
+static qmc5883l_handle_t gs_handle;                   /**< qmc5883l handle */
+static qmc5883l_adaptive_t gs_adaptive;               /**< adaptive rate controller */
+static double gs_host_us;                             /**< host time */
+static uint32_t gs_transfers;                         /**< iic transfers */
+static const uint16_t gs_rate_hz[4] = {10, 50, 100, 200};        /**< output rate table */
+
+/**
+ * @brief     counting iic bus read
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_adaptive_test_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_transfers++;
+    gs_host_us += (29.0 + 9.0 * len) * 1000000.0 / ADAPTIVE_TEST_BUS_HZ;
+    
+    return qmc5883l_interface_iic_read(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_adaptive_test_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_transfers++;
+    gs_host_us += (20.0 + 9.0 * len) * 1000000.0 / ADAPTIVE_TEST_BUS_HZ;
+    
+    return qmc5883l_interface_iic_write(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting delay
+ * @param[in] ms is the delay time
+ * @note      forwards to the interface
+ */
+static void a_adaptive_test_delay_ms(uint32_t ms)
+{
+    gs_host_us += ms * 1000.0;
+    
+    qmc5883l_interface_delay_ms(ms);
+}
+
+/**
+ * @brief     adaptive test
+ * @param[in] times is the number of read samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the host time is the sum of the requested delays and the iic frames at 400kHz
+ */
+uint8_t qmc5883l_adaptive_test(uint32_t times)
+{
+    qmc5883l_output_rate_t rate;
+    qmc5883l_output_rate_t now_rate;
+    uint64_t time_us;
+    uint64_t last_us;
+    uint64_t seconds_at[4];
+    double offset;
+    double slip;
+    uint32_t floor_start;
+    uint32_t switches;
+    uint32_t rises;
+    uint32_t peaks;
+    uint32_t i;
+    uint8_t res;
+    uint8_t last_rate;
+    int16_t raw[3];
+    float m_gauss[3];
+    float quiet[3];
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, a_adaptive_test_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, a_adaptive_test_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, a_adaptive_test_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start adaptive test */
+    qmc5883l_interface_debug_print("qmc5883l: start adaptive test.\n");
+    
+    /* param limits */
+    memset(&gs_adaptive, 0, sizeof(gs_adaptive));
+    if ((qmc5883l_adaptive_init(NULL, &gs_handle, 1.0f, 2.0f, 1) != 2) ||
+        (qmc5883l_adaptive_init(&gs_adaptive, &gs_handle, 1.0f, 2.0f, 1) != 3) ||
+        (qmc5883l_adaptive_read(&gs_adaptive, raw, m_gauss, &time_us, &rate) != 3) ||
+        (qmc5883l_adaptive_set_min_rate(&gs_adaptive, 0, QMC5883L_OUTPUT_RATE_10HZ) != 3) ||
+        (qmc5883l_adaptive_get_rate(&gs_adaptive, &rate, &switches) != 3))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: adaptive limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if ((qmc5883l_adaptive_init(&gs_adaptive, &gs_handle, 2.0f, 2.0f, 1) != 4) ||
+        (qmc5883l_adaptive_init(&gs_adaptive, &gs_handle, 1.0f, 2.0f, 0) != 4) ||
+        (qmc5883l_adaptive_init(&gs_adaptive, &gs_handle, ADAPTIVE_TEST_LOW_MGAUSS, ADAPTIVE_TEST_HIGH_MGAUSS, ADAPTIVE_TEST_HOLD_MS) != 0) ||
+        (qmc5883l_adaptive_set_min_rate(&gs_adaptive, QMC5883L_ADAPTIVE_MAX_CONSUMERS, QMC5883L_OUTPUT_RATE_10HZ) != 4))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: adaptive init check error.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* read through quiet and active periods */
+    memset(seconds_at, 0, sizeof(seconds_at));
+    gs_host_us = 0.0;
+    gs_transfers = 0;
+    offset = 0.0;
+    slip = 0.0;
+    last_us = 0;
+    last_rate = QMC5883L_OUTPUT_RATE_200HZ;
+    floor_start = times / 2;
+    rises = 0;
+    peaks = 0;
+    for (i = 0; i < times; i++)
+    {
+        uint64_t period;
+        float dev;
+        
+        /* a consumer needs 100Hz for a while in the middle */
+        if ((i == floor_start) || (i == floor_start + ADAPTIVE_TEST_FLOOR_SAMPLES))
+        {
+            (void)qmc5883l_adaptive_set_min_rate(&gs_adaptive, 0, (i == floor_start) ? QMC5883L_OUTPUT_RATE_100HZ : QMC5883L_OUTPUT_RATE_10HZ);
+        }
+        if (qmc5883l_adaptive_read(&gs_adaptive, raw, m_gauss, &time_us, &rate) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* the sample time moves by the period in force and follows the host */
+        period = 1000000U / gs_rate_hz[rate];
+        if ((time_us != last_us + period) && (time_us != last_us + 2 * period))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: sample %d time step check error.\n", (int)i);
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if (i == 0)
+        {
+            offset = gs_host_us - (double)time_us;
+            quiet[0] = m_gauss[0];
+            quiet[1] = m_gauss[1];
+            quiet[2] = m_gauss[2];
+        }
+        slip = fmax(slip, fabs(gs_host_us - (double)time_us - offset));
+        seconds_at[rate] += time_us - last_us;
+        last_us = time_us;
+        
+        /* the peak of an event must be read at the full rate */
+        dev = sqrtf((m_gauss[0] - quiet[0]) * (m_gauss[0] - quiet[0]) + (m_gauss[1] - quiet[1]) * (m_gauss[1] - quiet[1]) +
+                    (m_gauss[2] - quiet[2]) * (m_gauss[2] - quiet[2]));
+        if (dev > 3.0f * ADAPTIVE_TEST_HIGH_MGAUSS)
+        {
+            peaks++;
+            if (rate != QMC5883L_OUTPUT_RATE_200HZ)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: sample %d event rate check error.\n", (int)i);
+                (void)qmc5883l_deinit(&gs_handle);
+                
+                return 1;
+            }
+        }
+        
+        /* the floor holds from the second sample after the declaration */
+        if ((i > floor_start + 1) && (i < floor_start + ADAPTIVE_TEST_FLOOR_SAMPLES) && (rate < QMC5883L_OUTPUT_RATE_100HZ))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: sample %d floor check error.\n", (int)i);
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (void)qmc5883l_adaptive_get_rate(&gs_adaptive, &now_rate, &switches);
+        rises += ((now_rate == QMC5883L_OUTPUT_RATE_200HZ) && (last_rate != QMC5883L_OUTPUT_RATE_200HZ)) ? 1 : 0;
+        last_rate = (uint8_t)now_rate;
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    (void)qmc5883l_adaptive_get_rate(&gs_adaptive, &now_rate, &switches);
+    qmc5883l_interface_debug_print("qmc5883l: %d samples over %.2fs, average %.1fHz, %.1f transfers/s.\n", (int)times,
+                                   last_us * 1e-6, times / (last_us * 1e-6), gs_transfers / (gs_host_us * 1e-6));
+    qmc5883l_interface_debug_print("qmc5883l: time at 10/50/100/200Hz %.2f/%.2f/%.2f/%.2fs, %d switches, %d rises, %d peak samples.\n",
+                                   seconds_at[0] * 1e-6, seconds_at[1] * 1e-6, seconds_at[2] * 1e-6, seconds_at[3] * 1e-6,
+                                   (int)switches, (int)rises, (int)peaks);
+    qmc5883l_interface_debug_print("qmc5883l: sample time within %.3fms of the host time.\n", slip / 1000.0);
+    if (slip > ADAPTIVE_TEST_MAX_SLIP_US + (double)switches * ADAPTIVE_TEST_SWITCH_SLIP_US)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: time continuity check error.\n");
+        
+        return 1;
+    }
+    if (switches > 4 * (rises + 1) + 2)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: thrash check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish adaptive test */
+    qmc5883l_interface_debug_print("qmc5883l: finish adaptive test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,434 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_ahrs_test.c
+ * @brief     driver qmc5883l ahrs test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_ahrs_test.h"
+#include "driver_qmc5883l_heading.h"
+#include <math.h>
+#include <time.h>
+
+/**
+ * @brief ahrs test definition
+ */
+#define AHRS_TEST_GYRO_HZ           400           /**< gyro rate of the synthetic trajectory */
+#define AHRS_TEST_MAG_DIVIDER       4             /**< one magnetometer sample every 4 gyro samples */
+#define AHRS_TEST_SECONDS           40            /**< trajectory length */
+#define AHRS_TEST_SETTLE_SECONDS    20            /**< convergence time before the error is checked */
+#define AHRS_TEST_KP                2.0f          /**< proportional gain */
+#define AHRS_TEST_KI                0.1f          /**< integral gain */
+#define AHRS_TEST_MAX_ERROR         1.5f          /**< max angle error in degrees */
+#define AHRS_TEST_BENCH_STEPS       200000        /**< benchmark updates */
+#define AHRS_TEST_LIVE_US           5000          /**< 200Hz live sample period */
+#define AHRS_TEST_LIVE_KP           5.0f          /**< still sensor, only the magnetometer and gravity drive the estimate */
+#define AHRS_TEST_POLL_MS           1             /**< data ready poll period */
+#define AHRS_TEST_POLL_TRIES        100           /**< data ready polls before timeout */
+
+static qmc5883l_handle_t gs_handle;               /**< qmc5883l handle */
+static qmc5883l_ahrs_t gs_ahrs;                   /**< float filter */
+static qmc5883l_ahrs_fixed_t gs_ahrs_fixed;       /**< fixed filter */
+
+/**
+ * @brief      rotate a vector from the earth frame to the body frame
+ * @param[in]  *q points to a quaternion buffer
+ * @param[in]  *v points to an earth vector buffer
+ * @param[out] *b points to a body vector buffer
+ * @note       none
+ */
+static void a_ahrs_test_to_body(const double q[4], const double v[3], double b[3])
+{
+    b[0] = (1.0 - 2.0 * (q[2] * q[2] + q[3] * q[3])) * v[0] + 2.0 * (q[1] * q[2] + q[0] * q[3]) * v[1] +
+           2.0 * (q[1] * q[3] - q[0] * q[2]) * v[2];
+    b[1] = 2.0 * (q[1] * q[2] - q[0] * q[3]) * v[0] + (1.0 - 2.0 * (q[1] * q[1] + q[3] * q[3])) * v[1] +
+           2.0 * (q[2] * q[3] + q[0] * q[1]) * v[2];
+    b[2] = 2.0 * (q[1] * q[3] + q[0] * q[2]) * v[0] + 2.0 * (q[2] * q[3] - q[0] * q[1]) * v[1] +
+           (1.0 - 2.0 * (q[1] * q[1] + q[2] * q[2])) * v[2];
+}
+
+/**
+ * @brief     get the angle between two orientations
+ * @param[in] *q points to a true quaternion buffer
+ * @param[in] *e points to an estimated quaternion buffer
+ * @return    angle in degrees
+ * @note      none
+ */
+static double a_ahrs_test_angle(const double q[4], const double e[4])
+{
+    double d;
+    
+    d = fabs(q[0] * e[0] + q[1] * e[1] + q[2] * e[2] + q[3] * e[3]);
+    d = (d > 1.0) ? 1.0 : d;
+    
+    return 2.0 * acos(d) * 57.29577951308232;
+}
+
+/**
+ * @brief  track a synthetic trajectory with both filters
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   the filters start from identity while the body starts rolled and turned,
+ *         the gyro carries a bias and the magnetometer runs at a quarter of the gyro rate
+ */
+static uint8_t a_ahrs_test_track(void)
+{
+    const double up[3] = {0.0, 0.0, 1.0};
+    const double field[3] = {0.2, 0.0, -0.4};
+    const double bias[3] = {0.01, -0.02, 0.015};
+    double q[4] = {0.9588, 0.0843, 0.0226, 0.2705};
+    double error;
+    double error_fixed;
+    double n;
+    uint32_t steps;
+    uint32_t i;
+    uint8_t k;
+    
+    (void)qmc5883l_ahrs_init(&gs_ahrs, AHRS_TEST_KP, AHRS_TEST_KI);
+    (void)qmc5883l_ahrs_fixed_init(&gs_ahrs_fixed, (int32_t)(AHRS_TEST_KP * QMC5883L_AHRS_FIXED_GAIN_ONE),
+                                   (int32_t)(AHRS_TEST_KI * QMC5883L_AHRS_FIXED_GAIN_ONE));
+    n = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (k = 0; k < 4; k++)
+    {
+        q[k] /= n;
+    }
+    error = 0.0;
+    error_fixed = 0.0;
+    steps = AHRS_TEST_GYRO_HZ * AHRS_TEST_SECONDS;
+    for (i = 0; i < steps; i++)
+    {
+        double t_s = (double)i / AHRS_TEST_GYRO_HZ;
+        double w[3];
+        double a[3];
+        double m[3];
+        double h[4];
+        double r[4];
+        double angle;
+        double s;
+        float gyro[3];
+        float accel[3];
+        float mag[3];
+        float e[4];
+        int32_t gyro_fixed[3];
+        int32_t accel_fixed[3];
+        int32_t mag_fixed[3];
+        int32_t e_fixed[4];
+        uint64_t time_us = (uint64_t)i * 1000000U / AHRS_TEST_GYRO_HZ;
+        
+        /* body rate, turning and rocking */
+        w[0] = 0.6 * sin(0.7 * t_s);
+        w[1] = 0.4 * cos(0.5 * t_s);
+        w[2] = 0.5;
+        
+        /* sensors at the current orientation */
+        a_ahrs_test_to_body(q, up, a);
+        a_ahrs_test_to_body(q, field, m);
+        for (k = 0; k < 3; k++)
+        {
+            gyro[k] = (float)(w[k] + bias[k]);
+            accel[k] = (float)a[k];
+            mag[k] = (float)m[k];
+            gyro_fixed[k] = (int32_t)lround((w[k] + bias[k]) * QMC5883L_AHRS_FIXED_GAIN_ONE);
+            accel_fixed[k] = (int32_t)lround(a[k] * 1000.0);
+            mag_fixed[k] = (int32_t)lround(m[k] * 12000.0);
+        }
+        if ((i % AHRS_TEST_MAG_DIVIDER) == 0)
+        {
+            (void)qmc5883l_ahrs_set_mag(&gs_ahrs, time_us, mag);
+            (void)qmc5883l_ahrs_fixed_set_mag(&gs_ahrs_fixed, time_us, mag_fixed);
+        }
+        (void)qmc5883l_ahrs_update(&gs_ahrs, time_us, gyro, accel);
+        (void)qmc5883l_ahrs_fixed_update(&gs_ahrs_fixed, time_us, gyro_fixed, accel_fixed);
+        
+        /* compare after the settle time */
+        if (t_s >= AHRS_TEST_SETTLE_SECONDS)
+        {
+            (void)qmc5883l_ahrs_get_quaternion(&gs_ahrs, e);
+            (void)qmc5883l_ahrs_fixed_get_quaternion(&gs_ahrs_fixed, e_fixed);
+            for (k = 0; k < 4; k++)
+            {
+                r[k] = e[k];
+            }
+            angle = a_ahrs_test_angle(q, r);
+            error = (angle > error) ? angle : error;
+            for (k = 0; k < 4; k++)
+            {
+                r[k] = (double)e_fixed[k] / QMC5883L_AHRS_FIXED_ONE;
+            }
+            angle = a_ahrs_test_angle(q, r);
+            error_fixed = (angle > error_fixed) ? angle : error_fixed;
+        }
+        
+        /* exact step of the true orientation, the rate is held over the gyro period */
+        n = sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        s = sin(0.5 * n / AHRS_TEST_GYRO_HZ) / n;
+        h[0] = cos(0.5 * n / AHRS_TEST_GYRO_HZ);
+        h[1] = w[0] * s;
+        h[2] = w[1] * s;
+        h[3] = w[2] * s;
+        r[0] = q[0] * h[0] - q[1] * h[1] - q[2] * h[2] - q[3] * h[3];
+        r[1] = q[0] * h[1] + q[1] * h[0] + q[2] * h[3] - q[3] * h[2];
+        r[2] = q[0] * h[2] - q[1] * h[3] + q[2] * h[0] + q[3] * h[1];
+        r[3] = q[0] * h[3] + q[1] * h[2] - q[2] * h[1] + q[3] * h[0];
+        for (k = 0; k < 4; k++)
+        {
+            q[k] = r[k];
+        }
+    }
+    qmc5883l_interface_debug_print("qmc5883l: tracking deviation float %.3f deg, fixed %.3f deg.\n", error, error_fixed);
+    if ((error > AHRS_TEST_MAX_ERROR) || (error_fixed > AHRS_TEST_MAX_ERROR))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: tracking check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  measure the update rate of both filters
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   a magnetometer sample is queued every fourth update as in the trajectory
+ */
+static uint8_t a_ahrs_test_bench(void)
+{
+    const float gyro[3] = {0.01f, -0.02f, 0.3f};
+    const float accel[3] = {0.05f, -0.03f, 0.99f};
+    const float mag[3] = {0.2f, 0.05f, -0.4f};
+    const int32_t gyro_fixed[3] = {655, -1311, 19661};
+    const int32_t accel_fixed[3] = {50, -30, 990};
+    const int32_t mag_fixed[3] = {2400, 600, -4800};
+    float q[4];
+    int32_t q_fixed[4];
+    double seconds;
+    double seconds_fixed;
+    clock_t start;
+    uint32_t i;
+    
+    (void)qmc5883l_ahrs_init(&gs_ahrs, AHRS_TEST_KP, AHRS_TEST_KI);
+    (void)qmc5883l_ahrs_fixed_init(&gs_ahrs_fixed, (int32_t)(AHRS_TEST_KP * QMC5883L_AHRS_FIXED_GAIN_ONE),
+                                   (int32_t)(AHRS_TEST_KI * QMC5883L_AHRS_FIXED_GAIN_ONE));
+    start = clock();
+    for (i = 0; i < AHRS_TEST_BENCH_STEPS; i++)
+    {
+        if ((i % AHRS_TEST_MAG_DIVIDER) == 0)
+        {
+            (void)qmc5883l_ahrs_set_mag(&gs_ahrs, (uint64_t)i * 2500U, mag);
+        }
+        (void)qmc5883l_ahrs_update(&gs_ahrs, (uint64_t)i * 2500U, gyro, accel);
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (i = 0; i < AHRS_TEST_BENCH_STEPS; i++)
+    {
+        if ((i % AHRS_TEST_MAG_DIVIDER) == 0)
+        {
+            (void)qmc5883l_ahrs_fixed_set_mag(&gs_ahrs_fixed, (uint64_t)i * 2500U, mag_fixed);
+        }
+        (void)qmc5883l_ahrs_fixed_update(&gs_ahrs_fixed, (uint64_t)i * 2500U, gyro_fixed, accel_fixed);
+    }
+    seconds_fixed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    /* the results keep the loops alive and must stay unit */
+    (void)qmc5883l_ahrs_get_quaternion(&gs_ahrs, q);
+    (void)qmc5883l_ahrs_fixed_get_quaternion(&gs_ahrs_fixed, q_fixed);
+    if ((fabsf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3] - 1.0f) > 1e-4f) ||
+        (fabs(((double)q_fixed[0] * q_fixed[0] + (double)q_fixed[1] * q_fixed[1] + (double)q_fixed[2] * q_fixed[2] +
+               (double)q_fixed[3] * q_fixed[3]) / ((double)QMC5883L_AHRS_FIXED_ONE * QMC5883L_AHRS_FIXED_ONE) - 1.0) > 1e-4))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: quaternion norm check error.\n");
+        
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: float %.0f updates/s, fixed %.0f updates/s.\n",
+                                   (seconds > 0.0) ? AHRS_TEST_BENCH_STEPS / seconds : 0.0,
+                                   (seconds_fixed > 0.0) ? AHRS_TEST_BENCH_STEPS / seconds_fixed : 0.0);
+    
+    return 0;
+}
+
+/**
+ * @brief  wait for the next sample
+ * @return status code
+ *         - 0 success
+ *         - 1 wait failed
+ * @note   none
+ */
+static uint8_t a_ahrs_test_wait(void)
+{
+    uint8_t status;
+    uint8_t i;
+    
+    for (i = 0; i < AHRS_TEST_POLL_TRIES; i++)
+    {
+        if (qmc5883l_get_status(&gs_handle, &status) != 0)
+        {
+            return 1;
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)
+        {
+            return 0;
+        }
+        qmc5883l_interface_delay_ms(AHRS_TEST_POLL_MS);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     ahrs test
+ * @param[in] times is the number of read samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sensor must be kept level and still, the fused yaw must match the flat heading
+ */
+uint8_t qmc5883l_ahrs_test(uint32_t times)
+{
+    const float gyro[3] = {0.0f, 0.0f, 0.0f};
+    const float accel[3] = {0.0f, 0.0f, 1.0f};
+    const int32_t big[3] = {1 << 25, 0, 0};
+    uint8_t res;
+    uint32_t i;
+    int16_t raw[3];
+    float m_gauss[3];
+    float roll;
+    float pitch;
+    float yaw;
+    float heading;
+    float diff;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start ahrs test */
+    qmc5883l_interface_debug_print("qmc5883l: start ahrs test.\n");
+    
+    /* param limits */
+    if ((qmc5883l_ahrs_init(&gs_ahrs, -1.0f, 0.0f) != 4) ||
+        (qmc5883l_ahrs_update(&gs_ahrs, 0, gyro, accel) != 3) ||
+        (qmc5883l_ahrs_fixed_init(&gs_ahrs_fixed, 0, -1) != 4) ||
+        (qmc5883l_ahrs_fixed_init(&gs_ahrs_fixed, QMC5883L_AHRS_FIXED_GAIN_ONE, 0) != 0) ||
+        (qmc5883l_ahrs_fixed_set_mag(&gs_ahrs_fixed, 0, big) != 4) ||
+        (qmc5883l_ahrs_fixed_update(&gs_ahrs_fixed, 0, big, big) != 4))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: ahrs limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* synthetic trajectory */
+    res = a_ahrs_test_track();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: synthetic trajectory is tracked.\n");
+    
+    /* update rate */
+    res = a_ahrs_test_bench();
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* level and still, the yaw follows the heading within a few seconds */
+    (void)qmc5883l_ahrs_init(&gs_ahrs, AHRS_TEST_LIVE_KP, 0.0f);
+    for (i = 0; i < times; i++)
+    {
+        uint64_t time_us = (uint64_t)i * AHRS_TEST_LIVE_US;
+        
+        res = a_ahrs_test_wait();
+        if (res == 0)
+        {
+            res = qmc5883l_read(&gs_handle, raw, m_gauss);
+        }
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (void)qmc5883l_ahrs_set_mag(&gs_ahrs, time_us, m_gauss);
+        (void)qmc5883l_ahrs_update(&gs_ahrs, time_us, gyro, accel);
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    (void)qmc5883l_ahrs_get_euler(&gs_ahrs, &roll, &pitch, &yaw);
+    (void)qmc5883l_heading_flat(m_gauss, &heading);
+    diff = fmodf(yaw - heading + 540.0f, 360.0f) - 180.0f;
+    qmc5883l_interface_debug_print("qmc5883l: roll %.2f pitch %.2f yaw %.2f deg, flat heading %.2f deg.\n",
+                                   roll, pitch, yaw, heading);
+    if ((fabsf(roll) > 1.0f) || (fabsf(pitch) > 1.0f) || (fabsf(diff) > 2.0f))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: yaw check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish ahrs test */
+    qmc5883l_interface_debug_print("qmc5883l: finish ahrs test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,371 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_allan_test.c
+ * @brief     driver qmc5883l allan test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_allan_test.h"
+#include <math.h>
+#include <time.h>
+
+/**
+ * @brief allan test definition
+ */
+#define ALLAN_TEST_EXACT_SAMPLES    5000          /**< samples of the brute force comparison */
+#define ALLAN_TEST_EXACT_LEVELS     11            /**< octaves of the brute force comparison */
+#define ALLAN_TEST_WHITE_SAMPLES    262144        /**< samples of the white noise check */
+#define ALLAN_TEST_WHITE_LEVELS     10            /**< octaves of the white noise check */
+#define ALLAN_TEST_RATE_HZ          200.0f        /**< live output data rate */
+#define ALLAN_TEST_POLL_MS          1             /**< data ready poll period */
+#define ALLAN_TEST_POLL_TRIES       100           /**< data ready polls before timeout */
+
+static qmc5883l_handle_t gs_handle;               /**< qmc5883l handle */
+static qmc5883l_allan_t gs_allan;                 /**< allan calculator */
+static float gs_buffer[ALLAN_TEST_EXACT_SAMPLES][3];     /**< stored samples of the comparison */
+static uint32_t gs_seed = 12345;                  /**< noise generator state */
+
+/**
+ * @brief  get a gaussian noise sample
+ * @return unit variance noise
+ * @note   box muller over a 32 bit lcg
+ */
+static double a_allan_test_gauss(void)
+{
+    double u1;
+    double u2;
+    
+    gs_seed = gs_seed * 1664525U + 1013904223U;
+    u1 = ((gs_seed >> 8) + 1.0) / 16777217.0;
+    gs_seed = gs_seed * 1664525U + 1013904223U;
+    u2 = (gs_seed >> 8) / 16777216.0;
+    
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * 3.14159265358979323846 * u2);
+}
+
+/**
+ * @brief  compare with a brute force estimate over stored samples
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   noise on a slope, the reference windows end where the streaming ones do
+ */
+static uint8_t a_allan_test_exact(void)
+{
+    uint32_t n;
+    uint8_t k;
+    uint8_t a;
+    
+    (void)qmc5883l_allan_init(&gs_allan, ALLAN_TEST_RATE_HZ, ALLAN_TEST_EXACT_LEVELS);
+    for (n = 0; n < ALLAN_TEST_EXACT_SAMPLES; n++)
+    {
+        gs_buffer[n][0] = (float)(300.0 + 0.01 * n + a_allan_test_gauss());
+        gs_buffer[n][1] = (float)(-150.0 + 2.0 * a_allan_test_gauss());
+        gs_buffer[n][2] = (float)(400.0 - 0.003 * n);
+        (void)qmc5883l_allan_push(&gs_allan, gs_buffer[n]);
+    }
+    for (k = 0; k < ALLAN_TEST_EXACT_LEVELS; k++)
+    {
+        uint32_t tau = 1UL << k;
+        uint32_t stride = (k <= QMC5883L_ALLAN_OVERLAP_SHIFT) ? 1 : (tau >> QMC5883L_ALLAN_OVERLAP_SHIFT);
+        uint32_t count = 0;
+        uint32_t diffs;
+        uint32_t e;
+        uint32_t i;
+        double d2[3] = {0.0, 0.0, 0.0};
+        float sigma[3];
+        float tau_s;
+        
+        for (e = stride; e <= ALLAN_TEST_EXACT_SAMPLES; e += stride)
+        {
+            if (e < 2 * tau)
+            {
+                continue;
+            }
+            for (a = 0; a < 3; a++)
+            {
+                double d = 0.0;
+                
+                for (i = e - tau; i < e; i++)
+                {
+                    d += gs_buffer[i][a] - gs_buffer[i - tau][a];
+                }
+                d2[a] += d * d;
+            }
+            count++;
+        }
+        if (count == 0)
+        {
+            if (qmc5883l_allan_get(&gs_allan, k, &tau_s, sigma, &diffs) != 3)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: empty octave %d check error.\n", k);
+                
+                return 1;
+            }
+            continue;
+        }
+        if ((qmc5883l_allan_get(&gs_allan, k, &tau_s, sigma, &diffs) != 0) || (diffs != count) ||
+            (fabsf(tau_s - tau / ALLAN_TEST_RATE_HZ) > 1e-6f))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: octave %d window check error.\n", k);
+            
+            return 1;
+        }
+        for (a = 0; a < 3; a++)
+        {
+            double ref = sqrt(d2[a] / (2.0 * tau * tau * count));
+            
+            if (fabs(sigma[a] - ref) > 1e-4 * ref + 1e-6)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: octave %d axis %d sigma %.6f, expect %.6f check error.\n", k, a, sigma[a], ref);
+                
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  check the white noise slope
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   white noise falls as 1 / sqrt(tau)
+ */
+static uint8_t a_allan_test_white(void)
+{
+    float m[3];
+    float sigma[3];
+    float tau_s;
+    uint32_t diffs;
+    uint32_t n;
+    uint8_t k;
+    uint8_t a;
+    clock_t start;
+    
+    (void)qmc5883l_allan_init(&gs_allan, ALLAN_TEST_RATE_HZ, ALLAN_TEST_WHITE_LEVELS);
+    start = clock();
+    for (n = 0; n < ALLAN_TEST_WHITE_SAMPLES; n++)
+    {
+        m[0] = (float)a_allan_test_gauss();
+        m[1] = (float)(2.0 * a_allan_test_gauss());
+        m[2] = (float)(0.5 * a_allan_test_gauss());
+        (void)qmc5883l_allan_push(&gs_allan, m);
+    }
+    qmc5883l_interface_debug_print("qmc5883l: %.1f ns per sample, %d bytes of state.\n",
+                                   (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ALLAN_TEST_WHITE_SAMPLES,
+                                   (int)sizeof(qmc5883l_allan_t));
+    for (k = 0; k < ALLAN_TEST_WHITE_LEVELS; k++)
+    {
+        const float expect[3] = {1.0f, 2.0f, 0.5f};
+        
+        (void)qmc5883l_allan_get(&gs_allan, k, &tau_s, sigma, &diffs);
+        for (a = 0; a < 3; a++)
+        {
+            float r = sigma[a] * sqrtf((float)(1UL << k)) / expect[a];
+            
+            if (fabsf(r - 1.0f) > 0.15f)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: white noise octave %d axis %d ratio %.3f check error.\n", k, a, r);
+                
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  wait for the next sample
+ * @return status code
+ *         - 0 success
+ *         - 1 wait failed
+ * @note   none
+ */
+static uint8_t a_allan_test_wait(void)
+{
+    uint8_t status;
+    uint8_t i;
+    
+    for (i = 0; i < ALLAN_TEST_POLL_TRIES; i++)
+    {
+        if (qmc5883l_get_status(&gs_handle, &status) != 0)
+        {
+            return 1;
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)
+        {
+            return 0;
+        }
+        qmc5883l_interface_delay_ms(ALLAN_TEST_POLL_MS);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     allan test
+ * @param[in] seconds is the capture length
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sensor must be kept still, every octave that fits the capture is printed
+ */
+uint8_t qmc5883l_allan_test(uint32_t seconds)
+{
+    uint8_t res;
+    uint8_t levels;
+    uint8_t k;
+    uint32_t i;
+    uint32_t samples;
+    uint32_t diffs;
+    int16_t raw[3];
+    float m_gauss[3];
+    float sigma[3];
+    float tau_s;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start allan test */
+    qmc5883l_interface_debug_print("qmc5883l: start allan test.\n");
+    
+    /* param limits */
+    if ((qmc5883l_allan_init(&gs_allan, 0.0f, 4) != 4) ||
+        (qmc5883l_allan_init(&gs_allan, ALLAN_TEST_RATE_HZ, 0) != 4) ||
+        (qmc5883l_allan_init(&gs_allan, ALLAN_TEST_RATE_HZ, QMC5883L_ALLAN_MAX_LEVELS + 1) != 4) ||
+        (qmc5883l_allan_init(&gs_allan, ALLAN_TEST_RATE_HZ, 4) != 0) ||
+        (qmc5883l_allan_get(&gs_allan, 0, &tau_s, sigma, &diffs) != 3) ||
+        (qmc5883l_allan_get(&gs_allan, 4, &tau_s, sigma, &diffs) != 4))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: allan limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* brute force comparison */
+    res = a_allan_test_exact();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: streaming estimate matches the stored samples.\n");
+    
+    /* white noise slope */
+    res = a_allan_test_white();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: white noise falls as 1 / sqrt(tau).\n");
+    
+    /* every octave with two windows in the capture */
+    samples = seconds * (uint32_t)ALLAN_TEST_RATE_HZ;
+    if (samples < 2)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: capture length check error.\n");
+        
+        return 1;
+    }
+    for (levels = 1; (levels < QMC5883L_ALLAN_MAX_LEVELS) && ((2UL << levels) <= samples); levels++)
+    {
+    }
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* capture */
+    (void)qmc5883l_allan_init(&gs_allan, ALLAN_TEST_RATE_HZ, levels);
+    for (i = 0; i < samples; i++)
+    {
+        res = a_allan_test_wait();
+        if (res == 0)
+        {
+            res = qmc5883l_read(&gs_handle, raw, m_gauss);
+        }
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (void)qmc5883l_allan_push(&gs_allan, m_gauss);
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    /* sigma(tau) per axis */
+    for (k = 0; k < levels; k++)
+    {
+        if (qmc5883l_allan_get(&gs_allan, k, &tau_s, sigma, &diffs) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: octave %d check error.\n", k);
+            
+            return 1;
+        }
+        qmc5883l_interface_debug_print("qmc5883l: tau %.3fs sigma %.4f %.4f %.4f mgauss, %d differences.\n",
+                                       tau_s, sigma[0], sigma[1], sigma[2], (int)diffs);
+    }
+    
+    /* finish allan test */
+    qmc5883l_interface_debug_print("qmc5883l: finish allan test.\n");
+    
+    return 0;
+}
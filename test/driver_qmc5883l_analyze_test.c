@@ -0,0 +1,449 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_analyze_test.c
+ * @brief     driver qmc5883l analyze test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "driver_qmc5883l_analyze_test.h"
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief analyze test definition
+ */
+#define ANALYZE_TEST_FILES          16                 /**< synthetic files */
+#define ANALYZE_TEST_BASE           40000              /**< samples of the first file */
+#define ANALYZE_TEST_STEP           13331              /**< more samples per file */
+#define ANALYZE_TEST_BLOCK          1024               /**< samples per index block */
+#define ANALYZE_TEST_GRAIN          4                  /**< blocks below which a task is not split */
+#define ANALYZE_TEST_HIST_MAX       1000.0f            /**< histogram upper edge in mgauss */
+#define ANALYZE_TEST_RADIUS         6000.0             /**< mean field in lsb at 2gauss */
+#define ANALYZE_TEST_POLL_MS        1                  /**< data ready poll period */
+#define ANALYZE_TEST_POLL_TRIES     100                /**< data ready polls before timeout */
+
+static qmc5883l_handle_t gs_handle;                                  /**< qmc5883l handle */
+static qmc5883l_index_writer_t gs_writer;                            /**< index writer */
+static qmc5883l_index_reader_t gs_reader;                            /**< index reader */
+static qmc5883l_calibration_t gs_cal;                                /**< hard iron calibration */
+static qmc5883l_analyze_stats_t gs_stats[2];                         /**< first and current run */
+static char gs_path[ANALYZE_TEST_FILES][64];                         /**< file names */
+static const char *gs_paths[ANALYZE_TEST_FILES];                     /**< file name pointers */
+static const int16_t gs_offset[3] = {300, -200, 100};                /**< hard iron offset in lsb */
+static uint32_t gs_seed = 17;                                        /**< noise generator state */
+
+/**
+ * @brief  monotonic time
+ * @return time in seconds
+ * @note   the cpu clock would add up the threads
+ */
+static double a_analyze_test_now(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief  remove the synthetic files
+ * @note   none
+ */
+static void a_analyze_test_remove(void)
+{
+    uint32_t f;
+    
+    for (f = 0; f < ANALYZE_TEST_FILES; f++)
+    {
+        (void)remove(gs_path[f]);
+    }
+}
+
+/**
+ * @brief  write the synthetic files
+ * @return status code
+ *         - 0 success
+ *         - 1 write failed
+ * @note   a rotating field with a slowly breathing magnitude, a hard iron offset and noise
+ */
+static uint8_t a_analyze_test_write(void)
+{
+    int16_t raw[3];
+    uint32_t f;
+    uint32_t n;
+    uint8_t a;
+    
+    for (f = 0; f < ANALYZE_TEST_FILES; f++)
+    {
+        (void)snprintf(gs_path[f], sizeof(gs_path[f]), "qmc5883l_analyze_test_%02d.bin", (int)f);
+        gs_paths[f] = gs_path[f];
+        if (qmc5883l_index_create(&gs_writer, gs_path[f], ANALYZE_TEST_BLOCK) != 0)
+        {
+            return 1;
+        }
+        for (n = 0; n < ANALYZE_TEST_BASE + f * ANALYZE_TEST_STEP; n++)
+        {
+            double theta = n * 0.001 + f;
+            double phi = n * 0.0007 + 0.3 * f;
+            double r = ANALYZE_TEST_RADIUS * (1.0 + 0.1 * sin(n * 1e-4 + f));
+            double dir[3];
+            
+            dir[0] = sin(phi) * cos(theta);
+            dir[1] = sin(phi) * sin(theta);
+            dir[2] = cos(phi);
+            for (a = 0; a < 3; a++)
+            {
+                gs_seed = gs_seed * 1664525U + 1013904223U;
+                raw[a] = (int16_t)lround(r * dir[a] + gs_offset[a] + (double)((gs_seed >> 16) % 61) - 30.0);
+            }
+            if (qmc5883l_index_append(&gs_writer, (uint64_t)n * 5000U, raw) != 0)
+            {
+                (void)qmc5883l_index_finish(&gs_writer);
+                
+                return 1;
+            }
+        }
+        if (qmc5883l_index_finish(&gs_writer) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  check the first run against a plain loop
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   the loop uses qmc5883l_calibration_apply, the bins may differ at the edges by rounding
+ */
+static uint8_t a_analyze_test_reference(void)
+{
+    const qmc5883l_analyze_stats_t *s = &gs_stats[0];
+    const float resolution = 1000.0f / 12000.0f;
+    uint64_t hist[QMC5883L_ANALYZE_BINS];
+    uint64_t count;
+    uint64_t moved;
+    uint64_t i;
+    uint32_t f;
+    double sum;
+    double sum2;
+    double mean;
+    double sigma;
+    float min;
+    float max;
+    
+    memset(hist, 0, sizeof(hist));
+    count = 0;
+    sum = 0.0;
+    sum2 = 0.0;
+    min = 0.0f;
+    max = 0.0f;
+    for (f = 0; f < ANALYZE_TEST_FILES; f++)
+    {
+        if (qmc5883l_index_open(&gs_reader, gs_path[f]) != 0)
+        {
+            return 1;
+        }
+        for (i = 0; i < gs_reader.header->samples; i++)
+        {
+            float m[3];
+            float out[3];
+            float mag;
+            uint32_t bin;
+            
+            m[0] = (float)gs_reader.samples[i].raw[0] * resolution;
+            m[1] = (float)gs_reader.samples[i].raw[1] * resolution;
+            m[2] = (float)gs_reader.samples[i].raw[2] * resolution;
+            (void)qmc5883l_calibration_apply(&gs_cal, m, out);
+            mag = sqrtf(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+            bin = (uint32_t)(mag * (QMC5883L_ANALYZE_BINS / ANALYZE_TEST_HIST_MAX));
+            hist[(bin < QMC5883L_ANALYZE_BINS) ? bin : (QMC5883L_ANALYZE_BINS - 1)]++;
+            min = ((count == 0) || (mag < min)) ? mag : min;
+            max = ((count == 0) || (mag > max)) ? mag : max;
+            sum += mag;
+            sum2 += (double)mag * mag;
+            count++;
+        }
+        (void)qmc5883l_index_close(&gs_reader);
+    }
+    mean = sum / count;
+    sigma = sqrt((sum2 - sum * mean) / (count - 1));
+    moved = 0;
+    for (i = 0; i < QMC5883L_ANALYZE_BINS; i++)
+    {
+        moved += (hist[i] > s->hist[i]) ? (hist[i] - s->hist[i]) : (s->hist[i] - hist[i]);
+    }
+    qmc5883l_interface_debug_print("qmc5883l: %d samples, mean %.3f sigma %.3f min %.3f max %.3f mgauss.\n",
+                                   (int)s->count, s->mean_mgauss, s->sigma_mgauss, s->min_mgauss, s->max_mgauss);
+    if ((s->count != count) || (fabs(s->mean_mgauss - mean) > 1e-3) || (fabs(s->sigma_mgauss - sigma) > 1e-3) ||
+        (fabsf(s->min_mgauss - min) > 1e-3f) || (fabsf(s->max_mgauss - max) > 1e-3f) || (moved > count / 10000))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: reference check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  check the current run against the first run
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   only the merge order of the floating point sums may differ
+ */
+static uint8_t a_analyze_test_same(void)
+{
+    const qmc5883l_analyze_stats_t *a = &gs_stats[0];
+    const qmc5883l_analyze_stats_t *b = &gs_stats[1];
+    
+    if ((a->count != b->count) || (a->min_mgauss != b->min_mgauss) || (a->max_mgauss != b->max_mgauss) ||
+        (memcmp(a->hist, b->hist, sizeof(a->hist)) != 0) ||
+        (fabs(a->mean_mgauss - b->mean_mgauss) > 1e-9 * a->mean_mgauss) ||
+        (fabs(a->sigma_mgauss - b->sigma_mgauss) > 1e-9 * a->sigma_mgauss))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: thread result check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  wait for the next sample
+ * @return status code
+ *         - 0 success
+ *         - 1 wait failed
+ * @note   none
+ */
+static uint8_t a_analyze_test_wait(void)
+{
+    uint8_t status;
+    uint8_t i;
+    
+    for (i = 0; i < ANALYZE_TEST_POLL_TRIES; i++)
+    {
+        if (qmc5883l_get_status(&gs_handle, &status) != 0)
+        {
+            return 1;
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)
+        {
+            return 0;
+        }
+        qmc5883l_interface_delay_ms(ANALYZE_TEST_POLL_MS);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     analyze test
+ * @param[in] times is the number of logged chip samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the index files are written into the working directory and removed afterwards
+ */
+uint8_t qmc5883l_analyze_test(uint32_t times)
+{
+    const float offset[3] = {300.0f / 12.0f, -200.0f / 12.0f, 100.0f / 12.0f};
+    const float matrix[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    const uint32_t threads[4] = {1, 2, 4, 8};
+    qmc5883l_analyze_config_t config;
+    double single;
+    double seconds;
+    uint32_t i;
+    uint8_t res;
+    int16_t raw[3];
+    float m_gauss[3];
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start analyze test */
+    qmc5883l_interface_debug_print("qmc5883l: start analyze test.\n");
+    
+    /* param limits */
+    (void)qmc5883l_calibration_init(&gs_cal);
+    (void)qmc5883l_calibration_set(&gs_cal, offset, matrix, 500.0f);
+    config.scale = QMC5883L_FULL_SCALE_2GAUSS;
+    config.cal = &gs_cal;
+    config.hist_max_mgauss = ANALYZE_TEST_HIST_MAX;
+    config.threads = 0;
+    config.grain = ANALYZE_TEST_GRAIN;
+    gs_paths[0] = "qmc5883l_analyze_test_missing.bin";
+    if ((qmc5883l_analyze_run(NULL, 1, &config, &gs_stats[0]) != 2) ||
+        (qmc5883l_analyze_run(gs_paths, 1, &config, &gs_stats[0]) != 4) ||
+        (qmc5883l_analyze_run(gs_paths, 0, &config, &gs_stats[0]) != 4))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: analyze limit check error.\n");
+        
+        return 1;
+    }
+    config.threads = 1;
+    if (qmc5883l_analyze_run(gs_paths, 1, &config, &gs_stats[0]) != 1)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: missing file check error.\n");
+        
+        return 1;
+    }
+    
+    /* synthetic files */
+    if (a_analyze_test_write() != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: write files failed.\n");
+        a_analyze_test_remove();
+        
+        return 1;
+    }
+    
+    /* the same result on every thread count */
+    single = 0.0;
+    qmc5883l_interface_debug_print("qmc5883l: %d files on %d online cores.\n", ANALYZE_TEST_FILES, (int)sysconf(_SC_NPROCESSORS_ONLN));
+    for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++)
+    {
+        qmc5883l_analyze_stats_t *s = &gs_stats[(i == 0) ? 0 : 1];
+        
+        config.threads = threads[i];
+        seconds = a_analyze_test_now();
+        res = qmc5883l_analyze_run(gs_paths, ANALYZE_TEST_FILES, &config, s);
+        seconds = a_analyze_test_now() - seconds;
+        single = (i == 0) ? seconds : single;
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: analyze run failed.\n");
+            a_analyze_test_remove();
+            
+            return 1;
+        }
+        qmc5883l_interface_debug_print("qmc5883l: %d threads %.1fms, %.1fM samples/s, speedup %.2f, %d tasks, %d steals.\n",
+                                       (int)threads[i], seconds * 1000.0, s->count / seconds * 1e-6, single / seconds,
+                                       (int)s->tasks, (int)s->steals);
+        if (((i == 0) && (a_analyze_test_reference() != 0)) || ((i != 0) && (a_analyze_test_same() != 0)))
+        {
+            a_analyze_test_remove();
+            
+            return 1;
+        }
+    }
+    a_analyze_test_remove();
+    qmc5883l_interface_debug_print("qmc5883l: every thread count matches the plain loop.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* log the chip into one file */
+    if (qmc5883l_index_create(&gs_writer, gs_path[0], 64) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: write files failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < times; i++)
+    {
+        res = a_analyze_test_wait();
+        if (res == 0)
+        {
+            res = qmc5883l_read(&gs_handle, raw, m_gauss);
+        }
+        if ((res != 0) || (qmc5883l_index_append(&gs_writer, (uint64_t)i * 5000U, raw) != 0))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            (void)qmc5883l_index_finish(&gs_writer);
+            (void)remove(gs_path[0]);
+            
+            return 1;
+        }
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    /* analyze it uncalibrated */
+    config.cal = NULL;
+    config.threads = 2;
+    config.grain = 1;
+    res = qmc5883l_index_finish(&gs_writer);
+    if (res == 0)
+    {
+        res = qmc5883l_analyze_run(gs_paths, 1, &config, &gs_stats[1]);
+    }
+    (void)remove(gs_path[0]);
+    if ((res != 0) || (gs_stats[1].count != times))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: chip analyze check error.\n");
+        
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: %d chip samples, mean %.3f sigma %.3f mgauss.\n",
+                                   (int)times, gs_stats[1].mean_mgauss, gs_stats[1].sigma_mgauss);
+    
+    /* finish analyze test */
+    qmc5883l_interface_debug_print("qmc5883l: finish analyze test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_autorange_test.c
+ * @brief     driver qmc5883l autorange test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_autorange_test.h"
+#include <math.h>
+
+/**
+ * @brief autorange test definition
+ */
+#define AUTORANGE_TEST_DOWN_RATIO        0.5f        /**< go down below half of the 2gauss span */
+#define AUTORANGE_TEST_HOLD              20          /**< 100ms below the threshold */
+#define AUTORANGE_TEST_PERIOD_MS         5           /**< 200Hz sample period */
+
+static qmc5883l_handle_t gs_handle;                  /**< qmc5883l handle */
+static qmc5883l_autorange_t gs_autorange;            /**< auto range */
+static uint32_t gs_writes;                           /**< iic write transactions */
+
+/**
+ * @brief     counting iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_autorange_test_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_writes++;
+    
+    return qmc5883l_interface_iic_write(addr, reg, buf, len);
+}
+
+/**
+ * @brief     autorange test
+ * @param[in] times is the number of read samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      a magnet must be moved close to the sensor and away again during the test
+ */
+uint8_t qmc5883l_autorange_test(uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t ups;
+    uint32_t downs;
+    uint32_t overflows;
+    uint32_t writes;
+    int16_t raw[3];
+    float m_gauss[3];
+    float prev[3];
+    float step;
+    qmc5883l_full_scale_t scale;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, a_autorange_test_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start autorange test */
+    qmc5883l_interface_debug_print("qmc5883l: start autorange test.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 64 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_64) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* ratio and hold limits */
+    if ((qmc5883l_autorange_init(&gs_autorange, &gs_handle, 1.0f, AUTORANGE_TEST_HOLD) != 4) ||
+        (qmc5883l_autorange_init(&gs_autorange, &gs_handle, AUTORANGE_TEST_DOWN_RATIO, 0) != 4) ||
+        (qmc5883l_autorange_init(&gs_autorange, &gs_handle, AUTORANGE_TEST_DOWN_RATIO, AUTORANGE_TEST_HOLD) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: autorange limit check error.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* read through the field changes */
+    qmc5883l_interface_debug_print("qmc5883l: go up on overflow, down below %.0f%% of 2gauss for %d samples.\n",
+                                   AUTORANGE_TEST_DOWN_RATIO * 100.0f, AUTORANGE_TEST_HOLD);
+    ups = 0;
+    downs = 0;
+    overflows = 0;
+    gs_writes = 0;
+    prev[0] = 0.0f;
+    prev[1] = 0.0f;
+    prev[2] = 0.0f;
+    step = 0.0f;
+    scale = QMC5883L_FULL_SCALE_2GAUSS;
+    for (i = 0; i < times; i++)
+    {
+        qmc5883l_full_scale_t before;
+        float jump;
+        uint8_t flags;
+        uint8_t k;
+        
+        qmc5883l_interface_delay_ms(AUTORANGE_TEST_PERIOD_MS);
+        before = scale;
+        res = qmc5883l_autorange_read(&gs_autorange, raw, m_gauss, &flags);
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (void)qmc5883l_autorange_get_full_scale(&gs_autorange, &scale);
+        jump = 0.0f;
+        for (k = 0; k < 3; k++)
+        {
+            jump = (fabsf(m_gauss[k] - prev[k]) > jump) ? fabsf(m_gauss[k] - prev[k]) : jump;
+        }
+        prev[0] = m_gauss[0];
+        prev[1] = m_gauss[1];
+        prev[2] = m_gauss[2];
+        if ((flags & QMC5883L_AUTORANGE_FLAG_OVERFLOW) != 0)
+        {
+            overflows++;
+        }
+        if ((before == QMC5883L_FULL_SCALE_2GAUSS) && (scale == QMC5883L_FULL_SCALE_8GAUSS))
+        {
+            ups++;
+        }
+        if ((before == QMC5883L_FULL_SCALE_8GAUSS) && (scale == QMC5883L_FULL_SCALE_2GAUSS))
+        {
+            downs++;
+        }
+        
+        /* the first sample after going down must join the 8gauss samples smoothly */
+        if (((flags & QMC5883L_AUTORANGE_FLAG_SWITCH) != 0) && (before == QMC5883L_FULL_SCALE_2GAUSS) &&
+            (jump > 3.0f * step + 10.0f))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: jump of %.1f mgauss after going down check error.\n", jump);
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if ((flags & (QMC5883L_AUTORANGE_FLAG_OVERFLOW | QMC5883L_AUTORANGE_FLAG_SWITCH)) == 0)
+        {
+            step = jump;
+        }
+    }
+    writes = gs_writes;
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    /* check the switches */
+    qmc5883l_interface_debug_print("qmc5883l: %d samples, %d clipped, %d up and %d down switches, %d control1 writes.\n",
+                                   times, overflows, ups, downs, writes);
+    if ((ups == 0) || (downs == 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: no range switch, move a magnet close to the sensor and away again.\n");
+        
+        return 1;
+    }
+    if (writes != ups + downs)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: bus write count check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish autorange test */
+    qmc5883l_interface_debug_print("qmc5883l: finish autorange test.\n");
+    
+    return 0;
+}
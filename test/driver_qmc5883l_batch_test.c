@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_batch_test.c
+ * @brief     driver qmc5883l batch test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_batch_test.h"
+#include <math.h>
+#include <time.h>
+
+/**
+ * @brief batch test definition
+ */
+#define BATCH_TEST_LEN              1021          /**< samples, not a multiple of the simd width to cover the tail */
+#define BATCH_TEST_TOLERANCE        0.001f        /**< max relative float deviation */
+
+static int16_t gs_raw[BATCH_TEST_LEN][3];                 /**< raw samples */
+static float gs_ref[BATCH_TEST_LEN][3];                   /**< per sample reference */
+static float gs_out[BATCH_TEST_LEN][3];                   /**< batch output */
+static int32_t gs_fixed[BATCH_TEST_LEN][3];               /**< batch fixed point output */
+static qmc5883l_calibration_t gs_calibration;             /**< calibration */
+static const char *const gs_kernel_name[] =               /**< kernel name */
+{
+    "scalar", "sse2", "avx2", "neon",
+};
+
+/**
+ * @brief     get the seconds of a clock interval
+ * @param[in] start is the start clock
+ * @return    seconds
+ * @note      none
+ */
+static double a_batch_test_seconds(clock_t start)
+{
+    double s;
+    
+    s = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    return (s > 1e-9) ? s : 1e-9;
+}
+
+/**
+ * @brief  run the per sample path over the buffer
+ * @note   this is the qmc5883l_read conversion followed by qmc5883l_calibration_apply
+ */
+static void a_batch_test_reference(void)
+{
+    uint32_t i;
+    
+    for (i = 0; i < BATCH_TEST_LEN; i++)
+    {
+        float m_gauss[3];
+        
+        m_gauss[0] = (float)(gs_raw[i][0]) * (1000.0f / 12000.0f);
+        m_gauss[1] = (float)(gs_raw[i][1]) * (1000.0f / 12000.0f);
+        m_gauss[2] = (float)(gs_raw[i][2]) * (1000.0f / 12000.0f);
+        (void)qmc5883l_calibration_apply(&gs_calibration, m_gauss, gs_ref[i]);
+    }
+}
+
+/**
+ * @brief  check the batch output against the reference
+ * @return 1 if any value deviates
+ * @note   none
+ */
+static uint8_t a_batch_test_check(void)
+{
+    uint32_t i;
+    uint8_t j;
+    
+    for (i = 0; i < BATCH_TEST_LEN; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            float ref;
+            float fixed;
+            
+            ref = gs_ref[i][j];
+            if (fabsf(gs_out[i][j] - ref) > BATCH_TEST_TOLERANCE * (fabsf(ref) + 1.0f))
+            {
+                return 1;
+            }
+            fixed = (float)gs_fixed[i][j] / (float)(1 << QMC5883L_BATCH_FRAC_BITS);
+            if (fabsf(fixed - ref) > BATCH_TEST_TOLERANCE * (fabsf(ref) + 1.0f) + 1.0f / (float)(1 << QMC5883L_BATCH_FRAC_BITS))
+            {
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     batch test
+ * @param[in] times is the number of benchmark passes over the sample buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the chip is not used
+ */
+uint8_t qmc5883l_batch_test(uint32_t times)
+{
+    const float offset[3] = {120.0f, -80.0f, 60.0f};
+    const float matrix[3][3] = {{0.93f, -0.05f, -0.02f}, {-0.05f, 1.11f, 0.03f}, {-0.02f, 0.03f, 0.98f}};
+    qmc5883l_batch_kernel_t native;
+    uint32_t seed;
+    uint32_t i;
+    uint32_t t;
+    uint8_t k;
+    clock_t start;
+    double scalar_rate;
+    
+    /* start batch test */
+    qmc5883l_interface_debug_print("qmc5883l: start batch test.\n");
+    
+    /* random samples over the whole int16 range */
+    seed = 1;
+    for (i = 0; i < BATCH_TEST_LEN; i++)
+    {
+        uint8_t j;
+        
+        for (j = 0; j < 3; j++)
+        {
+            seed = seed * 1664525U + 1013904223U;
+            gs_raw[i][j] = (int16_t)(seed >> 16);
+        }
+    }
+    (void)qmc5883l_calibration_init(&gs_calibration);
+    (void)qmc5883l_calibration_set(&gs_calibration, offset, matrix, 500.0f);
+    
+    /* benchmark the per sample path */
+    start = clock();
+    for (t = 0; t < times; t++)
+    {
+        a_batch_test_reference();
+    }
+    scalar_rate = (double)BATCH_TEST_LEN * times / a_batch_test_seconds(start) / 1000000.0;
+    qmc5883l_interface_debug_print("qmc5883l: per sample path %.1f Msamples/s.\n", scalar_rate);
+    
+    /* check and benchmark every built kernel */
+    (void)qmc5883l_batch_get_native_kernel(&native);
+    qmc5883l_interface_debug_print("qmc5883l: native kernel is %s.\n", gs_kernel_name[native]);
+    for (k = QMC5883L_BATCH_KERNEL_SCALAR; k <= QMC5883L_BATCH_KERNEL_NEON; k++)
+    {
+        double rate;
+        double fixed_rate;
+        
+        if (qmc5883l_batch_set_kernel((qmc5883l_batch_kernel_t)k) != 0)
+        {
+            continue;
+        }
+        memset(gs_out, 0, sizeof(gs_out));
+        memset(gs_fixed, 0, sizeof(gs_fixed));
+        if ((qmc5883l_batch_calibrate(&gs_calibration, QMC5883L_FULL_SCALE_2GAUSS, (const int16_t (*)[3])gs_raw, gs_out, BATCH_TEST_LEN) != 0) ||
+            (qmc5883l_batch_calibrate_fixed(&gs_calibration, QMC5883L_FULL_SCALE_2GAUSS, (const int16_t (*)[3])gs_raw, gs_fixed, BATCH_TEST_LEN) != 0))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: batch calibrate failed.\n");
+            (void)qmc5883l_batch_set_kernel(native);
+            
+            return 1;
+        }
+        if (a_batch_test_check() != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: %s kernel check error.\n", gs_kernel_name[k]);
+            (void)qmc5883l_batch_set_kernel(native);
+            
+            return 1;
+        }
+        
+        /* float output */
+        start = clock();
+        for (t = 0; t < times; t++)
+        {
+            (void)qmc5883l_batch_calibrate(&gs_calibration, QMC5883L_FULL_SCALE_2GAUSS, (const int16_t (*)[3])gs_raw, gs_out, BATCH_TEST_LEN);
+        }
+        rate = (double)BATCH_TEST_LEN * times / a_batch_test_seconds(start) / 1000000.0;
+        
+        /* fixed point output */
+        start = clock();
+        for (t = 0; t < times; t++)
+        {
+            (void)qmc5883l_batch_calibrate_fixed(&gs_calibration, QMC5883L_FULL_SCALE_2GAUSS, (const int16_t (*)[3])gs_raw, gs_fixed, BATCH_TEST_LEN);
+        }
+        fixed_rate = (double)BATCH_TEST_LEN * times / a_batch_test_seconds(start) / 1000000.0;
+        qmc5883l_interface_debug_print("qmc5883l: %s kernel float %.1f Msamples/s (x%.1f), fixed %.1f Msamples/s (x%.1f).\n",
+                                       gs_kernel_name[k], rate, rate / scalar_rate, fixed_rate, fixed_rate / scalar_rate);
+    }
+    (void)qmc5883l_batch_set_kernel(native);
+    
+    /* finish batch test */
+    qmc5883l_interface_debug_print("qmc5883l: finish batch test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,436 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_bench_test.c
+ * @brief     driver qmc5883l bench test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_bench_test.h"
+#include <time.h>
+
+/**
+ * @brief bench test definition
+ */
+#define BENCH_TEST_PERIOD        0x01          /**< recommended period value */
+#define BENCH_TEST_LIFECYCLE     2             /**< entries that run on the unconfigured chip */
+
+/**
+ * @brief bench function enumeration definition
+ */
+typedef enum
+{
+    BENCH_TEST_INFO,
+    BENCH_TEST_INIT,
+    BENCH_TEST_GET_MODE,
+    BENCH_TEST_SET_MODE,
+    BENCH_TEST_GET_OUTPUT_RATE,
+    BENCH_TEST_SET_OUTPUT_RATE,
+    BENCH_TEST_GET_FULL_SCALE,
+    BENCH_TEST_SET_FULL_SCALE,
+    BENCH_TEST_GET_OVER_SAMPLE,
+    BENCH_TEST_SET_OVER_SAMPLE,
+    BENCH_TEST_GET_INTERRUPT,
+    BENCH_TEST_SET_INTERRUPT,
+    BENCH_TEST_GET_POINTER_ROLL_OVER,
+    BENCH_TEST_SET_POINTER_ROLL_OVER,
+    BENCH_TEST_GET_PERIOD,
+    BENCH_TEST_SET_PERIOD,
+    BENCH_TEST_GET_STATUS,
+    BENCH_TEST_READ,
+    BENCH_TEST_READ_TEMPERATURE,
+    BENCH_TEST_GET_REG,
+    BENCH_TEST_SET_REG,
+    BENCH_TEST_SOFT_RESET,
+} bench_test_function_t;
+
+/**
+ * @brief bench entry structure definition
+ */
+typedef struct bench_entry_s
+{
+    const char *name;                          /**< public function name */
+    bench_test_function_t function;            /**< function to call */
+    float max_iic;                             /**< iic transactions per call budget */
+} bench_entry_t;
+
+static qmc5883l_handle_t gs_handle;            /**< qmc5883l handle */
+static uint32_t gs_iic;                        /**< iic transactions */
+static uint32_t gs_bytes;                      /**< iic bytes on the wire */
+static uint32_t gs_delays;                     /**< delay_ms calls */
+static uint64_t gs_delay_ms;                   /**< delayed time */
+static qmc5883l_mode_t gs_mode;                /**< mode read back by the getter */
+static qmc5883l_output_rate_t gs_rate;         /**< rate read back by the getter */
+static qmc5883l_full_scale_t gs_scale;         /**< scale read back by the getter */
+static qmc5883l_over_sample_t gs_sample;       /**< over sample read back by the getter */
+static qmc5883l_bool_t gs_interrupt;           /**< interrupt read back by the getter */
+static qmc5883l_bool_t gs_roll_over;           /**< roll over read back by the getter */
+static uint8_t gs_period;                      /**< period read back by the getter */
+
+/**
+ * @brief     counting iic bus read
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_bench_test_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_iic++;
+    gs_bytes += len;
+    
+    return qmc5883l_interface_iic_read(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_bench_test_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_iic++;
+    gs_bytes += len;
+    
+    return qmc5883l_interface_iic_write(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting delay
+ * @param[in] ms is the delay time
+ * @note      forwards to the interface
+ */
+static void a_bench_test_delay_ms(uint32_t ms)
+{
+    gs_delays++;
+    gs_delay_ms += ms;
+    
+    qmc5883l_interface_delay_ms(ms);
+}
+
+/**
+ * @brief     call one public function
+ * @param[in] function is the function to call
+ * @return    status code
+ *            - 0 success
+ *            - 1 call failed
+ * @note      setters write back what the getters read, so the chip state never changes
+ */
+static uint8_t a_bench_test_call(bench_test_function_t function)
+{
+    qmc5883l_info_t info;
+    int16_t raw[3];
+    float m_gauss[3];
+    float deg;
+    uint8_t status;
+    uint8_t buf[6];
+    
+    switch (function)
+    {
+        case BENCH_TEST_INFO :
+        {
+            return qmc5883l_info(&info);
+        }
+        case BENCH_TEST_INIT :
+        {
+            if (qmc5883l_deinit(&gs_handle) != 0)
+            {
+                return 1;
+            }
+            
+            return qmc5883l_init(&gs_handle);
+        }
+        case BENCH_TEST_GET_MODE :
+        {
+            return qmc5883l_get_mode(&gs_handle, &gs_mode);
+        }
+        case BENCH_TEST_SET_MODE :
+        {
+            return qmc5883l_set_mode(&gs_handle, gs_mode);
+        }
+        case BENCH_TEST_GET_OUTPUT_RATE :
+        {
+            return qmc5883l_get_output_rate(&gs_handle, &gs_rate);
+        }
+        case BENCH_TEST_SET_OUTPUT_RATE :
+        {
+            return qmc5883l_set_output_rate(&gs_handle, gs_rate);
+        }
+        case BENCH_TEST_GET_FULL_SCALE :
+        {
+            return qmc5883l_get_full_scale(&gs_handle, &gs_scale);
+        }
+        case BENCH_TEST_SET_FULL_SCALE :
+        {
+            return qmc5883l_set_full_scale(&gs_handle, gs_scale);
+        }
+        case BENCH_TEST_GET_OVER_SAMPLE :
+        {
+            return qmc5883l_get_over_sample(&gs_handle, &gs_sample);
+        }
+        case BENCH_TEST_SET_OVER_SAMPLE :
+        {
+            return qmc5883l_set_over_sample(&gs_handle, gs_sample);
+        }
+        case BENCH_TEST_GET_INTERRUPT :
+        {
+            return qmc5883l_get_interrupt(&gs_handle, &gs_interrupt);
+        }
+        case BENCH_TEST_SET_INTERRUPT :
+        {
+            return qmc5883l_set_interrupt(&gs_handle, gs_interrupt);
+        }
+        case BENCH_TEST_GET_POINTER_ROLL_OVER :
+        {
+            return qmc5883l_get_pointer_roll_over(&gs_handle, &gs_roll_over);
+        }
+        case BENCH_TEST_SET_POINTER_ROLL_OVER :
+        {
+            return qmc5883l_set_pointer_roll_over(&gs_handle, gs_roll_over);
+        }
+        case BENCH_TEST_GET_PERIOD :
+        {
+            return qmc5883l_get_period(&gs_handle, &gs_period);
+        }
+        case BENCH_TEST_SET_PERIOD :
+        {
+            return qmc5883l_set_period(&gs_handle, gs_period);
+        }
+        case BENCH_TEST_GET_STATUS :
+        {
+            return qmc5883l_get_status(&gs_handle, &status);
+        }
+        case BENCH_TEST_READ :
+        {
+            return qmc5883l_read(&gs_handle, raw, m_gauss);
+        }
+        case BENCH_TEST_READ_TEMPERATURE :
+        {
+            return qmc5883l_read_temperature(&gs_handle, &raw[0], &deg);
+        }
+        case BENCH_TEST_GET_REG :
+        {
+            return qmc5883l_get_reg(&gs_handle, 0x00, buf, 6);
+        }
+        case BENCH_TEST_SET_REG :
+        {
+            buf[0] = BENCH_TEST_PERIOD;
+            
+            return qmc5883l_set_reg(&gs_handle, 0x0B, buf, 1);
+        }
+        case BENCH_TEST_SOFT_RESET :
+        {
+            return qmc5883l_soft_reset(&gs_handle);
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief bench table, the lifecycle runs before the chip is configured, getters run before
+ *        their setters and the soft reset runs last
+ */
+static const bench_entry_t gs_entries[] =
+{
+    {"qmc5883l_info", BENCH_TEST_INFO, 0.0f},
+    {"qmc5883l_deinit+qmc5883l_init", BENCH_TEST_INIT, 5.0f},
+    {"qmc5883l_get_mode", BENCH_TEST_GET_MODE, 1.0f},
+    {"qmc5883l_set_mode", BENCH_TEST_SET_MODE, 2.0f},
+    {"qmc5883l_get_output_rate", BENCH_TEST_GET_OUTPUT_RATE, 1.0f},
+    {"qmc5883l_set_output_rate", BENCH_TEST_SET_OUTPUT_RATE, 2.0f},
+    {"qmc5883l_get_full_scale", BENCH_TEST_GET_FULL_SCALE, 1.0f},
+    {"qmc5883l_set_full_scale", BENCH_TEST_SET_FULL_SCALE, 2.0f},
+    {"qmc5883l_get_over_sample", BENCH_TEST_GET_OVER_SAMPLE, 1.0f},
+    {"qmc5883l_set_over_sample", BENCH_TEST_SET_OVER_SAMPLE, 2.0f},
+    {"qmc5883l_get_interrupt", BENCH_TEST_GET_INTERRUPT, 1.0f},
+    {"qmc5883l_set_interrupt", BENCH_TEST_SET_INTERRUPT, 2.0f},
+    {"qmc5883l_get_pointer_roll_over", BENCH_TEST_GET_POINTER_ROLL_OVER, 1.0f},
+    {"qmc5883l_set_pointer_roll_over", BENCH_TEST_SET_POINTER_ROLL_OVER, 2.0f},
+    {"qmc5883l_get_period", BENCH_TEST_GET_PERIOD, 1.0f},
+    {"qmc5883l_set_period", BENCH_TEST_SET_PERIOD, 1.0f},
+    {"qmc5883l_get_status", BENCH_TEST_GET_STATUS, 1.0f},
+    {"qmc5883l_read", BENCH_TEST_READ, 4.0f},
+    {"qmc5883l_read_temperature", BENCH_TEST_READ_TEMPERATURE, 1.0f},
+    {"qmc5883l_get_reg", BENCH_TEST_GET_REG, 1.0f},
+    {"qmc5883l_set_reg", BENCH_TEST_SET_REG, 1.0f},
+    {"qmc5883l_soft_reset", BENCH_TEST_SOFT_RESET, 2.0f},
+};
+
+/**
+ * @brief      bench a range of the table
+ * @param[in]  first is the first entry
+ * @param[in]  last is one past the last entry
+ * @param[in]  times is the number of calls per function
+ * @param[out] *over points to a budget flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 call failed
+ * @note       prints one json object per entry
+ */
+static uint8_t a_bench_test_run(uint32_t first, uint32_t last, uint32_t times, uint8_t *over)
+{
+    const uint32_t n = (uint32_t)(sizeof(gs_entries) / sizeof(gs_entries[0]));
+    uint32_t e;
+    uint32_t i;
+    
+    for (e = first; e < last; e++)
+    {
+        const bench_entry_t *entry = &gs_entries[e];
+        double ns;
+        float iic;
+        clock_t start;
+        
+        gs_iic = 0;
+        gs_bytes = 0;
+        gs_delays = 0;
+        gs_delay_ms = 0;
+        start = clock();
+        for (i = 0; i < times; i++)
+        {
+            if (a_bench_test_call(entry->function) != 0)
+            {
+                qmc5883l_interface_debug_print("]}\n");
+                qmc5883l_interface_debug_print("qmc5883l: %s failed.\n", entry->name);
+                
+                return 1;
+            }
+        }
+        ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / times;
+        iic = (float)gs_iic / (float)times;
+        qmc5883l_interface_debug_print("  {\"name\": \"%s\", \"ns_per_call\": %.1f, \"iic_per_call\": %.2f, "
+                                       "\"bytes_per_call\": %.2f, \"delays_per_call\": %.2f, \"delay_ms_per_call\": %.2f}%s\n",
+                                       entry->name, ns, iic, (double)gs_bytes / times, (double)gs_delays / times,
+                                       (double)gs_delay_ms / times, (e + 1 < n) ? "," : "");
+        if (iic > entry->max_iic)
+        {
+            *over = 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     bench test
+ * @param[in] times is the number of calls per function
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      prints one json document, a function over its iic budget fails the test
+ */
+uint8_t qmc5883l_bench_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t over;
+    uint32_t n;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, a_bench_test_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, a_bench_test_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, a_bench_test_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* check times */
+    if (times == 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: times check error.\n");
+        
+        return 1;
+    }
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* one json document, one function per line */
+    over = 0;
+    n = (uint32_t)(sizeof(gs_entries) / sizeof(gs_entries[0]));
+    qmc5883l_interface_debug_print("{\"driver\": \"qmc5883l\", \"calls\": %u, \"functions\": [\n", (unsigned int)times);
+    res = a_bench_test_run(0, BENCH_TEST_LIFECYCLE, times, &over);
+    if (res != 0)
+    {
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, BENCH_TEST_PERIOD) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("]}\n");
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = a_bench_test_run(BENCH_TEST_LIFECYCLE, n, times, &over);
+    if (res != 0)
+    {
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    qmc5883l_interface_debug_print("]}\n");
+    (void)qmc5883l_deinit(&gs_handle);
+    if (over != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: iic budget check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,377 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_binlog_test.c
+ * @brief     driver qmc5883l binlog test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_binlog_test.h"
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief binlog test definition
+ */
+#define BINLOG_TEST_BLOCK           256           /**< block length */
+#define BINLOG_TEST_MAX_BLOCKS      1024          /**< stored blocks */
+#define BINLOG_TEST_SAMPLES         20000         /**< synthetic samples */
+#define BINLOG_TEST_JUMP_EVERY      997           /**< one full scale jump this often */
+#define BINLOG_TEST_PERIOD_US       5000          /**< sample period */
+#define BINLOG_TEST_MAX_BYTES       5.0           /**< max stored bytes per chip sample */
+#define BINLOG_TEST_MIN_CHECK       1000          /**< chip samples before the size check, the open block pads */
+#define BINLOG_TEST_POLL_MS         1             /**< data ready poll period */
+#define BINLOG_TEST_POLL_TRIES      100           /**< data ready polls before timeout */
+
+static qmc5883l_handle_t gs_handle;                                             /**< qmc5883l handle */
+static qmc5883l_binlog_t gs_binlog;                                             /**< log writer */
+static uint8_t gs_block[BINLOG_TEST_BLOCK];                                     /**< open block */
+static uint8_t gs_store[BINLOG_TEST_MAX_BLOCKS][BINLOG_TEST_BLOCK];             /**< written blocks */
+static uint32_t gs_blocks;                                                      /**< written block count */
+static int16_t gs_raw[BINLOG_TEST_SAMPLES][3];                                  /**< logged samples */
+static int16_t gs_decoded[BINLOG_TEST_BLOCK][3];                                /**< decoded block */
+static uint64_t gs_time_us[BINLOG_TEST_BLOCK];                                  /**< decoded block times */
+static uint32_t gs_seed = 11;                                                   /**< noise generator state */
+
+/**
+ * @brief     block sink
+ * @param[in] *block points to a block buffer
+ * @param[in] len is the block length
+ * @return    status code
+ *            - 0 success
+ *            - 1 store is full
+ * @note      none
+ */
+static uint8_t a_binlog_test_write(const uint8_t *block, uint16_t len)
+{
+    if ((gs_blocks >= BINLOG_TEST_MAX_BLOCKS) || (len != BINLOG_TEST_BLOCK))
+    {
+        return 1;
+    }
+    memcpy(gs_store[gs_blocks], block, len);
+    gs_blocks++;
+    
+    return 0;
+}
+
+/**
+ * @brief     decode the stored blocks and compare them with the logged samples
+ * @param[in] samples is the number of logged samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      samples were logged every BINLOG_TEST_PERIOD_US from 0
+ */
+static uint8_t a_binlog_test_verify(uint32_t samples)
+{
+    uint32_t seq;
+    uint32_t n;
+    uint32_t b;
+    uint16_t count;
+    uint16_t i;
+    
+    n = 0;
+    for (b = 0; b < gs_blocks; b++)
+    {
+        if ((qmc5883l_binlog_decode(gs_store[b], BINLOG_TEST_BLOCK, &seq, gs_decoded, gs_time_us, BINLOG_TEST_BLOCK, &count) != 0) ||
+            (seq != b) || (n + count > samples))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: block %d decode check error.\n", (int)b);
+            
+            return 1;
+        }
+        for (i = 0; i < count; i++, n++)
+        {
+            if ((gs_decoded[i][0] != gs_raw[n][0]) || (gs_decoded[i][1] != gs_raw[n][1]) ||
+                (gs_decoded[i][2] != gs_raw[n][2]) || (gs_time_us[i] != (uint64_t)n * BINLOG_TEST_PERIOD_US))
+            {
+                qmc5883l_interface_debug_print("qmc5883l: sample %d round trip check error.\n", (int)n);
+                
+                return 1;
+            }
+        }
+    }
+    if (n != samples)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: sample count check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  log a synthetic stream
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   noisy slow field with a full scale jump every 997 samples
+ */
+static uint8_t a_binlog_test_synthetic(void)
+{
+    uint32_t seq;
+    uint32_t n;
+    uint16_t count;
+    uint8_t a;
+    double encode;
+    double decode;
+    clock_t start;
+    
+    /* build the stream */
+    for (n = 0; n < BINLOG_TEST_SAMPLES; n++)
+    {
+        for (a = 0; a < 3; a++)
+        {
+            int32_t v;
+            
+            gs_seed = gs_seed * 1664525U + 1013904223U;
+            v = (int32_t)(n / 8) * (a + 1) - 3000 + (int32_t)((gs_seed >> 16) % 49) - 24;
+            if ((n % BINLOG_TEST_JUMP_EVERY) == 0)
+            {
+                v = ((n / BINLOG_TEST_JUMP_EVERY) % 2 == 0) ? 32767 : -32768;
+            }
+            gs_raw[n][a] = (int16_t)v;
+        }
+    }
+    
+    /* encode */
+    (void)qmc5883l_binlog_init(&gs_binlog, gs_block, BINLOG_TEST_BLOCK, a_binlog_test_write);
+    gs_blocks = 0;
+    start = clock();
+    for (n = 0; n < BINLOG_TEST_SAMPLES; n++)
+    {
+        if (qmc5883l_binlog_push(&gs_binlog, (uint64_t)n * BINLOG_TEST_PERIOD_US, gs_raw[n]) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: push check error.\n");
+            
+            return 1;
+        }
+    }
+    if (qmc5883l_binlog_flush(&gs_binlog) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: flush check error.\n");
+        
+        return 1;
+    }
+    encode = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    /* decode */
+    start = clock();
+    for (n = 0; n < gs_blocks; n++)
+    {
+        (void)qmc5883l_binlog_decode(gs_store[n], BINLOG_TEST_BLOCK, &seq, gs_decoded, gs_time_us, BINLOG_TEST_BLOCK, &count);
+    }
+    decode = (double)(clock() - start) / CLOCKS_PER_SEC;
+    qmc5883l_interface_debug_print("qmc5883l: %d samples in %d blocks, %.3f bytes per sample.\n", BINLOG_TEST_SAMPLES,
+                                   (int)gs_blocks, (double)gs_blocks * BINLOG_TEST_BLOCK / BINLOG_TEST_SAMPLES);
+    qmc5883l_interface_debug_print("qmc5883l: encode %.1fns, decode %.1fns per sample.\n",
+                                   encode * 1e9 / BINLOG_TEST_SAMPLES, decode * 1e9 / BINLOG_TEST_SAMPLES);
+    if (a_binlog_test_verify(BINLOG_TEST_SAMPLES) != 0)
+    {
+        return 1;
+    }
+    
+    /* a flipped bit must fail the crc */
+    gs_store[1][BINLOG_TEST_BLOCK / 2] ^= 0x10;
+    if (qmc5883l_binlog_decode(gs_store[1], BINLOG_TEST_BLOCK, &seq, gs_decoded, gs_time_us, BINLOG_TEST_BLOCK, &count) != 1)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: crc check error.\n");
+        
+        return 1;
+    }
+    gs_store[1][BINLOG_TEST_BLOCK / 2] ^= 0x10;
+    gs_store[2][5] ^= 0x01;
+    if (qmc5883l_binlog_decode(gs_store[2], BINLOG_TEST_BLOCK, &seq, gs_decoded, gs_time_us, BINLOG_TEST_BLOCK, &count) != 1)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: header crc check error.\n");
+        
+        return 1;
+    }
+    gs_store[2][5] ^= 0x01;
+    
+    return 0;
+}
+
+/**
+ * @brief  wait for the next sample
+ * @return status code
+ *         - 0 success
+ *         - 1 wait failed
+ * @note   none
+ */
+static uint8_t a_binlog_test_wait(void)
+{
+    uint8_t status;
+    uint8_t i;
+    
+    for (i = 0; i < BINLOG_TEST_POLL_TRIES; i++)
+    {
+        if (qmc5883l_get_status(&gs_handle, &status) != 0)
+        {
+            return 1;
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)
+        {
+            return 0;
+        }
+        qmc5883l_interface_delay_ms(BINLOG_TEST_POLL_MS);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     binlog test
+ * @param[in] times is the number of logged chip samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the chip samples are stamped with the nominal 200Hz period
+ */
+uint8_t qmc5883l_binlog_test(uint32_t times)
+{
+    const int16_t zero[3] = {0, 0, 0};
+    char line[64];
+    uint32_t text;
+    uint32_t seq;
+    uint32_t i;
+    uint16_t count;
+    uint8_t res;
+    float m_gauss[3];
+    double bytes;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start binlog test */
+    qmc5883l_interface_debug_print("qmc5883l: start binlog test.\n");
+    
+    /* param limits */
+    if ((qmc5883l_binlog_init(&gs_binlog, NULL, BINLOG_TEST_BLOCK, a_binlog_test_write) != 2) ||
+        (qmc5883l_binlog_init(&gs_binlog, gs_block, QMC5883L_BINLOG_MIN_BLOCK - 1, a_binlog_test_write) != 4) ||
+        (qmc5883l_binlog_init(&gs_binlog, gs_block, QMC5883L_BINLOG_MAX_BLOCK + 1, a_binlog_test_write) != 4) ||
+        (qmc5883l_binlog_push(&gs_binlog, 0, zero) != 3) ||
+        (qmc5883l_binlog_flush(&gs_binlog) != 3) ||
+        (qmc5883l_binlog_decode(gs_block, BINLOG_TEST_BLOCK, &seq, NULL, NULL, 0, &count) != 2))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: binlog limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* synthetic stream */
+    res = a_binlog_test_synthetic();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: synthetic stream round trips and corruption is caught.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* log the chip */
+    times = (times > BINLOG_TEST_SAMPLES) ? BINLOG_TEST_SAMPLES : times;
+    (void)qmc5883l_binlog_init(&gs_binlog, gs_block, BINLOG_TEST_BLOCK, a_binlog_test_write);
+    gs_blocks = 0;
+    text = 0;
+    for (i = 0; i < times; i++)
+    {
+        res = a_binlog_test_wait();
+        if (res == 0)
+        {
+            res = qmc5883l_read(&gs_handle, gs_raw[i], m_gauss);
+        }
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if (qmc5883l_binlog_push(&gs_binlog, (uint64_t)i * BINLOG_TEST_PERIOD_US, gs_raw[i]) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: push check error.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        text += (uint32_t)snprintf(line, sizeof(line), "%u,%d,%d,%d\n", (unsigned int)(i * BINLOG_TEST_PERIOD_US),
+                                   gs_raw[i][0], gs_raw[i][1], gs_raw[i][2]);
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    if ((qmc5883l_binlog_flush(&gs_binlog) != 0) || (a_binlog_test_verify(times) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: chip log check error.\n");
+        
+        return 1;
+    }
+    bytes = (times > 0) ? (double)gs_blocks * BINLOG_TEST_BLOCK / times : 0.0;
+    qmc5883l_interface_debug_print("qmc5883l: %d chip samples in %d blocks, %.3f bytes per sample, csv %.3f.\n",
+                                   (int)times, (int)gs_blocks, bytes, (times > 0) ? (double)text / times : 0.0);
+    if ((times >= BINLOG_TEST_MIN_CHECK) && (bytes > BINLOG_TEST_MAX_BYTES))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: bytes per sample check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish binlog test */
+    qmc5883l_interface_debug_print("qmc5883l: finish binlog test.\n");
+    
+    return 0;
+}
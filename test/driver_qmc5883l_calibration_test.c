@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_calibration_test.c
+ * @brief     driver qmc5883l calibration test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_calibration_test.h"
+#include <math.h>
+
+/**
+ * @brief calibration test definition
+ */
+#define CALIBRATION_TEST_PERIOD_MS        5            /**< 200Hz sample period */
+#define CALIBRATION_TEST_TOLERANCE        0.05f        /**< max rms radius deviation after calibration */
+
+static qmc5883l_handle_t gs_handle;                    /**< qmc5883l handle */
+static qmc5883l_calibration_t gs_calibration;          /**< calibration */
+
+/**
+ * @brief      read one pass and measure the radius deviation
+ * @param[in]  times is the number of samples
+ * @param[in]  update is 1 to feed the samples to the fit
+ * @param[in]  radius is the reference radius, 0 uses the mean magnitude of the pass
+ * @param[out] *rms points to a relative rms radius deviation buffer
+ * @param[out] *raw_rms points to a relative rms radius deviation buffer of the uncalibrated data
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_calibration_test_pass(uint32_t times, uint8_t update, float radius, float *rms, float *raw_rms)
+{
+    uint32_t i;
+    int16_t raw[3];
+    float m_gauss[3];
+    float out[3];
+    double sum;
+    double sum2;
+    double raw_sum;
+    double raw_sum2;
+    
+    sum = 0.0;
+    sum2 = 0.0;
+    raw_sum = 0.0;
+    raw_sum2 = 0.0;
+    for (i = 0; i < times; i++)
+    {
+        double r;
+        
+        /* wait a sample */
+        qmc5883l_interface_delay_ms(CALIBRATION_TEST_PERIOD_MS);
+        if (qmc5883l_read(&gs_handle, raw, m_gauss) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            
+            return 1;
+        }
+        if (update != 0)
+        {
+            (void)qmc5883l_calibration_update(&gs_calibration, m_gauss);
+        }
+        (void)qmc5883l_calibration_apply(&gs_calibration, m_gauss, out);
+        
+        /* sum the magnitudes */
+        r = sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+        sum += r;
+        sum2 += r * r;
+        r = sqrt(m_gauss[0] * m_gauss[0] + m_gauss[1] * m_gauss[1] + m_gauss[2] * m_gauss[2]);
+        raw_sum += r;
+        raw_sum2 += r * r;
+    }
+    
+    /* rms deviation around the reference, or the standard deviation around the mean */
+    if (radius > 0.0f)
+    {
+        *rms = (float)(sqrt(sum2 / times - 2.0 * radius * sum / times + (double)radius * radius) / radius);
+    }
+    else
+    {
+        *rms = (float)(sqrt(fabs(sum2 / times - (sum / times) * (sum / times))) / (sum / times));
+    }
+    *raw_rms = (float)(sqrt(fabs(raw_sum2 / times - (raw_sum / times) * (raw_sum / times))) / (raw_sum / times));
+    
+    return 0;
+}
+
+/**
+ * @brief     calibration test
+ * @param[in] times is the number of samples of each pass
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sensor must be rotated through all orientations during the test
+ */
+uint8_t qmc5883l_calibration_test(uint32_t times)
+{
+    uint8_t res;
+    float offset[3];
+    float matrix[3][3];
+    float radius;
+    float rms;
+    float raw_rms;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start calibration test */
+    qmc5883l_interface_debug_print("qmc5883l: start calibration test.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* collect the fit samples */
+    (void)qmc5883l_calibration_init(&gs_calibration);
+    qmc5883l_interface_debug_print("qmc5883l: rotate the sensor, collect %d samples.\n", times);
+    res = a_calibration_test_pass(times, 1, 0.0f, &rms, &raw_rms);
+    if (res != 0)
+    {
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* solve */
+    res = qmc5883l_calibration_solve(&gs_calibration);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: calibration solve failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)qmc5883l_calibration_get(&gs_calibration, offset, matrix, &radius);
+    qmc5883l_interface_debug_print("qmc5883l: offset is %.2f %.2f %.2f m_gauss.\n", offset[0], offset[1], offset[2]);
+    qmc5883l_interface_debug_print("qmc5883l: matrix is %.4f %.4f %.4f.\n", matrix[0][0], matrix[0][1], matrix[0][2]);
+    qmc5883l_interface_debug_print("qmc5883l:           %.4f %.4f %.4f.\n", matrix[1][0], matrix[1][1], matrix[1][2]);
+    qmc5883l_interface_debug_print("qmc5883l:           %.4f %.4f %.4f.\n", matrix[2][0], matrix[2][1], matrix[2][2]);
+    qmc5883l_interface_debug_print("qmc5883l: radius is %.2f m_gauss.\n", radius);
+    
+    /* check a new pass */
+    qmc5883l_interface_debug_print("qmc5883l: rotate the sensor, check %d samples.\n", times);
+    res = a_calibration_test_pass(times, 0, radius, &rms, &raw_rms);
+    if (res != 0)
+    {
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: uncalibrated radius deviation is %.2f%%.\n", raw_rms * 100.0f);
+    qmc5883l_interface_debug_print("qmc5883l: calibrated radius deviation is %.2f%%.\n", rms * 100.0f);
+    if (rms > CALIBRATION_TEST_TOLERANCE)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: calibrated radius check error.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish calibration test */
+    qmc5883l_interface_debug_print("qmc5883l: finish calibration test.\n");
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    return 0;
+}
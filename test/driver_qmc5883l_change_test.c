@@ -0,0 +1,248 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_change_test.c
+ * @brief     driver qmc5883l change test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_change_test.h"
+
+/**
+ * @brief change test definition
+ */
+#define CHANGE_TEST_ON                 20.0f         /**< 20 mgauss starts a change */
+#define CHANGE_TEST_OFF                10.0f         /**< 10 mgauss ends a change */
+#define CHANGE_TEST_DEBOUNCE_ON        3             /**< 300ms above on */
+#define CHANGE_TEST_DEBOUNCE_OFF       5             /**< 500ms below off */
+#define CHANGE_TEST_TIME_CONSTANT      100.0f        /**< 10s baseline */
+#define CHANGE_TEST_PERIOD_MS          100           /**< 10Hz sample period */
+
+static qmc5883l_handle_t gs_handle;                  /**< qmc5883l handle */
+static qmc5883l_change_t gs_change;                  /**< change detector */
+
+/**
+ * @brief  check the hysteresis and the debounce
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   none
+ */
+static uint8_t a_change_test_debounce(void)
+{
+    const float base[3] = {200.0f, -150.0f, 400.0f};
+    const float level[7] = {0.0f, 30.0f, 0.0f, 30.0f, 15.0f, 5.0f, 30.0f};
+    const uint8_t count[7] = {10, 2, 5, 3, 50, 4, 1};
+    const uint8_t expect[7] = {0, 0, 0, 1, 0, 0, 0};
+    qmc5883l_change_event_t event;
+    float m_gauss[3];
+    uint32_t events;
+    uint8_t i;
+    uint8_t j;
+    
+    /* short bursts are suppressed, a value between the thresholds keeps the state, short dips do not end it */
+    (void)qmc5883l_change_init(&gs_change, CHANGE_TEST_ON, CHANGE_TEST_OFF, CHANGE_TEST_DEBOUNCE_ON,
+                               CHANGE_TEST_DEBOUNCE_OFF, CHANGE_TEST_TIME_CONSTANT);
+    for (i = 0; i < 7; i++)
+    {
+        events = 0;
+        m_gauss[0] = base[0];
+        m_gauss[1] = base[1];
+        m_gauss[2] = base[2] + level[i];
+        for (j = 0; j < count[i]; j++)
+        {
+            (void)qmc5883l_change_push(&gs_change, m_gauss, &event);
+            events += (event != QMC5883L_CHANGE_EVENT_NONE) ? 1 : 0;
+        }
+        if (events != expect[i])
+        {
+            qmc5883l_interface_debug_print("qmc5883l: step %d gave %d events check error.\n", i, events);
+            
+            return 1;
+        }
+    }
+    
+    /* five quiet samples end it */
+    m_gauss[2] = base[2];
+    for (j = 0; j < CHANGE_TEST_DEBOUNCE_OFF; j++)
+    {
+        (void)qmc5883l_change_push(&gs_change, m_gauss, &event);
+    }
+    if (event != QMC5883L_CHANGE_EVENT_FALL)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: fall event check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     change test
+ * @param[in] times is the number of read samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      a ferrous object must be brought close to the sensor and removed again during the test
+ */
+uint8_t qmc5883l_change_test(uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t rises;
+    uint32_t falls;
+    uint32_t samples;
+    uint32_t published;
+    uint32_t suppressed;
+    int16_t raw[3];
+    float m_gauss[3];
+    float baseline[3];
+    float deviation;
+    qmc5883l_change_event_t last;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start change test */
+    qmc5883l_interface_debug_print("qmc5883l: start change test.\n");
+    
+    /* threshold and debounce limits */
+    if ((qmc5883l_change_init(&gs_change, CHANGE_TEST_OFF, CHANGE_TEST_OFF, CHANGE_TEST_DEBOUNCE_ON,
+                              CHANGE_TEST_DEBOUNCE_OFF, CHANGE_TEST_TIME_CONSTANT) != 4) ||
+        (qmc5883l_change_init(&gs_change, CHANGE_TEST_ON, CHANGE_TEST_OFF, 0,
+                              CHANGE_TEST_DEBOUNCE_OFF, CHANGE_TEST_TIME_CONSTANT) != 4) ||
+        (qmc5883l_change_init(&gs_change, CHANGE_TEST_ON, CHANGE_TEST_OFF, CHANGE_TEST_DEBOUNCE_ON,
+                              CHANGE_TEST_DEBOUNCE_OFF, 0.5f) != 4))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: change limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* hysteresis and debounce */
+    res = a_change_test_debounce();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: bursts and dips are debounced.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 10Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_10HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* publish only the changes */
+    qmc5883l_interface_debug_print("qmc5883l: on %.0f mgauss for %d samples, off %.0f mgauss for %d samples.\n",
+                                   CHANGE_TEST_ON, CHANGE_TEST_DEBOUNCE_ON, CHANGE_TEST_OFF, CHANGE_TEST_DEBOUNCE_OFF);
+    (void)qmc5883l_change_init(&gs_change, CHANGE_TEST_ON, CHANGE_TEST_OFF, CHANGE_TEST_DEBOUNCE_ON,
+                               CHANGE_TEST_DEBOUNCE_OFF, CHANGE_TEST_TIME_CONSTANT);
+    rises = 0;
+    falls = 0;
+    last = QMC5883L_CHANGE_EVENT_FALL;
+    for (i = 0; i < times; i++)
+    {
+        qmc5883l_change_event_t event;
+        
+        qmc5883l_interface_delay_ms(CHANGE_TEST_PERIOD_MS);
+        res = qmc5883l_change_read(&gs_handle, &gs_change, raw, m_gauss, &event);
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if (event == QMC5883L_CHANGE_EVENT_NONE)
+        {
+            continue;
+        }
+        (void)qmc5883l_change_get_baseline(&gs_change, baseline, &deviation);
+        qmc5883l_interface_debug_print("qmc5883l: sample %d %s, deviation %.1f mgauss.\n", i,
+                                       (event == QMC5883L_CHANGE_EVENT_RISE) ? "rise" : "fall", deviation);
+        if (event == last)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: event order check error.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        last = event;
+        rises += (event == QMC5883L_CHANGE_EVENT_RISE) ? 1 : 0;
+        falls += (event == QMC5883L_CHANGE_EVENT_FALL) ? 1 : 0;
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    /* check the counters */
+    (void)qmc5883l_change_get_stats(&gs_change, &samples, &published, &suppressed);
+    qmc5883l_interface_debug_print("qmc5883l: %d samples, %d published, %d suppressed.\n", samples, published, suppressed);
+    if ((samples != times) || (published != rises + falls) || (published + suppressed != samples))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: counter check error.\n");
+        
+        return 1;
+    }
+    if ((rises == 0) || (falls == 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: no change seen, bring a ferrous object close and remove it.\n");
+        
+        return 1;
+    }
+    
+    /* finish change test */
+    qmc5883l_interface_debug_print("qmc5883l: finish change test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,562 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_coro_test.cpp
+ * @brief     driver qmc5883l coro test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_coro_test.h"
+#include "driver_qmc5883l_coro.hpp"
+
+/**
+ * @brief coro test definition
+ */
+#define CORO_TEST_SENSORS            8              /**< simulated sensors */
+#define CORO_TEST_POLL_US            1000           /**< loop poll period */
+#define CORO_TEST_MAX_LATENCY_US     3000           /**< max time from data ready to the read, two 1ms delays and the other reads */
+#define CORO_TEST_BUS_HZ             400000         /**< assumed iic clock for the loop time */
+#define CORO_TEST_DEAD_POLL_US       20000          /**< loop poll period of the dead sensor */
+
+static double gs_now_us;                                              /**< loop time */
+static uint32_t gs_transfers[CORO_TEST_SENSORS];                      /**< transfers of each sensor */
+static uint64_t gs_max_latency_us[CORO_TEST_SENSORS];                 /**< max read latency of each sensor */
+
+/**
+ * @brief loop clock
+ * @note  the sum of the requested delays and the iic frames at 400kHz
+ */
+struct CoroTestClock
+{
+    static uint64_t now_us() noexcept
+    {
+        return static_cast<uint64_t>(gs_now_us);
+    }
+    
+    static void sleep_until_us(uint64_t time_us) noexcept
+    {
+        if (time_us > now_us())
+        {
+            uint32_t ms = static_cast<uint32_t>((time_us - now_us() + 999) / 1000);
+            
+            qmc5883l_interface_delay_ms(ms);
+            gs_now_us += ms * 1000.0;
+        }
+    }
+};
+
+/**
+ * @brief interface bus of the chip
+ */
+struct CoroTestBus
+{
+    static uint8_t init()
+    {
+        return qmc5883l_interface_iic_init();
+    }
+    
+    static uint8_t deinit()
+    {
+        return qmc5883l_interface_iic_deinit();
+    }
+    
+    static uint8_t read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+    {
+        gs_now_us += (29.0 + 9.0 * len) * 1000000.0 / CORO_TEST_BUS_HZ;
+        
+        return qmc5883l_interface_iic_read(addr, reg, buf, len);
+    }
+    
+    static uint8_t write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+    {
+        gs_now_us += (20.0 + 9.0 * len) * 1000000.0 / CORO_TEST_BUS_HZ;
+        
+        return qmc5883l_interface_iic_write(addr, reg, buf, len);
+    }
+    
+    static void delay_ms(uint32_t ms)
+    {
+        CoroTestClock::sleep_until_us(CoroTestClock::now_us() + ms * 1000ULL);
+    }
+};
+
+/**
+ * @brief simulated sensor bus
+ * @note  sample k is ready k periods after the control 1 write, x reads back k so a skipped sample shows as a gap
+ */
+template <int N>
+struct CoroTestFakeBus
+{
+    static inline uint64_t start_us = 0;            /**< control 1 write time */
+    static inline uint64_t period_us = 100000;      /**< sample period */
+    static inline uint64_t taken = 0;               /**< last read sample */
+    
+    static uint64_t latest()
+    {
+        return (CoroTestClock::now_us() - start_us) / period_us;
+    }
+    
+    static uint8_t init()
+    {
+        return 0;
+    }
+    
+    static uint8_t deinit()
+    {
+        return 0;
+    }
+    
+    static uint8_t read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+    {
+        (void)addr;
+        gs_now_us += (29.0 + 9.0 * len) * 1000000.0 / CORO_TEST_BUS_HZ;
+        gs_transfers[N]++;
+        memset(buf, 0, len);
+        if (reg == qmc5883l::reg::ID)
+        {
+            buf[0] = 0xFF;
+        }
+        else if (reg == qmc5883l::reg::STATUS)
+        {
+            buf[0] = ((latest() > taken) ? QMC5883L_STATUS_DRDY : 0) | ((latest() > taken + 1) ? QMC5883L_STATUS_DOR : 0);
+        }
+        else if ((reg == qmc5883l::reg::X_LSB) && (len == 6))
+        {
+            if (taken > 0)
+            {
+                gs_max_latency_us[N] = std::max(gs_max_latency_us[N], CoroTestClock::now_us() - (start_us + (taken + 1) * period_us));
+            }
+            taken = latest();
+            buf[0] = static_cast<uint8_t>(taken & 0xFF);
+            buf[1] = static_cast<uint8_t>((taken >> 8) & 0xFF);
+            buf[2] = static_cast<uint8_t>(N);
+        }
+        
+        return 0;
+    }
+    
+    static uint8_t write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+    {
+        static constexpr uint64_t hz[4] = {10, 50, 100, 200};
+        
+        (void)addr;
+        gs_now_us += (20.0 + 9.0 * len) * 1000000.0 / CORO_TEST_BUS_HZ;
+        if (reg == qmc5883l::reg::CONTROL1)
+        {
+            start_us = CoroTestClock::now_us();
+            period_us = 1000000 / hz[(buf[0] >> 2) & 0x03];
+            taken = 0;
+        }
+        
+        return 0;
+    }
+    
+    static void delay_ms(uint32_t ms)
+    {
+        CoroTestClock::sleep_until_us(CoroTestClock::now_us() + ms * 1000ULL);
+    }
+};
+
+/**
+ * @brief simulated sensor interrupt pin
+ */
+template <int N>
+struct CoroTestFakePin
+{
+    static bool level()
+    {
+        return CoroTestFakeBus<N>::latest() > CoroTestFakeBus<N>::taken;
+    }
+};
+
+/* sensors 0 to 3 wake on the pin, 4 to 7 on the timer, at 10, 50, 100 and 200Hz */
+static constexpr qmc5883l_output_rate_t gsc_rate[4] = {QMC5883L_OUTPUT_RATE_10HZ, QMC5883L_OUTPUT_RATE_50HZ,
+                                                       QMC5883L_OUTPUT_RATE_100HZ, QMC5883L_OUTPUT_RATE_200HZ};
+template <int N>
+using CoroTestFakeDevice = qmc5883l::Device<CoroTestFakeBus<N>, qmc5883l::Config<QMC5883L_FULL_SCALE_2GAUSS, gsc_rate[N % 4]>>;
+template <int N>
+using CoroTestFakeSource = qmc5883l::Source<CoroTestFakeDevice<N>, CoroTestClock,
+                                            std::conditional_t<(N < 4), qmc5883l::PinTrigger<CoroTestFakePin<N>>, qmc5883l::TimerTrigger>>;
+using CoroTestLoop = qmc5883l::Loop<CoroTestClock>;
+using CoroTestDevice = qmc5883l::Device<CoroTestBus>;
+
+/**
+ * @brief consumer executor
+ * @note  counts the resumes and forwards them to the loop
+ */
+struct CoroTestExecutor
+{
+    CoroTestLoop *loop;        /**< loop */
+    uint32_t posts;            /**< resumes */
+    
+    void post(std::coroutine_handle<> h)
+    {
+        posts++;
+        loop->post(h);
+    }
+};
+
+/**
+ * @brief detached test coroutine
+ */
+struct CoroTestTask
+{
+    struct promise_type
+    {
+        CoroTestTask get_return_object() noexcept
+        {
+            return {};
+        }
+        
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        
+        void return_void() noexcept
+        {
+        }
+        
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief consumer result structure definition
+ */
+typedef struct coro_test_result_s
+{
+    uint32_t samples;        /**< good samples */
+    uint32_t gaps;           /**< skipped samples */
+    uint32_t errors;         /**< failed waits */
+    uint32_t overruns;       /**< samples with the dor bit */
+    uint64_t max_step_us;    /**< max time between two samples */
+    uint8_t done;            /**< finished flag */
+} coro_test_result_t;
+
+static coro_test_result_t gs_result[CORO_TEST_SENSORS + 1];        /**< consumer results, the chip last */
+
+/**
+ * @brief     wait once
+ * @param[in] &source is the source
+ * @param[in] *res points to the result
+ * @note      none
+ */
+template <typename S>
+static CoroTestTask a_coro_test_once(S &source, uint8_t *res)
+{
+    qmc5883l::Sample s = co_await source.next_sample();
+    
+    *res = s.res;
+}
+
+/**
+ * @brief     consume samples of a simulated sensor
+ * @param[in] &source is the source
+ * @param[in] &ex is the consumer executor
+ * @param[in] count is the number of samples
+ * @param[in] *result points to the result
+ * @note      none
+ */
+template <typename S>
+static CoroTestTask a_coro_test_consume(S &source, CoroTestExecutor &ex, uint32_t count, coro_test_result_t *result)
+{
+    int16_t last = 0;
+    
+    for (uint32_t i = 0; i < count; i++)
+    {
+        qmc5883l::Sample s = co_await source.next_sample(ex);
+        
+        if (s.res != 0)
+        {
+            result->errors++;
+            
+            break;
+        }
+        /* samples may pile up before the first wait */
+        result->gaps += ((i > 0) && (s.raw[0] != last + 1)) ? 1 : 0;
+        result->overruns += ((i > 0) && ((s.status & QMC5883L_STATUS_DOR) != 0)) ? 1 : 0;
+        last = s.raw[0];
+        result->samples++;
+    }
+    result->done = 1;
+}
+
+/**
+ * @brief     consume the chip through the generator
+ * @param[in] &source is the source
+ * @param[in] &ex is the consumer executor
+ * @param[in] count is the number of samples
+ * @param[in] *result points to the result
+ * @note      none
+ */
+template <typename S>
+static CoroTestTask a_coro_test_generate(S &source, CoroTestExecutor &ex, uint32_t count, coro_test_result_t *result)
+{
+    qmc5883l::AsyncGenerator<qmc5883l::Sample> gen = source.samples(ex, count);
+    uint64_t last_us = 0;
+    
+    while (qmc5883l::Sample *s = co_await gen.next())
+    {
+        if (s->res != 0)
+        {
+            result->errors++;
+            
+            break;
+        }
+        if (result->samples > 0)
+        {
+            result->max_step_us = std::max(result->max_step_us, s->time_us - last_us);
+        }
+        result->overruns += ((result->samples > 0) && ((s->status & QMC5883L_STATUS_DOR) != 0)) ? 1 : 0;
+        last_us = s->time_us;
+        result->samples++;
+    }
+    result->done = 1;
+}
+
+/**
+ * @brief     start a simulated sensor
+ * @param[in] &dev is the device
+ * @param[in] &source is the source
+ * @param[in] &ex is the consumer executor
+ * @param[in] times is the number of samples at 200Hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+template <int N>
+static uint8_t a_coro_test_start(CoroTestFakeDevice<N> &dev, CoroTestFakeSource<N> &source, CoroTestExecutor &ex, uint32_t times)
+{
+    if (dev.init() != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: sensor %d init failed.\n", N);
+        
+        return 1;
+    }
+    gs_transfers[N] = 0;
+    (void)a_coro_test_consume(source, ex, times * CoroTestFakeDevice<N>::config::rate_hz / 200, &gs_result[N]);
+    
+    return 0;
+}
+
+/**
+ * @brief     coro test
+ * @param[in] times is the number of samples of each 200Hz sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      one loop serves the chip and eight simulated sensors, built only into c++20 capable projects
+ */
+uint8_t qmc5883l_coro_test(uint32_t times)
+{
+    CoroTestLoop loop(CORO_TEST_POLL_US);
+    CoroTestExecutor ex{&loop, 0};
+    CoroTestDevice chip;
+    CoroTestFakeDevice<0> dev0;
+    CoroTestFakeDevice<1> dev1;
+    CoroTestFakeDevice<2> dev2;
+    CoroTestFakeDevice<3> dev3;
+    CoroTestFakeDevice<4> dev4;
+    CoroTestFakeDevice<5> dev5;
+    CoroTestFakeDevice<6> dev6;
+    CoroTestFakeDevice<7> dev7;
+    qmc5883l::Source<CoroTestDevice, CoroTestClock> chip_source(chip, loop);
+    CoroTestFakeSource<0> source0(dev0, loop);
+    CoroTestFakeSource<1> source1(dev1, loop);
+    CoroTestFakeSource<2> source2(dev2, loop);
+    CoroTestFakeSource<3> source3(dev3, loop);
+    CoroTestFakeSource<4> source4(dev4, loop);
+    CoroTestFakeSource<5> source5(dev5, loop);
+    CoroTestFakeSource<6> source6(dev6, loop);
+    CoroTestFakeSource<7> source7(dev7, loop);
+    uint32_t total;
+    uint32_t pin_transfers;
+    uint32_t pin_samples;
+    uint32_t timer_transfers;
+    uint32_t timer_samples;
+    uint64_t max_latency;
+    uint64_t start_us;
+    uint8_t res;
+    
+    /* start coro test */
+    qmc5883l_interface_debug_print("qmc5883l: start coro test.\n");
+    
+    /* a device that is not initialized */
+    res = 0;
+    (void)a_coro_test_once(source0, &res);
+    if (res != 3)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: not initialized check error.\n");
+        
+        return 1;
+    }
+    
+    /* the chip at 200Hz through the generator */
+    gs_now_us = 0.0;
+    memset(gs_result, 0, sizeof(gs_result));
+    memset(gs_max_latency_us, 0, sizeof(gs_max_latency_us));
+    if (chip.init() != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+        
+        return 1;
+    }
+    (void)a_coro_test_generate(chip_source, ex, times, &gs_result[CORO_TEST_SENSORS]);
+    
+    /* a second wait on a busy source */
+    res = 0;
+    (void)a_coro_test_once(chip_source, &res);
+    if (res != 4)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: busy check error.\n");
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    
+    /* eight simulated sensors on the same loop */
+    if ((a_coro_test_start(dev0, source0, ex, times) != 0) || (a_coro_test_start(dev1, source1, ex, times) != 0) ||
+        (a_coro_test_start(dev2, source2, ex, times) != 0) || (a_coro_test_start(dev3, source3, ex, times) != 0) ||
+        (a_coro_test_start(dev4, source4, ex, times) != 0) || (a_coro_test_start(dev5, source5, ex, times) != 0) ||
+        (a_coro_test_start(dev6, source6, ex, times) != 0) || (a_coro_test_start(dev7, source7, ex, times) != 0))
+    {
+        (void)chip.deinit();
+        
+        return 1;
+    }
+    
+    /* one thread runs everything */
+    start_us = CoroTestClock::now_us();
+    loop.run();
+    (void)chip.deinit();
+    
+    /* check every consumer */
+    total = 0;
+    pin_transfers = 0;
+    pin_samples = 0;
+    timer_transfers = 0;
+    timer_samples = 0;
+    max_latency = 0;
+    for (uint32_t i = 0; i < CORO_TEST_SENSORS + 1; i++)
+    {
+        if ((gs_result[i].done != 1) || (gs_result[i].errors != 0) || (gs_result[i].gaps != 0) || (gs_result[i].overruns != 0))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: sensor %d done %d, %d failed waits, %d gaps, %d overruns.\n", (int)i,
+                                           gs_result[i].done, (int)gs_result[i].errors, (int)gs_result[i].gaps,
+                                           (int)gs_result[i].overruns);
+            qmc5883l_interface_debug_print("qmc5883l: consumer check error.\n");
+            
+            return 1;
+        }
+        total += gs_result[i].samples;
+        if (i < CORO_TEST_SENSORS)
+        {
+            max_latency = std::max(max_latency, gs_max_latency_us[i]);
+        }
+        if (i < 4)
+        {
+            pin_transfers += gs_transfers[i];
+            pin_samples += gs_result[i].samples;
+        }
+        else if (i < CORO_TEST_SENSORS)
+        {
+            timer_transfers += gs_transfers[i];
+            timer_samples += gs_result[i].samples;
+        }
+    }
+    qmc5883l_interface_debug_print("qmc5883l: %d samples of 9 sensors in %.2fs on one thread, %d executor resumes.\n",
+                                   (int)total, (CoroTestClock::now_us() - start_us) * 1e-6, (int)ex.posts);
+    qmc5883l_interface_debug_print("qmc5883l: max read latency %.3fms, chip max sample step %.3fms.\n",
+                                   max_latency / 1000.0, gs_result[CORO_TEST_SENSORS].max_step_us / 1000.0);
+    qmc5883l_interface_debug_print("qmc5883l: %.2f transfers per sample on a pin wake, %.2f on a timer wake.\n",
+                                   (double)pin_transfers / pin_samples, (double)timer_transfers / timer_samples);
+    if (ex.posts != total)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: executor check error.\n");
+        
+        return 1;
+    }
+    if (pin_transfers != pin_samples)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: pin wake transfer check error.\n");
+        
+        return 1;
+    }
+    if (max_latency > CORO_TEST_MAX_LATENCY_US)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: latency check error.\n");
+        
+        return 1;
+    }
+    
+    /* a dead sensor times out after ready_tries ms, not after ready_tries polls */
+    {
+        CoroTestLoop dead_loop(CORO_TEST_DEAD_POLL_US);
+        CoroTestFakeSource<4> dead_source(dev4, dead_loop);
+        uint64_t timeout_us;
+        
+        if (dev4.init() != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: sensor 4 init failed.\n");
+            
+            return 1;
+        }
+        CoroTestFakeBus<4>::period_us = UINT64_MAX;
+        res = 0;
+        start_us = CoroTestClock::now_us();
+        (void)a_coro_test_once(dead_source, &res);
+        dead_loop.run();
+        timeout_us = CoroTestClock::now_us() - start_us;
+        qmc5883l_interface_debug_print("qmc5883l: dead sensor timed out after %.3fms with a %dms poll.\n",
+                                       timeout_us / 1000.0, CORO_TEST_DEAD_POLL_US / 1000);
+        if ((res != 1) || (timeout_us > CoroTestFakeDevice<4>::ready_tries * 1000ULL + 2 * CORO_TEST_DEAD_POLL_US))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: timeout check error.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* finish coro test */
+    qmc5883l_interface_debug_print("qmc5883l: finish coro test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,246 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_decimate_test.c
+ * @brief     driver qmc5883l decimate test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_decimate_test.h"
+#include <math.h>
+
+/**
+ * @brief decimate test definition
+ */
+#define DECIMATE_TEST_RATIO         8        /**< 200Hz to 25Hz */
+#define DECIMATE_TEST_ORDER         3        /**< cic order */
+#define DECIMATE_TEST_PERIOD_MS     5        /**< 200Hz sample period */
+#define DECIMATE_TEST_DC            1234     /**< dc input */
+
+static qmc5883l_handle_t gs_handle;          /**< qmc5883l handle */
+static qmc5883l_decimate_t gs_decimate;      /**< decimation stage */
+
+/**
+ * @brief  check the dc gain and the settling
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   none
+ */
+static uint8_t a_decimate_test_dc(void)
+{
+    const int16_t raw[3] = {DECIMATE_TEST_DC, -DECIMATE_TEST_DC, 32767};
+    int16_t out[3];
+    uint32_t i;
+    uint32_t outputs;
+    uint8_t ready;
+    
+    outputs = 0;
+    for (i = 0; i < DECIMATE_TEST_RATIO * 16; i++)
+    {
+        (void)qmc5883l_decimate_push(&gs_decimate, raw, out, &ready);
+        if (ready != 0)
+        {
+            outputs++;
+            if ((out[0] != raw[0]) || (out[1] != raw[1]) || (out[2] != raw[2]))
+            {
+                qmc5883l_interface_debug_print("qmc5883l: dc output %d %d %d check error.\n", out[0], out[1], out[2]);
+                
+                return 1;
+            }
+        }
+    }
+    if (outputs != 16 - DECIMATE_TEST_ORDER - 2 + 1)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: output count %d check error.\n", outputs);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     decimate test
+ * @param[in] times is the number of decimated samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sensor must be kept still
+ */
+uint8_t qmc5883l_decimate_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t k;
+    uint8_t ready;
+    uint32_t n_in;
+    uint32_t n_out;
+    int16_t raw[3];
+    int16_t out[3];
+    float m_gauss[3];
+    double in_sum[3];
+    double in_sum2[3];
+    double out_sum[3];
+    double out_sum2[3];
+    double in_std;
+    double out_std;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start decimate test */
+    qmc5883l_interface_debug_print("qmc5883l: start decimate test.\n");
+    
+    /* ratio and order limits */
+    if ((qmc5883l_decimate_init(&gs_decimate, 1, 1, QMC5883L_BOOL_TRUE) != 4) ||
+        (qmc5883l_decimate_init(&gs_decimate, 20, 4, QMC5883L_BOOL_TRUE) != 4) ||
+        (qmc5883l_decimate_init(&gs_decimate, 16, 4, QMC5883L_BOOL_TRUE) != 0) ||
+        (qmc5883l_decimate_push(&gs_decimate, NULL, out, &ready) != 2) ||
+        (qmc5883l_decimate_push(&gs_decimate, raw, NULL, &ready) != 2) ||
+        (qmc5883l_decimate_push(&gs_decimate, raw, out, NULL) != 2))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: decimate limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* dc gain and settling of the compensated filter */
+    (void)qmc5883l_decimate_init(&gs_decimate, DECIMATE_TEST_RATIO, DECIMATE_TEST_ORDER, QMC5883L_BOOL_TRUE);
+    res = a_decimate_test_dc();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: dc gain is exact.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 64 over sample for the most noise, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_64) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* decimate 200Hz to 25Hz */
+    qmc5883l_interface_debug_print("qmc5883l: decimate 200Hz by %d with a order %d cic.\n", DECIMATE_TEST_RATIO, DECIMATE_TEST_ORDER);
+    (void)qmc5883l_decimate_reset(&gs_decimate);
+    memset(in_sum, 0, sizeof(in_sum));
+    memset(in_sum2, 0, sizeof(in_sum2));
+    memset(out_sum, 0, sizeof(out_sum));
+    memset(out_sum2, 0, sizeof(out_sum2));
+    n_in = 0;
+    n_out = 0;
+    while (n_out < times)
+    {
+        qmc5883l_interface_delay_ms(DECIMATE_TEST_PERIOD_MS);
+        res = qmc5883l_read(&gs_handle, raw, m_gauss);
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (void)qmc5883l_decimate_push(&gs_decimate, raw, out, &ready);
+        n_in++;
+        for (k = 0; k < 3; k++)
+        {
+            in_sum[k] += raw[k];
+            in_sum2[k] += (double)raw[k] * raw[k];
+        }
+        if (ready != 0)
+        {
+            n_out++;
+            for (k = 0; k < 3; k++)
+            {
+                out_sum[k] += out[k];
+                out_sum2[k] += (double)out[k] * out[k];
+            }
+        }
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    /* compare the noise */
+    in_std = 0.0;
+    out_std = 0.0;
+    for (k = 0; k < 3; k++)
+    {
+        double in_mean;
+        double out_mean;
+        
+        in_mean = in_sum[k] / n_in;
+        out_mean = out_sum[k] / n_out;
+        in_std += in_sum2[k] / n_in - in_mean * in_mean;
+        out_std += out_sum2[k] / n_out - out_mean * out_mean;
+        qmc5883l_interface_debug_print("qmc5883l: axis %d mean in %.1f, out %.1f.\n", k, in_mean, out_mean);
+        if (fabs(in_mean - out_mean) > 2.0 + 3.0 * sqrt(in_sum2[k] / n_in - in_mean * in_mean) / sqrt((double)n_out))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: mean check error.\n");
+            
+            return 1;
+        }
+    }
+    in_std = sqrt(in_std / 3.0);
+    out_std = sqrt(out_std / 3.0);
+    qmc5883l_interface_debug_print("qmc5883l: %d inputs, %d outputs.\n", n_in, n_out);
+    qmc5883l_interface_debug_print("qmc5883l: noise in %.2f lsb, out %.2f lsb, %.1fx lower.\n", in_std, out_std, in_std / out_std);
+    if (out_std * 1.5 > in_std)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: noise reduction check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish decimate test */
+    qmc5883l_interface_debug_print("qmc5883l: finish decimate test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,328 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_device_test.cpp
+ * @brief     driver qmc5883l device test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_device_test.h"
+#include "driver_qmc5883l.hpp"
+#include <cmath>
+
+/**
+ * @brief device test definition
+ */
+#define DEVICE_TEST_MAX_MEAN_MGAUSS        0.5f        /**< max mean difference between the drivers */
+
+/**
+ * @brief counting interface bus
+ */
+struct DeviceTestBus
+{
+    static inline uint32_t transfers = 0;        /**< iic transfers besides the status polls */
+    
+    static uint8_t init()
+    {
+        return qmc5883l_interface_iic_init();
+    }
+    
+    static uint8_t deinit()
+    {
+        return qmc5883l_interface_iic_deinit();
+    }
+    
+    static uint8_t read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+    {
+        transfers += (reg != qmc5883l::reg::STATUS) ? 1 : 0;
+        
+        return qmc5883l_interface_iic_read(addr, reg, buf, len);
+    }
+    
+    static uint8_t write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+    {
+        transfers++;
+        
+        return qmc5883l_interface_iic_write(addr, reg, buf, len);
+    }
+    
+    static void delay_ms(uint32_t ms)
+    {
+        qmc5883l_interface_delay_ms(ms);
+    }
+};
+
+/* the configuration is resolved at compile time */
+using DeviceTestDefault = qmc5883l::Config<>;
+using DeviceTestWide = qmc5883l::Config<QMC5883L_FULL_SCALE_8GAUSS, QMC5883L_OUTPUT_RATE_50HZ, QMC5883L_OVER_SAMPLE_128>;
+static_assert(DeviceTestDefault::control1 == 0x0D, "control1 of 2gauss 200Hz 512 continuous");
+static_assert(DeviceTestWide::control1 == 0x95, "control1 of 8gauss 50Hz 128 continuous");
+static_assert(qmc5883l::Config<QMC5883L_FULL_SCALE_2GAUSS, QMC5883L_OUTPUT_RATE_10HZ, QMC5883L_OVER_SAMPLE_64,
+                               QMC5883L_MODE_STANDBY>::control1 == 0xC0, "control1 of 2gauss 10Hz 64 standby");
+static_assert(DeviceTestDefault::resolution == 1000.0f / 12000.0f, "2gauss resolution");
+static_assert(DeviceTestWide::resolution == 1000.0f / 3000.0f, "8gauss resolution");
+static_assert(DeviceTestWide::period_us == 20000, "50Hz period");
+static constexpr uint8_t gsc_test_bytes[2] = {0x34, 0xF2};
+static_assert(qmc5883l::decode(gsc_test_bytes) == -3532, "little endian decoding");
+
+static qmc5883l_handle_t gs_handle;        /**< qmc5883l handle */
+
+/**
+ * @brief      configure the chip through the c driver
+ * @param[in]  scale is the full scale
+ * @param[in]  rate is the output rate
+ * @param[in]  sample is the over sample
+ * @param[out] *control1 points to the resulting control 1 register
+ * @param[out] *period points to the resulting period register
+ * @return     status code
+ *             - 0 success
+ *             - 1 configure failed
+ * @note       leaves the c driver initialized
+ */
+static uint8_t a_device_test_c_config(qmc5883l_full_scale_t scale, qmc5883l_output_rate_t rate, qmc5883l_over_sample_t sample,
+                                      uint8_t *control1, uint8_t *period)
+{
+    if (qmc5883l_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    if ((qmc5883l_set_output_rate(&gs_handle, rate) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, scale) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, sample) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0) ||
+        (qmc5883l_get_reg(&gs_handle, qmc5883l::reg::CONTROL1, control1, 1) != 0) ||
+        (qmc5883l_get_reg(&gs_handle, qmc5883l::reg::PERIOD, period, 1) != 0))
+    {
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      read through a device and average
+ * @param[in]  &device is the initialized device
+ * @param[in]  times is the number of samples
+ * @param[out] *mean points to the mean field buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       every sample must convert exactly like qmc5883l_read
+ */
+template <typename D>
+static uint8_t a_device_test_mean(D &device, uint32_t times, float mean[3])
+{
+    mean[0] = 0.0f;
+    mean[1] = 0.0f;
+    mean[2] = 0.0f;
+    for (uint32_t i = 0; i < times; i++)
+    {
+        int16_t raw[3];
+        float m_gauss[3];
+        
+        if (device.read(raw, m_gauss) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            
+            return 1;
+        }
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            if (m_gauss[j] != (float)(raw[j]) * D::resolution)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: sample %d conversion check error.\n", (int)i);
+                
+                return 1;
+            }
+            mean[j] += m_gauss[j] / times;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     device test
+ * @param[in] times is the number of read samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      checks the c++17 header against the c driver, built only into c++ capable projects
+ */
+uint8_t qmc5883l_device_test(uint32_t times)
+{
+    qmc5883l::Device<DeviceTestBus, DeviceTestDefault> device;
+    qmc5883l::Device<DeviceTestBus, DeviceTestWide> wide;
+    uint8_t control1;
+    uint8_t period;
+    uint8_t value;
+    int16_t raw[3];
+    float m_gauss[3];
+    float c_mean[3];
+    float mean[3];
+    float wide_mean[3];
+    double c_transfers;
+    double transfers;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, DeviceTestBus::read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, DeviceTestBus::write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start device test */
+    qmc5883l_interface_debug_print("qmc5883l: start device test.\n");
+    
+    /* state checks */
+    if ((device.read(raw, m_gauss) != 3) || (device.read_data(raw, m_gauss) != 3) ||
+        (device.get_status(&value) != 3) || (device.deinit() != 3) || device.inited())
+    {
+        qmc5883l_interface_debug_print("qmc5883l: device state check error.\n");
+        
+        return 1;
+    }
+    
+    /* the c driver reference */
+    if (a_device_test_c_config(QMC5883L_FULL_SCALE_2GAUSS, QMC5883L_OUTPUT_RATE_200HZ, QMC5883L_OVER_SAMPLE_512, &control1, &period) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: c driver config failed.\n");
+        
+        return 1;
+    }
+    c_mean[0] = 0.0f;
+    c_mean[1] = 0.0f;
+    c_mean[2] = 0.0f;
+    DeviceTestBus::transfers = 0;
+    for (uint32_t i = 0; i < times; i++)
+    {
+        if (qmc5883l_read(&gs_handle, raw, m_gauss) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        c_mean[0] += m_gauss[0] / times;
+        c_mean[1] += m_gauss[1] / times;
+        c_mean[2] += m_gauss[2] / times;
+    }
+    c_transfers = (double)DeviceTestBus::transfers / times;
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    /* the device writes the same registers */
+    if (device.init() != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: device init failed.\n");
+        
+        return 1;
+    }
+    if ((DeviceTestBus::read(qmc5883l::reg::ADDRESS, qmc5883l::reg::CONTROL1, &value, 1) != 0) || (value != control1) ||
+        (DeviceTestBus::read(qmc5883l::reg::ADDRESS, qmc5883l::reg::PERIOD, &value, 1) != 0) || (value != period))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: register compatibility check error.\n");
+        (void)device.deinit();
+        
+        return 1;
+    }
+    DeviceTestBus::transfers = 0;
+    if (a_device_test_mean(device, times, mean) != 0)
+    {
+        (void)device.deinit();
+        
+        return 1;
+    }
+    transfers = (double)DeviceTestBus::transfers / times;
+    if (device.deinit() != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: device deinit failed.\n");
+        
+        return 1;
+    }
+    
+    /* the wide range configuration */
+    if (a_device_test_c_config(QMC5883L_FULL_SCALE_8GAUSS, QMC5883L_OUTPUT_RATE_50HZ, QMC5883L_OVER_SAMPLE_128, &control1, &period) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: c driver config failed.\n");
+        
+        return 1;
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    if (wide.init() != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: device init failed.\n");
+        
+        return 1;
+    }
+    if ((DeviceTestBus::read(qmc5883l::reg::ADDRESS, qmc5883l::reg::CONTROL1, &value, 1) != 0) || (value != control1) ||
+        (a_device_test_mean(wide, times, wide_mean) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: wide range check error.\n");
+        (void)wide.deinit();
+        
+        return 1;
+    }
+    (void)wide.deinit();
+    
+    /* both drivers see the same field */
+    qmc5883l_interface_debug_print("qmc5883l: c driver mean %.2f %.2f %.2f mgauss, %.2f transfers per read besides polls.\n",
+                                   c_mean[0], c_mean[1], c_mean[2], c_transfers);
+    qmc5883l_interface_debug_print("qmc5883l: device mean %.2f %.2f %.2f mgauss, %.2f transfers per read besides polls.\n",
+                                   mean[0], mean[1], mean[2], transfers);
+    qmc5883l_interface_debug_print("qmc5883l: 8gauss device mean %.2f %.2f %.2f mgauss.\n",
+                                   wide_mean[0], wide_mean[1], wide_mean[2]);
+    for (uint32_t j = 0; j < 3; j++)
+    {
+        if ((std::fabs(mean[j] - c_mean[j]) > DEVICE_TEST_MAX_MEAN_MGAUSS) ||
+            (std::fabs(wide_mean[j] - c_mean[j]) > 4.0f * DEVICE_TEST_MAX_MEAN_MGAUSS))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: mean check error.\n");
+            
+            return 1;
+        }
+    }
+    if (transfers >= c_transfers)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: transfer check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish device test */
+    qmc5883l_interface_debug_print("qmc5883l: finish device test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,307 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_duty_test.c
+ * @brief     driver qmc5883l duty test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_duty_test.h"
+#include <math.h>
+
+/**
+ * @brief duty test definition
+ */
+#define DUTY_TEST_INTERVAL_US       1000000       /**< sample interval */
+#define DUTY_TEST_MAX_LATE_US       2000          /**< max time from a slot to its sample */
+#define DUTY_TEST_MAX_ERROR         10.0f         /**< max difference to the continuous sample in mgauss */
+#define DUTY_TEST_MAX_DUTY          0.01f         /**< max duty cycle */
+#define DUTY_TEST_MAX_POLLS         100           /**< polls per sample before timeout */
+#define DUTY_TEST_POLL_MS           1             /**< data ready poll period */
+#define DUTY_TEST_POLL_TRIES        100           /**< data ready polls before timeout */
+#define DUTY_TEST_BUS_HZ            400000        /**< assumed iic clock for the host time */
+
+static qmc5883l_handle_t gs_handle;        /**< qmc5883l handle */
+static qmc5883l_duty_t gs_duty;            /**< duty scheduler */
+static double gs_host_us;                  /**< host time */
+static uint32_t gs_reads;                  /**< iic reads */
+static uint32_t gs_writes;                 /**< iic writes */
+
+/**
+ * @brief     counting iic bus read
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_duty_test_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_reads++;
+    gs_host_us += (29.0 + 9.0 * len) * 1000000.0 / DUTY_TEST_BUS_HZ;
+    
+    return qmc5883l_interface_iic_read(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_duty_test_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_writes++;
+    gs_host_us += (20.0 + 9.0 * len) * 1000000.0 / DUTY_TEST_BUS_HZ;
+    
+    return qmc5883l_interface_iic_write(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting delay
+ * @param[in] ms is the delay time
+ * @note      forwards to the interface
+ */
+static void a_duty_test_delay_ms(uint32_t ms)
+{
+    gs_host_us += ms * 1000.0;
+    
+    qmc5883l_interface_delay_ms(ms);
+}
+
+/**
+ * @brief  wait for the next sample
+ * @return status code
+ *         - 0 success
+ *         - 1 wait failed
+ * @note   none
+ */
+static uint8_t a_duty_test_wait(void)
+{
+    uint8_t status;
+    uint8_t i;
+    
+    for (i = 0; i < DUTY_TEST_POLL_TRIES; i++)
+    {
+        if (qmc5883l_get_status(&gs_handle, &status) != 0)
+        {
+            return 1;
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)
+        {
+            return 0;
+        }
+        a_duty_test_delay_ms(DUTY_TEST_POLL_MS);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     duty test
+ * @param[in] times is the number of duty cycled samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the host time is the sum of the requested delays and the iic frames at 400kHz
+ */
+uint8_t qmc5883l_duty_test(uint32_t times)
+{
+    uint64_t slot;
+    uint64_t wait;
+    uint64_t late;
+    uint64_t now;
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t polls;
+    uint32_t i;
+    uint8_t ready;
+    uint8_t res;
+    int16_t raw[3];
+    float m_gauss[3];
+    float reference[3];
+    float error;
+    float duty_cycle;
+    float current;
+    float continuous;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, a_duty_test_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, a_duty_test_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, a_duty_test_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start duty test */
+    qmc5883l_interface_debug_print("qmc5883l: start duty test.\n");
+    
+    /* param limits */
+    memset(&gs_duty, 0, sizeof(gs_duty));
+    if ((qmc5883l_duty_init(NULL, &gs_handle, DUTY_TEST_INTERVAL_US, 0) != 2) ||
+        (qmc5883l_duty_init(&gs_duty, &gs_handle, DUTY_TEST_INTERVAL_US, 0) != 3) ||
+        (qmc5883l_duty_poll(&gs_duty, 0, raw, m_gauss, &ready) != 3) ||
+        (qmc5883l_duty_get_wait(&gs_duty, 0, &wait) != 3) ||
+        (qmc5883l_duty_get_report(&gs_duty, 0, &duty_cycle, &current, &continuous) != 3))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: duty limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* one continuous sample as the reference */
+    res = a_duty_test_wait();
+    if (res == 0)
+    {
+        res = qmc5883l_read(&gs_handle, raw, reference);
+    }
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a latency sized interval is refused */
+    if (qmc5883l_duty_init(&gs_duty, &gs_handle, 5000, 0) != 4)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: interval check error.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* duty cycle */
+    gs_host_us = 0.0;
+    if (qmc5883l_duty_init(&gs_duty, &gs_handle, DUTY_TEST_INTERVAL_US, 0) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: duty init failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: interval %dms, first sample latency %dus.\n",
+                                   DUTY_TEST_INTERVAL_US / 1000, (int)gs_duty.latency_us);
+    reads = gs_reads;
+    writes = gs_writes;
+    late = 0;
+    error = 0.0f;
+    for (i = 0; i < times; i++)
+    {
+        slot = (uint64_t)(i + 1) * DUTY_TEST_INTERVAL_US;
+        ready = 0;
+        now = (uint64_t)gs_host_us;
+        for (polls = 0; (ready == 0) && (polls < DUTY_TEST_MAX_POLLS); polls++)
+        {
+            now = (uint64_t)gs_host_us;
+            if (qmc5883l_duty_poll(&gs_duty, now, raw, m_gauss, &ready) != 0)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: duty poll failed.\n");
+                (void)qmc5883l_deinit(&gs_handle);
+                
+                return 1;
+            }
+            if (ready == 0)
+            {
+                (void)qmc5883l_duty_get_wait(&gs_duty, now, &wait);
+                a_duty_test_delay_ms((uint32_t)((wait + 999) / 1000));
+            }
+        }
+        if ((ready == 0) || (now < slot) || (now - slot > DUTY_TEST_MAX_LATE_US))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: sample %d timing check error.\n", (int)i);
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        late = (now - slot > late) ? (now - slot) : late;
+        error = fmaxf(error, fmaxf(fabsf(m_gauss[0] - reference[0]),
+                                   fmaxf(fabsf(m_gauss[1] - reference[1]), fabsf(m_gauss[2] - reference[2]))));
+    }
+    now = (uint64_t)gs_host_us;
+    (void)qmc5883l_duty_get_report(&gs_duty, now, &duty_cycle, &current, &continuous);
+    reads = gs_reads - reads;
+    writes = gs_writes - writes;
+    (void)qmc5883l_deinit(&gs_handle);
+    qmc5883l_interface_debug_print("qmc5883l: %d samples, %d reads, %d writes, %d retries, max %dus after the slot, max deviation %.3f mgauss.\n",
+                                   (int)times, (int)reads, (int)writes, (int)gs_duty.retries, (int)late, error);
+    qmc5883l_interface_debug_print("qmc5883l: duty cycle %.3f%%, estimated %.1fuA against %.1fuA continuous.\n",
+                                   duty_cycle * 100.0f, current, continuous);
+    if ((reads != times + gs_duty.retries) || (writes != 2 * times))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: shadow check error.\n");
+        
+        return 1;
+    }
+    if ((error > DUTY_TEST_MAX_ERROR) || (duty_cycle > DUTY_TEST_MAX_DUTY) || (current * 10.0f > continuous))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: duty cycle check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish duty test */
+    qmc5883l_interface_debug_print("qmc5883l: finish duty test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,365 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_fault.c
+ * @brief     driver qmc5883l fault source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_fault.h"
+
+/**
+ * @brief fault status register definition
+ */
+#define FAULT_REG_STATUS        0x06        /**< status register */
+
+/**
+ * @brief fault state structure definition
+ */
+typedef struct fault_s
+{
+    qmc5883l_fault_bus_t bus;                 /**< wrapped bus */
+    qmc5883l_fault_config_t config;           /**< fault config */
+    qmc5883l_fault_stats_t stats;             /**< fault statistics */
+    uint32_t index;                           /**< transfer index since the config */
+    uint32_t seed;                            /**< random generator state */
+    uint64_t time_ms;                         /**< delay based clock */
+} fault_t;
+
+static fault_t gs_fault;        /**< fault state */
+
+/**
+ * @brief  get a random number
+ * @return random number
+ * @note   none
+ */
+static uint32_t a_fault_random(void)
+{
+    gs_fault.seed ^= gs_fault.seed << 13;
+    gs_fault.seed ^= gs_fault.seed >> 17;
+    gs_fault.seed ^= gs_fault.seed << 5;
+    
+    return gs_fault.seed;
+}
+
+/**
+ * @brief     delay through the wrapped bus
+ * @param[in] ms is the delay time
+ * @note      none
+ */
+static void a_fault_delay(uint32_t ms)
+{
+    gs_fault.bus.delay_ms(ms);
+    gs_fault.time_ms += ms;
+}
+
+/**
+ * @brief  check whether the current transfer is faulty
+ * @return 1 if the fault triggers
+ * @note   consumes one transfer index
+ */
+static uint8_t a_fault_trigger(void)
+{
+    uint32_t index;
+    
+    index = gs_fault.index++;
+    gs_fault.stats.transfers++;
+    if (gs_fault.config.fault == QMC5883L_FAULT_NONE)
+    {
+        return 0;
+    }
+    if (gs_fault.config.trigger == QMC5883L_FAULT_TRIGGER_SCHEDULE)
+    {
+        return ((index >= gs_fault.config.start) && ((index - gs_fault.config.start) < gs_fault.config.count)) ? 1 : 0;
+    }
+    else
+    {
+        return (((float)(a_fault_random() >> 8) / 16777216.0f) < gs_fault.config.probability) ? 1 : 0;
+    }
+}
+
+/**
+ * @brief mark an injected fault
+ * @note  none
+ */
+static void a_fault_injected(void)
+{
+    uint64_t now;
+    
+    now = qmc5883l_fault_get_time_ms();
+    if (gs_fault.stats.injected == 0)
+    {
+        gs_fault.stats.first_fault_ms = now;
+    }
+    gs_fault.stats.last_fault_ms = now;
+    gs_fault.stats.injected++;
+}
+
+/**
+ * @brief     set the wrapped bus
+ * @param[in] *bus points to a fault bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus is NULL
+ *            - 3 linked functions is NULL
+ * @note      clears the fault config and statistics
+ */
+uint8_t qmc5883l_fault_init(const qmc5883l_fault_bus_t *bus)
+{
+    if (bus == NULL)
+    {
+        return 2;
+    }
+    if ((bus->iic_init == NULL) || (bus->iic_deinit == NULL) || (bus->iic_read == NULL) ||
+        (bus->iic_write == NULL) || (bus->delay_ms == NULL))
+    {
+        return 3;
+    }
+    
+    memset(&gs_fault, 0, sizeof(fault_t));
+    gs_fault.bus = *bus;
+    gs_fault.seed = 0x12345678U;
+    
+    return 0;
+}
+
+/**
+ * @brief     set the fault config
+ * @param[in] *config points to a fault config structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 config is NULL
+ * @note      the schedule counts transfers from this call
+ */
+uint8_t qmc5883l_fault_set_config(const qmc5883l_fault_config_t *config)
+{
+    if (config == NULL)
+    {
+        return 2;
+    }
+    
+    gs_fault.config = *config;
+    gs_fault.index = 0;
+    gs_fault.seed = (config->seed != 0) ? config->seed : 0x12345678U;
+    memset(&gs_fault.stats, 0, sizeof(qmc5883l_fault_stats_t));
+    
+    return 0;
+}
+
+/**
+ * @brief      get the fault statistics
+ * @param[out] *stats points to a fault stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_fault_get_stats(qmc5883l_fault_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return 2;
+    }
+    
+    *stats = gs_fault.stats;
+    
+    return 0;
+}
+
+/**
+ * @brief  get the fault clock
+ * @return current time in milliseconds
+ * @note   none
+ */
+uint64_t qmc5883l_fault_get_time_ms(void)
+{
+    if (gs_fault.bus.timestamp_us != NULL)
+    {
+        return gs_fault.bus.timestamp_us() / 1000;
+    }
+    
+    return gs_fault.time_ms;
+}
+
+/**
+ * @brief  fault iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t qmc5883l_fault_iic_init(void)
+{
+    return gs_fault.bus.iic_init();
+}
+
+/**
+ * @brief  fault iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t qmc5883l_fault_iic_deinit(void)
+{
+    return gs_fault.bus.iic_deinit();
+}
+
+/**
+ * @brief      fault iic bus read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t qmc5883l_fault_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (a_fault_trigger() == 0)
+    {
+        return gs_fault.bus.iic_read(addr, reg, buf, len);
+    }
+    
+    switch (gs_fault.config.fault)
+    {
+        case QMC5883L_FAULT_NACK :
+        {
+            a_fault_injected();
+            
+            return 1;
+        }
+        case QMC5883L_FAULT_TIMEOUT :
+        {
+            a_fault_injected();
+            a_fault_delay(gs_fault.config.delay_ms);
+            
+            return 1;
+        }
+        case QMC5883L_FAULT_STUCK_DRDY :
+        {
+            res = gs_fault.bus.iic_read(addr, reg, buf, len);
+            if ((res == 0) && (reg <= FAULT_REG_STATUS) && ((uint32_t)reg + len > FAULT_REG_STATUS))
+            {
+                buf[FAULT_REG_STATUS - reg] &= (uint8_t)~QMC5883L_STATUS_DRDY;
+                a_fault_injected();
+            }
+            
+            return res;
+        }
+        case QMC5883L_FAULT_CORRUPT :
+        {
+            res = gs_fault.bus.iic_read(addr, reg, buf, len);
+            if ((res == 0) && (len != 0))
+            {
+                uint32_t bit;
+                
+                bit = a_fault_random() % ((uint32_t)len * 8);
+                buf[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+                a_fault_injected();
+            }
+            
+            return res;
+        }
+        case QMC5883L_FAULT_DELAY :
+        {
+            a_fault_injected();
+            a_fault_delay(gs_fault.config.delay_ms);
+            
+            return gs_fault.bus.iic_read(addr, reg, buf, len);
+        }
+        default :
+        {
+            return gs_fault.bus.iic_read(addr, reg, buf, len);
+        }
+    }
+}
+
+/**
+ * @brief     fault iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      stuck drdy and corrupt faults only affect reads
+ */
+uint8_t qmc5883l_fault_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (a_fault_trigger() == 0)
+    {
+        return gs_fault.bus.iic_write(addr, reg, buf, len);
+    }
+    
+    switch (gs_fault.config.fault)
+    {
+        case QMC5883L_FAULT_NACK :
+        {
+            a_fault_injected();
+            
+            return 1;
+        }
+        case QMC5883L_FAULT_TIMEOUT :
+        {
+            a_fault_injected();
+            a_fault_delay(gs_fault.config.delay_ms);
+            
+            return 1;
+        }
+        case QMC5883L_FAULT_DELAY :
+        {
+            a_fault_injected();
+            a_fault_delay(gs_fault.config.delay_ms);
+            
+            return gs_fault.bus.iic_write(addr, reg, buf, len);
+        }
+        default :
+        {
+            return gs_fault.bus.iic_write(addr, reg, buf, len);
+        }
+    }
+}
+
+/**
+ * @brief     fault delay ms
+ * @param[in] ms
+ * @note      none
+ */
+void qmc5883l_fault_delay_ms(uint32_t ms)
+{
+    a_fault_delay(ms);
+}
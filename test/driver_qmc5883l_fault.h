@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_fault.h
+ * @brief     driver qmc5883l fault header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_FAULT_H
+#define DRIVER_QMC5883L_FAULT_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_fault_driver qmc5883l fault driver function
+ * @brief    qmc5883l fault driver modules
+ * @ingroup  qmc5883l_test_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l fault enumeration definition
+ */
+typedef enum
+{
+    QMC5883L_FAULT_NONE       = 0x00,        /**< no fault */
+    QMC5883L_FAULT_NACK       = 0x01,        /**< transfer is not acknowledged */
+    QMC5883L_FAULT_TIMEOUT    = 0x02,        /**< transfer fails after the fault delay */
+    QMC5883L_FAULT_STUCK_DRDY = 0x03,        /**< status reads return drdy cleared */
+    QMC5883L_FAULT_CORRUPT    = 0x04,        /**< one bit of the read data is flipped */
+    QMC5883L_FAULT_DELAY      = 0x05,        /**< transfer succeeds after the fault delay */
+} qmc5883l_fault_t;
+
+/**
+ * @brief qmc5883l fault trigger enumeration definition
+ */
+typedef enum
+{
+    QMC5883L_FAULT_TRIGGER_SCHEDULE    = 0x00,        /**< transfers [start, start + count) are faulty */
+    QMC5883L_FAULT_TRIGGER_PROBABILITY = 0x01,        /**< every transfer is faulty with a probability */
+} qmc5883l_fault_trigger_t;
+
+/**
+ * @brief qmc5883l fault bus structure definition
+ */
+typedef struct qmc5883l_fault_bus_s
+{
+    uint8_t (*iic_init)(void);                                                          /**< point to an iic_init function address */
+    uint8_t (*iic_deinit)(void);                                                        /**< point to an iic_deinit function address */
+    uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read function address */
+    uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write function address */
+    void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
+    uint64_t (*timestamp_us)(void);                                                     /**< point to a clock function address, NULL to count delays */
+} qmc5883l_fault_bus_t;
+
+/**
+ * @brief qmc5883l fault config structure definition
+ */
+typedef struct qmc5883l_fault_config_s
+{
+    qmc5883l_fault_t fault;                  /**< injected fault */
+    qmc5883l_fault_trigger_t trigger;        /**< fault trigger */
+    uint32_t start;                          /**< first faulty transfer of the schedule */
+    uint32_t count;                          /**< faulty transfers of the schedule */
+    float probability;                       /**< fault probability of one transfer */
+    uint32_t seed;                           /**< random seed */
+    uint32_t delay_ms;                       /**< timeout or response delay */
+} qmc5883l_fault_config_t;
+
+/**
+ * @brief qmc5883l fault statistics structure definition
+ */
+typedef struct qmc5883l_fault_stats_s
+{
+    uint32_t transfers;              /**< iic transfers seen */
+    uint32_t injected;               /**< faults injected */
+    uint64_t first_fault_ms;         /**< time of the first injected fault */
+    uint64_t last_fault_ms;          /**< time of the last injected fault */
+} qmc5883l_fault_stats_t;
+
+/**
+ * @brief     set the wrapped bus
+ * @param[in] *bus points to a fault bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus is NULL
+ *            - 3 linked functions is NULL
+ * @note      clears the fault config and statistics
+ */
+uint8_t qmc5883l_fault_init(const qmc5883l_fault_bus_t *bus);
+
+/**
+ * @brief     set the fault config
+ * @param[in] *config points to a fault config structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 config is NULL
+ * @note      the schedule counts transfers from this call
+ */
+uint8_t qmc5883l_fault_set_config(const qmc5883l_fault_config_t *config);
+
+/**
+ * @brief      get the fault statistics
+ * @param[out] *stats points to a fault stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_fault_get_stats(qmc5883l_fault_stats_t *stats);
+
+/**
+ * @brief  get the fault clock
+ * @return current time in milliseconds
+ * @note   none
+ */
+uint64_t qmc5883l_fault_get_time_ms(void);
+
+/**
+ * @brief  fault iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t qmc5883l_fault_iic_init(void);
+
+/**
+ * @brief  fault iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t qmc5883l_fault_iic_deinit(void);
+
+/**
+ * @brief      fault iic bus read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t qmc5883l_fault_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     fault iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      stuck drdy and corrupt faults only affect reads
+ */
+uint8_t qmc5883l_fault_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     fault delay ms
+ * @param[in] ms
+ * @note      none
+ */
+void qmc5883l_fault_delay_ms(uint32_t ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,304 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_fault_test.c
+ * @brief     driver qmc5883l fault test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_fault_test.h"
+
+/**
+ * @brief fault test definition
+ */
+#define FAULT_TEST_START            4         /**< first faulty transfer */
+#define FAULT_TEST_COUNT            8         /**< faulty transfers */
+#define FAULT_TEST_DELAY_MS         100       /**< timeout and response delay */
+#define FAULT_TEST_TOLERANCE        100       /**< max raw deviation of a good sample */
+#define FAULT_TEST_STALL_COUNT      6000      /**< stuck drdy status reads, longer than one qmc5883l_read poll */
+
+static qmc5883l_handle_t gs_handle;        /**< qmc5883l handle */
+
+/**
+ * @brief fault test case structure definition
+ */
+typedef struct fault_test_case_s
+{
+    qmc5883l_fault_t fault;        /**< injected fault */
+    uint32_t count;                /**< faulty transfers */
+    const char *name;              /**< fault name */
+} fault_test_case_t;
+
+/**
+ * @brief fault test case table definition
+ */
+static const fault_test_case_t gs_case[] =
+{
+    {QMC5883L_FAULT_NACK, FAULT_TEST_COUNT, "nack"},
+    {QMC5883L_FAULT_TIMEOUT, FAULT_TEST_COUNT, "timeout"},
+    {QMC5883L_FAULT_STUCK_DRDY, FAULT_TEST_COUNT, "stuck drdy"},
+    {QMC5883L_FAULT_STUCK_DRDY, FAULT_TEST_STALL_COUNT, "long stuck drdy"},
+    {QMC5883L_FAULT_CORRUPT, FAULT_TEST_COUNT, "corrupt"},
+    {QMC5883L_FAULT_DELAY, FAULT_TEST_COUNT, "delay"},
+};
+
+/**
+ * @brief     check a sample against the reference
+ * @param[in] *raw points to a raw data buffer
+ * @param[in] *ref points to a reference data buffer
+ * @return    1 if the sample deviates
+ * @note      none
+ */
+static uint8_t a_fault_test_deviates(const int16_t raw[3], const int16_t ref[3])
+{
+    uint8_t i;
+    
+    for (i = 0; i < 3; i++)
+    {
+        int32_t d;
+        
+        d = (int32_t)raw[i] - (int32_t)ref[i];
+        if ((d > FAULT_TEST_TOLERANCE) || (d < -FAULT_TEST_TOLERANCE))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     fault test
+ * @param[in] times is the number of good samples read after each fault
+ * @param[in] *timestamp_us points to a monotonic microsecond clock function
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sensor must be kept still, corruption is detected against a reference sample,
+ *            every read that starts after the fault window must succeed,
+ *            the clock must count the bus time as well as the delays
+ */
+uint8_t qmc5883l_fault_test(uint32_t times, uint64_t (*timestamp_us)(void))
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t c;
+    int16_t raw[3];
+    int16_t ref[3];
+    float m_gauss[3];
+    uint64_t start_ms;
+    uint64_t period_ms;
+    qmc5883l_fault_bus_t bus;
+    qmc5883l_fault_config_t config;
+    qmc5883l_fault_stats_t stats;
+    
+    /* check the clock */
+    if (timestamp_us == NULL)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: clock is null.\n");
+        
+        return 1;
+    }
+    
+    /* wrap the interface */
+    memset(&bus, 0, sizeof(qmc5883l_fault_bus_t));
+    bus.iic_init = qmc5883l_interface_iic_init;
+    bus.iic_deinit = qmc5883l_interface_iic_deinit;
+    bus.iic_read = qmc5883l_interface_iic_read;
+    bus.iic_write = qmc5883l_interface_iic_write;
+    bus.delay_ms = qmc5883l_interface_delay_ms;
+    bus.timestamp_us = timestamp_us;
+    res = qmc5883l_fault_init(&bus);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: fault init failed.\n");
+        
+        return 1;
+    }
+    
+    /* link fault function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_fault_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_fault_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_fault_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_fault_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_fault_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* start fault test */
+    qmc5883l_interface_debug_print("qmc5883l: start fault test.\n");
+    
+    /* 50Hz, 2gauss, 512 over sample and continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_50HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* measure the fault free sample period */
+    start_ms = qmc5883l_fault_get_time_ms();
+    for (i = 0; i < times + 1; i++)
+    {
+        res = qmc5883l_read(&gs_handle, ref, m_gauss);
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    period_ms = (qmc5883l_fault_get_time_ms() - start_ms) / (times + 1);
+    if (period_ms == 0)
+    {
+        period_ms = 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: fault free sample period is %dms.\n", (uint32_t)period_ms);
+    
+    for (c = 0; c < sizeof(gs_case) / sizeof(gs_case[0]); c++)
+    {
+        uint32_t good = 0;
+        uint32_t cleared_good = 0;
+        uint32_t cleared_attempts = 0;
+        uint32_t failed = 0;
+        uint32_t corrupted = 0;
+        uint32_t attempts = 0;
+        uint32_t accounted = 0;
+        uint64_t recover_ms = 0;
+        uint64_t stall_ms = 0;
+        uint64_t duration_ms;
+        uint64_t expected;
+        
+        /* inject the fault into a window of transfers */
+        qmc5883l_interface_debug_print("qmc5883l: %s fault test.\n", gs_case[c].name);
+        memset(&config, 0, sizeof(qmc5883l_fault_config_t));
+        config.fault = gs_case[c].fault;
+        config.trigger = QMC5883L_FAULT_TRIGGER_SCHEDULE;
+        config.start = FAULT_TEST_START;
+        config.count = gs_case[c].count;
+        config.delay_ms = FAULT_TEST_DELAY_MS;
+        (void)qmc5883l_fault_set_config(&config);
+        (void)qmc5883l_fault_get_stats(&stats);
+        start_ms = qmc5883l_fault_get_time_ms();
+        
+        /* read until enough good samples follow the fault window */
+        while (attempts < times * 10 + 100)
+        {
+            uint8_t cleared;
+            uint64_t read_ms;
+            
+            cleared = (stats.transfers >= FAULT_TEST_START + gs_case[c].count) ? 1 : 0;
+            attempts++;
+            cleared_attempts += cleared;
+            read_ms = qmc5883l_fault_get_time_ms();
+            res = qmc5883l_read(&gs_handle, raw, m_gauss);
+            read_ms = qmc5883l_fault_get_time_ms() - read_ms;
+            if ((cleared == 0) && (read_ms > stall_ms))
+            {
+                stall_ms = read_ms;
+            }
+            (void)qmc5883l_fault_get_stats(&stats);
+            if (res != 0)
+            {
+                failed++;
+                
+                continue;
+            }
+            if (a_fault_test_deviates(raw, ref) != 0)
+            {
+                corrupted++;
+                
+                continue;
+            }
+            cleared_good += cleared;
+            if (stats.injected != accounted)
+            {
+                recover_ms = qmc5883l_fault_get_time_ms() - stats.first_fault_ms;
+                accounted = stats.injected;
+            }
+            good++;
+            if (cleared_good >= times)
+            {
+                break;
+            }
+        }
+        duration_ms = qmc5883l_fault_get_time_ms() - start_ms;
+        expected = duration_ms / period_ms;
+        
+        /* output */
+        qmc5883l_interface_debug_print("qmc5883l: injected %d faults, %d reads failed, %d samples corrupted.\n",
+                                       stats.injected, failed, corrupted);
+        qmc5883l_interface_debug_print("qmc5883l: time to recover is %dms.\n", (uint32_t)recover_ms);
+        qmc5883l_interface_debug_print("qmc5883l: longest read during the fault took %dms.\n", (uint32_t)stall_ms);
+        qmc5883l_interface_debug_print("qmc5883l: lost %d samples.\n", (expected > good) ? (uint32_t)(expected - good) : 0);
+        
+        /* failed reads take time, so the recovery can not be instant */
+        if ((failed != 0) && (recover_ms == 0))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: %d reads failed but no recovery time, clock check error.\n", failed);
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* every read after the fault window must be good */
+        if ((cleared_good < times) || (cleared_good != cleared_attempts))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: %d of %d reads good after the fault, recovery check error.\n",
+                                           cleared_good, cleared_attempts);
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* finish fault test */
+    config.fault = QMC5883L_FAULT_NONE;
+    (void)qmc5883l_fault_set_config(&config);
+    qmc5883l_interface_debug_print("qmc5883l: finish fault test.\n");
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    return 0;
+}
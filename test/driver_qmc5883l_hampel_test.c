@@ -0,0 +1,321 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_hampel_test.c
+ * @brief     driver qmc5883l hampel test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_hampel_test.h"
+#include <stdlib.h>
+
+/**
+ * @brief hampel test definition
+ */
+#define HAMPEL_TEST_WINDOW           15          /**< window length */
+#define HAMPEL_TEST_THRESHOLD        3.0f        /**< threshold in scaled mad */
+#define HAMPEL_TEST_PERIOD_MS        5           /**< 200Hz sample period */
+#define HAMPEL_TEST_SPIKE_PERIOD     37          /**< one spike every 37 samples */
+#define HAMPEL_TEST_SPIKE            2000        /**< spike height in lsb */
+
+static qmc5883l_handle_t gs_handle;              /**< qmc5883l handle */
+static qmc5883l_hampel_t gs_hampel;              /**< outlier filter */
+
+/**
+ * @brief     compare two int16 values
+ * @param[in] *a points to the first value
+ * @param[in] *b points to the second value
+ * @return    comparison result
+ * @note      none
+ */
+static int a_hampel_test_compare(const void *a, const void *b)
+{
+    return (int)(*(const int16_t *)a) - (int)(*(const int16_t *)b);
+}
+
+/**
+ * @brief      check a value against the textbook median and mad
+ * @param[in]  *window points to the window values
+ * @param[in]  len is the window length
+ * @param[in]  v is the checked value
+ * @param[in]  k_q8 is the threshold in q8
+ * @param[out] *med points to a median buffer
+ * @return     1 if the value is an outlier
+ * @note       sorts copies of the window and of the deviations
+ */
+static uint8_t a_hampel_test_reference(const int16_t *window, uint8_t len, int16_t v, uint32_t k_q8, int16_t *med)
+{
+    int16_t s[QMC5883L_HAMPEL_MAX_WINDOW];
+    int32_t dev;
+    int32_t mad;
+    uint8_t i;
+    
+    memcpy(s, window, sizeof(int16_t) * len);
+    qsort(s, len, sizeof(int16_t), a_hampel_test_compare);
+    *med = s[len / 2];
+    for (i = 0; i < len; i++)
+    {
+        int32_t d;
+        
+        d = (int32_t)window[i] - *med;
+        s[i] = (int16_t)((d < 0) ? -d : d);
+    }
+    qsort(s, len, sizeof(int16_t), a_hampel_test_compare);
+    mad = (s[len / 2] < 1) ? 1 : s[len / 2];
+    dev = (int32_t)v - *med;
+    dev = (dev < 0) ? -dev : dev;
+    
+    return ((uint32_t)dev * 256U > k_q8 * (uint32_t)mad) ? 1 : 0;
+}
+
+/**
+ * @brief  check the filter against the reference on random data
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   none
+ */
+static uint8_t a_hampel_test_reference_check(void)
+{
+    int16_t history[3][QMC5883L_HAMPEL_MAX_WINDOW];
+    uint32_t i;
+    uint8_t k;
+    
+    srand(1);
+    (void)qmc5883l_hampel_init(&gs_hampel, HAMPEL_TEST_WINDOW, HAMPEL_TEST_THRESHOLD);
+    for (i = 0; i < 20000; i++)
+    {
+        int16_t raw[3];
+        int16_t out[3];
+        uint8_t replaced;
+        
+        for (k = 0; k < 3; k++)
+        {
+            /* a few levels of noise, with the mad dropping to 0 on the z axis */
+            raw[k] = (int16_t)(((i / 1000) % 2 == 0) ? (rand() % 9 - 4) : (rand() % 201 - 100));
+            if (k == 2)
+            {
+                raw[k] = (int16_t)(raw[k] / 8);
+            }
+            if ((rand() % 20) == 0)
+            {
+                raw[k] = (int16_t)(rand() % 65536 - 32768);
+            }
+            history[k][i % HAMPEL_TEST_WINDOW] = raw[k];
+        }
+        (void)qmc5883l_hampel_push(&gs_hampel, raw, out, &replaced);
+        if (i < HAMPEL_TEST_WINDOW - 1)
+        {
+            if ((replaced != 0) || (out[0] != raw[0]) || (out[1] != raw[1]) || (out[2] != raw[2]))
+            {
+                qmc5883l_interface_debug_print("qmc5883l: warmup pass through check error.\n");
+                
+                return 1;
+            }
+            continue;
+        }
+        for (k = 0; k < 3; k++)
+        {
+            int16_t med;
+            uint8_t outlier;
+            
+            outlier = a_hampel_test_reference(history[k], HAMPEL_TEST_WINDOW, raw[k], gs_hampel.k_q8, &med);
+            if ((outlier != ((replaced >> k) & 1)) || (out[k] != (outlier != 0 ? med : raw[k])))
+            {
+                qmc5883l_interface_debug_print("qmc5883l: sample %d axis %d reference check error.\n", i, k);
+                
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     hampel test
+ * @param[in] times is the number of filtered samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sensor must be kept still
+ */
+uint8_t qmc5883l_hampel_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t replaced;
+    uint32_t i;
+    uint32_t spikes;
+    uint32_t caught;
+    uint32_t false_replaced;
+    uint32_t samples;
+    uint32_t replaced_samples;
+    uint32_t replaced_values;
+    int16_t raw[3];
+    int16_t out[3];
+    float m_gauss[3];
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start hampel test */
+    qmc5883l_interface_debug_print("qmc5883l: start hampel test.\n");
+    
+    /* window and threshold limits */
+    if ((qmc5883l_hampel_init(&gs_hampel, 4, HAMPEL_TEST_THRESHOLD) != 4) ||
+        (qmc5883l_hampel_init(&gs_hampel, QMC5883L_HAMPEL_MAX_WINDOW + 2, HAMPEL_TEST_THRESHOLD) != 4) ||
+        (qmc5883l_hampel_init(&gs_hampel, HAMPEL_TEST_WINDOW, 0.0f) != 4) ||
+        (qmc5883l_hampel_init(&gs_hampel, QMC5883L_HAMPEL_MAX_WINDOW, HAMPEL_TEST_THRESHOLD) != 0) ||
+        (qmc5883l_hampel_push(&gs_hampel, NULL, out, &replaced) != 2) ||
+        (qmc5883l_hampel_push(&gs_hampel, raw, NULL, &replaced) != 2) ||
+        (qmc5883l_hampel_push(&gs_hampel, raw, out, NULL) != 2))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: hampel limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* compare with a sort based median and mad */
+    res = a_hampel_test_reference_check();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: decisions match the sorted median and mad.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 64 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_64) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* inject spikes into the live samples */
+    qmc5883l_interface_debug_print("qmc5883l: window %d, threshold %.1f, a spike every %d samples.\n",
+                                   HAMPEL_TEST_WINDOW, HAMPEL_TEST_THRESHOLD, HAMPEL_TEST_SPIKE_PERIOD);
+    (void)qmc5883l_hampel_init(&gs_hampel, HAMPEL_TEST_WINDOW, HAMPEL_TEST_THRESHOLD);
+    spikes = 0;
+    caught = 0;
+    false_replaced = 0;
+    for (i = 0; i < times; i++)
+    {
+        int16_t clean;
+        uint8_t axis;
+        uint8_t spike;
+        
+        qmc5883l_interface_delay_ms(HAMPEL_TEST_PERIOD_MS);
+        res = qmc5883l_read(&gs_handle, raw, m_gauss);
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        axis = (uint8_t)((i / HAMPEL_TEST_SPIKE_PERIOD) % 3);
+        clean = raw[axis];
+        spike = ((i >= HAMPEL_TEST_WINDOW) && ((i % HAMPEL_TEST_SPIKE_PERIOD) == 0)) ? 1 : 0;
+        if (spike != 0)
+        {
+            raw[axis] = (int16_t)(raw[axis] + (((i / 2) % 2 == 0) ? HAMPEL_TEST_SPIKE : -HAMPEL_TEST_SPIKE));
+            spikes++;
+        }
+        (void)qmc5883l_hampel_push(&gs_hampel, raw, out, &replaced);
+        if (spike != 0)
+        {
+            if ((replaced & (1 << axis)) != 0)
+            {
+                caught++;
+                if (abs(out[axis] - clean) > HAMPEL_TEST_SPIKE / 10)
+                {
+                    qmc5883l_interface_debug_print("qmc5883l: replaced value %d against %d check error.\n", out[axis], clean);
+                    (void)qmc5883l_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+            }
+            replaced = (uint8_t)(replaced & ~(1 << axis));
+        }
+        false_replaced += (uint32_t)(((replaced >> 0) & 1) + ((replaced >> 1) & 1) + ((replaced >> 2) & 1));
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    /* check the counters */
+    (void)qmc5883l_hampel_get_stats(&gs_hampel, &samples, &replaced_samples, &replaced_values);
+    qmc5883l_interface_debug_print("qmc5883l: %d samples, %d replaced samples, %d replaced values.\n",
+                                   samples, replaced_samples, replaced_values);
+    qmc5883l_interface_debug_print("qmc5883l: %d of %d spikes caught, %d clean values replaced.\n", caught, spikes, false_replaced);
+    if ((samples != times) || (replaced_values != caught + false_replaced))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: counter check error.\n");
+        
+        return 1;
+    }
+    if (caught != spikes)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: spike rejection check error.\n");
+        
+        return 1;
+    }
+    /* a short window estimates the mad roughly, allow 3% of the axis values */
+    if (false_replaced * 100 > times * 3 * 3)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: false replacement check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish hampel test */
+    qmc5883l_interface_debug_print("qmc5883l: finish hampel test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,287 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_heading_test.c
+ * @brief     driver qmc5883l heading test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_heading_test.h"
+#include <math.h>
+#include <time.h>
+
+/**
+ * @brief heading test definition
+ */
+#define HEADING_TEST_LEN                  1024          /**< samples */
+#define HEADING_TEST_FIELD                500.0         /**< field in m_gauss */
+#define HEADING_TEST_LSB                  12.0          /**< lsb per m_gauss at 2gauss */
+#define HEADING_TEST_FLOAT_TOLERANCE      0.002f        /**< max float error in degrees */
+#define HEADING_TEST_FIXED_TOLERANCE      0.05f         /**< max fixed point error in degrees */
+
+static float gs_m_gauss[HEADING_TEST_LEN][3];             /**< field samples */
+static int16_t gs_raw[HEADING_TEST_LEN][3];               /**< raw field samples */
+static float gs_pitch_roll[HEADING_TEST_LEN][2];          /**< pitch and roll in degrees */
+static int16_t gs_pitch_roll_fixed[HEADING_TEST_LEN][2];  /**< pitch and roll as binary angles */
+static double gs_ref[HEADING_TEST_LEN];                   /**< libm heading of the float samples */
+static double gs_ref_fixed[HEADING_TEST_LEN];             /**< libm heading of the fixed samples */
+static float gs_deg[HEADING_TEST_LEN];                    /**< heading output */
+static volatile float gs_sink;                            /**< keeps the benchmark loops */
+
+/**
+ * @brief     libm tilt compensated heading
+ * @param[in] mx is the x field
+ * @param[in] my is the y field
+ * @param[in] mz is the z field
+ * @param[in] pitch is the pitch in degrees
+ * @param[in] roll is the roll in degrees
+ * @return    heading in [0, 360)
+ * @note      none
+ */
+static double a_heading_test_libm(double mx, double my, double mz, double pitch, double roll)
+{
+    const double d2r = 3.14159265358979323846 / 180.0;
+    double xh;
+    double yh;
+    double h;
+    
+    xh = mx * cos(pitch * d2r) + my * sin(roll * d2r) * sin(pitch * d2r) + mz * cos(roll * d2r) * sin(pitch * d2r);
+    yh = my * cos(roll * d2r) - mz * sin(roll * d2r);
+    h = atan2(-yh, xh) / d2r;
+    
+    return (h < 0.0) ? (h + 360.0) : h;
+}
+
+/**
+ * @brief     angle difference
+ * @param[in] a is the first angle in degrees
+ * @param[in] b is the second angle in degrees
+ * @return    absolute difference in [0, 180]
+ * @note      none
+ */
+static float a_heading_test_diff(double a, double b)
+{
+    double d;
+    
+    d = fmod(fabs(a - b), 360.0);
+    
+    return (float)((d > 180.0) ? (360.0 - d) : d);
+}
+
+/**
+ * @brief     get the nanoseconds per sample of a clock interval
+ * @param[in] start is the start clock
+ * @param[in] n is the number of samples
+ * @return    nanoseconds per sample
+ * @note      none
+ */
+static double a_heading_test_ns(clock_t start, double n)
+{
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / n;
+}
+
+/**
+ * @brief     heading test
+ * @param[in] times is the number of benchmark passes over the sample buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the chip is not used
+ */
+uint8_t qmc5883l_heading_test(uint32_t times)
+{
+    const double d2r = 3.14159265358979323846 / 180.0;
+    uint32_t seed;
+    uint32_t i;
+    uint32_t t;
+    float atan2_err;
+    float flat_err;
+    float tilt_err;
+    float fixed_err;
+    float batch_err;
+    clock_t start;
+    double n;
+    double ns_libm;
+    double ns_tilt;
+    double ns_fixed;
+    double ns_batch;
+    
+    /* start heading test */
+    qmc5883l_interface_debug_print("qmc5883l: start heading test.\n");
+    
+    /* random fields with up to 70 degrees dip and tilts up to 60 degrees */
+    seed = 1;
+    for (i = 0; i < HEADING_TEST_LEN; i++)
+    {
+        double r[4];
+        uint8_t j;
+        
+        for (j = 0; j < 4; j++)
+        {
+            seed = seed * 1664525U + 1013904223U;
+            r[j] = (double)(seed >> 8) / 16777216.0;
+        }
+        gs_m_gauss[i][0] = (float)(HEADING_TEST_FIELD * cos((r[1] - 0.5) * 140.0 * d2r) * cos(r[0] * 360.0 * d2r));
+        gs_m_gauss[i][1] = (float)(HEADING_TEST_FIELD * cos((r[1] - 0.5) * 140.0 * d2r) * sin(r[0] * 360.0 * d2r));
+        gs_m_gauss[i][2] = (float)(HEADING_TEST_FIELD * sin((r[1] - 0.5) * 140.0 * d2r));
+        gs_pitch_roll[i][0] = (float)((r[2] - 0.5) * 120.0);
+        gs_pitch_roll[i][1] = (float)((r[3] - 0.5) * 120.0);
+        for (j = 0; j < 3; j++)
+        {
+            gs_raw[i][j] = (int16_t)lround(gs_m_gauss[i][j] * HEADING_TEST_LSB);
+        }
+        for (j = 0; j < 2; j++)
+        {
+            gs_pitch_roll_fixed[i][j] = (int16_t)lround(gs_pitch_roll[i][j] / 360.0 * QMC5883L_HEADING_TURN);
+        }
+        gs_ref[i] = a_heading_test_libm(gs_m_gauss[i][0], gs_m_gauss[i][1], gs_m_gauss[i][2],
+                                        gs_pitch_roll[i][0], gs_pitch_roll[i][1]);
+        gs_ref_fixed[i] = a_heading_test_libm(gs_raw[i][0], gs_raw[i][1], gs_raw[i][2],
+                                              gs_pitch_roll_fixed[i][0] * 360.0 / QMC5883L_HEADING_TURN,
+                                              gs_pitch_roll_fixed[i][1] * 360.0 / QMC5883L_HEADING_TURN);
+    }
+    
+    /* error against libm */
+    atan2_err = 0.0f;
+    flat_err = 0.0f;
+    tilt_err = 0.0f;
+    fixed_err = 0.0f;
+    batch_err = 0.0f;
+    for (i = 0; i < HEADING_TEST_LEN; i++)
+    {
+        float y;
+        float x;
+        float deg;
+        uint16_t angle;
+        float e;
+        
+        y = gs_m_gauss[i][1];
+        x = gs_m_gauss[i][0];
+        e = a_heading_test_diff(qmc5883l_heading_atan2(y, x), atan2(y, x) / d2r);
+        atan2_err = (e > atan2_err) ? e : atan2_err;
+        (void)qmc5883l_heading_flat(gs_m_gauss[i], &deg);
+        e = a_heading_test_diff(deg, a_heading_test_libm(x, y, gs_m_gauss[i][2], 0.0, 0.0));
+        flat_err = (e > flat_err) ? e : flat_err;
+        (void)qmc5883l_heading_tilt(gs_m_gauss[i], gs_pitch_roll[i][0], gs_pitch_roll[i][1], &deg);
+        e = a_heading_test_diff(deg, gs_ref[i]);
+        tilt_err = (e > tilt_err) ? e : tilt_err;
+        (void)qmc5883l_heading_fixed(gs_raw[i], gs_pitch_roll_fixed[i][0], gs_pitch_roll_fixed[i][1], &angle);
+        e = a_heading_test_diff(angle * 360.0 / QMC5883L_HEADING_TURN, gs_ref_fixed[i]);
+        fixed_err = (e > fixed_err) ? e : fixed_err;
+    }
+    (void)qmc5883l_heading_batch((const float (*)[3])gs_m_gauss, (const float (*)[2])gs_pitch_roll, gs_deg, HEADING_TEST_LEN);
+    for (i = 0; i < HEADING_TEST_LEN; i++)
+    {
+        float e;
+        
+        e = a_heading_test_diff(gs_deg[i], gs_ref[i]);
+        batch_err = (e > batch_err) ? e : batch_err;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: atan2 max deviation from libm is %.5f degrees.\n", atan2_err);
+    qmc5883l_interface_debug_print("qmc5883l: flat heading max deviation from libm is %.5f degrees.\n", flat_err);
+    qmc5883l_interface_debug_print("qmc5883l: tilt heading max deviation from libm is %.5f degrees.\n", tilt_err);
+    qmc5883l_interface_debug_print("qmc5883l: fixed heading max deviation from libm is %.5f degrees.\n", fixed_err);
+    qmc5883l_interface_debug_print("qmc5883l: batch heading max deviation from libm is %.5f degrees.\n", batch_err);
+    if ((atan2_err > QMC5883L_HEADING_ATAN2_MAX_ERROR) || (flat_err > HEADING_TEST_FLOAT_TOLERANCE) ||
+        (tilt_err > HEADING_TEST_FLOAT_TOLERANCE) || (batch_err > HEADING_TEST_FLOAT_TOLERANCE) ||
+        (fixed_err > HEADING_TEST_FIXED_TOLERANCE))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: heading check error.\n");
+        
+        return 1;
+    }
+    
+    /* libm float path */
+    n = (double)HEADING_TEST_LEN * times;
+    start = clock();
+    for (t = 0; t < times; t++)
+    {
+        for (i = 0; i < HEADING_TEST_LEN; i++)
+        {
+            float p;
+            float r;
+            float h;
+            
+            p = gs_pitch_roll[i][0] * (float)d2r;
+            r = gs_pitch_roll[i][1] * (float)d2r;
+            h = atan2f(-(gs_m_gauss[i][1] * cosf(r) - gs_m_gauss[i][2] * sinf(r)),
+                       gs_m_gauss[i][0] * cosf(p) + gs_m_gauss[i][1] * sinf(r) * sinf(p) + gs_m_gauss[i][2] * cosf(r) * sinf(p));
+            gs_sink = h;
+        }
+    }
+    ns_libm = a_heading_test_ns(start, n);
+    
+    /* fast float path */
+    start = clock();
+    for (t = 0; t < times; t++)
+    {
+        for (i = 0; i < HEADING_TEST_LEN; i++)
+        {
+            float deg;
+            
+            (void)qmc5883l_heading_tilt(gs_m_gauss[i], gs_pitch_roll[i][0], gs_pitch_roll[i][1], &deg);
+            gs_sink = deg;
+        }
+    }
+    ns_tilt = a_heading_test_ns(start, n);
+    
+    /* fixed point path */
+    start = clock();
+    for (t = 0; t < times; t++)
+    {
+        for (i = 0; i < HEADING_TEST_LEN; i++)
+        {
+            uint16_t angle;
+            
+            (void)qmc5883l_heading_fixed(gs_raw[i], gs_pitch_roll_fixed[i][0], gs_pitch_roll_fixed[i][1], &angle);
+            gs_sink = angle;
+        }
+    }
+    ns_fixed = a_heading_test_ns(start, n);
+    
+    /* batch path */
+    start = clock();
+    for (t = 0; t < times; t++)
+    {
+        (void)qmc5883l_heading_batch((const float (*)[3])gs_m_gauss, (const float (*)[2])gs_pitch_roll, gs_deg, HEADING_TEST_LEN);
+        gs_sink = gs_deg[t % HEADING_TEST_LEN];
+    }
+    ns_batch = a_heading_test_ns(start, n);
+    qmc5883l_interface_debug_print("qmc5883l: libm tilt heading %.1f ns.\n", ns_libm);
+    qmc5883l_interface_debug_print("qmc5883l: fast tilt heading %.1f ns.\n", ns_tilt);
+    qmc5883l_interface_debug_print("qmc5883l: fixed tilt heading %.1f ns.\n", ns_fixed);
+    qmc5883l_interface_debug_print("qmc5883l: batch tilt heading %.1f ns.\n", ns_batch);
+    
+    /* finish heading test */
+    qmc5883l_interface_debug_print("qmc5883l: finish heading test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,556 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_index_test.c
+ * @brief     driver qmc5883l index test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_index_test.h"
+#include <time.h>
+
+/**
+ * @brief index test definition
+ */
+#define INDEX_TEST_PATH             "qmc5883l_index_test.bin"        /**< index file */
+#define INDEX_TEST_SAMPLES          1000000                          /**< synthetic samples */
+#define INDEX_TEST_PERIOD_US        5000                             /**< sample period */
+#define INDEX_TEST_GAP_EVERY        10007                            /**< a one second gap this often */
+#define INDEX_TEST_SPIKE_EVERY      99991                            /**< one x spike this often */
+#define INDEX_TEST_BAND             10000                            /**< threshold band half width */
+#define INDEX_TEST_CHECKS           100                              /**< brute force range checks */
+#define INDEX_TEST_QUERIES          100000                           /**< timed range queries */
+#define INDEX_TEST_MIN_SKIP         0.9                              /**< min skipped block ratio */
+#define INDEX_TEST_CHIP_MAX         10000                            /**< max logged chip samples */
+#define INDEX_TEST_POLL_MS          1                                /**< data ready poll period */
+#define INDEX_TEST_POLL_TRIES       100                              /**< data ready polls before timeout */
+
+static qmc5883l_handle_t gs_handle;                  /**< qmc5883l handle */
+static qmc5883l_index_writer_t gs_writer;            /**< index writer */
+static qmc5883l_index_reader_t gs_reader;            /**< index reader */
+static int16_t gs_raw[INDEX_TEST_CHIP_MAX][3];       /**< logged chip samples */
+static uint32_t gs_seed = 13;                        /**< noise generator state */
+
+/**
+ * @brief  next pseudo random number
+ * @return random number
+ * @note   none
+ */
+static uint32_t a_index_test_rand(void)
+{
+    gs_seed = gs_seed * 1664525U + 1013904223U;
+    
+    return gs_seed >> 8;
+}
+
+/**
+ * @brief     synthetic sample time
+ * @param[in] n is the sample position
+ * @return    sample time
+ * @note      none
+ */
+static uint64_t a_index_test_time(uint32_t n)
+{
+    return (uint64_t)n * INDEX_TEST_PERIOD_US + (uint64_t)(n / INDEX_TEST_GAP_EVERY) * 1000000U;
+}
+
+/**
+ * @brief  write the synthetic file
+ * @return status code
+ *         - 0 success
+ *         - 1 write failed
+ * @note   slow ramps with noise and an x spike every 99991 samples
+ */
+static uint8_t a_index_test_write(void)
+{
+    int16_t raw[3];
+    uint32_t n;
+    
+    if (qmc5883l_index_create(&gs_writer, INDEX_TEST_PATH, QMC5883L_INDEX_BLOCK_SAMPLES) != 0)
+    {
+        return 1;
+    }
+    for (n = 0; n < INDEX_TEST_SAMPLES; n++)
+    {
+        raw[0] = (int16_t)((int32_t)(n % 4000) - 2000 + (int32_t)(a_index_test_rand() % 41) - 20);
+        raw[1] = (int16_t)((int32_t)(n % 6000) - 3000 + (int32_t)(a_index_test_rand() % 41) - 20);
+        raw[2] = (int16_t)(4800 + (int32_t)(a_index_test_rand() % 41) - 20);
+        if ((n % INDEX_TEST_SPIKE_EVERY) == INDEX_TEST_SPIKE_EVERY / 2)
+        {
+            raw[0] = 20000;
+        }
+        if (qmc5883l_index_append(&gs_writer, a_index_test_time(n), raw) != 0)
+        {
+            (void)qmc5883l_index_finish(&gs_writer);
+            
+            return 1;
+        }
+    }
+    
+    return qmc5883l_index_finish(&gs_writer);
+}
+
+/**
+ * @brief  check range queries against a linear scan
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   none
+ */
+static uint8_t a_index_test_ranges(void)
+{
+    const qmc5883l_index_sample_t *samples;
+    uint64_t end_us;
+    uint64_t count;
+    uint64_t sum;
+    uint64_t i;
+    uint32_t q;
+    double seconds;
+    clock_t start;
+    
+    end_us = a_index_test_time(INDEX_TEST_SAMPLES - 1) + INDEX_TEST_PERIOD_US;
+    for (q = 0; q < INDEX_TEST_CHECKS; q++)
+    {
+        uint64_t t0 = ((uint64_t)a_index_test_rand() << 8 | (a_index_test_rand() & 0xFF)) % end_us;
+        uint64_t t1 = t0 + a_index_test_rand() % 20000000U;
+        uint64_t first = INDEX_TEST_SAMPLES;
+        uint64_t n = 0;
+        
+        for (i = 0; i < INDEX_TEST_SAMPLES; i++)
+        {
+            if ((gs_reader.samples[i].time_us >= t0) && (gs_reader.samples[i].time_us < t1))
+            {
+                first = (n == 0) ? i : first;
+                n++;
+            }
+        }
+        if ((qmc5883l_index_range(&gs_reader, t0, t1, &samples, &count) != 0) || (count != n) ||
+            ((n != 0) && (samples != gs_reader.samples + first)))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: range check error.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* time the queries, the sum keeps the loop alive */
+    sum = 0;
+    start = clock();
+    for (q = 0; q < INDEX_TEST_QUERIES; q++)
+    {
+        uint64_t t0 = ((uint64_t)q * 7919U * 1000U) % end_us;
+        
+        (void)qmc5883l_index_range(&gs_reader, t0, t0 + 1000000U, &samples, &count);
+        sum += count;
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    qmc5883l_interface_debug_print("qmc5883l: %d range queries at %.1fns each, %.1f samples per query.\n",
+                                   INDEX_TEST_QUERIES, seconds * 1e9 / INDEX_TEST_QUERIES, (double)sum / INDEX_TEST_QUERIES);
+    
+    return 0;
+}
+
+/**
+ * @brief  check threshold queries against a linear scan
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   none
+ */
+static uint8_t a_index_test_find(void)
+{
+    uint64_t skipped;
+    uint64_t searched;
+    uint64_t pos;
+    uint64_t i;
+    uint32_t hits;
+    double ratio;
+    
+    skipped = 0;
+    searched = 0;
+    hits = 0;
+    pos = 0;
+    i = 0;
+    while (1)
+    {
+        if (qmc5883l_index_find(&gs_reader, 0, -INDEX_TEST_BAND, INDEX_TEST_BAND, i, &pos) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: find check error.\n");
+            
+            return 1;
+        }
+        skipped += gs_reader.skipped;
+        searched += ((pos < INDEX_TEST_SAMPLES) ? pos : (INDEX_TEST_SAMPLES - 1)) / QMC5883L_INDEX_BLOCK_SAMPLES -
+                    i / QMC5883L_INDEX_BLOCK_SAMPLES + 1;
+        
+        /* the linear scan must agree */
+        for (; i < pos; i++)
+        {
+            if ((gs_reader.samples[i].raw[0] < -INDEX_TEST_BAND) || (gs_reader.samples[i].raw[0] > INDEX_TEST_BAND))
+            {
+                qmc5883l_interface_debug_print("qmc5883l: find missed a sample check error.\n");
+                
+                return 1;
+            }
+        }
+        if (pos >= INDEX_TEST_SAMPLES)
+        {
+            break;
+        }
+        if ((pos % INDEX_TEST_SPIKE_EVERY) != INDEX_TEST_SPIKE_EVERY / 2)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: find position check error.\n");
+            
+            return 1;
+        }
+        hits++;
+        i = pos + 1;
+    }
+    ratio = (searched != 0) ? (double)skipped / searched : 0.0;
+    qmc5883l_interface_debug_print("qmc5883l: %d spikes found, %.1f%% of the blocks skipped.\n", (int)hits, ratio * 100.0);
+    if ((hits != (INDEX_TEST_SAMPLES - INDEX_TEST_SPIKE_EVERY / 2 - 1) / INDEX_TEST_SPIKE_EVERY + 1) || (ratio < INDEX_TEST_MIN_SKIP))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: skip check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check that corrupted blocks are rejected
+ * @param[in] index_offset is the byte offset of the block index
+ * @param[in] blocks is the number of blocks
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      each case patches one block, tries to open the file and restores the block
+ */
+static uint8_t a_index_test_corrupt(uint64_t index_offset, uint64_t blocks)
+{
+    qmc5883l_index_block_t good[2];
+    qmc5883l_index_block_t bad;
+    uint8_t res;
+    uint8_t c;
+    long pos;
+    FILE *fp;
+    
+    fp = fopen(INDEX_TEST_PATH, "r+b");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    res = 0;
+    for (c = 0; (res == 0) && (c < 6); c++)
+    {
+        /* the last block for the length case, the second block for the others */
+        pos = (long)(index_offset + ((c == 3) ? (blocks - 1) : 1) * sizeof(qmc5883l_index_block_t));
+        if ((fseek(fp, pos - (long)sizeof(qmc5883l_index_block_t), SEEK_SET) != 0) ||
+            (fread(good, sizeof(qmc5883l_index_block_t), 2, fp) != 2))
+        {
+            res = 1;
+            
+            break;
+        }
+        bad = good[1];
+        switch (c)
+        {
+            case 0 :
+            {
+                bad.count = 0;
+                
+                break;
+            }
+            case 1 :
+            {
+                bad.count = QMC5883L_INDEX_BLOCK_SAMPLES + 1;
+                
+                break;
+            }
+            case 2 :
+            {
+                bad.first += 1;
+                
+                break;
+            }
+            case 3 :
+            {
+                bad.count = QMC5883L_INDEX_BLOCK_SAMPLES;
+                
+                break;
+            }
+            case 4 :
+            {
+                bad.first_us = bad.last_us + 1;
+                
+                break;
+            }
+            default :
+            {
+                bad.first_us = good[0].first_us;
+                bad.last_us = good[0].last_us - 1;
+                
+                break;
+            }
+        }
+        if ((fseek(fp, pos, SEEK_SET) != 0) || (fwrite(&bad, sizeof(qmc5883l_index_block_t), 1, fp) != 1) ||
+            (fflush(fp) != 0))
+        {
+            res = 1;
+            
+            break;
+        }
+        if (qmc5883l_index_open(&gs_reader, INDEX_TEST_PATH) != 1)
+        {
+            (void)qmc5883l_index_close(&gs_reader);
+            qmc5883l_interface_debug_print("qmc5883l: corrupted block %d accepted, block check error.\n", c);
+            res = 1;
+        }
+        if ((fseek(fp, pos, SEEK_SET) != 0) || (fwrite(&good[1], sizeof(qmc5883l_index_block_t), 1, fp) != 1) ||
+            (fflush(fp) != 0))
+        {
+            res = 1;
+        }
+    }
+    (void)fclose(fp);
+    if ((res == 0) && (qmc5883l_index_open(&gs_reader, INDEX_TEST_PATH) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: restored file rejected, block check error.\n");
+        res = 1;
+    }
+    (void)qmc5883l_index_close(&gs_reader);
+    
+    return res;
+}
+
+/**
+ * @brief  wait for the next sample
+ * @return status code
+ *         - 0 success
+ *         - 1 wait failed
+ * @note   none
+ */
+static uint8_t a_index_test_wait(void)
+{
+    uint8_t status;
+    uint8_t i;
+    
+    for (i = 0; i < INDEX_TEST_POLL_TRIES; i++)
+    {
+        if (qmc5883l_get_status(&gs_handle, &status) != 0)
+        {
+            return 1;
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)
+        {
+            return 0;
+        }
+        qmc5883l_interface_delay_ms(INDEX_TEST_POLL_MS);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     index test
+ * @param[in] times is the number of logged chip samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the index file is written into the working directory and removed afterwards
+ */
+uint8_t qmc5883l_index_test(uint32_t times)
+{
+    const qmc5883l_index_sample_t *samples;
+    const int16_t zero[3] = {0, 0, 0};
+    uint64_t count;
+    uint64_t pos;
+    uint64_t index_offset;
+    uint64_t blocks;
+    uint32_t i;
+    uint8_t res;
+    float m_gauss[3];
+    double seconds;
+    clock_t start;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start index test */
+    qmc5883l_interface_debug_print("qmc5883l: start index test.\n");
+    
+    /* param limits */
+    memset(&gs_writer, 0, sizeof(gs_writer));
+    memset(&gs_reader, 0, sizeof(gs_reader));
+    if ((qmc5883l_index_create(&gs_writer, NULL, QMC5883L_INDEX_BLOCK_SAMPLES) != 2) ||
+        (qmc5883l_index_create(&gs_writer, INDEX_TEST_PATH, 0) != 4) ||
+        (qmc5883l_index_append(&gs_writer, 0, zero) != 3) ||
+        (qmc5883l_index_finish(&gs_writer) != 3) ||
+        (qmc5883l_index_range(&gs_reader, 0, 1, &samples, &count) != 3) ||
+        (qmc5883l_index_find(&gs_reader, 0, 0, 0, 0, &pos) != 3) ||
+        (qmc5883l_index_close(&gs_reader) != 3))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: index limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* synthetic file */
+    start = clock();
+    res = a_index_test_write();
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    if ((res != 0) || (qmc5883l_index_open(&gs_reader, INDEX_TEST_PATH) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: index file failed.\n");
+        (void)remove(INDEX_TEST_PATH);
+        
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: %d samples in %d blocks, %.1f MB written in %.3fs.\n",
+                                   (int)gs_reader.header->samples, (int)gs_reader.header->blocks,
+                                   gs_reader.size / 1048576.0, seconds);
+    if ((gs_reader.header->samples != INDEX_TEST_SAMPLES) || (qmc5883l_index_find(&gs_reader, 3, 0, 0, 0, &pos) != 4) ||
+        (a_index_test_ranges() != 0) || (a_index_test_find() != 0))
+    {
+        (void)qmc5883l_index_close(&gs_reader);
+        (void)remove(INDEX_TEST_PATH);
+        
+        return 1;
+    }
+    index_offset = gs_reader.header->index_offset;
+    blocks = gs_reader.header->blocks;
+    (void)qmc5883l_index_close(&gs_reader);
+    qmc5883l_interface_debug_print("qmc5883l: ranges and thresholds match a linear scan.\n");
+    
+    /* corrupted blocks */
+    if (a_index_test_corrupt(index_offset, blocks) != 0)
+    {
+        (void)remove(INDEX_TEST_PATH);
+        
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: corrupted blocks are rejected.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+        (void)remove(INDEX_TEST_PATH);
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        (void)remove(INDEX_TEST_PATH);
+        
+        return 1;
+    }
+    
+    /* log the chip */
+    times = (times > INDEX_TEST_CHIP_MAX) ? INDEX_TEST_CHIP_MAX : times;
+    if (qmc5883l_index_create(&gs_writer, INDEX_TEST_PATH, 64) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: index file failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < times; i++)
+    {
+        res = a_index_test_wait();
+        if (res == 0)
+        {
+            res = qmc5883l_read(&gs_handle, gs_raw[i], m_gauss);
+        }
+        if ((res != 0) || (qmc5883l_index_append(&gs_writer, (uint64_t)i * INDEX_TEST_PERIOD_US, gs_raw[i]) != 0))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            (void)qmc5883l_index_finish(&gs_writer);
+            (void)remove(INDEX_TEST_PATH);
+            
+            return 1;
+        }
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    if ((qmc5883l_index_finish(&gs_writer) != 0) || (qmc5883l_index_open(&gs_reader, INDEX_TEST_PATH) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: index file failed.\n");
+        (void)remove(INDEX_TEST_PATH);
+        
+        return 1;
+    }
+    
+    /* the middle half comes back in place */
+    res = qmc5883l_index_range(&gs_reader, (uint64_t)(times / 4) * INDEX_TEST_PERIOD_US,
+                               (uint64_t)(times / 4 + times / 2) * INDEX_TEST_PERIOD_US, &samples, &count);
+    if ((res != 0) || (count != times / 2))
+    {
+        res = 1;
+    }
+    for (i = 0; (res == 0) && (i < count); i++)
+    {
+        if (memcmp(samples[i].raw, gs_raw[times / 4 + i], sizeof(samples[i].raw)) != 0)
+        {
+            res = 1;
+        }
+    }
+    (void)qmc5883l_index_close(&gs_reader);
+    (void)remove(INDEX_TEST_PATH);
+    qmc5883l_interface_debug_print("qmc5883l: %d chip samples indexed, %d in the middle window.\n", (int)times, (int)count);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: chip window check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish index test */
+    qmc5883l_interface_debug_print("qmc5883l: finish index test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,304 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_mains_test.c
+ * @brief     driver qmc5883l mains test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_mains_test.h"
+#include <math.h>
+#include <time.h>
+
+/**
+ * @brief mains test definition
+ */
+#define MAINS_TEST_RATE_HZ          200.0f        /**< output data rate */
+#define MAINS_TEST_MAINS_HZ         60.0f         /**< mains frequency */
+#define MAINS_TEST_HARMONICS        3             /**< 60Hz, 120Hz and 180Hz */
+#define MAINS_TEST_BLOCK            200           /**< 1Hz bins */
+#define MAINS_TEST_WIDTH_HZ         2.0f          /**< notch width */
+#define MAINS_TEST_POLL_MS          1             /**< data ready poll period */
+#define MAINS_TEST_POLL_TRIES       100           /**< data ready polls before timeout */
+
+static qmc5883l_handle_t gs_handle;               /**< qmc5883l handle */
+static qmc5883l_mains_t gs_mains;                 /**< detector and notch */
+static qmc5883l_mains_t gs_residual;              /**< detector after the notch */
+
+/**
+ * @brief  check the estimates and the notch on known tones
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   none
+ */
+static uint8_t a_mains_test_tones(void)
+{
+    const double pi = 3.14159265358979323846;
+    const float dc[3] = {300.0f, -150.0f, 400.0f};
+    const float expect[3][3] = {{5.0f, 0.0f, 0.0f}, {0.0f, 3.0f, 0.0f}, {2.0f, 0.0f, 0.0f}};
+    float amplitude[QMC5883L_MAINS_MAX_TONES][3];
+    float freq[QMC5883L_MAINS_MAX_TONES];
+    float in[3];
+    float out[3];
+    float dev;
+    uint32_t n;
+    uint8_t tones;
+    uint8_t ready;
+    uint8_t t;
+    uint8_t k;
+    clock_t start;
+    
+    /* 60Hz, 120Hz and 180Hz fold to 60Hz, 80Hz and 20Hz */
+    (void)qmc5883l_mains_init(&gs_mains, MAINS_TEST_RATE_HZ, MAINS_TEST_MAINS_HZ, MAINS_TEST_HARMONICS,
+                              MAINS_TEST_BLOCK, MAINS_TEST_WIDTH_HZ);
+    (void)qmc5883l_mains_get_tones(&gs_mains, freq, &tones);
+    if ((tones != 3) || (fabsf(freq[0] - 60.0f) > 0.01f) || (fabsf(freq[1] - 80.0f) > 0.01f) || (fabsf(freq[2] - 20.0f) > 0.01f))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: tone folding check error.\n");
+        
+        return 1;
+    }
+    
+    /* x carries 60Hz and 180Hz, y carries 120Hz */
+    dev = 0.0f;
+    start = clock();
+    for (n = 0; n < 5 * MAINS_TEST_BLOCK; n++)
+    {
+        double t_s;
+        
+        t_s = (double)n / MAINS_TEST_RATE_HZ;
+        in[0] = dc[0] + (float)(5.0 * sin(2.0 * pi * 60.0 * t_s + 0.3) + 2.0 * cos(2.0 * pi * 180.0 * t_s));
+        in[1] = dc[1] + (float)(3.0 * sin(2.0 * pi * 120.0 * t_s + 1.1));
+        in[2] = dc[2];
+        (void)qmc5883l_mains_push(&gs_mains, in, out, &ready);
+        if (n >= 4 * MAINS_TEST_BLOCK)
+        {
+            for (k = 0; k < 3; k++)
+            {
+                dev = (fabsf(out[k] - dc[k]) > dev) ? fabsf(out[k] - dc[k]) : dev;
+            }
+        }
+    }
+    qmc5883l_interface_debug_print("qmc5883l: %.1f ns per sample with 3 tones and the notch.\n",
+                                   (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (5.0 * MAINS_TEST_BLOCK));
+    (void)qmc5883l_mains_get_amplitude(&gs_mains, amplitude);
+    for (t = 0; t < 3; t++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            if (fabsf(amplitude[t][k] - expect[t][k]) > 0.02f)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: tone %d axis %d amplitude %.3f check error.\n", t, k, amplitude[t][k]);
+                
+                return 1;
+            }
+        }
+    }
+    if (dev > 0.02f)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: notch residual %.3f mgauss check error.\n", dev);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  wait for the next sample
+ * @return status code
+ *         - 0 success
+ *         - 1 wait failed
+ * @note   a fixed delay drifts against the chip clock and skips samples, which breaks the tone phase
+ */
+static uint8_t a_mains_test_wait(void)
+{
+    uint8_t status;
+    uint8_t i;
+    
+    for (i = 0; i < MAINS_TEST_POLL_TRIES; i++)
+    {
+        if (qmc5883l_get_status(&gs_handle, &status) != 0)
+        {
+            return 1;
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)
+        {
+            return 0;
+        }
+        qmc5883l_interface_delay_ms(MAINS_TEST_POLL_MS);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     mains test
+ * @param[in] times is the number of read samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sensor must be kept still, interference near the mains frequency is measured and removed
+ */
+uint8_t qmc5883l_mains_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t t;
+    uint8_t k;
+    uint8_t tones;
+    uint8_t ready;
+    uint32_t i;
+    int16_t raw[3];
+    float m_gauss[3];
+    float out[3];
+    float freq[QMC5883L_MAINS_MAX_TONES];
+    float before[QMC5883L_MAINS_MAX_TONES][3];
+    float after[QMC5883L_MAINS_MAX_TONES][3];
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start mains test */
+    qmc5883l_interface_debug_print("qmc5883l: start mains test.\n");
+    
+    /* param limits, 200Hz folds every 50Hz harmonic after the second onto dc or 50Hz */
+    if ((qmc5883l_mains_init(&gs_mains, MAINS_TEST_RATE_HZ, 200.0f, 1, MAINS_TEST_BLOCK, 0.0f) != 4) ||
+        (qmc5883l_mains_init(&gs_mains, MAINS_TEST_RATE_HZ, MAINS_TEST_MAINS_HZ, 0, MAINS_TEST_BLOCK, 0.0f) != 4) ||
+        (qmc5883l_mains_init(&gs_mains, MAINS_TEST_RATE_HZ, MAINS_TEST_MAINS_HZ, 1, 8, 0.0f) != 4) ||
+        (qmc5883l_mains_init(&gs_mains, MAINS_TEST_RATE_HZ, MAINS_TEST_MAINS_HZ, 1, MAINS_TEST_BLOCK, 50.0f) != 4) ||
+        (qmc5883l_mains_init(&gs_mains, MAINS_TEST_RATE_HZ, 50.0f, 4, MAINS_TEST_BLOCK, 0.0f) != 0) ||
+        (qmc5883l_mains_push(&gs_mains, NULL, out, &ready) != 2) ||
+        (qmc5883l_mains_push(&gs_mains, m_gauss, NULL, &ready) != 2) ||
+        (qmc5883l_mains_push(&gs_mains, m_gauss, out, NULL) != 2))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: mains limit check error.\n");
+        
+        return 1;
+    }
+    (void)qmc5883l_mains_get_tones(&gs_mains, freq, &tones);
+    if ((tones != 2) || (fabsf(freq[0] - 50.0f) > 0.01f) || (fabsf(freq[1] - 100.0f) > 0.01f))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: 50Hz folding check error.\n");
+        
+        return 1;
+    }
+    
+    /* known tones */
+    res = a_mains_test_tones();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: known tones are measured and removed.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* measure before and after the notch */
+    (void)qmc5883l_mains_init(&gs_mains, MAINS_TEST_RATE_HZ, MAINS_TEST_MAINS_HZ, MAINS_TEST_HARMONICS,
+                              MAINS_TEST_BLOCK, MAINS_TEST_WIDTH_HZ);
+    (void)qmc5883l_mains_init(&gs_residual, MAINS_TEST_RATE_HZ, MAINS_TEST_MAINS_HZ, MAINS_TEST_HARMONICS,
+                              MAINS_TEST_BLOCK, 0.0f);
+    for (i = 0; i < times; i++)
+    {
+        uint8_t ready;
+        
+        res = a_mains_test_wait();
+        if (res == 0)
+        {
+            res = qmc5883l_read(&gs_handle, raw, m_gauss);
+        }
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (void)qmc5883l_mains_push(&gs_mains, m_gauss, m_gauss, &ready);
+        (void)qmc5883l_mains_push(&gs_residual, m_gauss, m_gauss, &ready);
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    if ((qmc5883l_mains_get_amplitude(&gs_mains, before) != 0) || (qmc5883l_mains_get_amplitude(&gs_residual, after) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: no finished block, run more than %d samples.\n", MAINS_TEST_BLOCK);
+        
+        return 1;
+    }
+    
+    /* the notch must remove what the detector sees */
+    (void)qmc5883l_mains_get_tones(&gs_mains, freq, &tones);
+    for (t = 0; t < tones; t++)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: %.0fHz amplitude %.2f %.2f %.2f mgauss, after the notch %.2f %.2f %.2f mgauss.\n",
+                                       freq[t], before[t][0], before[t][1], before[t][2], after[t][0], after[t][1], after[t][2]);
+        for (k = 0; k < 3; k++)
+        {
+            if (after[t][k] > 0.1f * before[t][k] + 0.5f)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: notch attenuation check error.\n");
+                
+                return 1;
+            }
+        }
+    }
+    
+    /* finish mains test */
+    qmc5883l_interface_debug_print("qmc5883l: finish mains test.\n");
+    
+    return 0;
+}
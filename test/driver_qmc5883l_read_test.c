@@ -246,6 +246,50 @@ uint8_t qmc5883l_read_test(uint32_t times)
         qmc5883l_interface_debug_print("qmc5883l: temperature %.2fC.\n", deg + 30.0f);
     }
     
+    /* set over sample 64 */
+    res = qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_64);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set over sample failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* output */
+    qmc5883l_interface_debug_print("qmc5883l: over sample 64 scale test.\n");
+    
+    /* delay 1 s*/
+    qmc5883l_interface_delay_ms(1000);
+    
+    /* read */
+    res = qmc5883l_read(&gs_handle, (int16_t *)raw, m_gauss);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the over sample bits must not change the 8gauss scale */
+    for (i = 0; i < 3; i++)
+    {
+        float diff;
+        
+        diff = m_gauss[i] - (float)raw[i] * (1000.0f / 3000.0f);
+        if ((diff > 0.01f) || (diff < -0.01f))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: raw %d read as %.2f m_gauss, scale check error.\n", raw[i], m_gauss[i]);
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    qmc5883l_interface_debug_print("qmc5883l: read x %.2f m_gauss.\n", m_gauss[0]);
+    qmc5883l_interface_debug_print("qmc5883l: read y %.2f m_gauss.\n", m_gauss[1]);
+    qmc5883l_interface_debug_print("qmc5883l: read z %.2f m_gauss.\n", m_gauss[2]);
+    
     /* finish read test */
     qmc5883l_interface_debug_print("qmc5883l: finish read test.\n");
     (void)qmc5883l_deinit(&gs_handle);
@@ -0,0 +1,729 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_record.c
+ * @brief     driver qmc5883l record source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_record.h"
+
+/**
+ * @brief record file format definition
+ */
+#define RECORD_MAGIC              "QMCR"        /**< file magic */
+#define RECORD_VERSION            0x01          /**< file version */
+#define RECORD_TYPE_READ          0x00          /**< iic read event */
+#define RECORD_TYPE_WRITE         0x01          /**< iic write event */
+#define RECORD_TYPE_DELAY         0x02          /**< delay event */
+#define RECORD_TYPE_CONTROL       0x03          /**< iic init or deinit event */
+#define RECORD_FLAG_FAILED        (1 << 2)      /**< callback returned an error */
+#define RECORD_FLAG_DEINIT        (1 << 3)      /**< control event is a deinit */
+
+/**
+ * @brief record event structure definition
+ */
+typedef struct record_event_s
+{
+    uint8_t tag;                                 /**< type and flags */
+    uint64_t delta_us;                           /**< time since the previous event */
+    uint8_t addr;                                /**< iic address */
+    uint8_t reg;                                 /**< iic register */
+    uint32_t len;                                /**< transfer length or delay ms */
+    uint8_t data[QMC5883L_RECORD_MAX_LEN];       /**< transfer data */
+} record_event_t;
+
+/**
+ * @brief record state structure definition
+ */
+typedef struct record_s
+{
+    FILE *fp;                                    /**< record file */
+    uint64_t (*timestamp_us)(void);              /**< clock function */
+    uint64_t last_us;                            /**< timestamp of the previous event */
+    uint64_t pending_us;                         /**< delay time since the previous event */
+    uint8_t error;                               /**< file write error flag */
+} record_t;
+
+/**
+ * @brief replay state structure definition
+ */
+typedef struct replay_s
+{
+    FILE *fp;                                    /**< replay file */
+    qmc5883l_replay_mode_t mode;                 /**< replay mode */
+    record_event_t event;                        /**< next event */
+    uint8_t valid;                               /**< next event is parsed */
+    uint64_t wait_us;                            /**< realtime sleep remainder */
+    qmc5883l_replay_stats_t stats;               /**< replay statistics */
+} replay_t;
+
+static record_t gs_record;        /**< record state */
+static replay_t gs_replay;        /**< replay state */
+
+/**
+ * @brief     write a varint into the record file
+ * @param[in] value is the written value
+ * @note      none
+ */
+static void a_record_put_varint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        if (fputc((int)((value & 0x7F) | 0x80), gs_record.fp) == EOF)
+        {
+            gs_record.error = 1;
+        }
+        value >>= 7;
+    }
+    if (fputc((int)value, gs_record.fp) == EOF)
+    {
+        gs_record.error = 1;
+    }
+}
+
+/**
+ * @brief     write an event header into the record file
+ * @param[in] tag is the event type and flags
+ * @note      none
+ */
+static void a_record_put_event(uint8_t tag)
+{
+    uint64_t delta;
+    
+    /* get the time since the previous event */
+    if (gs_record.timestamp_us != NULL)
+    {
+        uint64_t now;
+        
+        now = gs_record.timestamp_us();
+        delta = now - gs_record.last_us;
+        gs_record.last_us = now;
+    }
+    else
+    {
+        delta = gs_record.pending_us;
+    }
+    gs_record.pending_us = 0;
+    
+    if (fputc(tag, gs_record.fp) == EOF)
+    {
+        gs_record.error = 1;
+    }
+    a_record_put_varint(delta);
+}
+
+/**
+ * @brief     write a transfer event into the record file
+ * @param[in] type is the event type
+ * @param[in] res is the callback result
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @note      the data of a failed read is not stored
+ */
+static void a_record_put_transfer(uint8_t type, uint8_t res, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t store;
+    
+    if (gs_record.fp == NULL)
+    {
+        return;
+    }
+    
+    store = ((type == RECORD_TYPE_WRITE) || (res == 0)) ? 1 : 0;
+    a_record_put_event((uint8_t)(type | ((res != 0) ? RECORD_FLAG_FAILED : 0)));
+    if ((fputc(addr, gs_record.fp) == EOF) || (fputc(reg, gs_record.fp) == EOF))
+    {
+        gs_record.error = 1;
+    }
+    a_record_put_varint(len);
+    if ((store != 0) && (len != 0))
+    {
+        if (fwrite(buf, 1, len, gs_record.fp) != len)
+        {
+            gs_record.error = 1;
+        }
+    }
+}
+
+/**
+ * @brief     start recording the interface transfers into a file
+ * @param[in] *path points to a file path
+ * @param[in] *timestamp_us points to a monotonic microsecond clock function, NULL to derive time from delay_ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 open file failed
+ *            - 2 path is NULL
+ * @note      link qmc5883l_record_* with DRIVER_QMC5883L_LINK_* to record a run,
+ *            the transfers are forwarded to qmc5883l_interface_*
+ */
+uint8_t qmc5883l_record_start(const char *path, uint64_t (*timestamp_us)(void))
+{
+    if (path == NULL)
+    {
+        return 2;
+    }
+    if (gs_record.fp != NULL)
+    {
+        (void)qmc5883l_record_stop();
+    }
+    
+    memset(&gs_record, 0, sizeof(record_t));
+    gs_record.fp = fopen(path, "wb");
+    if (gs_record.fp == NULL)
+    {
+        return 1;
+    }
+    gs_record.timestamp_us = timestamp_us;
+    if (timestamp_us != NULL)
+    {
+        gs_record.last_us = timestamp_us();
+    }
+    if ((fwrite(RECORD_MAGIC, 1, 4, gs_record.fp) != 4) || (fputc(RECORD_VERSION, gs_record.fp) == EOF))
+    {
+        (void)fclose(gs_record.fp);
+        gs_record.fp = NULL;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  stop recording and close the file
+ * @return status code
+ *         - 0 success
+ *         - 1 write or close file failed
+ * @note   none
+ */
+uint8_t qmc5883l_record_stop(void)
+{
+    uint8_t res;
+    
+    if (gs_record.fp == NULL)
+    {
+        return 0;
+    }
+    
+    res = gs_record.error;
+    if (fclose(gs_record.fp) != 0)
+    {
+        res = 1;
+    }
+    gs_record.fp = NULL;
+    
+    return res;
+}
+
+/**
+ * @brief  record iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t qmc5883l_record_iic_init(void)
+{
+    uint8_t res;
+    
+    res = qmc5883l_interface_iic_init();
+    if (gs_record.fp != NULL)
+    {
+        a_record_put_event((uint8_t)(RECORD_TYPE_CONTROL | ((res != 0) ? RECORD_FLAG_FAILED : 0)));
+    }
+    
+    return res;
+}
+
+/**
+ * @brief  record iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t qmc5883l_record_iic_deinit(void)
+{
+    uint8_t res;
+    
+    res = qmc5883l_interface_iic_deinit();
+    if (gs_record.fp != NULL)
+    {
+        a_record_put_event((uint8_t)(RECORD_TYPE_CONTROL | RECORD_FLAG_DEINIT | ((res != 0) ? RECORD_FLAG_FAILED : 0)));
+    }
+    
+    return res;
+}
+
+/**
+ * @brief      record iic bus read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 len is over QMC5883L_RECORD_MAX_LEN
+ * @note       none
+ */
+uint8_t qmc5883l_record_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (len > QMC5883L_RECORD_MAX_LEN)
+    {
+        return 4;
+    }
+    res = qmc5883l_interface_iic_read(addr, reg, buf, len);
+    a_record_put_transfer(RECORD_TYPE_READ, res, addr, reg, buf, len);
+    
+    return res;
+}
+
+/**
+ * @brief     record iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 4 len is over QMC5883L_RECORD_MAX_LEN
+ * @note      none
+ */
+uint8_t qmc5883l_record_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (len > QMC5883L_RECORD_MAX_LEN)
+    {
+        return 4;
+    }
+    res = qmc5883l_interface_iic_write(addr, reg, buf, len);
+    a_record_put_transfer(RECORD_TYPE_WRITE, res, addr, reg, buf, len);
+    
+    return res;
+}
+
+/**
+ * @brief     record delay ms
+ * @param[in] ms
+ * @note      none
+ */
+void qmc5883l_record_delay_ms(uint32_t ms)
+{
+    qmc5883l_interface_delay_ms(ms);
+    if (gs_record.fp != NULL)
+    {
+        a_record_put_event(RECORD_TYPE_DELAY);
+        a_record_put_varint(ms);
+        gs_record.pending_us = (uint64_t)ms * 1000;
+    }
+}
+
+/**
+ * @brief      read a varint from the replay file
+ * @param[out] *value points to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_replay_get_varint(uint64_t *value)
+{
+    uint8_t shift;
+    int c;
+    
+    *value = 0;
+    for (shift = 0; shift < 64; shift += 7)
+    {
+        c = fgetc(gs_replay.fp);
+        if (c == EOF)
+        {
+            return 1;
+        }
+        *value |= (uint64_t)(c & 0x7F) << shift;
+        if ((c & 0x80) == 0)
+        {
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief  parse the next event of the replay file
+ * @return status code
+ *         - 0 success
+ *         - 1 end of file or parse failed
+ * @note   none
+ */
+static uint8_t a_replay_peek(void)
+{
+    record_event_t *e = &gs_replay.event;
+    uint64_t value;
+    int c;
+    
+    if (gs_replay.valid != 0)
+    {
+        return 0;
+    }
+    if ((gs_replay.fp == NULL) || (gs_replay.stats.finished != 0))
+    {
+        return 1;
+    }
+    
+    c = fgetc(gs_replay.fp);
+    if (c == EOF)
+    {
+        gs_replay.stats.finished = 1;
+        
+        return 1;
+    }
+    e->tag = (uint8_t)c;
+    if (a_replay_get_varint(&e->delta_us) != 0)
+    {
+        gs_replay.stats.finished = 1;
+        
+        return 1;
+    }
+    e->len = 0;
+    switch (e->tag & 0x03)
+    {
+        case RECORD_TYPE_READ :
+        case RECORD_TYPE_WRITE :
+        {
+            int addr;
+            int reg;
+            
+            addr = fgetc(gs_replay.fp);
+            reg = fgetc(gs_replay.fp);
+            if ((addr == EOF) || (reg == EOF) || (a_replay_get_varint(&value) != 0) ||
+                (value > QMC5883L_RECORD_MAX_LEN))
+            {
+                gs_replay.stats.finished = 1;
+                
+                return 1;
+            }
+            e->addr = (uint8_t)addr;
+            e->reg = (uint8_t)reg;
+            e->len = (uint32_t)value;
+            if ((((e->tag & 0x03) == RECORD_TYPE_WRITE) || ((e->tag & RECORD_FLAG_FAILED) == 0)) && (e->len != 0))
+            {
+                if (fread(e->data, 1, e->len, gs_replay.fp) != e->len)
+                {
+                    gs_replay.stats.finished = 1;
+                    
+                    return 1;
+                }
+            }
+            
+            break;
+        }
+        case RECORD_TYPE_DELAY :
+        {
+            if (a_replay_get_varint(&value) != 0)
+            {
+                gs_replay.stats.finished = 1;
+                
+                return 1;
+            }
+            e->len = (uint32_t)value;
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+    gs_replay.valid = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief consume the parsed event and reproduce its timing
+ * @note  none
+ */
+static void a_replay_consume(void)
+{
+    gs_replay.valid = 0;
+    gs_replay.stats.events++;
+    gs_replay.stats.elapsed_us += gs_replay.event.delta_us;
+    if (gs_replay.mode == QMC5883L_REPLAY_MODE_REALTIME)
+    {
+        gs_replay.wait_us += gs_replay.event.delta_us;
+        if (gs_replay.wait_us >= 1000)
+        {
+            qmc5883l_interface_delay_ms((uint32_t)(gs_replay.wait_us / 1000));
+            gs_replay.wait_us %= 1000;
+        }
+    }
+}
+
+/**
+ * @brief     open a record file for replay
+ * @param[in] *path points to a file path
+ * @param[in] mode is the replay mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 open file failed
+ *            - 2 path is NULL
+ *            - 4 file format is invalid
+ * @note      link qmc5883l_replay_* with DRIVER_QMC5883L_LINK_* to replay a run,
+ *            realtime mode sleeps with qmc5883l_interface_delay_ms
+ */
+uint8_t qmc5883l_replay_open(const char *path, qmc5883l_replay_mode_t mode)
+{
+    uint8_t header[5];
+    
+    if (path == NULL)
+    {
+        return 2;
+    }
+    if (gs_replay.fp != NULL)
+    {
+        (void)qmc5883l_replay_close();
+    }
+    
+    memset(&gs_replay, 0, sizeof(replay_t));
+    gs_replay.fp = fopen(path, "rb");
+    if (gs_replay.fp == NULL)
+    {
+        return 1;
+    }
+    if ((fread(header, 1, 5, gs_replay.fp) != 5) || (memcmp(header, RECORD_MAGIC, 4) != 0) ||
+        (header[4] != RECORD_VERSION))
+    {
+        (void)fclose(gs_replay.fp);
+        gs_replay.fp = NULL;
+        
+        return 4;
+    }
+    gs_replay.mode = mode;
+    
+    return 0;
+}
+
+/**
+ * @brief  close the replay file
+ * @return status code
+ *         - 0 success
+ *         - 1 close file failed
+ * @note   none
+ */
+uint8_t qmc5883l_replay_close(void)
+{
+    uint8_t res;
+    
+    if (gs_replay.fp == NULL)
+    {
+        return 0;
+    }
+    
+    res = (fclose(gs_replay.fp) != 0) ? 1 : 0;
+    gs_replay.fp = NULL;
+    gs_replay.valid = 0;
+    
+    return res;
+}
+
+/**
+ * @brief      get the replay statistics
+ * @param[out] *stats points to a replay stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_replay_get_stats(qmc5883l_replay_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return 2;
+    }
+    
+    *stats = gs_replay.stats;
+    
+    return 0;
+}
+
+/**
+ * @brief     replay a control event
+ * @param[in] deinit is the expected control kind
+ * @return    status code
+ *            - 0 success
+ *            - 1 failed
+ * @note      none
+ */
+static uint8_t a_replay_control(uint8_t deinit)
+{
+    uint8_t res;
+    
+    if (a_replay_peek() != 0)
+    {
+        return 1;
+    }
+    if (((gs_replay.event.tag & 0x03) != RECORD_TYPE_CONTROL) ||
+        (((gs_replay.event.tag & RECORD_FLAG_DEINIT) != 0 ? 1 : 0) != deinit))
+    {
+        gs_replay.stats.mismatches++;
+        
+        return 1;
+    }
+    res = ((gs_replay.event.tag & RECORD_FLAG_FAILED) != 0) ? 1 : 0;
+    a_replay_consume();
+    
+    return res;
+}
+
+/**
+ * @brief  replay iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t qmc5883l_replay_iic_init(void)
+{
+    return a_replay_control(0);
+}
+
+/**
+ * @brief  replay iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t qmc5883l_replay_iic_deinit(void)
+{
+    return a_replay_control(1);
+}
+
+/**
+ * @brief      replay iic bus read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a read which does not match the next recorded transfer fails
+ */
+uint8_t qmc5883l_replay_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    record_event_t *e = &gs_replay.event;
+    uint8_t res;
+    
+    if (a_replay_peek() != 0)
+    {
+        return 1;
+    }
+    if (((e->tag & 0x03) != RECORD_TYPE_READ) || (e->addr != addr) || (e->reg != reg) || (e->len != len))
+    {
+        gs_replay.stats.mismatches++;
+        
+        return 1;
+    }
+    res = ((e->tag & RECORD_FLAG_FAILED) != 0) ? 1 : 0;
+    if (res == 0)
+    {
+        memcpy(buf, e->data, len);
+    }
+    a_replay_consume();
+    
+    return res;
+}
+
+/**
+ * @brief     replay iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a write to another register than recorded fails,
+ *            different data is accepted and counted as a mismatch
+ */
+uint8_t qmc5883l_replay_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    record_event_t *e = &gs_replay.event;
+    uint8_t res;
+    
+    if (a_replay_peek() != 0)
+    {
+        return 1;
+    }
+    if (((e->tag & 0x03) != RECORD_TYPE_WRITE) || (e->addr != addr) || (e->reg != reg) || (e->len != len))
+    {
+        gs_replay.stats.mismatches++;
+        
+        return 1;
+    }
+    if ((len != 0) && (memcmp(buf, e->data, len) != 0))
+    {
+        gs_replay.stats.mismatches++;
+    }
+    res = ((e->tag & RECORD_FLAG_FAILED) != 0) ? 1 : 0;
+    a_replay_consume();
+    
+    return res;
+}
+
+/**
+ * @brief     replay delay ms
+ * @param[in] ms
+ * @note      the recorded gap is reproduced by the next transfer in realtime mode
+ */
+void qmc5883l_replay_delay_ms(uint32_t ms)
+{
+    (void)ms;
+    
+    if (a_replay_peek() != 0)
+    {
+        return;
+    }
+    if ((gs_replay.event.tag & 0x03) == RECORD_TYPE_DELAY)
+    {
+        a_replay_consume();
+    }
+}
@@ -0,0 +1,248 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_record.h
+ * @brief     driver qmc5883l record header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_RECORD_H
+#define DRIVER_QMC5883L_RECORD_H
+
+#include "driver_qmc5883l_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_record_driver qmc5883l record driver function
+ * @brief    qmc5883l record driver modules
+ * @ingroup  qmc5883l_test_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l record max transfer length definition
+ */
+#ifndef QMC5883L_RECORD_MAX_LEN
+    #define QMC5883L_RECORD_MAX_LEN 256        /**< max bytes of one recorded transfer */
+#endif
+
+/**
+ * @brief qmc5883l replay mode enumeration definition
+ */
+typedef enum
+{
+    QMC5883L_REPLAY_MODE_REALTIME = 0x00,        /**< reproduce the original timing */
+    QMC5883L_REPLAY_MODE_FAST     = 0x01,        /**< replay as fast as possible */
+} qmc5883l_replay_mode_t;
+
+/**
+ * @brief qmc5883l replay statistics structure definition
+ */
+typedef struct qmc5883l_replay_stats_s
+{
+    uint32_t events;            /**< replayed events */
+    uint32_t mismatches;        /**< transfers which differ from the record */
+    uint64_t elapsed_us;        /**< recorded time covered so far */
+    uint8_t finished;           /**< end of record reached */
+} qmc5883l_replay_stats_t;
+
+/**
+ * @brief     start recording the interface transfers into a file
+ * @param[in] *path points to a file path
+ * @param[in] *timestamp_us points to a monotonic microsecond clock function, NULL to derive time from delay_ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 open file failed
+ *            - 2 path is NULL
+ * @note      link qmc5883l_record_* with DRIVER_QMC5883L_LINK_* to record a run,
+ *            the transfers are forwarded to qmc5883l_interface_*
+ */
+uint8_t qmc5883l_record_start(const char *path, uint64_t (*timestamp_us)(void));
+
+/**
+ * @brief  stop recording and close the file
+ * @return status code
+ *         - 0 success
+ *         - 1 write or close file failed
+ * @note   none
+ */
+uint8_t qmc5883l_record_stop(void);
+
+/**
+ * @brief  record iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t qmc5883l_record_iic_init(void);
+
+/**
+ * @brief  record iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t qmc5883l_record_iic_deinit(void);
+
+/**
+ * @brief      record iic bus read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 len is over QMC5883L_RECORD_MAX_LEN
+ * @note       none
+ */
+uint8_t qmc5883l_record_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     record iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 4 len is over QMC5883L_RECORD_MAX_LEN
+ * @note      none
+ */
+uint8_t qmc5883l_record_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     record delay ms
+ * @param[in] ms
+ * @note      none
+ */
+void qmc5883l_record_delay_ms(uint32_t ms);
+
+/**
+ * @brief     open a record file for replay
+ * @param[in] *path points to a file path
+ * @param[in] mode is the replay mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 open file failed
+ *            - 2 path is NULL
+ *            - 4 file format is invalid
+ * @note      link qmc5883l_replay_* with DRIVER_QMC5883L_LINK_* to replay a run,
+ *            realtime mode sleeps with qmc5883l_interface_delay_ms
+ */
+uint8_t qmc5883l_replay_open(const char *path, qmc5883l_replay_mode_t mode);
+
+/**
+ * @brief  close the replay file
+ * @return status code
+ *         - 0 success
+ *         - 1 close file failed
+ * @note   none
+ */
+uint8_t qmc5883l_replay_close(void);
+
+/**
+ * @brief      get the replay statistics
+ * @param[out] *stats points to a replay stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_replay_get_stats(qmc5883l_replay_stats_t *stats);
+
+/**
+ * @brief  replay iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t qmc5883l_replay_iic_init(void);
+
+/**
+ * @brief  replay iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t qmc5883l_replay_iic_deinit(void);
+
+/**
+ * @brief      replay iic bus read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a read which does not match the next recorded transfer fails
+ */
+uint8_t qmc5883l_replay_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     replay iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a write to another register than recorded fails,
+ *            different data is accepted and counted as a mismatch
+ */
+uint8_t qmc5883l_replay_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     replay delay ms
+ * @param[in] ms
+ * @note      the recorded gap is reproduced by the next transfer in realtime mode
+ */
+void qmc5883l_replay_delay_ms(uint32_t ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_record_test.c
+ * @brief     driver qmc5883l record test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_record_test.h"
+
+/**
+ * @brief record test definition
+ */
+#define RECORD_TEST_PATH        "qmc5883l_record_test.bin"        /**< record file */
+#define RECORD_TEST_MAX         1000                              /**< max recorded samples */
+
+static qmc5883l_handle_t gs_handle;                     /**< qmc5883l handle */
+static int16_t gs_raw[RECORD_TEST_MAX][3];              /**< recorded samples */
+
+/**
+ * @brief     run the read sequence
+ * @param[in] times is the number of samples
+ * @param[in] check is 1 to compare with the recorded samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the interface must be linked before
+ */
+static uint8_t a_record_test_run(uint32_t times, uint8_t check)
+{
+    int16_t raw[3];
+    float m_gauss[3];
+    uint32_t i;
+    
+    /* qmc5883l init */
+    if (qmc5883l_init(&gs_handle) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* read */
+    for (i = 0; i < times; i++)
+    {
+        if (qmc5883l_read(&gs_handle, raw, m_gauss) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if (check == 0)
+        {
+            gs_raw[i][0] = raw[0];
+            gs_raw[i][1] = raw[1];
+            gs_raw[i][2] = raw[2];
+        }
+        else if ((raw[0] != gs_raw[i][0]) || (raw[1] != gs_raw[i][1]) || (raw[2] != gs_raw[i][2]))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: sample %d replay check error.\n", (int)i);
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* qmc5883l deinit */
+    if (qmc5883l_deinit(&gs_handle) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: deinit failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     record test
+ * @param[in] times is the number of recorded samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the record file is written into the working directory and removed afterwards
+ */
+uint8_t qmc5883l_record_test(uint32_t times)
+{
+    qmc5883l_replay_stats_t stats[2];
+    uint8_t buf[QMC5883L_RECORD_MAX_LEN + 1];
+    uint8_t mode;
+    
+    /* start record test */
+    qmc5883l_interface_debug_print("qmc5883l: start record test.\n");
+    
+    /* param limits */
+    if ((times == 0) || (times > RECORD_TEST_MAX))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: times must be 1 to %d.\n", RECORD_TEST_MAX);
+        
+        return 1;
+    }
+    memset(buf, 0, sizeof(buf));
+    if ((qmc5883l_record_start(NULL, NULL) != 2) || (qmc5883l_replay_open(NULL, QMC5883L_REPLAY_MODE_FAST) != 2) ||
+        (qmc5883l_replay_get_stats(NULL) != 2) ||
+        (qmc5883l_record_iic_read(0x1A, 0x00, buf, QMC5883L_RECORD_MAX_LEN + 1) != 4) ||
+        (qmc5883l_record_iic_write(0x1A, 0x00, buf, QMC5883L_RECORD_MAX_LEN + 1) != 4))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: record limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* record a read run */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_record_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_record_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_record_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_record_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_record_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    if (qmc5883l_record_start(RECORD_TEST_PATH, NULL) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: record start failed.\n");
+        
+        return 1;
+    }
+    if (a_record_test_run(times, 0) != 0)
+    {
+        (void)qmc5883l_record_stop();
+        (void)remove(RECORD_TEST_PATH);
+        
+        return 1;
+    }
+    if (qmc5883l_record_stop() != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: record stop failed.\n");
+        (void)remove(RECORD_TEST_PATH);
+        
+        return 1;
+    }
+    
+    /* replay it fast and in realtime */
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_replay_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_replay_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_replay_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_replay_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_replay_delay_ms);
+    for (mode = 0; mode < 2; mode++)
+    {
+        qmc5883l_replay_mode_t replay_mode;
+        
+        replay_mode = (mode == 0) ? QMC5883L_REPLAY_MODE_FAST : QMC5883L_REPLAY_MODE_REALTIME;
+        if (qmc5883l_replay_open(RECORD_TEST_PATH, replay_mode) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: replay open failed.\n");
+            (void)remove(RECORD_TEST_PATH);
+            
+            return 1;
+        }
+        if (a_record_test_run(times, 1) != 0)
+        {
+            (void)qmc5883l_replay_close();
+            (void)remove(RECORD_TEST_PATH);
+            
+            return 1;
+        }
+        
+        /* the record is used up */
+        if (qmc5883l_replay_iic_read(0x1A, 0x06, buf, 1) == 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: replay end check error.\n");
+            (void)qmc5883l_replay_close();
+            (void)remove(RECORD_TEST_PATH);
+            
+            return 1;
+        }
+        (void)qmc5883l_replay_get_stats(&stats[mode]);
+        (void)qmc5883l_replay_close();
+        qmc5883l_interface_debug_print("qmc5883l: %s replay of %d events covering %.3fs, %d mismatches.\n",
+                                       (mode == 0) ? "fast" : "realtime", (int)stats[mode].events,
+                                       stats[mode].elapsed_us * 1e-6, (int)stats[mode].mismatches);
+        if ((stats[mode].mismatches != 0) || (stats[mode].finished != 1))
+        {
+            qmc5883l_interface_debug_print("qmc5883l: replay mismatch check error.\n");
+            (void)remove(RECORD_TEST_PATH);
+            
+            return 1;
+        }
+    }
+    (void)remove(RECORD_TEST_PATH);
+    if ((stats[0].events != stats[1].events) || (stats[0].elapsed_us != stats[1].elapsed_us))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: replay mode check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish record test */
+    qmc5883l_interface_debug_print("qmc5883l: finish record test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,407 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_resample_test.c
+ * @brief     driver qmc5883l resample test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_resample_test.h"
+#include <math.h>
+
+/**
+ * @brief resample test definition
+ */
+#define RESAMPLE_TEST_RATE_HZ       200.0f        /**< nominal output data rate */
+#define RESAMPLE_TEST_TIME_CONSTANT 200           /**< steady tracking time constant in samples */
+#define RESAMPLE_TEST_SAMPLES       4000          /**< synthetic samples */
+#define RESAMPLE_TEST_SETTLE        1000          /**< synthetic samples before the checks */
+#define RESAMPLE_TEST_PERIOD_US     5150.0        /**< synthetic true period, 3% slow */
+#define RESAMPLE_TEST_JITTER_US     1000          /**< synthetic data ready poll period */
+#define RESAMPLE_TEST_LOSS_EVERY    700           /**< one synthetic sample is lost this often */
+#define RESAMPLE_TEST_POLL_MS       1             /**< data ready poll period */
+#define RESAMPLE_TEST_POLL_TRIES    100           /**< data ready polls before timeout */
+#define RESAMPLE_TEST_BUS_HZ        400000        /**< assumed iic clock for the host time */
+
+static qmc5883l_handle_t gs_handle;               /**< qmc5883l handle */
+static qmc5883l_resample_t gs_linear;             /**< linear resampler */
+static qmc5883l_resample_t gs_cubic;              /**< cubic resampler */
+static double gs_host_us;                         /**< host time */
+static uint32_t gs_seed = 7;                      /**< jitter generator state */
+
+/**
+ * @brief     synthetic field
+ * @param[in] t_us is the time
+ * @param[in] axis is the axis
+ * @return    field in mgauss
+ * @note      none
+ */
+static double a_resample_test_field(double t_us, uint8_t axis)
+{
+    const double pi = 3.14159265358979323846;
+    
+    if (axis == 0)
+    {
+        return 100.0 * sin(2.0 * pi * 1.3 * t_us * 1e-6);
+    }
+    else if (axis == 1)
+    {
+        return 50.0 * cos(2.0 * pi * 0.7 * t_us * 1e-6);
+    }
+    else
+    {
+        return 400.0;
+    }
+}
+
+/**
+ * @brief      check the grid points of one push
+ * @param[in]  *out points to an output buffer
+ * @param[in]  *out_time_us points to a grid time buffer
+ * @param[in]  count is the number of points
+ * @param[in]  check is 1 after the settle time
+ * @param[in]  *last points to the last grid time buffer
+ * @param[out] *error points to the max error buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 grid check failed
+ * @note       the poll sees data ready half a poll period late on average, the truth is shifted by the same
+ */
+static uint8_t a_resample_test_points(float out[QMC5883L_RESAMPLE_MAX_OUT][3], uint64_t out_time_us[QMC5883L_RESAMPLE_MAX_OUT],
+                                      uint8_t count, uint8_t check, uint64_t *last, double *error)
+{
+    uint8_t i;
+    uint8_t a;
+    
+    for (i = 0; i < count; i++)
+    {
+        if (((out_time_us[i] % 5000) != 0) || ((*last != 0) && (out_time_us[i] != *last + 5000)))
+        {
+            return 1;
+        }
+        *last = out_time_us[i];
+        if (check != 0)
+        {
+            for (a = 0; a < 3; a++)
+            {
+                double e = fabs(out[i][a] - a_resample_test_field((double)out_time_us[i] - RESAMPLE_TEST_JITTER_US / 2.0, a));
+                
+                *error = (e > *error) ? e : *error;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  resample a drifting synthetic stream
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   3% slow clock, data ready seen by a 1ms poll and a lost sample every 700
+ */
+static uint8_t a_resample_test_synthetic(void)
+{
+    float out[QMC5883L_RESAMPLE_MAX_OUT][3];
+    uint64_t out_time_us[QMC5883L_RESAMPLE_MAX_OUT];
+    uint64_t last_linear;
+    uint64_t last_cubic;
+    double error_linear;
+    double error_cubic;
+    float rate;
+    float m[3];
+    uint32_t missed;
+    uint32_t dropped;
+    uint32_t lost;
+    uint32_t n;
+    uint8_t count;
+    uint8_t a;
+    
+    (void)qmc5883l_resample_init(&gs_linear, RESAMPLE_TEST_RATE_HZ, RESAMPLE_TEST_RATE_HZ, QMC5883L_RESAMPLE_LINEAR, RESAMPLE_TEST_TIME_CONSTANT);
+    (void)qmc5883l_resample_init(&gs_cubic, RESAMPLE_TEST_RATE_HZ, RESAMPLE_TEST_RATE_HZ, QMC5883L_RESAMPLE_CUBIC, RESAMPLE_TEST_TIME_CONSTANT);
+    last_linear = 0;
+    last_cubic = 0;
+    error_linear = 0.0;
+    error_cubic = 0.0;
+    lost = 0;
+    for (n = 0; n < RESAMPLE_TEST_SAMPLES; n++)
+    {
+        double edge = 1000000.0 + n * RESAMPLE_TEST_PERIOD_US;
+        uint64_t seen;
+        
+        if ((n % RESAMPLE_TEST_LOSS_EVERY) == RESAMPLE_TEST_LOSS_EVERY - 1)
+        {
+            lost++;
+            
+            continue;
+        }
+        gs_seed = gs_seed * 1664525U + 1013904223U;
+        seen = (uint64_t)edge + (gs_seed >> 8) % RESAMPLE_TEST_JITTER_US;
+        for (a = 0; a < 3; a++)
+        {
+            m[a] = (float)a_resample_test_field(edge, a);
+        }
+        (void)qmc5883l_resample_push(&gs_linear, seen, m, out, out_time_us, &count);
+        if (a_resample_test_points(out, out_time_us, count, n >= RESAMPLE_TEST_SETTLE, &last_linear, &error_linear) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: linear grid check error.\n");
+            
+            return 1;
+        }
+        (void)qmc5883l_resample_push(&gs_cubic, seen, m, out, out_time_us, &count);
+        if (a_resample_test_points(out, out_time_us, count, n >= RESAMPLE_TEST_SETTLE, &last_cubic, &error_cubic) != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: cubic grid check error.\n");
+            
+            return 1;
+        }
+    }
+    (void)qmc5883l_resample_get_rate(&gs_linear, &rate, &missed, &dropped);
+    qmc5883l_interface_debug_print("qmc5883l: estimated %.3fHz, true %.3fHz, %d lost, %d missed.\n",
+                                   rate, 1000000.0 / RESAMPLE_TEST_PERIOD_US, (int)lost, (int)missed);
+    qmc5883l_interface_debug_print("qmc5883l: max deviation linear %.3f mgauss, cubic %.3f mgauss.\n", error_linear, error_cubic);
+    if ((fabs(rate * RESAMPLE_TEST_PERIOD_US / 1000000.0 - 1.0) > 0.001) || (missed != lost) || (dropped != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: rate estimate check error.\n");
+        
+        return 1;
+    }
+    if ((error_linear > 0.2) || (error_cubic > 0.2))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: interpolation check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     counting iic bus read
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_resample_test_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_host_us += (29.0 + 9.0 * len) * 1000000.0 / RESAMPLE_TEST_BUS_HZ;
+    
+    return qmc5883l_interface_iic_read(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_resample_test_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_host_us += (20.0 + 9.0 * len) * 1000000.0 / RESAMPLE_TEST_BUS_HZ;
+    
+    return qmc5883l_interface_iic_write(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting delay
+ * @param[in] ms is the delay time
+ * @note      forwards to the interface
+ */
+static void a_resample_test_delay_ms(uint32_t ms)
+{
+    gs_host_us += ms * 1000.0;
+    
+    qmc5883l_interface_delay_ms(ms);
+}
+
+/**
+ * @brief  wait for the next sample
+ * @return status code
+ *         - 0 success
+ *         - 1 wait failed
+ * @note   none
+ */
+static uint8_t a_resample_test_wait(void)
+{
+    uint8_t status;
+    uint8_t i;
+    
+    for (i = 0; i < RESAMPLE_TEST_POLL_TRIES; i++)
+    {
+        if (qmc5883l_get_status(&gs_handle, &status) != 0)
+        {
+            return 1;
+        }
+        if ((status & QMC5883L_STATUS_DRDY) != 0)
+        {
+            return 0;
+        }
+        a_resample_test_delay_ms(RESAMPLE_TEST_POLL_MS);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     resample test
+ * @param[in] times is the number of read samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the host time is the sum of the requested poll delays and the iic frames at 400kHz
+ */
+uint8_t qmc5883l_resample_test(uint32_t times)
+{
+    const float zero[3] = {0.0f, 0.0f, 0.0f};
+    float out[QMC5883L_RESAMPLE_MAX_OUT][3];
+    uint64_t out_time_us[QMC5883L_RESAMPLE_MAX_OUT];
+    uint64_t first;
+    uint64_t last;
+    uint32_t points;
+    uint32_t missed;
+    uint32_t dropped;
+    uint32_t i;
+    uint8_t res;
+    uint8_t count;
+    int16_t raw[3];
+    float m_gauss[3];
+    float rate;
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, a_resample_test_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, a_resample_test_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, a_resample_test_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start resample test */
+    qmc5883l_interface_debug_print("qmc5883l: start resample test.\n");
+    
+    /* param limits */
+    if ((qmc5883l_resample_init(&gs_linear, 0.0f, 200.0f, QMC5883L_RESAMPLE_LINEAR, 100) != 4) ||
+        (qmc5883l_resample_init(&gs_linear, 50.0f, 250.0f, QMC5883L_RESAMPLE_LINEAR, 100) != 4) ||
+        (qmc5883l_resample_init(&gs_linear, 200.0f, 200.0f, (qmc5883l_resample_method_t)2, 100) != 4) ||
+        (qmc5883l_resample_init(&gs_linear, 200.0f, 200.0f, QMC5883L_RESAMPLE_LINEAR, 1) != 4) ||
+        (qmc5883l_resample_push(&gs_linear, 0, zero, out, out_time_us, &count) != 3))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: resample limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* synthetic stream */
+    res = a_resample_test_synthetic();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: drifting stream is put on the exact grid.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* estimate the chip clock against the host time */
+    (void)qmc5883l_resample_init(&gs_linear, RESAMPLE_TEST_RATE_HZ, RESAMPLE_TEST_RATE_HZ, QMC5883L_RESAMPLE_LINEAR, RESAMPLE_TEST_TIME_CONSTANT);
+    gs_host_us = 0.0;
+    first = 0;
+    last = 0;
+    points = 0;
+    for (i = 0; i < times; i++)
+    {
+        res = a_resample_test_wait();
+        if (res == 0)
+        {
+            res = qmc5883l_read(&gs_handle, raw, m_gauss);
+        }
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (void)qmc5883l_resample_push(&gs_linear, (uint64_t)gs_host_us, m_gauss, out, out_time_us, &count);
+        if (count != 0)
+        {
+            first = (points == 0) ? out_time_us[0] : first;
+            last = out_time_us[count - 1];
+            points += count;
+        }
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    (void)qmc5883l_resample_get_rate(&gs_linear, &rate, &missed, &dropped);
+    qmc5883l_interface_debug_print("qmc5883l: chip clock %.3fHz, %d samples, %d grid points, %d missed.\n",
+                                   rate, (int)times, (int)points, (int)missed);
+    if ((points < 2) || ((last - first) != (uint64_t)(points - 1) * 5000) ||
+        (fabsf(rate / RESAMPLE_TEST_RATE_HZ - 1.0f) >= QMC5883L_RESAMPLE_MAX_ERROR))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: grid check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish resample test */
+    qmc5883l_interface_debug_print("qmc5883l: finish resample test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,653 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_sim.c
+ * @brief     driver qmc5883l sim source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_sim.h"
+
+/**
+ * @brief sim register definition
+ */
+#define SIM_ADDRESS               0x1A        /**< iic address */
+#define SIM_REG_X_LSB             0x00        /**< data output x lsb register */
+#define SIM_REG_STATUS            0x06        /**< status register */
+#define SIM_REG_TEMP_LSB          0x07        /**< temperature data lsb register */
+#define SIM_REG_TEMP_MSB          0x08        /**< temperature data msb register */
+#define SIM_REG_CONTROL1          0x09        /**< control 1 register */
+#define SIM_REG_CONTROL2          0x0A        /**< control 2 register */
+#define SIM_REG_PERIOD            0x0B        /**< period register */
+#define SIM_REG_RESERVED          0x0C        /**< reserved register */
+#define SIM_REG_ID                0x0D        /**< chip id register */
+#define SIM_REG_NUM               0x0E        /**< register number */
+
+/**
+ * @brief sim register bit definition
+ */
+#define SIM_STATUS_DRDY           (1 << 0)    /**< data ready */
+#define SIM_STATUS_OVL            (1 << 1)    /**< out of range */
+#define SIM_STATUS_DOR            (1 << 2)    /**< data skip */
+#define SIM_CONTROL2_INT_ENB      (1 << 0)    /**< interrupt disable */
+#define SIM_CONTROL2_ROL_PNT      (1 << 6)    /**< pointer roll over */
+#define SIM_CONTROL2_SOFT_RST     (1 << 7)    /**< soft reset */
+
+/**
+ * @brief sim state structure definition
+ */
+typedef struct sim_s
+{
+    uint8_t powered;                                         /**< power on flag */
+    uint8_t reg[SIM_REG_NUM];                                /**< register map */
+    uint64_t time_ns;                                        /**< virtual clock */
+    uint64_t next_ns;                                        /**< next measurement finish time */
+    float field[3];                                          /**< constant field */
+    void (*source)(uint64_t time_us, float m_gauss[3]);      /**< field source */
+    float temperature;                                       /**< die temperature */
+    float (*temperature_source)(uint64_t time_us);           /**< die temperature source */
+    float drift_linear[3];                                   /**< offset drift per degree */
+    float drift_quadratic[3];                                /**< offset drift per square degree */
+    float noise;                                             /**< rms noise at 512 over sample */
+    uint32_t seed;                                           /**< noise generator state */
+    uint32_t bus_clock;                                      /**< iic bus clock */
+    int32_t drift_ppm;                                       /**< oscillator error */
+    qmc5883l_sim_stats_t stats;                              /**< statistics */
+} sim_t;
+
+static sim_t gs_sim =
+{
+    .temperature = 25.0f,
+    .seed = 0x12345678U,
+    .bus_clock = QMC5883L_SIM_DEFAULT_BUS_CLOCK,
+};                                                           /**< sim state */
+
+/**
+ * @brief sim output rate table definition
+ */
+static const uint32_t gs_rate_hz[4] = {10, 50, 100, 200};
+
+/**
+ * @brief sim noise scale table definition, sqrt(512 / osr)
+ */
+static const float gs_noise_scale[4] = {1.0f, 1.41421356f, 2.0f, 2.82842712f};
+
+/**
+ * @brief restore the register defaults
+ * @note  none
+ */
+static void a_sim_reset_registers(void)
+{
+    memset(gs_sim.reg, 0, SIM_REG_NUM);
+    gs_sim.reg[SIM_REG_RESERVED] = 0x01;
+    gs_sim.reg[SIM_REG_ID] = 0xFF;
+    gs_sim.next_ns = 0;
+}
+
+/**
+ * @brief power on the chip once
+ * @note  none
+ */
+static void a_sim_power(void)
+{
+    if (gs_sim.powered == 0)
+    {
+        (void)qmc5883l_sim_init();
+    }
+}
+
+/**
+ * @brief  check the continuous mode
+ * @return 1 if the chip is measuring
+ * @note   none
+ */
+static uint8_t a_sim_continuous(void)
+{
+    return ((gs_sim.reg[SIM_REG_CONTROL1] & 0x03) == QMC5883L_MODE_CONTINUOUS) ? 1 : 0;
+}
+
+/**
+ * @brief  get the measurement period
+ * @return period in nanoseconds
+ * @note   none
+ */
+static uint64_t a_sim_period_ns(void)
+{
+    uint64_t period;
+    
+    period = 1000000000ULL / gs_rate_hz[(gs_sim.reg[SIM_REG_CONTROL1] >> 2) & 0x03];
+    
+    return period * (uint64_t)(1000000 + gs_sim.drift_ppm) / 1000000ULL;
+}
+
+/**
+ * @brief  get a gaussian noise sample
+ * @return unit variance noise
+ * @note   sum of four uniforms, good enough for noise statistics
+ */
+static float a_sim_gauss(void)
+{
+    float sum = 0.0f;
+    uint8_t i;
+    
+    for (i = 0; i < 4; i++)
+    {
+        gs_sim.seed ^= gs_sim.seed << 13;
+        gs_sim.seed ^= gs_sim.seed >> 17;
+        gs_sim.seed ^= gs_sim.seed << 5;
+        sum += (float)(gs_sim.seed >> 8) / 16777216.0f;
+    }
+    
+    return (sum - 2.0f) * 1.73205081f;
+}
+
+/**
+ * @brief     finish a measurement
+ * @param[in] time_ns is the measurement time
+ * @param[in] num is the number of measurements finished since the last update
+ * @note      only the latest one is loaded into the output registers
+ */
+static void a_sim_measure(uint64_t time_ns, uint64_t num)
+{
+    float m_gauss[3];
+    float dt;
+    float lsb;
+    float noise;
+    float v;
+    int32_t raw;
+    int16_t temp;
+    uint8_t status;
+    uint8_t i;
+    
+    /* get the field */
+    if (gs_sim.source != NULL)
+    {
+        gs_sim.source(time_ns / 1000, m_gauss);
+    }
+    else
+    {
+        m_gauss[0] = gs_sim.field[0];
+        m_gauss[1] = gs_sim.field[1];
+        m_gauss[2] = gs_sim.field[2];
+    }
+    
+    /* add the offset drift of the die temperature */
+    if (gs_sim.temperature_source != NULL)
+    {
+        gs_sim.temperature = gs_sim.temperature_source(time_ns / 1000);
+    }
+    dt = gs_sim.temperature - 25.0f;
+    for (i = 0; i < 3; i++)
+    {
+        m_gauss[i] += gs_sim.drift_linear[i] * dt + gs_sim.drift_quadratic[i] * dt * dt;
+    }
+    
+    /* convert with the range and saturate */
+    lsb = (((gs_sim.reg[SIM_REG_CONTROL1] >> 4) & 0x01) != 0) ? 3.0f : 12.0f;
+    noise = gs_sim.noise * gs_noise_scale[(gs_sim.reg[SIM_REG_CONTROL1] >> 6) & 0x03];
+    status = gs_sim.reg[SIM_REG_STATUS] & ~SIM_STATUS_OVL;
+    for (i = 0; i < 3; i++)
+    {
+        v = m_gauss[i];
+        if (noise > 0.0f)
+        {
+            v += noise * a_sim_gauss();
+        }
+        v *= lsb;
+        if (v >= 32767.0f)
+        {
+            raw = 32767;
+            status |= SIM_STATUS_OVL;
+        }
+        else if (v <= -32768.0f)
+        {
+            raw = -32768;
+            status |= SIM_STATUS_OVL;
+        }
+        else
+        {
+            raw = (int32_t)((v >= 0.0f) ? (v + 0.5f) : (v - 0.5f));
+        }
+        gs_sim.reg[SIM_REG_X_LSB + i * 2 + 0] = (uint8_t)((uint16_t)raw & 0xFF);
+        gs_sim.reg[SIM_REG_X_LSB + i * 2 + 1] = (uint8_t)(((uint16_t)raw >> 8) & 0xFF);
+    }
+    
+    /* update the temperature */
+    temp = (int16_t)((gs_sim.temperature - QMC5883L_SIM_TEMPERATURE_OFFSET) * 100.0f);
+    gs_sim.reg[SIM_REG_TEMP_LSB] = (uint8_t)((uint16_t)temp & 0xFF);
+    gs_sim.reg[SIM_REG_TEMP_MSB] = (uint8_t)(((uint16_t)temp >> 8) & 0xFF);
+    
+    /* set drdy, overwritten samples set dor */
+    if (((status & SIM_STATUS_DRDY) != 0) || (num > 1))
+    {
+        gs_sim.stats.skipped += (uint32_t)(num - 1) + (((status & SIM_STATUS_DRDY) != 0) ? 1 : 0);
+        status |= SIM_STATUS_DOR;
+    }
+    gs_sim.reg[SIM_REG_STATUS] = status | SIM_STATUS_DRDY;
+    gs_sim.stats.samples += (uint32_t)num;
+}
+
+/**
+ * @brief run all measurements which finished before the virtual clock
+ * @note  none
+ */
+static void a_sim_run(void)
+{
+    uint64_t period;
+    uint64_t num;
+    
+    if ((a_sim_continuous() == 0) || (gs_sim.time_ns < gs_sim.next_ns))
+    {
+        return;
+    }
+    
+    period = a_sim_period_ns();
+    num = (gs_sim.time_ns - gs_sim.next_ns) / period + 1;
+    gs_sim.next_ns += num * period;
+    a_sim_measure(gs_sim.next_ns - period, num);
+}
+
+/**
+ * @brief     advance the clock by a bus transfer
+ * @param[in] bits is the number of transferred bits
+ * @note      none
+ */
+static void a_sim_bus(uint32_t bits)
+{
+    uint64_t ns;
+    
+    if (gs_sim.bus_clock == 0)
+    {
+        return;
+    }
+    
+    ns = (uint64_t)bits * 1000000000ULL / gs_sim.bus_clock;
+    gs_sim.time_ns += ns;
+    gs_sim.stats.bus_us += ns / 1000;
+}
+
+/**
+ * @brief     write one register
+ * @param[in] reg is the register address
+ * @param[in] value is the written value
+ * @note      none
+ */
+static void a_sim_write_reg(uint8_t reg, uint8_t value)
+{
+    switch (reg)
+    {
+        case SIM_REG_CONTROL1 :
+        {
+            uint8_t was;
+            uint8_t rate;
+            
+            was = a_sim_continuous();
+            rate = (gs_sim.reg[SIM_REG_CONTROL1] >> 2) & 0x03;
+            gs_sim.reg[SIM_REG_CONTROL1] = value;
+            if ((a_sim_continuous() != 0) && ((was == 0) || (rate != ((value >> 2) & 0x03))))
+            {
+                gs_sim.next_ns = gs_sim.time_ns + a_sim_period_ns();
+            }
+            
+            break;
+        }
+        case SIM_REG_CONTROL2 :
+        {
+            if ((value & SIM_CONTROL2_SOFT_RST) != 0)
+            {
+                a_sim_reset_registers();
+            }
+            else
+            {
+                gs_sim.reg[SIM_REG_CONTROL2] = value & (SIM_CONTROL2_ROL_PNT | SIM_CONTROL2_INT_ENB);
+            }
+            
+            break;
+        }
+        case SIM_REG_PERIOD :
+        {
+            gs_sim.reg[SIM_REG_PERIOD] = value;
+            
+            break;
+        }
+        default :
+        {
+            /* read only or reserved */
+            break;
+        }
+    }
+}
+
+/**
+ * @brief  power on the simulated chip and reset the virtual clock
+ * @return status code
+ *         - 0 success
+ * @note   field, temperature, noise, bus clock and drift settings are kept
+ */
+uint8_t qmc5883l_sim_init(void)
+{
+    gs_sim.powered = 1;
+    gs_sim.time_ns = 0;
+    a_sim_reset_registers();
+    memset(&gs_sim.stats, 0, sizeof(qmc5883l_sim_stats_t));
+    
+    return 0;
+}
+
+/**
+ * @brief     set a constant magnetic field
+ * @param[in] *m_gauss points to a field buffer
+ * @note      none
+ */
+void qmc5883l_sim_set_field(const float m_gauss[3])
+{
+    gs_sim.field[0] = m_gauss[0];
+    gs_sim.field[1] = m_gauss[1];
+    gs_sim.field[2] = m_gauss[2];
+}
+
+/**
+ * @brief     set a programmable field source
+ * @param[in] *source points to a field function called at every measurement, NULL to use the constant field
+ * @note      none
+ */
+void qmc5883l_sim_set_field_source(void (*source)(uint64_t time_us, float m_gauss[3]))
+{
+    gs_sim.source = source;
+}
+
+/**
+ * @brief     set the die temperature
+ * @param[in] deg is the temperature in degrees celsius
+ * @note      none
+ */
+void qmc5883l_sim_set_temperature(float deg)
+{
+    gs_sim.temperature = deg;
+}
+
+/**
+ * @brief     set a programmable die temperature source
+ * @param[in] *source points to a temperature function called at every measurement, NULL to use the constant temperature
+ * @note      none
+ */
+void qmc5883l_sim_set_temperature_source(float (*source)(uint64_t time_us))
+{
+    gs_sim.temperature_source = source;
+}
+
+/**
+ * @brief     set the offset drift against the die temperature
+ * @param[in] *linear points to a linear coefficient buffer in m_gauss per degree
+ * @param[in] *quadratic points to a quadratic coefficient buffer in m_gauss per square degree
+ * @note      the drift is zero at 25 degrees, NULL clears the drift
+ */
+void qmc5883l_sim_set_temperature_drift(const float linear[3], const float quadratic[3])
+{
+    uint8_t i;
+    
+    for (i = 0; i < 3; i++)
+    {
+        gs_sim.drift_linear[i] = (linear != NULL) ? linear[i] : 0.0f;
+        gs_sim.drift_quadratic[i] = (quadratic != NULL) ? quadratic[i] : 0.0f;
+    }
+}
+
+/**
+ * @brief     set the measurement noise
+ * @param[in] m_gauss_rms is the rms noise at 512 over sample, it scales with sqrt(512 / osr)
+ * @param[in] seed is the noise seed
+ * @note      0 disables the noise
+ */
+void qmc5883l_sim_set_noise(float m_gauss_rms, uint32_t seed)
+{
+    gs_sim.noise = m_gauss_rms;
+    gs_sim.seed = (seed != 0) ? seed : 0x12345678U;
+}
+
+/**
+ * @brief     set the iic bus clock
+ * @param[in] hz is the bus clock, 0 makes transfers take no time
+ * @note      none
+ */
+void qmc5883l_sim_set_bus_clock(uint32_t hz)
+{
+    gs_sim.bus_clock = hz;
+}
+
+/**
+ * @brief     set the internal oscillator error
+ * @param[in] ppm is the sample period error in parts per million
+ * @note      positive values make the chip slower than the nominal output rate
+ */
+void qmc5883l_sim_set_clock_drift(int32_t ppm)
+{
+    gs_sim.drift_ppm = ppm;
+}
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] us is the advanced time in microseconds
+ * @note      none
+ */
+void qmc5883l_sim_advance_us(uint64_t us)
+{
+    a_sim_power();
+    gs_sim.time_ns += us * 1000;
+    a_sim_run();
+}
+
+/**
+ * @brief  get the virtual clock
+ * @return current time in microseconds
+ * @note   none
+ */
+uint64_t qmc5883l_sim_get_time_us(void)
+{
+    return gs_sim.time_ns / 1000;
+}
+
+/**
+ * @brief  get the interrupt pin level
+ * @return pin level
+ * @note   the pin follows drdy when the interrupt is enabled
+ */
+uint8_t qmc5883l_sim_get_int_pin(void)
+{
+    a_sim_power();
+    a_sim_run();
+    
+    return (((gs_sim.reg[SIM_REG_CONTROL2] & SIM_CONTROL2_INT_ENB) == 0) &&
+            ((gs_sim.reg[SIM_REG_STATUS] & SIM_STATUS_DRDY) != 0)) ? 1 : 0;
+}
+
+/**
+ * @brief      get the sim statistics
+ * @param[out] *stats points to a sim stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_sim_get_stats(qmc5883l_sim_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return 2;
+    }
+    
+    *stats = gs_sim.stats;
+    
+    return 0;
+}
+
+/**
+ * @brief  clear the sim statistics
+ * @note   none
+ */
+void qmc5883l_sim_clear_stats(void)
+{
+    memset(&gs_sim.stats, 0, sizeof(qmc5883l_sim_stats_t));
+}
+
+/**
+ * @brief  sim iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t qmc5883l_sim_iic_init(void)
+{
+    a_sim_power();
+    
+    return 0;
+}
+
+/**
+ * @brief  sim iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t qmc5883l_sim_iic_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      sim iic bus read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t qmc5883l_sim_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t pointer;
+    uint8_t data_read;
+    uint16_t i;
+    
+    a_sim_power();
+    a_sim_run();
+    if (addr != SIM_ADDRESS)
+    {
+        gs_sim.stats.nacks++;
+        a_sim_bus(10);
+        
+        return 1;
+    }
+    
+    /* start, address, register, restart, address, data and stop */
+    pointer = reg;
+    data_read = 0;
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = (pointer < SIM_REG_NUM) ? gs_sim.reg[pointer] : 0x00;
+        if (pointer <= SIM_REG_X_LSB + 5)
+        {
+            data_read = 1;
+        }
+        if ((pointer == SIM_REG_STATUS) && ((gs_sim.reg[SIM_REG_CONTROL2] & SIM_CONTROL2_ROL_PNT) != 0))
+        {
+            pointer = SIM_REG_X_LSB;
+        }
+        else
+        {
+            pointer++;
+        }
+    }
+    
+    /* reading any data register clears drdy and dor */
+    if (data_read != 0)
+    {
+        gs_sim.reg[SIM_REG_STATUS] &= ~(SIM_STATUS_DRDY | SIM_STATUS_DOR);
+    }
+    gs_sim.stats.iic_reads++;
+    gs_sim.stats.bytes_read += len;
+    a_sim_bus(29 + 9 * (uint32_t)len);
+    
+    return 0;
+}
+
+/**
+ * @brief     sim iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t qmc5883l_sim_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    a_sim_power();
+    a_sim_run();
+    if (addr != SIM_ADDRESS)
+    {
+        gs_sim.stats.nacks++;
+        a_sim_bus(10);
+        
+        return 1;
+    }
+    
+    /* start, address, register, data and stop */
+    for (i = 0; i < len; i++)
+    {
+        a_sim_write_reg((uint8_t)(reg + i), buf[i]);
+    }
+    gs_sim.stats.iic_writes++;
+    gs_sim.stats.bytes_written += len;
+    a_sim_bus(20 + 9 * (uint32_t)len);
+    
+    return 0;
+}
+
+/**
+ * @brief     sim delay ms
+ * @param[in] ms
+ * @note      advances the virtual clock and returns immediately
+ */
+void qmc5883l_sim_delay_ms(uint32_t ms)
+{
+    gs_sim.stats.delays++;
+    gs_sim.stats.delay_ms += ms;
+    qmc5883l_sim_advance_us((uint64_t)ms * 1000);
+}
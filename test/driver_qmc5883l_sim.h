@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_sim.h
+ * @brief     driver qmc5883l sim header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_SIM_H
+#define DRIVER_QMC5883L_SIM_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_sim_driver qmc5883l sim driver function
+ * @brief    qmc5883l sim driver modules
+ * @ingroup  qmc5883l_test_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l sim default definition
+ */
+#define QMC5883L_SIM_DEFAULT_BUS_CLOCK            400000        /**< 400kHz iic bus */
+#define QMC5883L_SIM_TEMPERATURE_OFFSET           30.0f         /**< uncompensated temperature offset */
+
+/**
+ * @brief qmc5883l sim statistics structure definition
+ */
+typedef struct qmc5883l_sim_stats_s
+{
+    uint32_t iic_reads;            /**< iic read transactions */
+    uint32_t iic_writes;           /**< iic write transactions */
+    uint32_t bytes_read;           /**< iic bytes read */
+    uint32_t bytes_written;        /**< iic bytes written */
+    uint32_t nacks;                /**< transactions to a wrong address */
+    uint32_t delays;               /**< delay_ms calls */
+    uint64_t delay_ms;             /**< total delayed time */
+    uint64_t bus_us;               /**< total bus busy time */
+    uint32_t samples;              /**< finished measurements */
+    uint32_t skipped;              /**< measurements overwritten before being read */
+} qmc5883l_sim_stats_t;
+
+/**
+ * @brief  power on the simulated chip and reset the virtual clock
+ * @return status code
+ *         - 0 success
+ * @note   field, temperature, noise, bus clock and drift settings are kept
+ */
+uint8_t qmc5883l_sim_init(void);
+
+/**
+ * @brief     set a constant magnetic field
+ * @param[in] *m_gauss points to a field buffer
+ * @note      none
+ */
+void qmc5883l_sim_set_field(const float m_gauss[3]);
+
+/**
+ * @brief     set a programmable field source
+ * @param[in] *source points to a field function called at every measurement, NULL to use the constant field
+ * @note      none
+ */
+void qmc5883l_sim_set_field_source(void (*source)(uint64_t time_us, float m_gauss[3]));
+
+/**
+ * @brief     set the die temperature
+ * @param[in] deg is the temperature in degrees celsius
+ * @note      none
+ */
+void qmc5883l_sim_set_temperature(float deg);
+
+/**
+ * @brief     set a programmable die temperature source
+ * @param[in] *source points to a temperature function called at every measurement, NULL to use the constant temperature
+ * @note      none
+ */
+void qmc5883l_sim_set_temperature_source(float (*source)(uint64_t time_us));
+
+/**
+ * @brief     set the offset drift against the die temperature
+ * @param[in] *linear points to a linear coefficient buffer in m_gauss per degree
+ * @param[in] *quadratic points to a quadratic coefficient buffer in m_gauss per square degree
+ * @note      the drift is zero at 25 degrees, NULL clears the drift
+ */
+void qmc5883l_sim_set_temperature_drift(const float linear[3], const float quadratic[3]);
+
+/**
+ * @brief     set the measurement noise
+ * @param[in] m_gauss_rms is the rms noise at 512 over sample, it scales with sqrt(512 / osr)
+ * @param[in] seed is the noise seed
+ * @note      0 disables the noise
+ */
+void qmc5883l_sim_set_noise(float m_gauss_rms, uint32_t seed);
+
+/**
+ * @brief     set the iic bus clock
+ * @param[in] hz is the bus clock, 0 makes transfers take no time
+ * @note      none
+ */
+void qmc5883l_sim_set_bus_clock(uint32_t hz);
+
+/**
+ * @brief     set the internal oscillator error
+ * @param[in] ppm is the sample period error in parts per million
+ * @note      positive values make the chip slower than the nominal output rate
+ */
+void qmc5883l_sim_set_clock_drift(int32_t ppm);
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] us is the advanced time in microseconds
+ * @note      none
+ */
+void qmc5883l_sim_advance_us(uint64_t us);
+
+/**
+ * @brief  get the virtual clock
+ * @return current time in microseconds
+ * @note   none
+ */
+uint64_t qmc5883l_sim_get_time_us(void);
+
+/**
+ * @brief  get the interrupt pin level
+ * @return pin level
+ * @note   the pin follows drdy when the interrupt is enabled
+ */
+uint8_t qmc5883l_sim_get_int_pin(void);
+
+/**
+ * @brief      get the sim statistics
+ * @param[out] *stats points to a sim stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats is NULL
+ * @note       none
+ */
+uint8_t qmc5883l_sim_get_stats(qmc5883l_sim_stats_t *stats);
+
+/**
+ * @brief  clear the sim statistics
+ * @note   none
+ */
+void qmc5883l_sim_clear_stats(void);
+
+/**
+ * @brief  sim iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t qmc5883l_sim_iic_init(void);
+
+/**
+ * @brief  sim iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t qmc5883l_sim_iic_deinit(void);
+
+/**
+ * @brief      sim iic bus read
+ * @param[in]  addr is the iic device write address
+ * @param[in]  reg is the iic register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t qmc5883l_sim_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     sim iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t qmc5883l_sim_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     sim delay ms
+ * @param[in] ms
+ * @note      advances the virtual clock and returns immediately
+ */
+void qmc5883l_sim_delay_ms(uint32_t ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
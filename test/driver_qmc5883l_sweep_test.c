@@ -0,0 +1,288 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_sweep_test.c
+ * @brief     driver qmc5883l sweep test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_sweep_test.h"
+#include <math.h>
+
+/**
+ * @brief sweep test definition
+ */
+#define SWEEP_TEST_POLL_MS          1             /**< data ready poll period */
+#define SWEEP_TEST_POLL_TRIES       250           /**< data ready polls before timeout, above one 10Hz period */
+#define SWEEP_TEST_BUS_HZ           400000        /**< assumed iic clock for the bus time */
+
+static qmc5883l_handle_t gs_handle;               /**< qmc5883l handle */
+static uint32_t gs_iic;                           /**< iic transactions */
+static uint64_t gs_delay_ms;                      /**< delayed time */
+static uint64_t gs_bus_bits;                      /**< iic clocks including start, address and ack */
+static uint32_t gs_dor;                           /**< polls that saw a skipped sample */
+
+/**
+ * @brief sweep tables definition
+ */
+static const qmc5883l_full_scale_t gs_scale[2] = {QMC5883L_FULL_SCALE_2GAUSS, QMC5883L_FULL_SCALE_8GAUSS};
+static const uint8_t gs_scale_gauss[2] = {2, 8};
+static const qmc5883l_output_rate_t gs_rate[4] = {QMC5883L_OUTPUT_RATE_10HZ, QMC5883L_OUTPUT_RATE_50HZ,
+                                                  QMC5883L_OUTPUT_RATE_100HZ, QMC5883L_OUTPUT_RATE_200HZ};
+static const uint16_t gs_rate_hz[4] = {10, 50, 100, 200};
+static const qmc5883l_over_sample_t gs_sample[4] = {QMC5883L_OVER_SAMPLE_64, QMC5883L_OVER_SAMPLE_128,
+                                                    QMC5883L_OVER_SAMPLE_256, QMC5883L_OVER_SAMPLE_512};
+static const uint16_t gs_sample_ratio[4] = {64, 128, 256, 512};
+
+/**
+ * @brief     counting iic bus read
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_sweep_test_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_iic++;
+    gs_bus_bits += 29 + 9 * (uint32_t)len;
+    
+    return qmc5883l_interface_iic_read(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      forwards to the interface
+ */
+static uint8_t a_sweep_test_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_iic++;
+    gs_bus_bits += 20 + 9 * (uint32_t)len;
+    
+    return qmc5883l_interface_iic_write(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting delay
+ * @param[in] ms is the delay time
+ * @note      forwards to the interface
+ */
+static void a_sweep_test_delay_ms(uint32_t ms)
+{
+    gs_delay_ms += ms;
+    
+    qmc5883l_interface_delay_ms(ms);
+}
+
+/**
+ * @brief  wait for the next sample
+ * @return status code
+ *         - 0 success
+ *         - 1 wait failed
+ * @note   a poll that sees dor counts one skipped sample
+ */
+static uint8_t a_sweep_test_wait(void)
+{
+    uint8_t status;
+    uint8_t dor;
+    uint16_t i;
+    
+    dor = 0;
+    for (i = 0; i < SWEEP_TEST_POLL_TRIES; i++)
+    {
+        if (qmc5883l_get_status(&gs_handle, &status) != 0)
+        {
+            return 1;
+        }
+        dor |= status & QMC5883L_STATUS_DOR;
+        if ((status & QMC5883L_STATUS_DRDY) != 0)
+        {
+            gs_dor += (dor != 0) ? 1 : 0;
+            
+            return 0;
+        }
+        a_sweep_test_delay_ms(SWEEP_TEST_POLL_MS);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     measure one configuration
+ * @param[in] times is the number of samples
+ * @param[in] *line points to the csv prefix of the configuration
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      the first sample after the change is dropped
+ */
+static uint8_t a_sweep_test_measure(uint32_t times, const char *line)
+{
+    double mean[3] = {0.0, 0.0, 0.0};
+    double m2[3] = {0.0, 0.0, 0.0};
+    double seconds;
+    int16_t raw[3];
+    float m_gauss[3];
+    uint32_t i;
+    uint8_t k;
+    
+    if ((a_sweep_test_wait() != 0) || (qmc5883l_read(&gs_handle, raw, m_gauss) != 0))
+    {
+        return 1;
+    }
+    gs_iic = 0;
+    gs_delay_ms = 0;
+    gs_bus_bits = 0;
+    gs_dor = 0;
+    for (i = 0; i < times; i++)
+    {
+        if ((a_sweep_test_wait() != 0) || (qmc5883l_read(&gs_handle, raw, m_gauss) != 0))
+        {
+            return 1;
+        }
+        
+        /* welford update */
+        for (k = 0; k < 3; k++)
+        {
+            double d = m_gauss[k] - mean[k];
+            
+            mean[k] += d / (i + 1);
+            m2[k] += d * (m_gauss[k] - mean[k]);
+        }
+    }
+    seconds = (double)gs_delay_ms / 1000.0 + (double)gs_bus_bits / SWEEP_TEST_BUS_HZ;
+    qmc5883l_interface_debug_print("%s,%.3f,%.3f,%.3f,%.1f,%.1f,%.2f\n", line,
+                                   (times > 1) ? sqrt(m2[0] / (times - 1)) : 0.0,
+                                   (times > 1) ? sqrt(m2[1] / (times - 1)) : 0.0,
+                                   (times > 1) ? sqrt(m2[2] / (times - 1)) : 0.0,
+                                   (seconds > 0.0) ? times / seconds : 0.0,
+                                   (seconds > 0.0) ? gs_dor / seconds : 0.0,
+                                   (double)gs_iic / times);
+    
+    return 0;
+}
+
+/**
+ * @brief     sweep test
+ * @param[in] times is the number of samples per configuration
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sensor must be kept still, the output is csv, the host time is the sum of the
+ *            requested poll delays and the iic frames at SWEEP_TEST_BUS_HZ
+ */
+uint8_t qmc5883l_sweep_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t s;
+    uint8_t r;
+    uint8_t o;
+    char line[32];
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, a_sweep_test_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, a_sweep_test_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, a_sweep_test_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* check times */
+    if (times == 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: times check error.\n");
+        
+        return 1;
+    }
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* continuous mode */
+    if ((qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* every range, rate and over sample combination */
+    qmc5883l_interface_debug_print("range_gauss,odr_hz,osr,std_x_mgauss,std_y_mgauss,std_z_mgauss,rate_hz,dor_hz,iic_per_sample\n");
+    for (s = 0; s < 2; s++)
+    {
+        for (r = 0; r < 4; r++)
+        {
+            for (o = 0; o < 4; o++)
+            {
+                if ((qmc5883l_set_full_scale(&gs_handle, gs_scale[s]) != 0) ||
+                    (qmc5883l_set_output_rate(&gs_handle, gs_rate[r]) != 0) ||
+                    (qmc5883l_set_over_sample(&gs_handle, gs_sample[o]) != 0))
+                {
+                    qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+                    (void)qmc5883l_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+                (void)snprintf(line, sizeof(line), "%d,%d,%d", gs_scale_gauss[s], gs_rate_hz[r], gs_sample_ratio[o]);
+                res = a_sweep_test_measure(times, line);
+                if (res != 0)
+                {
+                    qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+                    (void)qmc5883l_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+            }
+        }
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    return 0;
+}
@@ -0,0 +1,303 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_tempco_test.c
+ * @brief     driver qmc5883l tempco test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_qmc5883l_tempco_test.h"
+#include <math.h>
+
+/**
+ * @brief tempco test definition
+ */
+#define TEMPCO_TEST_ORDER            3         /**< polynomial order */
+#define TEMPCO_TEST_REFRESH          10        /**< temperature refresh period in samples */
+#define TEMPCO_TEST_PERIOD_MS        5         /**< 200Hz sample period */
+
+static qmc5883l_handle_t gs_handle;            /**< qmc5883l handle */
+static qmc5883l_tempco_t gs_tempco;            /**< temperature compensation */
+
+/**
+ * @brief  check the fit on an exact quadratic drift
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   none
+ */
+static uint8_t a_tempco_test_model(void)
+{
+    const float field[3] = {200.0f, -150.0f, 400.0f};
+    const float linear[3] = {0.8f, -0.5f, 0.3f};
+    const float quadratic[3] = {0.01f, 0.004f, -0.006f};
+    float m_gauss[3];
+    float out[3];
+    float deg;
+    uint8_t k;
+    
+    /* too few samples */
+    (void)qmc5883l_tempco_init(&gs_tempco, 2, TEMPCO_TEST_REFRESH);
+    for (deg = -20.0f; deg < -19.0f; deg += 0.1f)
+    {
+        (void)qmc5883l_tempco_update(&gs_tempco, deg, field);
+    }
+    if (qmc5883l_tempco_solve(&gs_tempco, 25.0f) != 4)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: too few samples check error.\n");
+        
+        return 1;
+    }
+    
+    /* learn from -20 to 60 degrees */
+    (void)qmc5883l_tempco_reset(&gs_tempco);
+    for (deg = -20.0f; deg <= 60.0f; deg += 0.5f)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            m_gauss[k] = field[k] + linear[k] * (deg - 25.0f) + quadratic[k] * (deg - 25.0f) * (deg - 25.0f);
+        }
+        (void)qmc5883l_tempco_update(&gs_tempco, deg, m_gauss);
+    }
+    if (qmc5883l_tempco_solve(&gs_tempco, 25.0f) != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: tempco solve failed.\n");
+        
+        return 1;
+    }
+    
+    /* the compensated field is constant inside the range and held outside */
+    for (deg = -30.0f; deg <= 70.0f; deg += 2.5f)
+    {
+        float t;
+        
+        t = (deg < -20.0f) ? -20.0f : ((deg > 60.0f) ? 60.0f : deg);
+        for (k = 0; k < 3; k++)
+        {
+            m_gauss[k] = field[k] + linear[k] * (t - 25.0f) + quadratic[k] * (t - 25.0f) * (t - 25.0f);
+        }
+        (void)qmc5883l_tempco_set_temperature(&gs_tempco, deg);
+        (void)qmc5883l_tempco_apply(&gs_tempco, m_gauss, out);
+        for (k = 0; k < 3; k++)
+        {
+            if (fabsf(out[k] - field[k]) > 0.01f)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: %.1f degrees axis %d compensated %.3f check error.\n", deg, k, out[k]);
+                
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     tempco test
+ * @param[in] times is the number of samples of each phase
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the sensor must be kept still while the temperature sweeps the deployment range in each phase
+ */
+uint8_t qmc5883l_tempco_test(uint32_t times)
+{
+    uint8_t res;
+    uint8_t k;
+    uint32_t i;
+    int16_t raw[3];
+    int16_t t_raw;
+    float m_gauss[3];
+    float deg;
+    float reference;
+    float t_min;
+    float t_max;
+    float coeff[3][QMC5883L_TEMPCO_MAX_ORDER + 1];
+    double sum[2][3];
+    double sum2[2][3];
+    double std[2];
+    
+    /* link interface function */
+    DRIVER_QMC5883L_LINK_INIT(&gs_handle, qmc5883l_handle_t);
+    DRIVER_QMC5883L_LINK_IIC_INIT(&gs_handle, qmc5883l_interface_iic_init);
+    DRIVER_QMC5883L_LINK_IIC_DEINIT(&gs_handle, qmc5883l_interface_iic_deinit);
+    DRIVER_QMC5883L_LINK_IIC_READ(&gs_handle, qmc5883l_interface_iic_read);
+    DRIVER_QMC5883L_LINK_IIC_WRITE(&gs_handle, qmc5883l_interface_iic_write);
+    DRIVER_QMC5883L_LINK_DELAY_MS(&gs_handle, qmc5883l_interface_delay_ms);
+    DRIVER_QMC5883L_LINK_DEBUG_PRINT(&gs_handle, qmc5883l_interface_debug_print);
+    
+    /* start tempco test */
+    qmc5883l_interface_debug_print("qmc5883l: start tempco test.\n");
+    
+    /* order and period limits */
+    if ((qmc5883l_tempco_init(&gs_tempco, 0, TEMPCO_TEST_REFRESH) != 4) ||
+        (qmc5883l_tempco_init(&gs_tempco, QMC5883L_TEMPCO_MAX_ORDER + 1, TEMPCO_TEST_REFRESH) != 4) ||
+        (qmc5883l_tempco_init(&gs_tempco, TEMPCO_TEST_ORDER, 0) != 4))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: tempco limit check error.\n");
+        
+        return 1;
+    }
+    
+    /* fit a known drift */
+    res = a_tempco_test_model();
+    if (res != 0)
+    {
+        return 1;
+    }
+    qmc5883l_interface_debug_print("qmc5883l: known drift is removed.\n");
+    
+    /* qmc5883l init */
+    res = qmc5883l_init(&gs_handle);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: init failed.\n");
+       
+        return 1;
+    }
+    
+    /* 200Hz, 2gauss, 512 over sample, continuous mode */
+    if ((qmc5883l_set_output_rate(&gs_handle, QMC5883L_OUTPUT_RATE_200HZ) != 0) ||
+        (qmc5883l_set_full_scale(&gs_handle, QMC5883L_FULL_SCALE_2GAUSS) != 0) ||
+        (qmc5883l_set_over_sample(&gs_handle, QMC5883L_OVER_SAMPLE_512) != 0) ||
+        (qmc5883l_set_period(&gs_handle, 0x01) != 0) ||
+        (qmc5883l_set_mode(&gs_handle, QMC5883L_MODE_CONTINUOUS) != 0))
+    {
+        qmc5883l_interface_debug_print("qmc5883l: set config failed.\n");
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* learn the drift, the temperature is read every refresh period */
+    qmc5883l_interface_debug_print("qmc5883l: learn an order %d model from %d samples.\n", TEMPCO_TEST_ORDER, times);
+    (void)qmc5883l_tempco_init(&gs_tempco, TEMPCO_TEST_ORDER, TEMPCO_TEST_REFRESH);
+    deg = 0.0f;
+    reference = 0.0f;
+    for (i = 0; i < times; i++)
+    {
+        qmc5883l_interface_delay_ms(TEMPCO_TEST_PERIOD_MS);
+        if ((i % TEMPCO_TEST_REFRESH) == 0)
+        {
+            res = qmc5883l_read_temperature(&gs_handle, &t_raw, &deg);
+            if (res != 0)
+            {
+                qmc5883l_interface_debug_print("qmc5883l: read temperature failed.\n");
+                (void)qmc5883l_deinit(&gs_handle);
+                
+                return 1;
+            }
+            if (i == 0)
+            {
+                reference = deg;
+            }
+        }
+        res = qmc5883l_read(&gs_handle, raw, m_gauss);
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (void)qmc5883l_tempco_update(&gs_tempco, deg, m_gauss);
+    }
+    res = qmc5883l_tempco_solve(&gs_tempco, reference);
+    if (res != 0)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: tempco solve failed, the temperature must change by %.0f degrees.\n",
+                                       QMC5883L_TEMPCO_MIN_SPAN);
+        (void)qmc5883l_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)qmc5883l_tempco_get(&gs_tempco, coeff, &reference, &t_min, &t_max);
+    qmc5883l_interface_debug_print("qmc5883l: learned from %.2f to %.2f, reference %.2f.\n", t_min, t_max, reference);
+    for (k = 0; k < 3; k++)
+    {
+        qmc5883l_interface_debug_print("qmc5883l: axis %d coefficients %.3f %.3f %.3f %.3f.\n",
+                                       k, coeff[k][0], coeff[k][1], coeff[k][2], coeff[k][3]);
+    }
+    
+    /* compensate a second sweep */
+    memset(sum, 0, sizeof(sum));
+    memset(sum2, 0, sizeof(sum2));
+    for (i = 0; i < times; i++)
+    {
+        qmc5883l_interface_delay_ms(TEMPCO_TEST_PERIOD_MS);
+        res = qmc5883l_tempco_read(&gs_handle, &gs_tempco, raw, m_gauss);
+        if (res != 0)
+        {
+            qmc5883l_interface_debug_print("qmc5883l: tempco read failed.\n");
+            (void)qmc5883l_deinit(&gs_handle);
+            
+            return 1;
+        }
+        for (k = 0; k < 3; k++)
+        {
+            double v;
+            
+            v = (double)m_gauss[k] + gs_tempco.offset[k];
+            sum[0][k] += v;
+            sum2[0][k] += v * v;
+            sum[1][k] += m_gauss[k];
+            sum2[1][k] += (double)m_gauss[k] * m_gauss[k];
+        }
+    }
+    (void)qmc5883l_deinit(&gs_handle);
+    
+    /* compare the spread */
+    std[0] = 0.0;
+    std[1] = 0.0;
+    for (k = 0; k < 3; k++)
+    {
+        double mean;
+        
+        mean = sum[0][k] / times;
+        std[0] += sum2[0][k] / times - mean * mean;
+        mean = sum[1][k] / times;
+        std[1] += sum2[1][k] / times - mean * mean;
+    }
+    std[0] = sqrt(std[0] / 3.0);
+    std[1] = sqrt(std[1] / 3.0);
+    qmc5883l_interface_debug_print("qmc5883l: spread raw %.2f mgauss, compensated %.2f mgauss.\n", std[0], std[1]);
+    if (std[1] * 4.0 > std[0])
+    {
+        qmc5883l_interface_debug_print("qmc5883l: compensation check error.\n");
+        
+        return 1;
+    }
+    
+    /* finish tempco test */
+    qmc5883l_interface_debug_print("qmc5883l: finish tempco test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,470 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_analyze.c
+ * @brief     driver qmc5883l analyze source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "driver_qmc5883l_analyze.h"
+#include "driver_qmc5883l_batch.h"
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+/**
+ * @brief analyze task structure definition
+ */
+typedef struct analyze_task_s
+{
+    uint64_t first;                              /**< first block of all files */
+    uint64_t last;                               /**< block after the task */
+} analyze_task_t;
+
+/**
+ * @brief analyze accumulator structure definition
+ */
+typedef struct analyze_acc_s
+{
+    uint64_t count;                              /**< samples */
+    double mean;                                 /**< running mean */
+    double m2;                                   /**< running sum of squared deviations */
+    float min;                                   /**< min magnitude */
+    float max;                                   /**< max magnitude */
+    uint64_t hist[QMC5883L_ANALYZE_BINS];        /**< magnitude histogram */
+    uint32_t tasks;                              /**< executed tasks */
+    uint32_t steals;                             /**< stolen tasks */
+} analyze_acc_t;
+
+struct analyze_s;
+
+/**
+ * @brief analyze worker structure definition
+ */
+typedef struct analyze_worker_s
+{
+    uint8_t head[64];                                    /**< keeps the stats off the previous worker deque */
+    analyze_acc_t acc;                                   /**< worker stats, only touched by the owner */
+    uint8_t tail[64];                                    /**< keeps the stats off the own deque */
+    pthread_mutex_t lock;                                /**< deque lock */
+    analyze_task_t deque[QMC5883L_ANALYZE_DEQUE];        /**< task ring */
+    uint32_t top;                                        /**< steal end */
+    uint32_t bottom;                                     /**< owner end */
+    uint32_t seed;                                       /**< victim generator state */
+    uint32_t id;                                         /**< worker index */
+    struct analyze_s *pool;                              /**< owning pool */
+    pthread_t thread;                                    /**< worker thread */
+} analyze_worker_t;
+
+/**
+ * @brief analyze pool structure definition
+ */
+typedef struct analyze_s
+{
+    const qmc5883l_analyze_config_t *config;     /**< pipeline config */
+    qmc5883l_index_reader_t *readers;            /**< mapped files */
+    uint64_t *prefix;                            /**< first block of every file and the block total */
+    uint32_t files;                              /**< file count */
+    analyze_worker_t *workers;                   /**< workers */
+    pthread_mutex_t lock;                        /**< remaining lock */
+    uint64_t remaining;                          /**< blocks not analyzed yet */
+} analyze_t;
+
+/**
+ * @brief     push a task on the owner end
+ * @param[in] *w points to a worker structure
+ * @param[in] task is the pushed task
+ * @return    status code
+ *            - 0 success
+ *            - 1 deque is full
+ * @note      none
+ */
+static uint8_t a_analyze_push(analyze_worker_t *w, analyze_task_t task)
+{
+    uint8_t res = 1;
+    
+    (void)pthread_mutex_lock(&w->lock);
+    if (w->bottom - w->top < QMC5883L_ANALYZE_DEQUE)
+    {
+        w->deque[w->bottom % QMC5883L_ANALYZE_DEQUE] = task;
+        w->bottom++;
+        res = 0;
+    }
+    (void)pthread_mutex_unlock(&w->lock);
+    
+    return res;
+}
+
+/**
+ * @brief      take a task from a deque
+ * @param[in]  *w points to a worker structure
+ * @param[in]  steal is 1 to take the oldest task, 0 to take the newest
+ * @param[out] *task points to a task buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 deque is empty
+ * @note       the owner works depth first on small halves, thieves get the large old ones
+ */
+static uint8_t a_analyze_take(analyze_worker_t *w, uint8_t steal, analyze_task_t *task)
+{
+    uint8_t res = 1;
+    
+    (void)pthread_mutex_lock(&w->lock);
+    if (w->bottom != w->top)
+    {
+        if (steal != 0)
+        {
+            *task = w->deque[w->top % QMC5883L_ANALYZE_DEQUE];
+            w->top++;
+        }
+        else
+        {
+            w->bottom--;
+            *task = w->deque[w->bottom % QMC5883L_ANALYZE_DEQUE];
+        }
+        res = 0;
+    }
+    (void)pthread_mutex_unlock(&w->lock);
+    
+    return res;
+}
+
+/**
+ * @brief     run the pipeline over one chunk of samples
+ * @param[in] *w points to a worker structure
+ * @param[in] *samples points to the mapped samples
+ * @param[in] len is the number of samples
+ * @note      decode, convert or calibrate, then the magnitude stats
+ */
+static void a_analyze_chunk(analyze_worker_t *w, const qmc5883l_index_sample_t *samples, uint32_t len)
+{
+    const qmc5883l_analyze_config_t *config = w->pool->config;
+    int16_t raw[QMC5883L_ANALYZE_CHUNK][3];
+    float m[QMC5883L_ANALYZE_CHUNK][3];
+    analyze_acc_t *acc = &w->acc;
+    float scale;
+    uint32_t i;
+    
+    /* decode */
+    for (i = 0; i < len; i++)
+    {
+        raw[i][0] = samples[i].raw[0];
+        raw[i][1] = samples[i].raw[1];
+        raw[i][2] = samples[i].raw[2];
+    }
+    
+    /* convert or calibrate */
+    if (config->cal != NULL)
+    {
+        (void)qmc5883l_batch_calibrate(config->cal, config->scale, (const int16_t (*)[3])raw, m, len);
+    }
+    else
+    {
+        (void)qmc5883l_batch_convert(config->scale, (const int16_t (*)[3])raw, m, len);
+    }
+    
+    /* stats */
+    scale = QMC5883L_ANALYZE_BINS / config->hist_max_mgauss;
+    for (i = 0; i < len; i++)
+    {
+        float mag = sqrtf(m[i][0] * m[i][0] + m[i][1] * m[i][1] + m[i][2] * m[i][2]);
+        double delta = mag - acc->mean;
+        uint32_t bin = (uint32_t)(mag * scale);
+        
+        acc->count++;
+        acc->mean += delta / (double)acc->count;
+        acc->m2 += delta * (mag - acc->mean);
+        acc->min = ((acc->count == 1) || (mag < acc->min)) ? mag : acc->min;
+        acc->max = ((acc->count == 1) || (mag > acc->max)) ? mag : acc->max;
+        acc->hist[(bin < QMC5883L_ANALYZE_BINS) ? bin : (QMC5883L_ANALYZE_BINS - 1)]++;
+    }
+}
+
+/**
+ * @brief     run one task
+ * @param[in] *w points to a worker structure
+ * @param[in] task is the task
+ * @note      the task is halved while it is above the grain, the upper halves go on the deque
+ */
+static void a_analyze_task(analyze_worker_t *w, analyze_task_t task)
+{
+    analyze_t *pool = w->pool;
+    uint64_t b;
+    uint32_t file;
+    
+    while (task.last - task.first > pool->config->grain)
+    {
+        analyze_task_t upper;
+        
+        upper.first = task.first + (task.last - task.first) / 2;
+        upper.last = task.last;
+        if (a_analyze_push(w, upper) != 0)
+        {
+            break;
+        }
+        task.last = upper.first;
+    }
+    
+    file = 0;
+    for (b = task.first; b < task.last; b++)
+    {
+        const qmc5883l_index_block_t *block;
+        uint64_t i;
+        
+        /* the file of the block */
+        if ((b < pool->prefix[file]) || (b >= pool->prefix[file + 1]))
+        {
+            uint32_t lo = 0;
+            uint32_t hi = pool->files;
+            
+            while (hi - lo > 1)
+            {
+                uint32_t mid = lo + (hi - lo) / 2;
+                
+                if (pool->prefix[mid] <= b)
+                {
+                    lo = mid;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            file = lo;
+        }
+        block = &pool->readers[file].blocks[b - pool->prefix[file]];
+        for (i = 0; i < block->count; i += QMC5883L_ANALYZE_CHUNK)
+        {
+            uint64_t len = block->count - i;
+            
+            a_analyze_chunk(w, pool->readers[file].samples + block->first + i,
+                            (uint32_t)((len < QMC5883L_ANALYZE_CHUNK) ? len : QMC5883L_ANALYZE_CHUNK));
+        }
+    }
+    w->acc.tasks++;
+    
+    (void)pthread_mutex_lock(&pool->lock);
+    pool->remaining -= task.last - task.first;
+    (void)pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief     worker thread
+ * @param[in] *arg points to a worker structure
+ * @return    NULL
+ * @note      runs until every block is analyzed
+ */
+static void *a_analyze_worker(void *arg)
+{
+    analyze_worker_t *w = (analyze_worker_t *)arg;
+    analyze_t *pool = w->pool;
+    uint32_t threads = pool->config->threads;
+    analyze_task_t task;
+    uint64_t remaining;
+    uint32_t i;
+    
+    while (1)
+    {
+        if (a_analyze_take(w, 0, &task) == 0)
+        {
+            a_analyze_task(w, task);
+            
+            continue;
+        }
+        
+        /* steal from the others starting at a random victim */
+        w->seed = w->seed * 1664525U + 1013904223U;
+        for (i = 0; i < threads - 1; i++)
+        {
+            analyze_worker_t *victim = &pool->workers[(w->id + 1 + ((w->seed >> 8) + i) % (threads - 1)) % threads];
+            
+            if (a_analyze_take(victim, 1, &task) == 0)
+            {
+                w->acc.steals++;
+                a_analyze_task(w, task);
+                
+                break;
+            }
+        }
+        if (i < threads - 1)
+        {
+            continue;
+        }
+        
+        (void)pthread_mutex_lock(&pool->lock);
+        remaining = pool->remaining;
+        (void)pthread_mutex_unlock(&pool->lock);
+        if (remaining == 0)
+        {
+            break;
+        }
+        (void)sched_yield();
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief      analyze index files
+ * @param[in]  **paths points to an index file path array
+ * @param[in]  files is the number of files
+ * @param[in]  *config points to a config structure
+ * @param[out] *stats points to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 open file or start thread failed
+ *             - 2 buffer is NULL
+ *             - 4 config is invalid
+ * @note       the blocks of all files form one range which is split in halves on demand, idle workers steal
+ *             the largest pending half, every worker keeps its own stats and they are merged after the join
+ */
+uint8_t qmc5883l_analyze_run(const char *const *paths, uint32_t files, const qmc5883l_analyze_config_t *config,
+                             qmc5883l_analyze_stats_t *stats)
+{
+    analyze_t pool;
+    analyze_task_t all;
+    uint32_t opened;
+    uint32_t started;
+    uint32_t i;
+    uint32_t j;
+    uint8_t res;
+    double m2;
+    
+    if ((paths == NULL) || (config == NULL) || (stats == NULL))
+    {
+        return 2;
+    }
+    if ((files == 0) || (config->scale > QMC5883L_FULL_SCALE_8GAUSS) || (config->hist_max_mgauss <= 0.0f) ||
+        (config->threads == 0) || (config->threads > QMC5883L_ANALYZE_MAX_THREADS) || (config->grain == 0))
+    {
+        return 4;
+    }
+    
+    /* map every file and number the blocks */
+    memset(&pool, 0, sizeof(analyze_t));
+    pool.config = config;
+    pool.files = files;
+    pool.readers = (qmc5883l_index_reader_t *)calloc(files, sizeof(qmc5883l_index_reader_t));
+    pool.prefix = (uint64_t *)calloc((size_t)files + 1, sizeof(uint64_t));
+    pool.workers = (analyze_worker_t *)calloc(config->threads, sizeof(analyze_worker_t));
+    res = ((pool.readers == NULL) || (pool.prefix == NULL) || (pool.workers == NULL)) ? 1 : 0;
+    for (opened = 0; (res == 0) && (opened < files); opened++)
+    {
+        if (qmc5883l_index_open(&pool.readers[opened], paths[opened]) != 0)
+        {
+            res = 1;
+            
+            break;
+        }
+        pool.prefix[opened + 1] = pool.prefix[opened] + pool.readers[opened].header->blocks;
+    }
+    
+    /* one task over everything, the others steal their share */
+    started = 0;
+    if (res == 0)
+    {
+        pool.remaining = pool.prefix[files];
+        (void)pthread_mutex_init(&pool.lock, NULL);
+        for (i = 0; i < config->threads; i++)
+        {
+            (void)pthread_mutex_init(&pool.workers[i].lock, NULL);
+            pool.workers[i].pool = &pool;
+            pool.workers[i].id = i;
+            pool.workers[i].seed = i * 2654435761U + 1;
+        }
+        all.first = 0;
+        all.last = pool.prefix[files];
+        if (all.last != 0)
+        {
+            (void)a_analyze_push(&pool.workers[0], all);
+        }
+        for (started = 0; started < config->threads; started++)
+        {
+            if (pthread_create(&pool.workers[started].thread, NULL, a_analyze_worker, &pool.workers[started]) != 0)
+            {
+                res = 1;
+                
+                break;
+            }
+        }
+        
+        /* after a failed start the started workers still finish the blocks */
+        for (i = 0; i < started; i++)
+        {
+            (void)pthread_join(pool.workers[i].thread, NULL);
+        }
+        for (i = 0; i < config->threads; i++)
+        {
+            (void)pthread_mutex_destroy(&pool.workers[i].lock);
+        }
+        (void)pthread_mutex_destroy(&pool.lock);
+    }
+    
+    /* merge the worker stats in a fixed order */
+    memset(stats, 0, sizeof(qmc5883l_analyze_stats_t));
+    m2 = 0.0;
+    for (i = 0; (res == 0) && (i < config->threads); i++)
+    {
+        const analyze_acc_t *acc = &pool.workers[i].acc;
+        uint64_t n = stats->count + acc->count;
+        double delta = acc->mean - stats->mean_mgauss;
+        
+        if (acc->count != 0)
+        {
+            m2 += acc->m2 + delta * delta * ((double)stats->count * (double)acc->count / (double)n);
+            stats->mean_mgauss += delta * (double)acc->count / (double)n;
+            stats->min_mgauss = ((stats->count == 0) || (acc->min < stats->min_mgauss)) ? acc->min : stats->min_mgauss;
+            stats->max_mgauss = ((stats->count == 0) || (acc->max > stats->max_mgauss)) ? acc->max : stats->max_mgauss;
+            stats->count = n;
+        }
+        for (j = 0; j < QMC5883L_ANALYZE_BINS; j++)
+        {
+            stats->hist[j] += acc->hist[j];
+        }
+        stats->tasks += acc->tasks;
+        stats->steals += acc->steals;
+    }
+    stats->sigma_mgauss = (stats->count > 1) ? sqrt(m2 / (double)(stats->count - 1)) : 0.0;
+    
+    /* unmap */
+    for (i = 0; i < opened; i++)
+    {
+        (void)qmc5883l_index_close(&pool.readers[i]);
+    }
+    free(pool.readers);
+    free(pool.prefix);
+    free(pool.workers);
+    
+    return res;
+}
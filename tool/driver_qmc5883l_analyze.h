@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_analyze.h
+ * @brief     driver qmc5883l analyze header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_ANALYZE_H
+#define DRIVER_QMC5883L_ANALYZE_H
+
+#include "driver_qmc5883l_index.h"
+#include "driver_qmc5883l_calibration.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_analyze_driver qmc5883l analyze driver function
+ * @brief    qmc5883l analyze driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l analyze definition
+ */
+#define QMC5883L_ANALYZE_BINS           64         /**< magnitude histogram bins */
+#define QMC5883L_ANALYZE_MAX_THREADS    64         /**< max worker threads */
+#define QMC5883L_ANALYZE_CHUNK          256        /**< samples per pipeline pass */
+#define QMC5883L_ANALYZE_DEQUE          64         /**< tasks per worker deque */
+
+/**
+ * @brief qmc5883l analyze config structure definition
+ */
+typedef struct qmc5883l_analyze_config_s
+{
+    qmc5883l_full_scale_t scale;             /**< full scale of the recordings */
+    qmc5883l_calibration_t *cal;             /**< calibration, NULL skips the calibrate stage */
+    float hist_max_mgauss;                   /**< upper edge of the histogram */
+    uint32_t threads;                        /**< worker threads */
+    uint32_t grain;                          /**< index blocks below which a task is not split */
+} qmc5883l_analyze_config_t;
+
+/**
+ * @brief qmc5883l analyze stats structure definition
+ */
+typedef struct qmc5883l_analyze_stats_s
+{
+    uint64_t count;                              /**< analyzed samples */
+    double mean_mgauss;                          /**< mean field magnitude */
+    double sigma_mgauss;                         /**< field magnitude standard deviation */
+    float min_mgauss;                            /**< min field magnitude */
+    float max_mgauss;                            /**< max field magnitude */
+    uint64_t hist[QMC5883L_ANALYZE_BINS];        /**< magnitude histogram, the last bin takes the overflow */
+    uint32_t tasks;                              /**< executed tasks */
+    uint32_t steals;                             /**< tasks taken from another worker */
+} qmc5883l_analyze_stats_t;
+
+/**
+ * @brief      analyze index files
+ * @param[in]  **paths points to an index file path array
+ * @param[in]  files is the number of files
+ * @param[in]  *config points to a config structure
+ * @param[out] *stats points to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 open file or start thread failed
+ *             - 2 buffer is NULL
+ *             - 4 config is invalid
+ * @note       the blocks of all files form one range which is split in halves on demand, idle workers steal
+ *             the largest pending half, every worker keeps its own stats and they are merged after the join
+ */
+uint8_t qmc5883l_analyze_run(const char *const *paths, uint32_t files, const qmc5883l_analyze_config_t *config,
+                             qmc5883l_analyze_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
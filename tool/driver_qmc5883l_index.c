@@ -0,0 +1,530 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_index.c
+ * @brief     driver qmc5883l index source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+
+#include "driver_qmc5883l_index.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief     write the open block into the spooled index
+ * @param[in] *writer points to a writer structure
+ * @note      none
+ */
+static void a_index_put_block(qmc5883l_index_writer_t *writer)
+{
+    if (writer->block.count == 0)
+    {
+        return;
+    }
+    if (fwrite(&writer->block, sizeof(qmc5883l_index_block_t), 1, writer->index) != 1)
+    {
+        writer->error = 1;
+    }
+    writer->header.blocks++;
+    writer->block.count = 0;
+}
+
+/**
+ * @brief     first sample at or after a time
+ * @param[in] *reader points to a reader structure
+ * @param[in] time_us is the searched time
+ * @return    sample position, the sample count when every sample is earlier
+ * @note      none
+ */
+static uint64_t a_index_lower_bound(qmc5883l_index_reader_t *reader, uint64_t time_us)
+{
+    const qmc5883l_index_block_t *b;
+    uint64_t lo;
+    uint64_t hi;
+    
+    /* first block which ends at or after the time */
+    lo = 0;
+    hi = reader->header->blocks;
+    while (lo < hi)
+    {
+        uint64_t mid = lo + (hi - lo) / 2;
+        
+        if (reader->blocks[mid].last_us < time_us)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (lo == reader->header->blocks)
+    {
+        return reader->header->samples;
+    }
+    
+    /* first sample of the block at or after the time */
+    b = &reader->blocks[lo];
+    lo = b->first;
+    hi = b->first + b->count - 1;
+    while (lo < hi)
+    {
+        uint64_t mid = lo + (hi - lo) / 2;
+        
+        if (reader->samples[mid].time_us < time_us)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    
+    return lo;
+}
+
+/**
+ * @brief     check the block index of a mapped file
+ * @param[in] *h points to a header structure
+ * @param[in] *blocks points to the block index
+ * @return    status code
+ *            - 0 success
+ *            - 1 a block is corrupted
+ * @note      every block must be full except the last one and the times must not go back,
+ *            so the searches stay inside the mapping
+ */
+static uint8_t a_index_check_blocks(const qmc5883l_index_header_t *h, const qmc5883l_index_block_t *blocks)
+{
+    uint64_t i;
+    uint64_t last_us;
+    
+    last_us = 0;
+    for (i = 0; i < h->blocks; i++)
+    {
+        const qmc5883l_index_block_t *b = &blocks[i];
+        
+        if ((b->first != i * h->block_samples) || (b->count == 0) || (b->count > h->block_samples) ||
+            (b->first + b->count > h->samples) || (b->first_us > b->last_us) || (b->last_us < last_us))
+        {
+            return 1;
+        }
+        last_us = b->last_us;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      create an index file
+ * @param[out] *writer points to a writer structure
+ * @param[in]  *path points to a file path
+ * @param[in]  block_samples is the number of samples per index block
+ * @return     status code
+ *             - 0 success
+ *             - 1 open file failed
+ *             - 2 writer or path is NULL
+ *             - 4 block_samples is 0
+ * @note       smaller blocks skip more finely, larger blocks keep the index small
+ */
+uint8_t qmc5883l_index_create(qmc5883l_index_writer_t *writer, const char *path, uint32_t block_samples)
+{
+    if ((writer == NULL) || (path == NULL))
+    {
+        return 2;
+    }
+    if (block_samples == 0)
+    {
+        return 4;
+    }
+    
+    memset(writer, 0, sizeof(qmc5883l_index_writer_t));
+    writer->fp = fopen(path, "wb");
+    if (writer->fp == NULL)
+    {
+        return 1;
+    }
+    writer->index = tmpfile();
+    if (writer->index == NULL)
+    {
+        (void)fclose(writer->fp);
+        writer->fp = NULL;
+        
+        return 1;
+    }
+    
+    /* the header is written again by finish */
+    memcpy(writer->header.magic, QMC5883L_INDEX_MAGIC, 4);
+    writer->header.version = QMC5883L_INDEX_VERSION;
+    writer->header.block_samples = block_samples;
+    if (fwrite(&writer->header, sizeof(qmc5883l_index_header_t), 1, writer->fp) != 1)
+    {
+        writer->error = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     append one sample
+ * @param[in] *writer points to a writer structure
+ * @param[in] time_us is the sample time
+ * @param[in] *raw points to a raw data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 writer or raw is NULL
+ *            - 3 writer is not open
+ *            - 4 time_us is before the last sample
+ * @note      none
+ */
+uint8_t qmc5883l_index_append(qmc5883l_index_writer_t *writer, uint64_t time_us, const int16_t raw[3])
+{
+    qmc5883l_index_block_t *b;
+    qmc5883l_index_sample_t s;
+    uint8_t a;
+    
+    if ((writer == NULL) || (raw == NULL))
+    {
+        return 2;
+    }
+    if (writer->fp == NULL)
+    {
+        return 3;
+    }
+    if ((writer->header.samples != 0) && (time_us < writer->header.last_us))
+    {
+        return 4;
+    }
+    
+    /* write the sample */
+    s.time_us = time_us;
+    s.raw[0] = raw[0];
+    s.raw[1] = raw[1];
+    s.raw[2] = raw[2];
+    s.reserved = 0;
+    if (fwrite(&s, sizeof(qmc5883l_index_sample_t), 1, writer->fp) != 1)
+    {
+        writer->error = 1;
+        
+        return 1;
+    }
+    
+    /* update the block summary */
+    b = &writer->block;
+    if (b->count == 0)
+    {
+        b->first_us = time_us;
+        b->first = writer->header.samples;
+        for (a = 0; a < 3; a++)
+        {
+            b->min[a] = raw[a];
+            b->max[a] = raw[a];
+        }
+    }
+    for (a = 0; a < 3; a++)
+    {
+        b->min[a] = (raw[a] < b->min[a]) ? raw[a] : b->min[a];
+        b->max[a] = (raw[a] > b->max[a]) ? raw[a] : b->max[a];
+    }
+    b->last_us = time_us;
+    b->count++;
+    if (writer->header.samples == 0)
+    {
+        writer->header.first_us = time_us;
+    }
+    writer->header.last_us = time_us;
+    writer->header.samples++;
+    if (b->count == writer->header.block_samples)
+    {
+        a_index_put_block(writer);
+    }
+    
+    return (writer->error != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     write the block index and close the file
+ * @param[in] *writer points to a writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write or close failed
+ *            - 2 writer is NULL
+ *            - 3 writer is not open
+ * @note      the file is only valid after close
+ */
+uint8_t qmc5883l_index_finish(qmc5883l_index_writer_t *writer)
+{
+    uint8_t buf[4096];
+    size_t len;
+    
+    if (writer == NULL)
+    {
+        return 2;
+    }
+    if (writer->fp == NULL)
+    {
+        return 3;
+    }
+    
+    /* copy the spooled index behind the samples */
+    a_index_put_block(writer);
+    writer->header.index_offset = sizeof(qmc5883l_index_header_t) +
+                                  writer->header.samples * sizeof(qmc5883l_index_sample_t);
+    rewind(writer->index);
+    while ((len = fread(buf, 1, sizeof(buf), writer->index)) != 0)
+    {
+        if (fwrite(buf, 1, len, writer->fp) != len)
+        {
+            writer->error = 1;
+        }
+    }
+    if (ferror(writer->index) != 0)
+    {
+        writer->error = 1;
+    }
+    (void)fclose(writer->index);
+    
+    /* write the final header */
+    if ((fseek(writer->fp, 0, SEEK_SET) != 0) ||
+        (fwrite(&writer->header, sizeof(qmc5883l_index_header_t), 1, writer->fp) != 1))
+    {
+        writer->error = 1;
+    }
+    if (fclose(writer->fp) != 0)
+    {
+        writer->error = 1;
+    }
+    writer->fp = NULL;
+    writer->index = NULL;
+    
+    return (writer->error != 0) ? 1 : 0;
+}
+
+/**
+ * @brief      map an index file
+ * @param[out] *reader points to a reader structure
+ * @param[in]  *path points to a file path
+ * @return     status code
+ *             - 0 success
+ *             - 1 open, map, format or block check failed
+ *             - 2 reader or path is NULL
+ * @note       the whole file is mapped read only, a 64 bit host is needed for files over a few GB
+ */
+uint8_t qmc5883l_index_open(qmc5883l_index_reader_t *reader, const char *path)
+{
+    const qmc5883l_index_header_t *h;
+    struct stat st;
+    void *map;
+    int fd;
+    
+    if ((reader == NULL) || (path == NULL))
+    {
+        return 2;
+    }
+    
+    memset(reader, 0, sizeof(qmc5883l_index_reader_t));
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    if ((fstat(fd, &st) != 0) || ((uint64_t)st.st_size < sizeof(qmc5883l_index_header_t)) ||
+        ((uint64_t)st.st_size > (uint64_t)(size_t)-1))
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (map == MAP_FAILED)
+    {
+        return 1;
+    }
+    
+    /* check the layout before any pointer is handed out */
+    h = (const qmc5883l_index_header_t *)map;
+    if ((memcmp(h->magic, QMC5883L_INDEX_MAGIC, 4) != 0) || (h->version != QMC5883L_INDEX_VERSION) ||
+        (h->block_samples == 0) || (h->samples > (uint64_t)st.st_size / sizeof(qmc5883l_index_sample_t)) ||
+        (h->blocks != (h->samples + h->block_samples - 1) / h->block_samples) ||
+        (h->index_offset != sizeof(qmc5883l_index_header_t) + h->samples * sizeof(qmc5883l_index_sample_t)) ||
+        (h->index_offset + h->blocks * sizeof(qmc5883l_index_block_t) != (uint64_t)st.st_size) ||
+        (a_index_check_blocks(h, (const qmc5883l_index_block_t *)((const uint8_t *)map + h->index_offset)) != 0))
+    {
+        (void)munmap(map, (size_t)st.st_size);
+        
+        return 1;
+    }
+    reader->map = (const uint8_t *)map;
+    reader->size = (size_t)st.st_size;
+    reader->header = h;
+    reader->samples = (const qmc5883l_index_sample_t *)(reader->map + sizeof(qmc5883l_index_header_t));
+    reader->blocks = (const qmc5883l_index_block_t *)(reader->map + h->index_offset);
+    
+    return 0;
+}
+
+/**
+ * @brief     unmap an index file
+ * @param[in] *reader points to a reader structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 unmap failed
+ *            - 2 reader is NULL
+ *            - 3 reader is not open
+ * @note      pointers returned by the reader are invalid afterwards
+ */
+uint8_t qmc5883l_index_close(qmc5883l_index_reader_t *reader)
+{
+    uint8_t res;
+    
+    if (reader == NULL)
+    {
+        return 2;
+    }
+    if (reader->map == NULL)
+    {
+        return 3;
+    }
+    
+    res = (munmap((void *)reader->map, reader->size) != 0) ? 1 : 0;
+    memset(reader, 0, sizeof(qmc5883l_index_reader_t));
+    
+    return res;
+}
+
+/**
+ * @brief      get the samples of a time range
+ * @param[in]  *reader points to a reader structure
+ * @param[in]  start_us is the first time of the range
+ * @param[in]  stop_us is the time after the range
+ * @param[out] **samples points to a sample pointer buffer
+ * @param[out] *count points to a sample count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 reader or buffer is NULL
+ *             - 3 reader is not open
+ * @note       returns the samples in [start_us, stop_us) in place in the mapping,
+ *             the block index is searched first and then the one block
+ */
+uint8_t qmc5883l_index_range(qmc5883l_index_reader_t *reader, uint64_t start_us, uint64_t stop_us,
+                             const qmc5883l_index_sample_t **samples, uint64_t *count)
+{
+    uint64_t first;
+    uint64_t last;
+    
+    if ((reader == NULL) || (samples == NULL) || (count == NULL))
+    {
+        return 2;
+    }
+    if (reader->map == NULL)
+    {
+        return 3;
+    }
+    
+    first = a_index_lower_bound(reader, start_us);
+    last = (stop_us > start_us) ? a_index_lower_bound(reader, stop_us) : first;
+    *samples = reader->samples + first;
+    *count = last - first;
+    
+    return 0;
+}
+
+/**
+ * @brief      find the next sample outside a band
+ * @param[in]  *reader points to a reader structure
+ * @param[in]  axis is the axis in [0, 2]
+ * @param[in]  low is the lowest value inside the band
+ * @param[in]  high is the highest value inside the band
+ * @param[in]  start is the first searched sample position
+ * @param[out] *pos points to a found sample position buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 reader or pos is NULL
+ *             - 3 reader is not open
+ *             - 4 axis is invalid
+ * @note       blocks whose min and max lie inside the band are skipped without touching their samples,
+ *             pos is the sample count when nothing is found
+ */
+uint8_t qmc5883l_index_find(qmc5883l_index_reader_t *reader, uint8_t axis, int16_t low, int16_t high,
+                            uint64_t start, uint64_t *pos)
+{
+    uint64_t b;
+    uint64_t i;
+    
+    if ((reader == NULL) || (pos == NULL))
+    {
+        return 2;
+    }
+    if (reader->map == NULL)
+    {
+        return 3;
+    }
+    if (axis > 2)
+    {
+        return 4;
+    }
+    
+    reader->skipped = 0;
+    for (b = start / reader->header->block_samples; b < reader->header->blocks; b++)
+    {
+        const qmc5883l_index_block_t *block = &reader->blocks[b];
+        uint64_t end = block->first + block->count;
+        
+        /* the whole block is inside the band */
+        if ((block->min[axis] >= low) && (block->max[axis] <= high))
+        {
+            reader->skipped++;
+            
+            continue;
+        }
+        for (i = (start > block->first) ? start : block->first; i < end; i++)
+        {
+            int16_t v = reader->samples[i].raw[axis];
+            
+            if ((v < low) || (v > high))
+            {
+                *pos = i;
+                
+                return 0;
+            }
+        }
+    }
+    *pos = reader->header->samples;
+    
+    return 0;
+}
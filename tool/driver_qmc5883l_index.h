@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_qmc5883l_index.h
+ * @brief     driver qmc5883l index header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_QMC5883L_INDEX_H
+#define DRIVER_QMC5883L_INDEX_H
+
+#include "driver_qmc5883l.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup qmc5883l_index_driver qmc5883l index driver function
+ * @brief    qmc5883l index driver modules
+ * @ingroup  qmc5883l_driver
+ * @{
+ */
+
+/**
+ * @brief qmc5883l index file definition
+ * @note  the file is a header, the samples in time order and the block index, all little endian and
+ *        stored as the structures below so a mapped file is read in place
+ */
+#define QMC5883L_INDEX_MAGIC            "QMCI"        /**< file magic */
+#define QMC5883L_INDEX_VERSION          1             /**< file version */
+#ifndef QMC5883L_INDEX_BLOCK_SAMPLES
+    #define QMC5883L_INDEX_BLOCK_SAMPLES 4096         /**< default samples per index block */
+#endif
+
+/**
+ * @brief qmc5883l index file header structure definition
+ */
+typedef struct qmc5883l_index_header_s
+{
+    char magic[4];                  /**< file magic */
+    uint32_t version;               /**< file version */
+    uint32_t block_samples;         /**< samples per index block */
+    uint32_t reserved;              /**< reserved */
+    uint64_t samples;               /**< sample count */
+    uint64_t blocks;                /**< index block count */
+    uint64_t index_offset;          /**< index byte offset */
+    uint64_t first_us;              /**< first sample time */
+    uint64_t last_us;               /**< last sample time */
+    uint64_t reserved2;             /**< reserved */
+} qmc5883l_index_header_t;
+
+/**
+ * @brief qmc5883l index sample structure definition
+ */
+typedef struct qmc5883l_index_sample_s
+{
+    uint64_t time_us;               /**< sample time */
+    int16_t raw[3];                 /**< raw data */
+    uint16_t reserved;              /**< reserved */
+} qmc5883l_index_sample_t;
+
+/**
+ * @brief qmc5883l index block structure definition
+ */
+typedef struct qmc5883l_index_block_s
+{
+    uint64_t first_us;              /**< first sample time */
+    uint64_t last_us;               /**< last sample time */
+    uint64_t first;                 /**< first sample position */
+    uint32_t count;                 /**< block samples */
+    int16_t min[3];                 /**< per axis min */
+    int16_t max[3];                 /**< per axis max */
+} qmc5883l_index_block_t;
+
+/**
+ * @brief qmc5883l index writer structure definition
+ */
+typedef struct qmc5883l_index_writer_s
+{
+    FILE *fp;                               /**< index file */
+    FILE *index;                            /**< spooled block index */
+    qmc5883l_index_header_t header;         /**< file header */
+    qmc5883l_index_block_t block;           /**< open block */
+    uint8_t error;                          /**< write error flag */
+} qmc5883l_index_writer_t;
+
+/**
+ * @brief qmc5883l index reader structure definition
+ */
+typedef struct qmc5883l_index_reader_s
+{
+    const uint8_t *map;                             /**< mapped file */
+    size_t size;                                    /**< mapped length */
+    const qmc5883l_index_header_t *header;          /**< file header */
+    const qmc5883l_index_sample_t *samples;         /**< samples */
+    const qmc5883l_index_block_t *blocks;           /**< block index */
+    uint64_t skipped;                               /**< blocks skipped by the last find */
+} qmc5883l_index_reader_t;
+
+/**
+ * @brief      create an index file
+ * @param[out] *writer points to a writer structure
+ * @param[in]  *path points to a file path
+ * @param[in]  block_samples is the number of samples per index block
+ * @return     status code
+ *             - 0 success
+ *             - 1 open file failed
+ *             - 2 writer or path is NULL
+ *             - 4 block_samples is 0
+ * @note       smaller blocks skip more finely, larger blocks keep the index small
+ */
+uint8_t qmc5883l_index_create(qmc5883l_index_writer_t *writer, const char *path, uint32_t block_samples);
+
+/**
+ * @brief     append one sample
+ * @param[in] *writer points to a writer structure
+ * @param[in] time_us is the sample time
+ * @param[in] *raw points to a raw data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 writer or raw is NULL
+ *            - 3 writer is not open
+ *            - 4 time_us is before the last sample
+ * @note      none
+ */
+uint8_t qmc5883l_index_append(qmc5883l_index_writer_t *writer, uint64_t time_us, const int16_t raw[3]);
+
+/**
+ * @brief     write the block index and close the file
+ * @param[in] *writer points to a writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write or close failed
+ *            - 2 writer is NULL
+ *            - 3 writer is not open
+ * @note      the file is only valid after close
+ */
+uint8_t qmc5883l_index_finish(qmc5883l_index_writer_t *writer);
+
+/**
+ * @brief      map an index file
+ * @param[out] *reader points to a reader structure
+ * @param[in]  *path points to a file path
+ * @return     status code
+ *             - 0 success
+ *             - 1 open, map, format or block check failed
+ *             - 2 reader or path is NULL
+ * @note       the whole file is mapped read only, a 64 bit host is needed for files over a few GB
+ */
+uint8_t qmc5883l_index_open(qmc5883l_index_reader_t *reader, const char *path);
+
+/**
+ * @brief     unmap an index file
+ * @param[in] *reader points to a reader structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 unmap failed
+ *            - 2 reader is NULL
+ *            - 3 reader is not open
+ * @note      pointers returned by the reader are invalid afterwards
+ */
+uint8_t qmc5883l_index_close(qmc5883l_index_reader_t *reader);
+
+/**
+ * @brief      get the samples of a time range
+ * @param[in]  *reader points to a reader structure
+ * @param[in]  start_us is the first time of the range
+ * @param[in]  stop_us is the time after the range
+ * @param[out] **samples points to a sample pointer buffer
+ * @param[out] *count points to a sample count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 reader or buffer is NULL
+ *             - 3 reader is not open
+ * @note       returns the samples in [start_us, stop_us) in place in the mapping,
+ *             the block index is searched first and then the one block
+ */
+uint8_t qmc5883l_index_range(qmc5883l_index_reader_t *reader, uint64_t start_us, uint64_t stop_us,
+                             const qmc5883l_index_sample_t **samples, uint64_t *count);
+
+/**
+ * @brief      find the next sample outside a band
+ * @param[in]  *reader points to a reader structure
+ * @param[in]  axis is the axis in [0, 2]
+ * @param[in]  low is the lowest value inside the band
+ * @param[in]  high is the highest value inside the band
+ * @param[in]  start is the first searched sample position
+ * @param[out] *pos points to a found sample position buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 reader or pos is NULL
+ *             - 3 reader is not open
+ *             - 4 axis is invalid
+ * @note       blocks whose min and max lie inside the band are skipped without touching their samples,
+ *             pos is the sample count when nothing is found
+ */
+uint8_t qmc5883l_index_find(qmc5883l_index_reader_t *reader, uint8_t axis, int16_t low, int16_t high,
+                            uint64_t start, uint64_t *pos);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif